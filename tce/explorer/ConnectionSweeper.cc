@@ -498,22 +498,37 @@ private:
             RowID bestConfInThisIteration = -1;
             std::vector<const TTAMachine::Connection*>::iterator unneededPos = 
                 connections.end();
-            // find the least affecting connection removal for this stage
+
+            // create the candidate configurations of this stage first so
+            // they can be evaluated as one batch
+            std::vector<RowID> confIds;
+            std::vector<DSDBManager::MachineConfiguration> confs;
             for (std::vector<const TTAMachine::Connection*>::iterator 
                      connI = connections.begin(); connI != connections.end();
                  ++connI) {
+                TTAMachine::Machine mach = *currentMachine;
+                removeConnection(mach, **connI);
+
+                DSDBManager::MachineConfiguration conf;
+                conf.architectureID = db().addArchitecture(mach);
+                confIds.push_back(db().addConfiguration(conf));
+                confs.push_back(db().configuration(confIds.back()));
+            }
+            std::vector<bool> evaluated;
+            evaluate(confs, evaluated);
+
+            // find the least affecting connection removal for this stage
+            std::size_t candidate = 0;
+            for (std::vector<const TTAMachine::Connection*>::iterator 
+                     connI = connections.begin(); connI != connections.end();
+                 ++connI, ++candidate) {
                 const TTAMachine::Connection* conn = *connI;
 
                 // compute the avgccWorsening
                 // check if it's the best found and if it's above the
                 // threshold               
-                TTAMachine::Machine mach = *currentMachine;
-                removeConnection(mach, *conn);
-
-                DSDBManager::MachineConfiguration conf;
-                conf.architectureID = db().addArchitecture(mach);
-                RowID confId = db().addConfiguration(conf);
-                bool success = evaluate(db().configuration(confId));
+                RowID confId = confIds.at(candidate);
+                bool success = evaluated.at(candidate);
 
                 if (success) {
                     unsigned int avgWorsening = 
@@ -32,6 +32,7 @@
  */
 
 #include <algorithm>
+#include <sstream>
 #include "boost/format.hpp"
 
 #include "Estimator.hh"
@@ -53,6 +54,8 @@
 #include "ControlUnit.hh"
 #include "FullyConnectedCheck.hh"
 #include "MachineCheckResults.hh"
+#include "ObjectState.hh"
+#include "ExecutionTrace.hh"
 
 using namespace HDB;
 
@@ -248,6 +251,165 @@ Estimator::icArea(
     return area;
 }
 
+/**
+ * Returns the key that identifies the given unit implementation.
+ *
+ * @param implementation The implementation location in the IDF.
+ * @return The HDB file and entry ID of the implementation.
+ */
+Estimator::ImplementationKey
+Estimator::implementationKey(
+    const IDF::UnitImplementationLocation& implementation) {
+    return ImplementationKey(implementation.hdbFile(), implementation.id());
+}
+
+/**
+ * Returns the key under which the estimates of a unit are memoized.
+ *
+ * The plugins get the unit architecture and its implementation, so the
+ * key consists of the implementation and the object state of the unit.
+ * The cache is ordered by the hash of the state, the state itself is
+ * compared on a hit. Equal units in different machines share the key.
+ *
+ * @param architecture The unit architecture.
+ * @param implementation The implementation of the unit.
+ * @param usage The usage of the unit the estimate depends on, empty for
+ *              the estimates that do not depend on the execution trace.
+ * @return The key.
+ */
+Estimator::ComponentKey
+Estimator::componentKey(
+    const TTAMachine::Unit& architecture,
+    const IDF::UnitImplementationLocation& implementation,
+    const std::string& usage) {
+    ComponentKey key;
+    key.state.reset(architecture.saveState());
+    key.index = ComponentIndex(
+        implementationKey(implementation), key.state->hash(), usage);
+    return key;
+}
+
+/**
+ * Looks up a memoized estimate.
+ *
+ * @param cache The memoized estimates.
+ * @param key The key of the unit.
+ * @param estimate Set to the memoized estimate, if found.
+ * @return True if the estimate was found.
+ */
+bool
+Estimator::findEstimate(
+    const ComponentEstimateCache& cache, const ComponentKey& key,
+    double& estimate) {
+    std::pair<ComponentEstimateCache::const_iterator,
+              ComponentEstimateCache::const_iterator> range =
+        cache.equal_range(key.index);
+    for (ComponentEstimateCache::const_iterator i = range.first;
+         i != range.second; ++i) {
+        if (!(*i->second.first != *key.state)) {
+            estimate = i->second.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Memoizes an estimate.
+ *
+ * @param cache The memoized estimates.
+ * @param key The key of the unit.
+ * @param estimate The estimate.
+ */
+void
+Estimator::addEstimate(
+    ComponentEstimateCache& cache, const ComponentKey& key,
+    double estimate) {
+    cache.insert(
+        std::make_pair(key.index, std::make_pair(key.state, estimate)));
+}
+
+/**
+ * Describes the usage of a function unit in the execution trace.
+ *
+ * The description consists of the data the FU energy plugins read from
+ * the trace: the simulated cycle count and the trigger counts of the
+ * operations of the unit.
+ *
+ * @param architecture The FU architecture.
+ * @param traceDB The execution trace.
+ * @param usage Set to the description.
+ * @return False if the usage could not be read from the trace.
+ */
+bool
+Estimator::functionUnitUsage(
+    const TTAMachine::FunctionUnit& architecture,
+    const ExecutionTrace& traceDB, std::string& usage) {
+    try {
+        std::unique_ptr<ExecutionTrace::FUOperationTriggerCountList>
+            triggers(traceDB.functionUnitOperationTriggerCounts(
+                         architecture.name()));
+        std::vector<std::string> counts;
+        for (ExecutionTrace::FUOperationTriggerCountList::const_iterator i =
+                 triggers->begin(); i != triggers->end(); ++i) {
+            std::ostringstream count;
+            count << i->get<0>() << "=" << i->get<1>();
+            counts.push_back(count.str());
+        }
+        std::sort(counts.begin(), counts.end());
+
+        std::ostringstream description;
+        description << traceDB.simulatedCycleCount();
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            description << " " << counts[i];
+        }
+        usage = description.str();
+        return true;
+    } catch (const Exception&) {
+        return false;
+    }
+}
+
+/**
+ * Describes the usage of a register file in the execution trace.
+ *
+ * The description consists of the data the RF energy plugins read from
+ * the trace: the simulated cycle count and the counts of the concurrent
+ * accesses of the register file.
+ *
+ * @param architecture The RF architecture.
+ * @param traceDB The execution trace.
+ * @param usage Set to the description.
+ * @return False if the usage could not be read from the trace.
+ */
+bool
+Estimator::registerFileUsage(
+    const TTAMachine::BaseRegisterFile& architecture,
+    const ExecutionTrace& traceDB, std::string& usage) {
+    try {
+        std::unique_ptr<ExecutionTrace::ConcurrentRFAccessCountList>
+            accesses(traceDB.registerFileAccessCounts(architecture.name()));
+        std::vector<std::string> counts;
+        for (ExecutionTrace::ConcurrentRFAccessCountList::const_iterator i =
+                 accesses->begin(); i != accesses->end(); ++i) {
+            std::ostringstream count;
+            count << i->get<0>() << "/" << i->get<1>() << "=" << i->get<2>();
+            counts.push_back(count.str());
+        }
+        std::sort(counts.begin(), counts.end());
+
+        std::ostringstream description;
+        description << traceDB.simulatedCycleCount();
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            description << " " << counts[i];
+        }
+        usage = description.str();
+        return true;
+    } catch (const Exception&) {
+        return false;
+    }
+}
+
 /**
  * Loads an FU cost estimation plugin for the given FU implementation.
  *
@@ -263,6 +425,13 @@ Estimator::fuCostFunctionPluginOfImplementation(
     std::string pluginName = "";
     HDB::HDBManager* theHDB = NULL;
     try {
+        ImplementationKey key = implementationKey(implementationEntry);
+        std::map<ImplementationKey, FUCostEstimationPlugin*>::const_iterator
+            cached = fuPlugins_.find(key);
+        if (cached != fuPlugins_.end()) {
+            return *cached->second;
+        }
+
         // use the HDB to find the estimation plugin from the plugin
         // registry
         theHDB = &HDBRegistry::instance().hdb(implementationEntry.hdbFile());
@@ -282,10 +451,15 @@ Estimator::fuCostFunctionPluginOfImplementation(
         HDB::CostFunctionPlugin& pluginData = fuEntry->costFunction();
         pluginFileName = pluginData.pluginFilePath();
         pluginName = pluginData.name();
+        delete fuEntry;
+        fuEntry = NULL;
 
         try {
-            return fuEstimatorPluginRegistry_.plugin(
-                pluginFileName, pluginName);
+            FUCostEstimationPlugin& plugin =
+                fuEstimatorPluginRegistry_.plugin(
+                    pluginFileName, pluginName);
+            fuPlugins_[key] = &plugin;
+            return plugin;
         } catch (const Exception& e) {
             throw CannotEstimateCost(
                 __FILE__, __LINE__, __func__, 
@@ -315,6 +489,13 @@ Estimator::rfCostFunctionPluginOfImplementation(
     std::string pluginName = "";
     HDB::HDBManager* theHDB = NULL;
     try {
+        ImplementationKey key = implementationKey(implementationEntry);
+        std::map<ImplementationKey, RFCostEstimationPlugin*>::const_iterator
+            cached = rfPlugins_.find(key);
+        if (cached != rfPlugins_.end()) {
+            return *cached->second;
+        }
+
         // use the HDB to find the estimation plugin from the plugin
         // registry
         theHDB = &HDBRegistry::instance().hdb(implementationEntry.hdbFile());
@@ -333,10 +514,15 @@ Estimator::rfCostFunctionPluginOfImplementation(
         HDB::CostFunctionPlugin& pluginData = rfEntry->costFunction();
         pluginFileName = pluginData.pluginFilePath();
         pluginName = pluginData.name();
+        delete rfEntry;
+        rfEntry = NULL;
 
         try {
-            return rfEstimatorPluginRegistry_.plugin(
-                pluginFileName, pluginName);
+            RFCostEstimationPlugin& plugin =
+                rfEstimatorPluginRegistry_.plugin(
+                    pluginFileName, pluginName);
+            rfPlugins_[key] = &plugin;
+            return plugin;
         } catch (const Exception& e) {
             throw CannotEstimateCost(
                 __FILE__, __LINE__, __func__, 
@@ -365,6 +551,12 @@ Estimator::functionUnitArea(
     const TTAMachine::FunctionUnit& architecture,
     const IDF::FUImplementationLocation& implementationEntry) {
     try {
+        ComponentKey key = componentKey(architecture, implementationEntry);
+        double cached = 0.0;
+        if (findEstimate(fuAreas_, key, cached)) {
+            return cached;
+        }
+
         AreaInGates area = 0.0;
         HDB::HDBManager& hdb = HDBRegistry::instance().hdb(
             implementationEntry.hdbFile());
@@ -376,6 +568,7 @@ Estimator::functionUnitArea(
                     "Plugin was unable to estimate area of function unit '") +
                 architecture.name() + ".");
         }
+        addEstimate(fuAreas_, key, area);
         return area;
     } catch (const Exception& e) {
         throw CannotEstimateCost(
@@ -399,6 +592,12 @@ Estimator::registerFileArea(
     const TTAMachine::BaseRegisterFile& architecture,
     const IDF::RFImplementationLocation& implementationEntry) {
     try {
+        ComponentKey key = componentKey(architecture, implementationEntry);
+        double cached = 0.0;
+        if (findEstimate(rfAreas_, key, cached)) {
+            return cached;
+        }
+
         AreaInGates area = 0.0;
         HDB::HDBManager& hdb = HDBRegistry::instance().hdb(
             implementationEntry.hdbFile());
@@ -408,6 +607,7 @@ Estimator::registerFileArea(
                 __FILE__, __LINE__, __func__,
                 std::string("Plugin was unable to estimate area."));
         }
+        addEstimate(rfAreas_, key, area);
         return area;
     } catch (const Exception& e) {
         throw CannotEstimateCost(
@@ -512,6 +712,19 @@ Estimator::functionUnitEnergy(
     const IDF::FUImplementationLocation& implementationEntry,
     const TTAProgram::Program& program, const ExecutionTrace& traceDB) {
     try {
+        // the energy depends on the program only through the usage of the
+        // unit, which is equal for many of the explored machines
+        std::string usage;
+        const bool memoized = functionUnitUsage(architecture, traceDB, usage);
+        ComponentKey key;
+        if (memoized) {
+            key = componentKey(architecture, implementationEntry, usage);
+            double cached = 0.0;
+            if (findEstimate(fuEnergies_, key, cached)) {
+                return cached;
+            }
+        }
+
         AreaInGates area = 0.0;
         HDB::HDBManager& hdb = HDBRegistry::instance().hdb(
             implementationEntry.hdbFile());
@@ -523,6 +736,9 @@ Estimator::functionUnitEnergy(
                 __FILE__, __LINE__, __func__,
                 std::string("Plugin was unable to estimate energy."));
         }
+        if (memoized) {
+            addEstimate(fuEnergies_, key, area);
+        }
         return area;
     } catch (const Exception& e) {
         throw CannotEstimateCost(
@@ -553,6 +769,19 @@ Estimator::registerFileEnergy(
     const IDF::RFImplementationLocation& implementationEntry,
     const TTAProgram::Program& program, const ExecutionTrace& traceDB) {
     try {
+        // the energy depends on the program only through the usage of the
+        // unit, which is equal for many of the explored machines
+        std::string usage;
+        const bool memoized = registerFileUsage(architecture, traceDB, usage);
+        ComponentKey key;
+        if (memoized) {
+            key = componentKey(architecture, implementationEntry, usage);
+            double cached = 0.0;
+            if (findEstimate(rfEnergies_, key, cached)) {
+                return cached;
+            }
+        }
+
         AreaInGates area = 0.0;
         HDB::HDBManager& hdb = HDBRegistry::instance().hdb(
             implementationEntry.hdbFile());
@@ -564,6 +793,9 @@ Estimator::registerFileEnergy(
                 __FILE__, __LINE__, __func__,
                 std::string("Plugin was unable to estimate energy."));
         }
+        if (memoized) {
+            addEstimate(rfEnergies_, key, area);
+        }
         return area;
     } catch (const Exception& e) {
         throw CannotEstimateCost(
@@ -835,6 +1067,12 @@ Estimator::functionUnitMaximumComputationDelay(
     const TTAMachine::FunctionUnit& architecture,
     const IDF::FUImplementationLocation& implementationEntry) {
     try {
+        ComponentKey key = componentKey(architecture, implementationEntry);
+        double cached = 0.0;
+        if (findEstimate(fuComputationDelays_, key, cached)) {
+            return cached;
+        }
+
         DelayInNanoSeconds delay = 0.0;
         HDB::HDBManager& hdb = HDBRegistry::instance().hdb(
             implementationEntry.hdbFile());
@@ -847,6 +1085,7 @@ Estimator::functionUnitMaximumComputationDelay(
                     "Plugin was unable to estimate computation delay of FU ") +
                 architecture.name());
         }
+        addEstimate(fuComputationDelays_, key, delay);
         return delay;
     } catch (const Exception& e) {
         throw CannotEstimateCost(
@@ -877,6 +1116,12 @@ Estimator::registerFileMaximumComputationDelay(
     const TTAMachine::BaseRegisterFile& architecture,
     const IDF::RFImplementationLocation& implementationEntry) {
     try {
+        ComponentKey key = componentKey(architecture, implementationEntry);
+        double cached = 0.0;
+        if (findEstimate(rfComputationDelays_, key, cached)) {
+            return cached;
+        }
+
         DelayInNanoSeconds delay = 0.0;
         HDB::HDBManager& hdb = HDBRegistry::instance().hdb(
             implementationEntry.hdbFile());
@@ -889,6 +1134,7 @@ Estimator::registerFileMaximumComputationDelay(
                     "Plugin was unable to estimate computation delay of RF ") +
                 architecture.name());
         }
+        addEstimate(rfComputationDelays_, key, delay);
         return delay;
     } catch (const Exception& e) {
         throw CannotEstimateCost(
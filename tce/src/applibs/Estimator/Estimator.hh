@@ -34,6 +34,11 @@
 #define TTA_COST_ESTIMATOR_HH
 
 #include <set>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
 
 #include "Exception.hh"
 #include "CostEstimatorTypes.hh"
@@ -49,12 +54,14 @@
 #include "FUCostEstimationPlugin.hh"
 
 class ExecutionTrace;
+class ObjectState;
 class UtilizationStats;
 class FUCostEstimationPlugin;
 class RFCostEstimationPlugin;
 
 namespace TTAMachine {
     class Machine;
+    class Unit;
     class FunctionUnit;
     class BaseRegisterFile;
     class FUPort;
@@ -81,6 +88,11 @@ namespace CostEstimator {
  * of single plugins, the situation is not exceptional, but they provide
  * estimation as a "capability", thus they signal explicitly whether they
  * can estimate a cost or not by returning true or false, respectively.
+ *
+ * The plugin of each HDB entry and the area and computation delay
+ * estimates of each FU and RF are memoized in the estimator. Clients that
+ * estimate many similar machines, such as the explorer, should reuse one
+ * Estimator for all of them.
  */
 class Estimator {
 public:
@@ -180,6 +192,43 @@ public:
         const IDF::RFImplementationLocation& implementationEntry);
 
 private:
+    /// HDB file and entry ID of a unit implementation.
+    typedef std::pair<std::string, int> ImplementationKey;
+    /// Implementation, hash of the unit architecture state and the usage
+    /// of the unit in the execution trace.
+    typedef std::tuple<ImplementationKey, std::size_t, std::string>
+    ComponentIndex;
+    /// The key of a memoized unit estimate.
+    struct ComponentKey {
+        ComponentIndex index;
+        /// The architecture state, compared on a hit as the hash may
+        /// collide.
+        std::shared_ptr<ObjectState> state;
+    };
+    /// Architecture state and the estimate of the memoized units.
+    typedef std::multimap<
+        ComponentIndex, std::pair<std::shared_ptr<ObjectState>, double> >
+    ComponentEstimateCache;
+
+    static ImplementationKey implementationKey(
+        const IDF::UnitImplementationLocation& implementation);
+    static ComponentKey componentKey(
+        const TTAMachine::Unit& architecture,
+        const IDF::UnitImplementationLocation& implementation,
+        const std::string& usage = "");
+    static bool findEstimate(
+        const ComponentEstimateCache& cache, const ComponentKey& key,
+        double& estimate);
+    static void addEstimate(
+        ComponentEstimateCache& cache, const ComponentKey& key,
+        double estimate);
+    static bool functionUnitUsage(
+        const TTAMachine::FunctionUnit& architecture,
+        const ExecutionTrace& traceDB, std::string& usage);
+    static bool registerFileUsage(
+        const TTAMachine::BaseRegisterFile& architecture,
+        const ExecutionTrace& traceDB, std::string& usage);
+
     static TransportPathList* findAllICPaths(
         const TTAMachine::Machine& machine);
 
@@ -204,6 +253,18 @@ private:
     RFCostEstimationPluginRegistry rfEstimatorPluginRegistry_;
     /// all accessed IC&decoder plugins are stored in this registry
     ICDecoderCostEstimationPluginRegistry icDecoderEstimatorPluginRegistry_;
+
+    /// FU estimation plugins of the already looked up HDB entries
+    std::map<ImplementationKey, FUCostEstimationPlugin*> fuPlugins_;
+    /// RF estimation plugins of the already looked up HDB entries
+    std::map<ImplementationKey, RFCostEstimationPlugin*> rfPlugins_;
+    /// memoized estimates of the units
+    ComponentEstimateCache fuAreas_;
+    ComponentEstimateCache rfAreas_;
+    ComponentEstimateCache fuComputationDelays_;
+    ComponentEstimateCache rfComputationDelays_;
+    ComponentEstimateCache fuEnergies_;
+    ComponentEstimateCache rfEnergies_;
 };
 
 }
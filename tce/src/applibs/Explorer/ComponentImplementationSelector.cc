@@ -76,12 +76,17 @@ ComponentImplementationSelector::~ComponentImplementationSelector() {
 /**
  * Adds new HDB to look for components.
  *
+ * The entry queries of the HDB are answered from an in-memory snapshot
+ * from now on, because the selection queries the same HDBs for every unit
+ * of every machine.
+ *
  * @param hdb The HDB file name to be added.
  * @exception Exception in case there was a problem while opening the HDB.
  */
 void
 ComponentImplementationSelector::addHDB(const HDBManager& hdb) {
     usedHDBs_.insert(hdb.fileName());
+    HDBRegistry::instance().hdb(hdb.fileName()).setSnapshotEnabled(true);
 }
 
 /**
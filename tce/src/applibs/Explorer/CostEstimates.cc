@@ -74,7 +74,7 @@ CostEstimates::setLongestPathDelay(double delay) {
 /**
  * Sets new energy estimate for the given program.
  *
- * If there was an old energy value for the given key it is removed first.
+ * If there was an old energy value for the given key it is replaced.
  *
  * @param program Program that is used as a key.
  * @param energy Energy consumed while running the program (in milli joules).
@@ -83,13 +83,25 @@ void
 CostEstimates::setEnergy(
     const TTAProgram::Program& program, double energy) {
 
-    map<const TTAProgram::Program*, double>::iterator iter = 
+    map<const TTAProgram::Program*, int>::const_iterator iter = 
         energyMap_.find(&program);
     if (iter != energyMap_.end()) {
-        energyMap_.erase(iter);
+        energies_[iter->second] = energy;
+        return;
     }
-    energyMap_.insert(
-        std::pair<const TTAProgram::Program*, double>(&program, energy));
+    energyMap_[&program] = energies_.size();
+    energies_.push_back(energy);
+}
+
+/**
+ * Adds a new energy estimate that is not bound to a program.
+ *
+ * @param energy Energy consumed while running a program (in milli joules).
+ */
+void
+CostEstimates::addEnergy(double energy) {
+
+    energies_.push_back(energy);
 }
 
 /**
@@ -123,7 +135,7 @@ CostEstimates::longestPathDelay() const {
 int
 CostEstimates::energies() const {
 
-    return energyMap_.size();
+    return energies_.size();
 }
 
 /**
@@ -139,13 +151,7 @@ CostEstimates::energy(int index) const {
     if (index < 0 || index >= energies()) {
         throw OutOfRange(__FILE__, __LINE__, __func__);
     }
-    map<const TTAProgram::Program*, double>::const_iterator iter = 
-        energyMap_.begin();
-    while (index > 0) {
-        iter++;
-        index--;
-    }
-    return (*iter).second;
+    return energies_[index];
 }
 
 /**
@@ -157,10 +163,10 @@ CostEstimates::energy(int index) const {
  */
 double
 CostEstimates::energy(const TTAProgram::Program& program) const {
-    map<const TTAProgram::Program*, double>::const_iterator iter = 
+    map<const TTAProgram::Program*, int>::const_iterator iter = 
         energyMap_.find(&program);
     if (iter == energyMap_.end()) {
         throw KeyNotFound(__FILE__, __LINE__, __func__);
     }
-    return (*iter).second;
+    return energies_[iter->second];
 }
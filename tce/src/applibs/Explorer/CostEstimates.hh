@@ -35,6 +35,7 @@
 #define TTA_COST_ESTIMATES_HH
 
 #include <map>
+#include <vector>
 
 #include "Application.hh"
 #include "Exception.hh"
@@ -52,7 +53,9 @@ namespace TTAProgram {
  * when the configuration is used to run different programs. Area and longest
  * path delay are constants to one configuration while there can be multiple
  * programs executed so multiple energy consumption estimations and cycle
- * counts as well. Each energy consumption is bound to one program.
+ * counts as well. An energy consumption can be bound to a program, or just
+ * added in the order the programs were evaluated in, if the program is not
+ * available, e.g., when it was evaluated in another process.
  */
 class CostEstimates {
 public:
@@ -61,6 +64,7 @@ public:
     void setArea(double area);
     void setLongestPathDelay(double delay);
     void setEnergy(const TTAProgram::Program& program, double energy);
+    void addEnergy(double energy);
     void setCycleCount(
         const TTAProgram::Program& program, ClockCycleCount cycles);
     double area() const;
@@ -70,8 +74,11 @@ public:
     double energy(const TTAProgram::Program& program) const;
 
 private:
-    /// Map containing programs and energies consumed in running the programs.
-    std::map<const TTAProgram::Program*, double> energyMap_;
+    /// Energies consumed in running the programs, in the order they were
+    /// added.
+    std::vector<double> energies_;
+    /// Indices of the energies of the programs in energies_.
+    std::map<const TTAProgram::Program*, int> energyMap_;
     /// Area estimation value (in gates).
     double area_;
     /// Longest path delay estimation value (in nano seconds).
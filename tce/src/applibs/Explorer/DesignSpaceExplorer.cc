@@ -32,10 +32,19 @@
  * @note rating: red
  */
 
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
 #include <boost/timer.hpp>
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include <string>
@@ -62,6 +71,7 @@
 #include "Application.hh"
 #include "ComponentImplementationSelector.hh"
 #include "Exception.hh"
+#include "HDBRegistry.hh"
 
 using std::set;
 using std::vector;
@@ -74,11 +84,28 @@ DesignSpaceExplorer::pluginTool_;
 CostEstimates 
 DesignSpaceExplorer::dummyEstimate_;
 
+/**
+ * The compiler backend plugin cache directory shared by the evaluations of
+ * the explorer process. Removed when the process exits.
+ */
+class ExplorerPluginCacheDirectory {
+public:
+    ~ExplorerPluginCacheDirectory() {
+        if (!path.empty()) {
+            FileSystem::removeFileOrDirectory(path);
+        }
+    }
+    /// Path to the directory, empty if not created yet.
+    std::string path;
+};
+
+static ExplorerPluginCacheDirectory pluginCacheDirectory;
+
 
 /**
  * The constructor.
  */
-DesignSpaceExplorer::DesignSpaceExplorer() {
+DesignSpaceExplorer::DesignSpaceExplorer() : jobs_(0) {
     
     //schedulingPlan_ = 
     //    SchedulingPlan::loadFromFile(Environment::oldGccSchedulerConf());
@@ -119,6 +146,14 @@ DesignSpaceExplorer::setDSDB(DSDBManager& dsdb) {
  * include area, energy and longest path delay estimations. Estimation is not
  * included either if the estimate flag is set to false.
  *
+ * In case more than one evaluation job is allowed (see evaluationJobs()),
+ * the applications are compiled and simulated concurrently in worker
+ * processes. The results are then stored to the DSDB by this process in
+ * the order of the application IDs, thus the DSDB contents are the same
+ * as with sequential evaluation. The energies of the programs are not
+ * added to the CostEstimates object in that case as the programs exist only
+ * in the workers, they can be queried from the DSDB instead.
+ *
  * @param configuration Machine configuration (architecture, implementation).
  * @param result CostEstimates object where the configuration cost
  * estimates are stored if the evaluation succeeds. 
@@ -133,162 +168,508 @@ DesignSpaceExplorer::evaluate(
     const DSDBManager::MachineConfiguration& configuration,
     CostEstimates& result, bool estimate) {
 
-    TTAMachine::Machine* adf = NULL;
-    IDF::MachineImplementation* idf = NULL;
-    if (configuration.hasImplementation) {
-        adf = dsdb_->architecture(configuration.architectureID);
-        idf = dsdb_->implementation(configuration.implementationID);
-    } else {
-        adf = dsdb_->architecture(configuration.architectureID);
-    }
-
-    try {
-        // program independent estimations
-        if (configuration.hasImplementation && estimate) {
+    std::vector<DSDBManager::MachineConfiguration> configurations;
+    configurations.push_back(configuration);
+    std::vector<bool> results;
+    evaluateConfigurations(configurations, results, estimate, &result);
+    return results.at(0);
+}
 
-            // estimate total area and longest path delay
-            CostEstimator::AreaInGates totalArea = 0;
-            CostEstimator::DelayInNanoSeconds longestPathDelay = 0;
-            createEstimateData(*adf, *idf, totalArea, longestPathDelay);
+/**
+ * Evaluates a set of processor configurations.
+ *
+ * Equals to calling evaluate() for each of the configurations in order,
+ * but in case more than one evaluation job is allowed, the compilation
+ * and simulation of all the (configuration, application) pairs are
+ * distributed to the same pool of worker processes. Thus, explorer plugins
+ * that generate many candidate configurations at once can use this to
+ * keep all the workers busy.
+ *
+ * @param configurations The configurations to evaluate.
+ * @param results Set to true for the configurations that were evaluated
+ *                successfully, false for the others.
+ * @param estimate Flag indicating that the configurations with an
+ *                 implementation are also estimated.
+ */
+void
+DesignSpaceExplorer::evaluate(
+    const std::vector<DSDBManager::MachineConfiguration>& configurations,
+    std::vector<bool>& results, bool estimate) {
 
-            dsdb_->setAreaEstimate(configuration.implementationID, totalArea);
-            result.setArea(totalArea);
+    evaluateConfigurations(configurations, results, estimate, NULL);
+}
 
-            dsdb_->setLongestPathDelayEstimate(
-                configuration.implementationID, longestPathDelay);
-            result.setLongestPathDelay(longestPathDelay);
-        }
-       
-        // get all programs from the dsdb
-        set<RowID> applicationIDs = dsdb_->applicationIDs();
-        for (set<RowID>::const_iterator i = applicationIDs.begin();
-             i != applicationIDs.end(); i++) {
-
-            if (dsdb_->isUnschedulable((*i), configuration.architectureID)) {
-                return false;
+/**
+ * Implementation of the evaluate() methods.
+ *
+ * @param configurations The configurations to evaluate.
+ * @param results The evaluation results of the configurations.
+ * @param estimate Flag indicating that the configurations with an
+ *                 implementation are also estimated.
+ * @param estimates CostEstimates object for a single configuration
+ *                  evaluation, NULL if the estimates are only stored to
+ *                  the DSDB.
+ */
+void
+DesignSpaceExplorer::evaluateConfigurations(
+    const std::vector<DSDBManager::MachineConfiguration>& configurations,
+    std::vector<bool>& results, bool estimate, CostEstimates* estimates) {
+
+    const int jobs = evaluationJobs();
+    results.assign(configurations.size(), true);
+
+    std::vector<TTAMachine::Machine*> adfs(configurations.size(), NULL);
+    std::vector<IDF::MachineImplementation*> idfs(
+        configurations.size(), NULL);
+    std::vector<EvaluationTask> tasks;
+
+    for (std::size_t c = 0; c < configurations.size(); ++c) {
+        const DSDBManager::MachineConfiguration& configuration =
+            configurations[c];
+        try {
+            adfs[c] = dsdb_->architecture(configuration.architectureID);
+            if (configuration.hasImplementation) {
+                idfs[c] = dsdb_->implementation(
+                    configuration.implementationID);
             }
 
-            if (!estimate && 
-                dsdb_->hasCycleCount(*i, configuration.architectureID)) {
-                // this configuration has been compiled+simulated previously,
-                // the old cycle count can be reused for this app
-                continue; 
-            }
+            // program independent estimations
+            if (configuration.hasImplementation && estimate) {
 
-            string applicationPath = dsdb_->applicationPath(*i);
-            TestApplication testApplication(applicationPath);
-            
-            std::string applicationFile = testApplication.applicationPath();
-
-            // test that program is found
-            if (applicationFile.length() < 1) {
-                delete adf;
-                adf = NULL;
-                delete idf;
-                idf = NULL;
-                throw InvalidData(
-                    __FILE__, __LINE__, __func__,
-                    (boost::format(
-                        "No program found from application dir '%s'") 
-                     % applicationPath).str());
-                return false;
-            }
-            
-#if (!defined(HAVE_CXX11) && !defined(HAVE_CXX0X))
-            std::auto_ptr<TTAProgram::Program> scheduledProgram(
-                schedule(applicationFile, *adf));
-#else
-            std::unique_ptr<TTAProgram::Program> scheduledProgram(
-                schedule(applicationFile, *adf));
-#endif
-
-            if (scheduledProgram.get() == NULL) {
-                dsdb_->setUnschedulable((*i), configuration.architectureID);
-                delete adf;
-                adf = NULL;
-                delete idf;
-                idf = NULL;
-                return false;
+                // estimate total area and longest path delay
+                CostEstimator::AreaInGates totalArea = 0;
+                CostEstimator::DelayInNanoSeconds longestPathDelay = 0;
+                createEstimateData(
+                    *adfs[c], *idfs[c], totalArea, longestPathDelay);
+
+                dsdb_->setAreaEstimate(
+                    configuration.implementationID, totalArea);
+                dsdb_->setLongestPathDelayEstimate(
+                    configuration.implementationID, longestPathDelay);
+                if (estimates != NULL) {
+                    estimates->setArea(totalArea);
+                    estimates->setLongestPathDelay(longestPathDelay);
+                }
             }
 
-            // simulate the scheduled program
-            ClockCycleCount runnedCycles;
-            const ExecutionTrace* traceDB = NULL;
-            if (configuration.hasImplementation && estimate) {
-                traceDB = simulate(
-                    *scheduledProgram, *adf, testApplication, 0, runnedCycles,
-                    true);
-            } else {
-                simulate(
-                    *scheduledProgram, *adf, testApplication, 0, runnedCycles,
-                    false);
-            }
+            // collect the applications that are not yet compiled and
+            // simulated on this architecture
+            std::vector<EvaluationTask> configurationTasks;
+            set<RowID> applicationIDs = dsdb_->applicationIDs();
+            for (set<RowID>::const_iterator i = applicationIDs.begin();
+                 i != applicationIDs.end(); i++) {
+
+                if (dsdb_->isUnschedulable(
+                        (*i), configuration.architectureID)) {
+                    results[c] = false;
+                    break;
+                }
 
-            //std::cerr << "DEBUG: simulated" << std::endl;
-            // verify the simulation
-            if (testApplication.hasCorrectOutput()) {
-                string correctResult = testApplication.correctOutput();
-                string resultString = oStream_->str();
-                if (resultString != correctResult) {
-                    std::cerr << "Simulation FAILED, possible bug in scheduler!"
-                              << std::endl;
-                    std::cerr << "Architecture id in DSDB:" << std::endl;
-                    std::cerr << configuration.architectureID << std::endl;
-                    std::cerr << "use sqlite3 to find out which configuration "
-                              << "has that id to get the machine written to "
-                              << "ADF." << std::endl;
-                    // @todo Do a method into DSDBManager to find out the
-                    //       configuration ID.
-                    std::cerr << "********** result found:" << std::endl;
-                    std::cerr << resultString << std::endl;
-                    std::cerr << "********** expected result:" << std::endl;
-                    std::cerr << correctResult << std::endl;
-                    std::cerr << "**********" << std::endl;
-                    delete idf;
-                    idf = NULL;
-                    delete adf;
-                    adf = NULL;
-                    return false;
+                if (!estimate && 
+                    dsdb_->hasCycleCount(*i, configuration.architectureID)) {
+                    // this configuration has been compiled+simulated
+                    // previously, the old cycle count can be reused for
+                    // this app
+                    continue; 
                 }
-                //std::cerr << "DEBUG: simulation OK" << std::endl;
-                // reset the stream pointer in to the beginning and empty the
-                // stream
-                oStream_->str("");
-                oStream_->seekp(0);
+
+                EvaluationTask task;
+                task.configuration = c;
+                task.applicationID = *i;
+                task.applicationPath = dsdb_->applicationPath(*i);
+                configurationTasks.push_back(task);
+            }
+            if (results[c]) {
+                tasks.insert(
+                    tasks.end(), configurationTasks.begin(),
+                    configurationTasks.end());
             }
+        } catch (const Exception& e) {
+            debugLog(e.errorMessageStack());
+            results[c] = false;
+        }
+    }
 
-            // add simulated cycle count to dsdb
-            dsdb_->addCycleCount(
-                    (*i), configuration.architectureID,
-                    runnedCycles);
+    // compile and simulate the applications
+    std::vector<ApplicationEvaluation> evaluations(tasks.size());
+    if (jobs > 1 && tasks.size() > 1) {
+        evaluateInWorkers(
+            tasks, configurations, adfs, idfs, estimate, jobs, evaluations);
+    }
 
-            if (configuration.hasImplementation && estimate) {
-                // energy estimate the simulated program
-                EnergyInMilliJoules programEnergy =
-                    estimator_.totalEnergy(
-                        *adf, *idf, *scheduledProgram, *traceDB);
-                dsdb_->addEnergyEstimate(
-                    (*i), configuration.implementationID, programEnergy);
-                result.setEnergy(*scheduledProgram, programEnergy);
+    // store the results to the DSDB in the sequential evaluation order
+    for (std::size_t t = 0; t < tasks.size(); ++t) {
+        const EvaluationTask& task = tasks[t];
+        const std::size_t c = task.configuration;
+        if (!results[c]) {
+            continue;
+        }
+        const DSDBManager::MachineConfiguration& configuration =
+            configurations[c];
+        if (dsdb_->isUnschedulable(
+                task.applicationID, configuration.architectureID)) {
+            // marked by an earlier configuration of the batch
+            results[c] = false;
+            continue;
+        }
+        if (!estimate &&
+            dsdb_->hasCycleCount(
+                task.applicationID, configuration.architectureID)) {
+            // stored by an earlier configuration of the batch
+            continue;
+        }
+        if (jobs <= 1 || tasks.size() <= 1) {
+            evaluations[t] = evaluateApplication(
+                task.applicationPath, *adfs[c], idfs[c],
+                configuration.hasImplementation && estimate,
+                configuration.architectureID);
+        }
+        results[c] = storeEvaluation(
+            task, configuration, evaluations[t], estimate);
+        if (results[c] && estimates != NULL &&
+            configuration.hasImplementation && estimate) {
+            estimates->addEnergy(evaluations[t].energy);
+        }
+    }
+
+    for (std::size_t c = 0; c < configurations.size(); ++c) {
+        delete adfs[c];
+        adfs[c] = NULL;
+        delete idfs[c];
+        idfs[c] = NULL;
+    }
+}
+
+/**
+ * Compiles and simulates one application on a machine.
+ *
+ * Does not access the DSDB, the results are returned to the caller
+ * for storing them. 
+ *
+ * @param applicationPath The directory of the test application.
+ * @param adf The machine to evaluate.
+ * @param idf The implementation of the machine, can be NULL if estimate
+ *            is false.
+ * @param estimate True if the energy consumption is to be estimated.
+ * @param architectureID The DSDB ID of the machine, for error reporting.
+ * @return The outcome of the evaluation.
+ */
+DesignSpaceExplorer::ApplicationEvaluation
+DesignSpaceExplorer::evaluateApplication(
+    const std::string& applicationPath, TTAMachine::Machine& adf,
+    const IDF::MachineImplementation* idf, bool estimate,
+    RowID architectureID) {
+
+    ApplicationEvaluation evaluation;
+    evaluation.status = ApplicationEvaluation::EVAL_FAILED;
+    evaluation.cycles = 0;
+    evaluation.energy = 0.0;
+
+    try {
+        TestApplication testApplication(applicationPath);
+        
+        std::string applicationFile = testApplication.applicationPath();
+
+        // test that program is found
+        if (applicationFile.length() < 1) {
+            throw InvalidData(
+                __FILE__, __LINE__, __func__,
+                (boost::format(
+                    "No program found from application dir '%s'") 
+                 % applicationPath).str());
+        }
+            
+        std::unique_ptr<TTAProgram::Program> scheduledProgram(
+            schedule(applicationFile, adf));
+
+        if (scheduledProgram.get() == NULL) {
+            evaluation.status = ApplicationEvaluation::EVAL_UNSCHEDULABLE;
+            return evaluation;
+        }
+
+        // simulate the scheduled program
+        ClockCycleCount runnedCycles;
+        std::unique_ptr<const ExecutionTrace> traceDB(
+            simulate(
+                *scheduledProgram, adf, testApplication, 0, runnedCycles,
+                estimate));
+
+        // verify the simulation
+        if (testApplication.hasCorrectOutput()) {
+            string correctResult = testApplication.correctOutput();
+            string resultString = oStream_->str();
+            // reset the stream pointer in to the beginning and empty the
+            // stream
+            oStream_->str("");
+            oStream_->seekp(0);
+            if (resultString != correctResult) {
+                std::cerr << "Simulation FAILED, possible bug in scheduler!"
+                          << std::endl;
+                std::cerr << "Architecture id in DSDB:" << std::endl;
+                std::cerr << architectureID << std::endl;
+                std::cerr << "use sqlite3 to find out which configuration "
+                          << "has that id to get the machine written to "
+                          << "ADF." << std::endl;
+                // @todo Do a method into DSDBManager to find out the
+                //       configuration ID.
+                std::cerr << "********** result found:" << std::endl;
+                std::cerr << resultString << std::endl;
+                std::cerr << "********** expected result:" << std::endl;
+                std::cerr << correctResult << std::endl;
+                std::cerr << "**********" << std::endl;
+                return evaluation;
             }
-            delete traceDB;
-            traceDB = NULL;
+        }
+        evaluation.cycles = runnedCycles;
+
+        if (estimate) {
+            // energy estimate the simulated program
+            EnergyInMilliJoules programEnergy =
+                estimator_.totalEnergy(
+                    adf, *idf, *scheduledProgram, *traceDB);
+            evaluation.energy = programEnergy;
+        }
+        evaluation.status = ApplicationEvaluation::EVAL_OK;
+    } catch (const Exception& e) {
+        debugLog(e.errorMessageStack());
+    }
+    return evaluation;
+}
+
+/**
+ * Stores the outcome of an application evaluation to the DSDB.
+ *
+ * @param task The evaluated (configuration, application) pair.
+ * @param configuration The evaluated configuration.
+ * @param evaluation The outcome of the evaluation.
+ * @param estimate True if the configuration was estimated.
+ * @return True if the evaluation succeeded.
+ */
+bool
+DesignSpaceExplorer::storeEvaluation(
+    const EvaluationTask& task,
+    const DSDBManager::MachineConfiguration& configuration,
+    const ApplicationEvaluation& evaluation, bool estimate) {
+
+    try {
+        switch (evaluation.status) {
+        case ApplicationEvaluation::EVAL_UNSCHEDULABLE:
+            dsdb_->setUnschedulable(
+                task.applicationID, configuration.architectureID);
+            return false;
+        case ApplicationEvaluation::EVAL_FAILED:
+            return false;
+        case ApplicationEvaluation::EVAL_OK:
+            break;
+        }
+
+        // add simulated cycle count to dsdb
+        dsdb_->addCycleCount(
+            task.applicationID, configuration.architectureID,
+            evaluation.cycles);
+
+        if (configuration.hasImplementation && estimate) {
+            dsdb_->addEnergyEstimate(
+                task.applicationID, configuration.implementationID,
+                evaluation.energy);
         }
     } catch (const Exception& e) {
-        delete adf;
-        adf = NULL;
-        delete idf;
-        idf = NULL;
         debugLog(e.errorMessageStack());
         return false;
     }
-    delete idf;
-    idf = NULL;
-    delete adf;
-    adf = NULL;
     return true;
 }
 
+/**
+ * Evaluates the given tasks concurrently in forked worker processes.
+ *
+ * Each (configuration, application) pair is compiled and simulated in its
+ * own child process so the workers do not share any simulator or compiler
+ * state. At most the given number of workers run at a time. A worker sends
+ * its ApplicationEvaluation back through a pipe and does not write to the
+ * DSDB. A worker that dies without reporting is counted as a failed
+ * evaluation.
+ *
+ * The SQLite connections inherited from the parent are not used by the
+ * workers: each worker reopens the DSDB and the HDBs. The random number
+ * generator is reseeded in each worker so the temporary files the workers
+ * create do not get the same names.
+ *
+ * @param tasks The pairs to evaluate.
+ * @param configurations The configurations the tasks refer to.
+ * @param adfs The machines of the configurations.
+ * @param idfs The implementations of the configurations.
+ * @param estimate True if the configurations with an implementation are to
+ *                 be estimated.
+ * @param jobs Maximum number of concurrent workers.
+ * @param evaluations The outcomes, in the order of the tasks.
+ */
+void
+DesignSpaceExplorer::evaluateInWorkers(
+    const std::vector<EvaluationTask>& tasks,
+    const std::vector<DSDBManager::MachineConfiguration>& configurations,
+    const std::vector<TTAMachine::Machine*>& adfs,
+    const std::vector<IDF::MachineImplementation*>& idfs,
+    bool estimate, int jobs,
+    std::vector<ApplicationEvaluation>& evaluations) {
+
+    /// The running workers: process id -> (task index, read end of pipe).
+    std::map<pid_t, std::pair<std::size_t, int> > workers;
+
+    // make sure the buffered output is not duplicated by the workers
+    std::cout.flush();
+    std::cerr.flush();
+
+    // create the plugin cache before forking so the workers share it
+    backendPluginCache();
+
+    std::size_t nextTask = 0;
+    while (nextTask < tasks.size() || !workers.empty()) {
+
+        while (nextTask < tasks.size() &&
+               static_cast<int>(workers.size()) < jobs) {
+            const EvaluationTask& task = tasks[nextTask];
+            const std::size_t c = task.configuration;
+            ApplicationEvaluation& evaluation = evaluations[nextTask];
+            evaluation.status = ApplicationEvaluation::EVAL_FAILED;
+            evaluation.cycles = 0;
+            evaluation.energy = 0.0;
+
+            int fds[2];
+            if (pipe(fds) != 0) {
+                throw IOException(
+                    __FILE__, __LINE__, __func__,
+                    "Could not create a pipe for an evaluation worker.");
+            }
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(fds[0]);
+                close(fds[1]);
+                throw IOException(
+                    __FILE__, __LINE__, __func__,
+                    "Could not fork an evaluation worker.");
+            } else if (pid == 0) {
+                // the worker, which must never unwind back to the caller
+                // nor run the static destructors shared with the parent,
+                // e.g., the one removing the plugin cache directory
+                int exitStatus = 1;
+                try {
+                    close(fds[0]);
+                    srand(getpid());
+                    ApplicationEvaluation result;
+                    result.status = ApplicationEvaluation::EVAL_FAILED;
+                    result.cycles = 0;
+                    result.energy = 0.0;
+                    try {
+                        // the parent's DSDBManager is left untouched, it is
+                        // not destroyed as the worker exits with _exit()
+                        dsdb_ = new DSDBManager(dsdb_->dsdbFile());
+                        HDB::HDBRegistry::instance().reopenAfterFork();
+                        result = evaluateApplication(
+                            task.applicationPath, *adfs[c], idfs[c],
+                            configurations[c].hasImplementation && estimate,
+                            configurations[c].architectureID);
+                    } catch (const Exception& e) {
+                        debugLog(e.errorMessageStack());
+                    }
+                    if (write(fds[1], &result, sizeof(result)) ==
+                        sizeof(result)) {
+                        exitStatus = 0;
+                    }
+                    close(fds[1]);
+                } catch (...) {
+                    // the parent sees the closed pipe as a failed
+                    // evaluation
+                }
+                // skip the destructors and atexit handlers of the parent's
+                // objects, e.g., the DSDB connection
+                _exit(exitStatus);
+            }
+            close(fds[1]);
+            workers[pid] = std::make_pair(nextTask, fds[0]);
+            ++nextTask;
+        }
+
+        // wait only for the own workers, the other child processes of
+        // the explorer (e.g., the ones run by the plugins) are not ours to
+        // reap
+        std::vector<pollfd> polled;
+        std::vector<pid_t> pids;
+        for (std::map<pid_t, std::pair<std::size_t, int> >::const_iterator
+                 i = workers.begin(); i != workers.end(); ++i) {
+            pollfd pfd;
+            pfd.fd = i->second.second;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            polled.push_back(pfd);
+            pids.push_back(i->first);
+        }
+        if (polled.empty()) {
+            continue;
+        }
+        if (poll(&polled[0], polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // cannot wait for the results, stop all the workers
+            for (std::size_t i = 0; i < pids.size(); ++i) {
+                kill(pids[i], SIGKILL);
+                close(polled[i].fd);
+                waitpid(pids[i], NULL, 0);
+            }
+            workers.clear();
+            break;
+        }
+        for (std::size_t i = 0; i < polled.size(); ++i) {
+            if (polled[i].revents == 0) {
+                continue;
+            }
+            // the result is written at once, EOF without it means the
+            // worker died
+            ApplicationEvaluation result;
+            const int fd = polled[i].fd;
+            if (read(fd, &result, sizeof(result)) == sizeof(result)) {
+                evaluations[workers[pids[i]].first] = result;
+            }
+            close(fd);
+            while (waitpid(pids[i], NULL, 0) < 0 && errno == EINTR) {
+            }
+            workers.erase(pids[i]);
+        }
+    }
+}
+
+/**
+ * Sets the maximum number of concurrent evaluation workers.
+ *
+ * @param jobs Number of workers, 0 to use the value of the --jobs command
+ *             line option.
+ */
+void
+DesignSpaceExplorer::setEvaluationJobs(int jobs) {
+    jobs_ = jobs;
+}
+
+/**
+ * Returns the maximum number of concurrent evaluation workers.
+ *
+ * @return The number of workers set with setEvaluationJobs(), or if not
+ *         set, the one given with the --jobs command line option, 1 by
+ *         default.
+ */
+int
+DesignSpaceExplorer::evaluationJobs() const {
+    if (jobs_ > 0) {
+        return jobs_;
+    }
+    ExplorerCmdLineOptions* options = 
+        dynamic_cast<ExplorerCmdLineOptions*>(Application::cmdLineOptions());
+    if (options != NULL) {
+        return options->jobs();
+    }
+    return 1;
+}
+
 
 /**
  * Returns the DSDBManager of the current exploration process.
@@ -347,9 +728,13 @@ DesignSpaceExplorer::schedule(
     // call tcecc to compile, link and schedule the program
     std::vector<std::string> tceccOutputLines;
     std::string tceccPath = Environment::tceCompiler();
+    const std::string pluginCache = backendPluginCache();
     std::string tceccCommand = tceccPath + " "  
         + compilerOptions + " --no-link -a " + adf + " -o " 
-        + tpef + " " + bytecodeFile + " --no-plugin-cache 2>&1";
+        + tpef + " " + bytecodeFile 
+        + (pluginCache.empty() ? 
+           " --no-plugin-cache" : " --plugin-cache-dir=" + pluginCache)
+        + " 2>&1";
 
     const bool debug = Application::verboseLevel() > 0;
 
@@ -386,6 +771,25 @@ DesignSpaceExplorer::schedule(
     return prog;        
 }
 
+/**
+ * Returns the compiler backend plugin cache directory of the explorer.
+ *
+ * The backend plugin of a machine is generated and compiled once and then
+ * reused by all the compilations for the same machine, e.g., for the other
+ * test applications. The directory is private to the explorer process so
+ * the plugins of the explored machines do not fill the user's plugin cache.
+ *
+ * @return Path to the plugin cache directory, empty if it could not be
+ *         created.
+ */
+std::string
+DesignSpaceExplorer::backendPluginCache() {
+    if (pluginCacheDirectory.path.empty()) {
+        pluginCacheDirectory.path = FileSystem::createTempDirectory();
+    }
+    return pluginCacheDirectory.path;
+}
+
 /**
  * Simulates the parallel program.
  *
@@ -77,6 +77,12 @@ public:
     virtual bool evaluate(
         const DSDBManager::MachineConfiguration& configuration,
         CostEstimates& results=dummyEstimate_, bool estimate=false);
+    virtual void evaluate(
+        const std::vector<DSDBManager::MachineConfiguration>& configurations,
+        std::vector<bool>& results, bool estimate=false);
+
+    void setEvaluationJobs(int jobs);
+    int evaluationJobs() const;
 
     virtual DSDBManager& db();
     static DesignSpaceExplorerPlugin* loadExplorerPlugin(
@@ -125,6 +131,52 @@ protected:
         const bool tracing, const bool useCompiledSimulation = false);
 
 private:
+    /// A test application to compile and simulate on a configuration.
+    struct EvaluationTask {
+        /// Index of the configuration in the evaluated batch.
+        std::size_t configuration;
+        /// DSDB ID of the application.
+        RowID applicationID;
+        /// Directory of the application.
+        std::string applicationPath;
+    };
+
+    /// Outcome of compiling and simulating an application. Passed from
+    /// the evaluation workers through a pipe, thus must stay plain data.
+    struct ApplicationEvaluation {
+        enum Status {
+            EVAL_OK,            ///< Simulated with the correct output.
+            EVAL_UNSCHEDULABLE, ///< The scheduler failed.
+            EVAL_FAILED         ///< Other error or incorrect output.
+        };
+        /// The outcome.
+        Status status;
+        /// Simulated cycle count if the evaluation succeeded.
+        ClockCycleCount cycles;
+        /// Energy estimate of the program, if estimated.
+        double energy;
+    };
+
+    void evaluateConfigurations(
+        const std::vector<DSDBManager::MachineConfiguration>& configurations,
+        std::vector<bool>& results, bool estimate, CostEstimates* estimates);
+    ApplicationEvaluation evaluateApplication(
+        const std::string& applicationPath, TTAMachine::Machine& adf,
+        const IDF::MachineImplementation* idf, bool estimate,
+        RowID architectureID);
+    bool storeEvaluation(
+        const EvaluationTask& task,
+        const DSDBManager::MachineConfiguration& configuration,
+        const ApplicationEvaluation& evaluation, bool estimate);
+    static std::string backendPluginCache();
+    void evaluateInWorkers(
+        const std::vector<EvaluationTask>& tasks,
+        const std::vector<DSDBManager::MachineConfiguration>& configurations,
+        const std::vector<TTAMachine::Machine*>& adfs,
+        const std::vector<IDF::MachineImplementation*>& idfs,
+        bool estimate, int jobs,
+        std::vector<ApplicationEvaluation>& evaluations);
+
     /// Design space database where results are stored.
     DSDBManager* dsdb_;
     /// The plugin tool.
@@ -135,6 +187,9 @@ private:
     std::ostringstream* oStream_;
     /// Used for the default evaluate() argument.
     static CostEstimates dummyEstimate_;
+    /// Maximum number of concurrent evaluation workers, 0 for the
+    /// command line default.
+    int jobs_;
 
 };
 
@@ -104,6 +104,10 @@ const std::string SWL_IDF_FILE = "idf";
 const std::string SWS_COMPILER_OPTIONS = "f";
 /// Long switch string of options to pass to compiler
 const std::string SWL_COMPILER_OPTIONS = "compiler_options";
+/// Short switch string for the number of evaluation jobs.
+const std::string SWS_JOBS = "j";
+/// Long switch string for the number of evaluation jobs.
+const std::string SWL_JOBS = "jobs";
 
 /**
  * Constructor.
@@ -202,6 +206,13 @@ ExplorerCmdLineOptions::ExplorerCmdLineOptions() : CmdLineOptions("") {
             SWL_COMPILER_OPTIONS,
             "Options to pass to the compiler.",
             SWS_COMPILER_OPTIONS));
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_JOBS,
+            "Number of configuration evaluations (compilation and "
+            "simulation) to run concurrently in worker processes. "
+            "Default is 1.",
+            SWS_JOBS));
             
 }
 
@@ -591,3 +602,19 @@ ExplorerCmdLineOptions::compilerOptionsString() const {
     }
     return optsString;
 }
+
+/**
+ * Returns the number of concurrent evaluation workers given as an option.
+ *
+ * @return The number of workers, 1 if not given or if not positive.
+ */
+int
+ExplorerCmdLineOptions::jobs() const {
+
+    if (findOption(SWL_JOBS)->isDefined() &&
+        findOption(SWL_JOBS)->integer() > 0) {
+        return findOption(SWL_JOBS)->integer();
+    } else {
+        return 1;
+    }
+}
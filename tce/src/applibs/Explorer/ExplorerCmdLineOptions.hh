@@ -81,6 +81,8 @@ public:
     bool compilerOptions() const;    
     std::string compilerOptionsString() const;
 
+    int jobs() const;
+
 private:
     /// Copying not allowed.
     ExplorerCmdLineOptions(const ExplorerCmdLineOptions&);
@@ -98,6 +98,10 @@ IGNORE_COMPILER_WARNING("-Wcomment")
 #define CONFIG_H
 
 #include <cstdlib> // system()
+#include <cstdio> // rename()
+#include <unistd.h> // getpid(), link()
+#include <sstream>
+#include <boost/functional/hash.hpp>
 #include <fstream>
 
 #include "LLVMBackend.hh"
@@ -106,6 +110,7 @@ IGNORE_COMPILER_WARNING("-Wcomment")
 
 #include "Environment.hh"
 #include "Conversion.hh"
+#include "StringTools.hh"
 #include "FileSystem.hh"
 #include "TCETargetMachine.hh"
 #include "TCEStubTargetMachine.hh"
@@ -796,6 +801,12 @@ LLVMBackend::createPlugin(const TTAMachine::Machine& target) {
         }
     }
 
+    // The plugin is compiled to a process specific file which is then
+    // renamed to the cached one. Thus concurrent compilations for the same
+    // target never load a partially written plugin from the cache.
+    const std::string tempPluginFileName = 
+        pluginFileName + "." + Conversion::toString(getpid()) + ".tmp";
+
     if (!options_->useOldBackendSources()) {
         // Create target instruction and register definitions in .td files.
         TDGen plugingen(target);
@@ -932,42 +943,101 @@ LLVMBackend::createPlugin(const TTAMachine::Machine& target) {
         "-DLITTLE_ENDIAN_TARGET" : "";
 
     TCEString bitnessOption = target.is64bit() ? "-DTARGET64BIT" : "";
-    // Compile plugin to cache.
-    // CXX and SHARED_CXX_FLAGS defined in tce_config.h
-    cmd = std::string(CXX) +
-        " -I" + tempDir_ +
-        pluginIncludeFlags +
-        " " + SHARED_CXX_FLAGS +
-        " " + LLVM_CPPFLAGS +
+    TCEString vectorOption = 
+        options_->useVectorBackend() ? " -DUSE_VECTOR_REGS" : "";
+
+    // Machines that differ only in details not visible to the backend,
+    // e.g., in their interconnection network, get identical generated
+    // sources. Unless the plugin is discarded after use, it is stored
+    // under a name derived from the generated sources and reused for all
+    // such machines instead of compiling it again.
+    std::string sharedPluginFileName = "";
+    if (options_->saveBackendPlugin()) {
+        sharedPluginFileName = cachePath_ + DS + 
+            sharedPluginFilename(
+                endianOption + " " + bitnessOption + vectorOption);
+    }
+    const std::string builtPluginFileName = 
+        sharedPluginFileName != "" ? sharedPluginFileName : pluginFileName;
+
+    if (!FileSystem::fileExists(builtPluginFileName)) {
+        // Compile plugin to cache.
+        // CXX and SHARED_CXX_FLAGS defined in tce_config.h
+        cmd = std::string(CXX) +
+            " -I" + tempDir_ +
+            pluginIncludeFlags +
+            " " + SHARED_CXX_FLAGS +
+            " " + LLVM_CPPFLAGS +
 #ifdef LLVM_OLDER_THAN_10
 #if defined(HAVE_CXX0X)
-        " " + CXX0X_FLAG +
+            " " + CXX0X_FLAG +
 #elif defined(HAVE_CXX11)
-        " " + CXX11_FLAG +
+            " " + CXX11_FLAG +
 #endif
 #else
-        " " + CXX14_FLAG +
+            " " + CXX14_FLAG +
 #endif
-        " " + endianOption +
-        " " + bitnessOption +
-        " " + pluginSources +
-        " -o " + pluginFileName;
+            " " + endianOption +
+            " " + bitnessOption +
+            " " + pluginSources +
+            " -o " + tempPluginFileName +
+            vectorOption;
+        if (Application::verboseLevel() > 0) {
+            Application::logStream() << "LLVMBackend: " << cmd << std::endl;
+        }
+        ret = system(cmd.c_str());
+        if (ret) {
+            FileSystem::removeFileOrDirectory(tempPluginFileName);
+            std::string msg = std::string() +
+                "Failed to build compiler plugin for target "
+                "architecture.\n" +
+                "Failed command was: " + cmd;
 
-    // TODO: whether vectors are used or not stored in has of the
-    // plugin. this is a temporary solution
-    if (options_->useVectorBackend()) {
-        cmd += " -DUSE_VECTOR_REGS";
-    }
-    if (Application::verboseLevel() > 0) {
-        Application::logStream() << "LLVMBackend: " << cmd << std::endl;
+            throw CompileError(__FILE__, __LINE__, __func__, msg);
+        }
+        if (std::rename(
+                tempPluginFileName.c_str(), 
+                builtPluginFileName.c_str()) != 0) {
+            FileSystem::removeFileOrDirectory(tempPluginFileName);
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "Unable to store compiler plugin to '" + builtPluginFileName +
+                "'.");
+        }
+    } else if (Application::verboseLevel() > 0) {
+        Application::logStream() 
+            << "LLVMBackend: reusing plugin " << builtPluginFileName 
+            << std::endl;
     }
-    ret = system(cmd.c_str());
-    if (ret) {
-        std::string msg = std::string() +
-            "Failed to build compiler plugin for target architecture.\n" +
-            "Failed command was: " + cmd;
 
-        throw CompileError(__FILE__, __LINE__, __func__, msg);
+    if (sharedPluginFileName != "") {
+        // A hard link, or a copy in case the file system does not support
+        // them, lets the plugin be found by the machine hash next time.
+        // It is made under the process specific name and renamed over the
+        // old plugin, so concurrent compilations loading the plugin by
+        // the machine hash always find a complete file.
+        FileSystem::removeFileOrDirectory(tempPluginFileName);
+        try {
+            if (link(
+                    sharedPluginFileName.c_str(), 
+                    tempPluginFileName.c_str()) != 0) {
+                FileSystem::copy(sharedPluginFileName, tempPluginFileName);
+            }
+        } catch (const Exception&) {
+            FileSystem::removeFileOrDirectory(tempPluginFileName);
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "Unable to store compiler plugin to '" + 
+                pluginFileName + "'.");
+        }
+        if (std::rename(
+                tempPluginFileName.c_str(), pluginFileName.c_str()) != 0) {
+            FileSystem::removeFileOrDirectory(tempPluginFileName);
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "Unable to store compiler plugin to '" + 
+                pluginFileName + "'.");
+        }
     }
 
     // Load plugin.
@@ -1007,3 +1077,43 @@ LLVMBackend::pluginFilename(const TTAMachine::Machine& target) {
 
     return fileName;
 }
+
+/**
+ * Returns a plugin filename derived from the generated backend sources.
+ *
+ * The sources generated for the current target in the temporary directory
+ * together with the plugin compilation options define the plugin, thus
+ * machines with identical sources can share the plugin.
+ *
+ * @param compileOptions The target specific plugin compilation options.
+ * @return Filename for the plugin compiled from the generated sources.
+ */
+std::string
+LLVMBackend::sharedPluginFilename(const std::string& compileOptions) {
+    static const char* const GENERATED_FILES[] = {
+        "Backend.inc", "TCEGenRegisterInfo.inc", "TCEGenInstrInfo.inc",
+        "TCEGenDAGISel.inc", "TCEGenCallingConv.inc",
+        "TCEGenSubTargetInfo.inc"};
+
+    std::string sources = compileOptions;
+    for (std::size_t i = 0; 
+         i < sizeof(GENERATED_FILES) / sizeof(GENERATED_FILES[0]); ++i) {
+        std::ifstream file((tempDir_ + DS + GENERATED_FILES[i]).c_str());
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        sources += contents.str();
+    }
+    // tblgen may refer to its input file which is in a temporary directory
+    // unique for each compilation
+    sources = StringTools::replaceAllOccurrences(sources, tempDir_, "");
+
+    boost::hash<std::string> stringHasher;
+    TCEString fileName = PLUGIN_PREFIX;
+    fileName += Conversion::toHexString(sources.length()).substr(2);
+    fileName += "_";
+    fileName += Conversion::toHexString(stringHasher(sources)).substr(2);
+    fileName += "-" + Application::TCEVersionString();
+    fileName += PLUGIN_SUFFIX;
+
+    return fileName;
+}
@@ -87,6 +87,7 @@ public:
 
 private:
     std::string pluginFilename(const TTAMachine::Machine& target);
+    std::string sharedPluginFilename(const std::string& compileOptions);
 
     /// Assume we are running an installed TCE version.
     bool useInstalledVersion_;
@@ -69,6 +69,8 @@ const std::string LLVMTCECmdLineOptions::SWL_ENABLE_VECTOR_BACKEND =
 const std::string LLVMTCECmdLineOptions::SWL_WORK_ITEM_AA_FILE = "wi-aa-filename";
 const std::string LLVMTCECmdLineOptions::SWL_BACKEND_CACHE_DIR = "backend-cache-dir";
 const std::string LLVMTCECmdLineOptions::SWL_INIT_SP = "init-sp";
+const std::string LLVMTCECmdLineOptions::SWL_SCHEDULER_JOBS = 
+    "scheduler-jobs";
 
 const std::string LLVMTCECmdLineOptions::USAGE =
     "Usage: llvmtce [OPTION]... BYTECODE\n"
@@ -184,6 +186,12 @@ LLVMTCECmdLineOptions::LLVMTCECmdLineOptions() {
         new UnsignedIntegerCmdLineOptionParser(
             SWL_INIT_SP,
             "Initialize the stack pointer of the program to the given value."));
+
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_SCHEDULER_JOBS,
+            "Number of procedures to schedule concurrently in threads. "
+            "Default is 1."));
 }
 
 /**
@@ -381,3 +389,19 @@ unsigned
 LLVMTCECmdLineOptions::initialStackPointerValue() const {
     return findOption(SWL_INIT_SP)->unsignedInteger();
 }
+
+/**
+ * Returns the number of procedures to schedule concurrently.
+ *
+ * @return The number of scheduler threads, 1 if not given or if not
+ *         positive.
+ */
+int
+LLVMTCECmdLineOptions::schedulerJobs() const {
+    if (findOption(SWL_SCHEDULER_JOBS)->isDefined() &&
+        findOption(SWL_SCHEDULER_JOBS)->integer() > 0) {
+        return findOption(SWL_SCHEDULER_JOBS)->integer();
+    } else {
+        return 1;
+    }
+}
@@ -93,6 +93,8 @@ public:
     bool isInitialStackPointerValueSet() const;
     unsigned initialStackPointerValue() const;
 
+    int schedulerJobs() const;
+
     virtual void printVersion() const {
         std::cout << "llvm-tce - TCE LLVM code generator " << VERSION
                   << std::endl;
@@ -127,6 +129,7 @@ private:
     static const std::string SWL_ANALYZE_INSTRUCTION_PATTERNS;
     static const std::string SWL_BACKEND_CACHE_DIR;
     static const std::string SWL_INIT_SP;
+    static const std::string SWL_SCHEDULER_JOBS;
     static const std::string USAGE;
 };
 
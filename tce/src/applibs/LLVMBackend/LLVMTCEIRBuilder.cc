@@ -67,6 +67,9 @@ IGNORE_COMPILER_WARNING("-Wunused-parameter")
 
 
 #include <stdlib.h>
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/MC/MCContext.h>
 #include <llvm/MC/MCSymbol.h>
@@ -200,6 +203,22 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
             // got them for us and passed through.        
             AA = AA_;
         }
+        if (deferScheduling()) {
+            // The alias analysis results are only valid during this
+            // call, so build the DDG now and schedule it later.
+            DeferredFunction f;
+            f.procedure = procedure;
+            f.cfg = cfg;
+            f.ddg = NULL;
+            f.dsf = delaySlotFilling_ ? new CopyingDelaySlotFiller : NULL;
+            f.name = fnName;
+            EXIT_IF_THROWS(f.ddg = prepareOptimized(*cfg, AA));
+            if (f.dsf != NULL) {
+                EXIT_IF_THROWS(f.dsf->initialize(*cfg, *f.ddg, *mach_));
+            }
+            deferred_.push_back(f);
+            return false;
+        }
         EXIT_IF_THROWS(compileOptimized(*cfg, AA));
     }
 
@@ -658,6 +677,29 @@ LLVMTCEIRBuilder::compileOptimized(
     ControlFlowGraph& cfg, 
     llvm::AliasAnalysis* llvmAA) {
 
+    DataDependenceGraph* ddg = prepareOptimized(cfg, llvmAA);
+    CopyingDelaySlotFiller* dsf = NULL;
+    if (delaySlotFilling_) {
+        dsf = &delaySlotFiller();
+        dsf->initialize(cfg, *ddg, *mach_);
+    }
+    scheduleOptimized(cfg, *ddg, dsf);
+    delete ddg;
+}
+
+/**
+ * Builds the procedure DDG and runs the passes that precede scheduling.
+ *
+ * This is the part of compileOptimized() that needs the LLVM alias
+ * analysis and thus must run while the machine function is processed.
+ *
+ * @return The procedure DDG, owned by the caller.
+ */
+DataDependenceGraph*
+LLVMTCEIRBuilder::prepareOptimized(
+    ControlFlowGraph& cfg, 
+    llvm::AliasAnalysis* llvmAA) {
+
     SchedulerCmdLineOptions* options =
         dynamic_cast<SchedulerCmdLineOptions*>(
             Application::cmdLineOptions());
@@ -692,21 +734,35 @@ LLVMTCEIRBuilder::compileOptimized(
         // need the BB refs to rebuild the LLVM CFG 
         cfg.convertBBRefsToInstRefs();
     }
+    return ddg;
+}
+
+/**
+ * Schedules the procedure and runs the post-pass optimizations.
+ *
+ * Touches only the given procedure's CFG, DDG and delay slot filler, so
+ * different procedures can be scheduled concurrently.
+ *
+ * @param dsf Initialized delay slot filler, or NULL if not filling.
+ */
+void
+LLVMTCEIRBuilder::scheduleOptimized(
+    ControlFlowGraph& cfg, 
+    DataDependenceGraph& ddg,
+    CopyingDelaySlotFiller* dsf) {
 
+#if defined(WRITE_DDG_DOTS) || defined(WRITE_CFG_DOTS)
+    TCEString fnName = cfg.name();
+#endif
     CycleLookBackSoftwareBypasser bypasser;
-    CopyingDelaySlotFiller* dsf = nullptr;
-    if (delaySlotFilling_)
-        dsf = &delaySlotFiller();
     BBSchedulerController bbsc(*ipData_, &bypasser, dsf);
-    if (delaySlotFilling_)
-        delaySlotFiller().initialize(cfg, *ddg, *mach_);
-    bbsc.handleCFGDDG(cfg, *ddg, *mach_ );
+    bbsc.handleCFGDDG(cfg, ddg, *mach_ );
 
 #ifdef WRITE_CFG_DOTS
     cfg.writeToDotFile(fnName + "_cfg2.dot");
 #endif
 #ifdef WRITE_DDG_DOTS
-    ddg->writeToDotFile(fnName + "_ddg3.dot");
+    ddg.writeToDotFile(fnName + "_ddg3.dot");
 #endif
 
     if (!modifyMF_) {
@@ -718,8 +774,8 @@ LLVMTCEIRBuilder::compileOptimized(
 
     if (!functionAtATime_) {
         // TODO: make DS filler work with FAAT
-        if (delaySlotFilling_) {
-            delaySlotFiller().fillDelaySlots(cfg, *ddg, *mach_);
+        if (dsf != NULL) {
+            dsf->fillDelaySlots(cfg, ddg, *mach_);
         } 
     }
 
@@ -727,13 +783,85 @@ LLVMTCEIRBuilder::compileOptimized(
     ppos.handleControlFlowGraph(cfg, *mach_);
 
 #ifdef WRITE_DDG_DOTS
-    ddg->writeToDotFile(fnName + "_ddg4.dot");
+    ddg.writeToDotFile(fnName + "_ddg4.dot");
 #endif
 
 #ifdef WRITE_CFG_DOTS
     cfg.writeToDotFile(fnName + "_cfg3.dot");
 #endif
-    delete ddg;    
+}
+
+/**
+ * Returns true if the scheduling of the optimized functions should be
+ * deferred to doFinalization() and done in parallel.
+ *
+ * Falls back to the serial path whenever some output depends on the
+ * order in which the basic blocks are processed.
+ */
+bool
+LLVMTCEIRBuilder::deferScheduling() const {
+    return options_ != NULL && !modifyMF_ && !functionAtATime_ &&
+        options_->schedulerJobs() > 1 &&
+        !options_->dumpDDGsDot() && !options_->dumpDDGsXML() &&
+        !options_->printResourceConstraints();
+}
+
+/**
+ * Schedules the deferred functions using a pool of worker threads and
+ * copies the results to their procedures in the original order.
+ *
+ * The procedures do not share instructions, and the shared caches used by
+ * the scheduler only memoize results, so the produced program is the same
+ * regardless of the number of threads.
+ */
+void
+LLVMTCEIRBuilder::scheduleDeferredFunctions() {
+
+    if (deferred_.empty()) {
+        return;
+    }
+    std::vector<std::exception_ptr> errors(deferred_.size());
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < deferred_.size(); i = next++) {
+            DeferredFunction& f = deferred_[i];
+            try {
+                scheduleOptimized(*f.cfg, *f.ddg, f.dsf);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    size_t threadCount = std::min(
+        (size_t)options_->schedulerJobs(), deferred_.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+
+    for (size_t i = 0; i < deferred_.size(); ++i) {
+        DeferredFunction& f = deferred_[i];
+        if (errors[i]) {
+            EXIT_IF_THROWS(std::rethrow_exception(errors[i]));
+        }
+        f.cfg->convertBBRefsToInstRefs();
+        TTAProgram::InstructionReferenceManager& irm =
+            f.cfg->instructionReferenceManager();
+        f.cfg->copyToProcedure(*f.procedure, &irm);
+        if (f.procedure->instructionCount() > 0) {
+            codeLabels_[f.name] = &f.procedure->firstInstruction();
+        }
+        delete f.dsf;
+        delete f.ddg;
+        delete f.cfg;
+    }
+    deferred_.clear();
 }
 
 
@@ -874,6 +1002,7 @@ LLVMTCEIRBuilder::doFinalization(Module& m) {
     // through library boundaries is flaky. It crashes 
     // on x86-32 Linux at least. See:
     // https://bugs.launchpad.net/tce/+bug/894816
+    EXIT_IF_THROWS(scheduleDeferredFunctions());
     EXIT_IF_THROWS(LLVMTCEBuilder::doFinalization(m));
     EXIT_IF_THROWS(prog_->convertSymbolRefsToInsRefs());
     return false; 
@@ -138,6 +138,16 @@ namespace llvm {
         void compileOptimized(
             ControlFlowGraph& cfg, 
             llvm::AliasAnalysis* llvmAA);
+        DataDependenceGraph* prepareOptimized(
+            ControlFlowGraph& cfg, 
+            llvm::AliasAnalysis* llvmAA);
+        void scheduleOptimized(
+            ControlFlowGraph& cfg, 
+            DataDependenceGraph& ddg,
+            CopyingDelaySlotFiller* dsf);
+
+        bool deferScheduling() const;
+        void scheduleDeferredFunctions();
 
         CopyingDelaySlotFiller& delaySlotFiller();
 
@@ -170,6 +180,18 @@ namespace llvm {
 
         CopyingDelaySlotFiller* dsf_;
         bool delaySlotFilling_;
+
+        /// A function whose DDG has been built but which is scheduled
+        /// only in doFinalization(), concurrently with the others.
+        struct DeferredFunction {
+            TTAProgram::Procedure* procedure;
+            ControlFlowGraph* cfg;
+            DataDependenceGraph* ddg;
+            CopyingDelaySlotFiller* dsf;
+            TCEString name;
+        };
+        /// Deferred functions in their program order.
+        std::vector<DeferredFunction> deferred_;
     };
 }
 
@@ -171,6 +171,10 @@ MachineInstrDDG::MachineInstrDDG(
         }
     }
 
+    // the edge loop below checks for loops with hasPath() before every
+    // insertion, build the reachability index once and let connectNodes()
+    // keep it up to date
+    findAllPaths();
 
     for (DefinerMap::iterator i = definers_.begin(); i != definers_.end(); 
          ++i) {
@@ -56,7 +56,6 @@ IGNORE_COMPILER_WARNING("-Wunused-parameter")
 #include "LLVMPOMBuilder.hh"
 #include "PluginTools.hh"
 #include "FileSystem.hh"
-#include "ADFSerializer.hh"
 #include "Conversion.hh"
 
 #include <iostream>
@@ -306,16 +305,6 @@ TCEPassConfig::addPreISel() {
     return false;
 }
 
-/**
- * Creates a TTAMachine::Machine object of the target architecture.
- */
-TTAMachine::Machine*
-TCETargetMachine::createMachine() {
-    ADFSerializer serializer;
-    serializer.setSourceString(*plugin_->adfXML());
-    return serializer.readMachine();
-}
-
 /**
  * Returns list of llvm::ISD SelectionDAG opcodes for operations that are not
  * supported in the target architecture.
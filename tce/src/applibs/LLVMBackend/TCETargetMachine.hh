@@ -201,8 +201,6 @@ plugin_(plugin) {
             return plugin_->registerIndex(dwarfRegNum);
         }
 
-        TTAMachine::Machine* createMachine();
-
         std::string dataASName() {
             return plugin_->dataASName();
         }
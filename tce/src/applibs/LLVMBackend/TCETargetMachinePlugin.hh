@@ -139,7 +139,8 @@ namespace llvm {
        virtual int getTruePredicateOpcode(unsigned opc) const = 0;
        virtual int getFalsePredicateOpcode(unsigned opc) const = 0;
 
-       /// Returns pointer to xml string of the target machine .adf
+       /// Returns pointer to xml string of the target machine .adf, empty
+       /// as the machine is not embedded in the generated plugins.
        virtual const std::string* adfXML() = 0;
        /// Returns name of the data address space.
        virtual std::string dataASName() = 0;
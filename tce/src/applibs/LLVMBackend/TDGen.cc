@@ -36,7 +36,6 @@
 
 #include "TDGen.hh"
 #include "Machine.hh"
-#include "ADFSerializer.hh"
 #include "ControlUnit.hh"
 #include "Operation.hh"
 #include "HWOperation.hh"
@@ -1029,18 +1028,9 @@ TDGen::writeBackendCode(std::ostream& o) {
     }
 
 
-    // Target machine .adf XML string.
-    std::string adfXML;
-    ADFSerializer serializer;
-    serializer.setDestinationString(adfXML);
-    serializer.writeMachine(mach_);
-    o << "    adfXML_ = \"";
-    for (unsigned int i = 0; i < adfXML.length(); i++) {
-        if (adfXML[i] == '"') o << "\\\"";
-        else if (adfXML[i] == '\n') o << "\"\n\"";
-        else o << adfXML[i];
-    }
-    o << "\";" << std::endl;
+    // The target machine .adf is not embedded to the plugin, the machine
+    // is given to the backend at compile time. Thus the plugin can be
+    // shared by machines that generate identical backend sources.
 
 
     // data address space
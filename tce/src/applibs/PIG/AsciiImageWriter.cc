@@ -31,13 +31,8 @@
  * @note rating: red
  */
 
-#include <cstdint>
 #include <string>
-#include <iomanip>
-#include <vector>
-#include <numeric>
 #include <algorithm>
-#include <cmath>
 #include <iostream>
 
 #include "AsciiImageWriter.hh"
@@ -71,23 +66,20 @@ AsciiImageWriter::~AsciiImageWriter() {
  */
 void
 AsciiImageWriter::writeImage(std::ostream& stream) const {
-    int column = 0;
-    for (BitVector::const_iterator iter = bits_.begin(); iter != bits_.end();
-         iter++) {
-        BitVector::const_iterator nextIter = iter;
-        nextIter++;
-        stream << *iter;
-        column++;
-        if (column == rowLength_ && nextIter != bits_.end()) {
+
+    const std::size_t size = bits_.size();
+    const std::size_t rowLength =
+        rowLength_ > 0 ? static_cast<std::size_t>(rowLength_) : size;
+
+    // the last row is padded with zeroes if necessary
+    string row;
+    for (std::size_t first = 0; first < size; first += rowLength) {
+        if (first > 0) {
             stream << '\n';
-            column = 0;
-        } else if (nextIter == bits_.end()) {
-            // pad the remaining bits with zeroes if necessary
-            while (column < rowLength_) {
-                stream << "0";
-                column++;
-            }
         }
+        row.clear();
+        appendBits(row, first, rowLength);
+        stream << row;
     }
 }
 
@@ -135,13 +127,9 @@ AsciiImageWriter::writeSequence(
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
 
-    for (unsigned int index = nextBitIndex_; index <= lastIndex; index++) {
-        if (index < bits_.size()) {
-            stream << bits_[index];
-        } else {
-            stream << "0";
-        }
-    }
+    string sequence;
+    appendBits(sequence, nextBitIndex_, lastIndex + 1 - nextBitIndex_);
+    stream << sequence;
     nextBitIndex_ = lastIndex + 1;
 }
 
@@ -166,34 +154,64 @@ AsciiImageWriter::writeHexSequence(
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
 
-    const int nibbleCount = static_cast<int>(ceil(
-        static_cast<double>(length) / 4.0));
-
-    std::vector<bool> bitRow;
-
-    // Copy bitstream for one row
-    for (unsigned int i = nextBitIndex_; i <= lastIndex; ++i) {
-        bitRow.push_back(bits_[i]);
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    const int nibbleCount = (length + 3) / 4;
+    // the sequence is extended with zeros at the beginning to full nibbles
+    const int padBits = 4 * nibbleCount - length;
+
+    string digits;
+    for (int nibble = 0; nibble < nibbleCount; nibble++) {
+        int start = 4 * nibble - padBits;
+        BitVector::Word value = (start < 0) ?
+            bitsAt(nextBitIndex_, 4 + start) :
+            bitsAt(nextBitIndex_ + start, 4);
+        digits += HEX_DIGITS[value];
     }
+    stream << digits;
+    nextBitIndex_ += length;
+}
 
-    // optionally extend bit stream
-    int numPadBits = 4 * nibbleCount - length;
-    if (numPadBits) {
-        std::vector<bool> padBits(numPadBits, 0);
-        bitRow.insert(bitRow.begin(), padBits.begin(), padBits.end());
-    }
 
-    // Generate a list of nibble
-    std::vector<uint8_t> Nibble;
-    for (auto it = bitRow.begin(); it < bitRow.end(); it += 4) {
-        Nibble.push_back(std::accumulate(
-            it, it + 4, 0,[] (int x, int y) {return (x << 1) + y;}));
+/**
+ * Returns the bits of the given field of the vector as an integer.
+ *
+ * The positions beyond the end of the vector read as zeros.
+ *
+ * @param firstIndex Index of the first bit of the field.
+ * @param width Width of the field, at most BitVector::WORD_BITS.
+ * @return The field.
+ */
+BitVector::Word
+AsciiImageWriter::bitsAt(std::size_t firstIndex, int width) const {
+    if (firstIndex >= bits_.size()) {
+        return 0;
     }
+    const int available = std::min<std::size_t>(
+        width, bits_.size() - firstIndex);
+    return bits_.field(firstIndex, available) << (width - available);
+}
 
-    // "print" hex stream
-    for (auto ui8 = Nibble.begin(); ui8 < Nibble.end(); ++ui8) {
-        stream << std::hex << (int) *ui8;
-    }
 
-    nextBitIndex_ += length;
+/**
+ * Appends the given bits of the vector as 1's and 0's to a string.
+ *
+ * The positions beyond the end of the vector are written as 0's.
+ *
+ * @param text The string.
+ * @param firstIndex Index of the first bit to append.
+ * @param count The number of bits to append.
+ */
+void
+AsciiImageWriter::appendBits(
+    string& text, std::size_t firstIndex, std::size_t count) const {
+
+    text.reserve(text.size() + count);
+    for (std::size_t done = 0; done < count; done += BitVector::WORD_BITS) {
+        const int width = std::min<std::size_t>(
+            BitVector::WORD_BITS, count - done);
+        const BitVector::Word word = bitsAt(firstIndex + done, width);
+        for (int bit = width - 1; bit >= 0; bit--) {
+            text += ((word >> bit) & 1) ? '1' : '0';
+        }
+    }
 }
@@ -34,11 +34,12 @@
 #ifndef TTA_ASCII_IMAGE_WRITER_HH
 #define TTA_ASCII_IMAGE_WRITER_HH
 
+#include <string>
+
 #include "BitImageWriter.hh"
+#include "BitVector.hh"
 #include "Exception.hh"
 
-class BitVector;
-
 /**
  * Writes the bit image with ASCII 1's and 0's.
  */
@@ -60,6 +61,10 @@ protected:
         std::ostream& stream, int length, bool padEnd = false) const;
 
 private:
+    BitVector::Word bitsAt(std::size_t firstIndex, int width) const;
+    void appendBits(
+        std::string& text, std::size_t firstIndex, std::size_t count) const;
+
     /// The bits to be written.
     const BitVector& bits_;
     /// The length of a row in the output.
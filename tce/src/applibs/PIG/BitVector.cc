@@ -30,18 +30,18 @@
  * @note rating: red
  */
 
+#include <algorithm>
 #include <string>
 
 #include "BitVector.hh"
-#include "MathTools.hh"
 #include "Application.hh"
 
-using std::string;
+const int BitVector::WORD_BITS;
 
 /**
  * The constructor.
  */
-BitVector::BitVector() {
+BitVector::BitVector() : size_(0) {
 }
 
 
@@ -58,20 +58,24 @@ BitVector::BitVector() {
  * @exception OutOfRange If the given indexes are too big or too small.
  */
 BitVector::BitVector(
-    const BitVector& vector, unsigned int firstIndex, unsigned int lastIndex) {
+    const BitVector& vector, unsigned int firstIndex, unsigned int lastIndex) :
+    size_(0) {
+
     if (lastIndex < firstIndex || lastIndex >= vector.size()) {
-        const string procName = "BitVector::BitVector";
+        const std::string procName = "BitVector::BitVector";
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
 
-    BitVector::const_iterator firstIter = vector.begin();
-    firstIter += firstIndex;
-    BitVector::const_iterator lastIter = vector.begin();
-    lastIter += lastIndex + 1;
-    insert(begin(), firstIter, lastIter);
+    reserve(lastIndex - firstIndex + 1);
+    for (std::size_t index = firstIndex; index <= lastIndex;
+         index += WORD_BITS) {
+        int width = std::min<std::size_t>(WORD_BITS, lastIndex + 1 - index);
+        pushBack(vector.field(index, width), width);
+    }
     assert(size() == lastIndex - firstIndex + 1);
 }
 
+
 /**
  * The destructor.
  */
@@ -80,43 +84,202 @@ BitVector::~BitVector() {
 
 
 /**
- * Pushes back the given number and increases the size of the vector by the
- * given amount.
+ * Reserves space for the given number of bits.
  *
- * For example, if number 6 (110) is added with size 5, bits 00110 are 
- * concatenated to the vector. If size 2 is given, then bits 10 are
- * concatenated to the vector.
+ * @param bits The number of bits.
+ */
+void
+BitVector::reserve(std::size_t bits) {
+    words_.reserve((bits + WORD_BITS - 1) / WORD_BITS);
+}
+
+
+/**
+ * Removes all the bits.
+ */
+void
+BitVector::clear() {
+    words_.clear();
+    size_ = 0;
+}
+
+
+/**
+ * Returns the bit at the given index.
  *
- * @param integer The number to be added.
- * @param size The number of bits to be added.
+ * @param index The index.
+ * @return The bit.
+ * @exception OutOfRange If the index is out of range.
+ */
+bool
+BitVector::at(std::size_t index) const {
+    if (index >= size_) {
+        throw OutOfRange(__FILE__, __LINE__, __func__);
+    }
+    return operator[](index);
+}
+
+
+/**
+ * Inserts the given integer to the end of the vector.
+ *
+ * The integer is inserted in the given width, most significant bit first.
+ * Bits beyond the width of the integer are zeros.
+ *
+ * @param integer The integer.
+ * @param size The number of bits to insert.
  */
 void
 BitVector::pushBack(long long unsigned int integer, int size) {
-    for (int i = size - 1; i >= 0; i--) {
-        push_back(MathTools::bit(integer, i));
+
+    if (size <= 0) {
+        return;
+    }
+    if (size > WORD_BITS) {
+        pushBackZeros(size - WORD_BITS);
+        size = WORD_BITS;
+    } else if (size < WORD_BITS) {
+        integer &= (Word(1) << size) - 1;
+    }
+
+    const int offset = size_ % WORD_BITS;
+    if (offset == 0) {
+        words_.push_back(0);
     }
+    const int room = WORD_BITS - offset;
+    if (size <= room) {
+        words_.back() |= integer << (room - size);
+    } else {
+        words_.back() |= integer >> (size - room);
+        words_.push_back(integer << (WORD_BITS - (size - room)));
+    }
+    size_ += size;
 }
-    
+
 
 /**
- * Pushes back the given bit vector.
+ * Inserts the given bits to the end of the vector.
  *
- * @param bits The bit vector.
+ * @param bits The bits to insert.
  */
 void
 BitVector::pushBack(const BitVector& bits) {
-    reserve(size() + bits.size());
-    for (std::vector<bool>::const_iterator iter = bits.begin();
-         iter != bits.end(); iter++) {
-        push_back(*iter);
+
+    if (size_ % WORD_BITS == 0) {
+        words_.insert(words_.end(), bits.words_.begin(), bits.words_.end());
+        size_ += bits.size_;
+        return;
+    }
+
+    reserve(size_ + bits.size_);
+    std::size_t remaining = bits.size_;
+    for (std::size_t i = 0; remaining > 0; i++) {
+        int width = std::min<std::size_t>(WORD_BITS, remaining);
+        pushBack(bits.words_[i] >> (WORD_BITS - width), width);
+        remaining -= width;
     }
 }
+
+
+/**
+ * Overwrites a field of the vector with an integer.
+ *
+ * The most significant bit of the field is written to the first index.
+ *
+ * @param firstIndex Index of the first bit of the field.
+ * @param value The value of the field.
+ * @param width Width of the field, at most WORD_BITS.
+ * @exception OutOfRange If the field does not fit in the vector.
+ */
+void
+BitVector::setField(std::size_t firstIndex, Word value, int width) {
+
+    if (width < 0 || width > WORD_BITS || firstIndex + width > size_) {
+        throw OutOfRange(__FILE__, __LINE__, __func__);
+    }
+    if (width == 0) {
+        return;
+    }
+    if (width < WORD_BITS) {
+        value &= (Word(1) << width) - 1;
+    }
+
+    const std::size_t word = firstIndex / WORD_BITS;
+    const int offset = firstIndex % WORD_BITS;
+    if (offset + width <= WORD_BITS) {
+        const int shift = WORD_BITS - offset - width;
+        const Word mask = (~Word(0) >> (WORD_BITS - width)) << shift;
+        words_[word] = (words_[word] & ~mask) | (value << shift);
+    } else {
+        const int lowWidth = offset + width - WORD_BITS;
+        const Word highMask = ~Word(0) >> offset;
+        const Word lowMask = ~Word(0) << (WORD_BITS - lowWidth);
+        words_[word] = (words_[word] & ~highMask) | (value >> lowWidth);
+        words_[word + 1] = (words_[word + 1] & ~lowMask) |
+            (value << (WORD_BITS - lowWidth));
+    }
+}
+
+
+/**
+ * Tells whether the vectors have the same bits.
+ *
+ * @param other The other vector.
+ * @return True if the vectors are equal.
+ */
+bool
+BitVector::operator==(const BitVector& other) const {
+    return size_ == other.size_ && words_ == other.words_;
+}
+
+
+/**
+ * Tells whether the vectors differ.
+ *
+ * @param other The other vector.
+ * @return True if the vectors are not equal.
+ */
+bool
+BitVector::operator!=(const BitVector& other) const {
+    return !(*this == other);
+}
+
+
+/**
+ * Compares the vectors lexicographically like std::vector<bool> does.
+ *
+ * @param other The other vector.
+ * @return True if this vector is ordered before the other one.
+ */
+bool
+BitVector::operator<(const BitVector& other) const {
+
+    const std::size_t common = std::min(size_, other.size_);
+    const std::size_t fullWords = common / WORD_BITS;
+    for (std::size_t i = 0; i < fullWords; i++) {
+        if (words_[i] != other.words_[i]) {
+            return words_[i] < other.words_[i];
+        }
+    }
+    const int tail = common % WORD_BITS;
+    if (tail != 0) {
+        Word mine = words_[fullWords] >> (WORD_BITS - tail);
+        Word theirs = other.words_[fullWords] >> (WORD_BITS - tail);
+        if (mine != theirs) {
+            return mine < theirs;
+        }
+    }
+    return size_ < other.size_;
+}
+
+
 /**
- * Pushes back the given bit.
+ * Adds the given number of zero bits to the end of the vector.
  *
- * @param bit The bit to be added.
+ * @param count The number of bits.
  */
 void
-BitVector::pushBack(bool bit) {
-    push_back(bit);
+BitVector::pushBackZeros(std::size_t count) {
+    size_ += count;
+    words_.resize((size_ + WORD_BITS - 1) / WORD_BITS, 0);
 }
@@ -33,24 +33,112 @@
 #ifndef TTA_BIT_VECTOR_HH
 #define TTA_BIT_VECTOR_HH
 
+#include <cstddef>
+#include <iterator>
 #include <vector>
+
 #include "Exception.hh"
 
 /**
- * BitVector is a specialization of STL's bit vector. It provides some
- * handy helper methods.
+ * A growable sequence of bits for program and data images.
+ *
+ * The bits are packed most significant bit first into 64-bit words, so
+ * fields of up to 64 bits are appended, read and overwritten with a
+ * couple of shifts. The interface mimics std::vector<bool> where the
+ * image code used it bit by bit.
  */
-class BitVector : public std::vector<bool> {
+class BitVector {
 public:
+    /// Type of the words the bits are packed in.
+    typedef unsigned long long Word;
+
+    /// Number of bits in a Word.
+    static const int WORD_BITS = 64;
+
+    /**
+     * Writable reference to one bit of the vector.
+     */
+    class reference {
+    public:
+        reference(BitVector& vector, std::size_t index);
+        operator bool() const;
+        reference& operator=(bool bit);
+        reference& operator=(const reference& other);
+    private:
+        /// The vector of the bit.
+        BitVector& vector_;
+        /// Index of the bit.
+        std::size_t index_;
+    };
+
+    /**
+     * Read-only random access iterator over the bits.
+     */
+    class const_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef bool value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const bool* pointer;
+        typedef bool reference;
+
+        const_iterator(const BitVector& vector, std::size_t index);
+        bool operator*() const;
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        const_iterator& operator--();
+        const_iterator& operator+=(difference_type n);
+        const_iterator operator+(difference_type n) const;
+        difference_type operator-(const const_iterator& other) const;
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+        bool operator<(const const_iterator& other) const;
+    private:
+        /// The iterated vector.
+        const BitVector* vector_;
+        /// Index of the current bit.
+        std::size_t index_;
+    };
+
     BitVector();
     BitVector(
         const BitVector& vector, unsigned int firstIndex,
         unsigned int lastIndex);
     virtual ~BitVector();
 
+    std::size_t size() const;
+    bool empty() const;
+    void reserve(std::size_t bits);
+    void clear();
+
+    bool operator[](std::size_t index) const;
+    reference operator[](std::size_t index);
+    bool at(std::size_t index) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    void push_back(bool bit);
     void pushBack(long long unsigned int integer, int size);
     void pushBack(const BitVector& bits);
     void pushBack(bool bit);
+
+    Word field(std::size_t firstIndex, int width) const;
+    void setField(std::size_t firstIndex, Word value, int width);
+
+    bool operator==(const BitVector& other) const;
+    bool operator!=(const BitVector& other) const;
+    bool operator<(const BitVector& other) const;
+
+private:
+    void pushBackZeros(std::size_t count);
+
+    /// The bits, packed from the most significant bit of the first word.
+    /// The unused bits of the last word are always zero.
+    std::vector<Word> words_;
+    /// Number of bits in the vector.
+    std::size_t size_;
 };
 
+#include "BitVector.icc"
+
 #endif
@@ -391,9 +391,8 @@ CodeCompressorPlugin::addInstruction(
     }
 
     // fill the memory from last instruction to this instruction with 0's
-    for (unsigned int i = firstFree; i < instructionPosition; i++) {
-        programBits_->push_back(false);
-    }
+    static_cast<BitVector*>(programBits_)->pushBack(
+        0, instructionPosition - firstFree);
 
     // add the instruction bits
     programBits_->pushBack(*bits);
@@ -536,9 +535,7 @@ CodeCompressorPlugin::programBits() const {
     if (bitCount == mau_) {
         bitCount = 0;
     }
-    for (int i = 0; i < bitCount; i++) {
-        bits->push_back(false);
-    }
+    static_cast<BitVector*>(bits)->pushBack(0, bitCount);
 
     return bits;
 }
@@ -1097,9 +1094,7 @@ CodeCompressorPlugin::encodeLongImmediate(
             int zerosToAdd = slotWidth - (
                 leftmostBitToEncode - rightmostBitToEncode) - 1;
             assert(zerosToAdd >= 0);
-            for (int i = 0; i < zerosToAdd; i++) {
-                bitVector.push_back(false);
-            }
+            bitVector.pushBack(0, zerosToAdd);
 
             // push back the immediate value
             UIntWord immediateValue = imm.value().value().uIntWordValue();
@@ -1686,10 +1681,12 @@ CodeCompressorPlugin::addBits(
     int leftmostBit,
     int rightmostBit,
     BitVector& bitVector) {
-    
-    for (int i = leftmostBit; i >= rightmostBit; i--) {
-        bitVector.push_back(MathTools::bit(number, i));
+
+    long long unsigned int bits = 0;
+    if (rightmostBit < BitVector::WORD_BITS) {
+        bits = static_cast<long long unsigned int>(number) >> rightmostBit;
     }
+    bitVector.pushBack(bits, leftmostBit - rightmostBit + 1);
 }
 
 
@@ -117,9 +117,9 @@ InstructionBitVector::pushBack(const InstructionBitVector& bits) {
         }
     }
 
-    InstructionBitVector bitsCopy(bits);
-    
-    // fix the instruction references of the given bit vector
+    // fix the instruction references of the given bit vector, in a copy
+    // which is made only if there is something to fix
+    InstructionBitVector* bitsCopy = NULL;
     for (ReferenceMap::const_iterator iter = bits.references_.begin();
          iter != bits.references_.end(); iter++) {
         const Instruction* instruction = iter->first;
@@ -129,15 +129,23 @@ InstructionBitVector::pushBack(const InstructionBitVector& bits) {
                      indexBoundSet->begin(); 
                  setIter != indexBoundSet->end(); setIter++) {
                 IndexBoundTable* table = *setIter;
-                bitsCopy.fixBits(
+                if (bitsCopy == NULL) {
+                    bitsCopy = new InstructionBitVector(bits);
+                }
+                bitsCopy->fixBits(
                     *table, 
                     MapTools::valueForKey<unsigned int>(
                         instructionAddresses_, instruction));
             }
         }
     }           
-         
-    insert(end(), bitsCopy.begin(), bitsCopy.end());
+
+    if (bitsCopy == NULL) {
+        BitVector::pushBack(bits);
+    } else {
+        BitVector::pushBack(*bitsCopy);
+        delete bitsCopy;
+    }
 }
 
 /**
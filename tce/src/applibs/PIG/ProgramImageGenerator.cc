@@ -34,6 +34,7 @@
  * @note rating: red
  */
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -456,20 +457,25 @@ ProgramImageGenerator::generateDataImage(
                 unsigned int preferredSize =
                     ((dataBits.size() / (memWidth))+1) *
                     (memWidth);
-                while (dataBits.size() < preferredSize) {
-                    dataBits.push_back(0);
-                }
+                dataBits.pushBack(0, preferredSize - dataBits.size());
             }
 
             for (int k = 0; k < mausPerLine/2; k++) {
                 int bitOffset0 = k * as->width();
                 int bitOffset1 = (mausPerLine-k-1) * as->width();
                 // swap bytes of one MAU.
-                for (int j = 0; j < as->width(); j++) {
-                    bool bit0 = dataBits[lineOffset+bitOffset0 + j];
-                    dataBits[lineOffset+bitOffset0+j] =
-                        dataBits[lineOffset+bitOffset1+j];
-                    dataBits[lineOffset+bitOffset1+j] = bit0;
+                for (int j = 0; j < as->width();
+                     j += BitVector::WORD_BITS) {
+                    int width = std::min(
+                        as->width() - j, BitVector::WORD_BITS);
+                    BitVector::Word mau0 = dataBits.field(
+                        lineOffset + bitOffset0 + j, width);
+                    dataBits.setField(
+                        lineOffset + bitOffset0 + j,
+                        dataBits.field(lineOffset + bitOffset1 + j, width),
+                        width);
+                    dataBits.setField(
+                        lineOffset + bitOffset1 + j, mau0, width);
                 }
             }
             lineOffset += memWidth;
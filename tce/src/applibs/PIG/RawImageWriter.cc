@@ -30,6 +30,9 @@
  * @note rating: red
  */
 
+#include <algorithm>
+#include <string>
+
 #include "RawImageWriter.hh"
 #include "BitVector.hh"
 
@@ -56,34 +59,21 @@ RawImageWriter::~RawImageWriter() {
  */
 void
 RawImageWriter::writeImage(std::ostream& stream) const {
-    unsigned int size = bits_.size();
-    for (unsigned int i = 0; i < size; i += 8) {
-        stream << character(bits_, i);
-    }
-}
 
+    const std::size_t size = bits_.size();
+    std::string bytes;
+    bytes.reserve((size + 7) / 8);
 
-/**
- * Returns the byte of the given bit vector that starts at the given index.
- *
- * @param bits The bit vector.
- * @param startIndex The start index.
- * @return The byte.
- */
-char
-RawImageWriter::character(const BitVector& bits, unsigned int startIndex) {
-    unsigned int vectorSize = bits.size();
-    char character = 0;
-    if (bits[startIndex]) {
-        character++;
-    }
-    for (int i = 1; i < 8; i++) {
-        character = character << 1;
-        if (startIndex + i < vectorSize && bits[startIndex + i]) {
-            character++;
+    // the last byte is padded with zeros
+    for (std::size_t i = 0; i < size; i += BitVector::WORD_BITS) {
+        const int width =
+            std::min<std::size_t>(BitVector::WORD_BITS, size - i);
+        const BitVector::Word word =
+            bits_.field(i, width) << (BitVector::WORD_BITS - width);
+        for (int byte = 0; byte < (width + 7) / 8; byte++) {
+            bytes += static_cast<char>(
+                word >> (BitVector::WORD_BITS - 8 * (byte + 1)));
         }
     }
-    return character;
+    stream.write(bytes.data(), bytes.size());
 }
-            
-    
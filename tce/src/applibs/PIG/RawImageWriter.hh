@@ -48,8 +48,6 @@ public:
     virtual void writeImage(std::ostream& stream) const;
 
 private:
-    static char character(const BitVector& bits, unsigned int startIndex);
-
     /// The bits to be written.
     const BitVector& bits_;
 };
@@ -34,6 +34,14 @@
 #include <set>
 #include <string>
 #include <cstdlib>
+#include <chrono>
+#include <climits>
+#include <cerrno>
+
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
 
 #include <boost/timer.hpp>
 
@@ -63,6 +71,7 @@
 #include "BF2Scheduler.hh"
 #include "ControlUnit.hh"
 #include "LoopPrologAndEpilogBuilder.hh"
+#include "LoopIISearch.hh"
 
 namespace TTAMachine {
     class UniversalMachine;
@@ -470,8 +479,6 @@ BBSchedulerController::executeLoopPass(
 
     unsigned int iiMax = iiMinMax.second;
     unsigned int iiMin = iiMinMax.first;
-    unsigned int smallestSuccess = INT_MAX;
-    int tryCount = 0;
     unsigned int ii;
 
     if (Application::verboseLevel() > 0) {
@@ -479,78 +486,28 @@ BBSchedulerController::executeLoopPass(
                                  << iiMin << " MaxII=" << iiMax << std::endl;
     }
 
-    // search ii which is to be used by binary search.
-    while (iiMin <= iiMax) {
-
-        // split the search range by half.
-        ii = (iiMin*2 + iiMax)/3;
-
-        // Do not binary search with a max that is not working schedule.
-        // Try the max on second round instead to fail quickly
-        // when there is no solution.
-        if (tryCount && smallestSuccess == INT_MAX) {
-            ii = iiMax;
-        }
-
-        // Have we already tested this and found that it works?
-        // Don't test again!
-        if (ii == smallestSuccess) {
-            break;
-        }
-
-        if (Application::verboseLevel() > 0) {
-            Application::logStream() << "Testing with II=" << ii <<
-                std::endl;
-        }
-
-        // ddg of loop with back edges
-        DataDependenceGraph* loopDDG = bigDDG_->createSubgraph(bb, true);
-
-        SimpleResourceManager* rm =
-            SimpleResourceManager::createRM(targetMachine, ii);
-        rm->setDDG(loopDDG);
-
-        // when only testing, do not really need the prolog rm.
-        SimpleResourceManager* prologRM = NULL;
-
-        prologRM = SimpleResourceManager::createRM(targetMachine);
-        prologRM->setDDG(loopDDG);
-
-        // test scheduling.
-        try {
-            int loopScheduled = sched->handleLoopDDG(
-                *loopDDG, *rm, targetMachine, bb.tripCount(), prologRM, true);
-
-            // loop scheduler was slower than ordinary scheduler?
-            if (loopScheduled == 0) {
-                iiMax = ii -1;
-                smallestSuccess = ii;
-            } else {
-                // failed.
-                if (loopScheduled < 0) {
-                    iiMin = ii+1;
-                } else { // ok.
-                    iiMax = ii;
-                    smallestSuccess = ii;
-                }
-            }
-            SimpleResourceManager::disposeRM(rm);
-            SimpleResourceManager::disposeRM(prologRM);
-
-            delete loopDDG;
+    const int jobs = loopIIJobs();
+    std::chrono::steady_clock::time_point searchStart =
+        std::chrono::steady_clock::now();
 
-        } catch(ModuleRunTimeError& err) {
-            if (Application::verboseLevel() > 0) {
-                Application::logStream() << "\tLoop Scheduling failed: " <<
-                    err.errorMessageStack() << std::endl;
-            }
-            SimpleResourceManager::disposeRM(rm);
-            SimpleResourceManager::disposeRM(prologRM);
+    if (jobs > 1) {
+        LoopIISearch::searchInBatches(
+            [&](const std::vector<unsigned int>& iis) {
+                return testLoopIIsInWorkers(bb, targetMachine, *sched, iis);
+            }, jobs, iiMin, iiMax);
+    } else {
+        LoopIISearch::searchSerially(
+            [&](unsigned int testedII) {
+                return testLoopII(bb, targetMachine, *sched, testedII);
+            }, iiMin, iiMax);
+    }
 
-            delete loopDDG;
-            iiMin = ii+1;
-        }
-        tryCount++;
+    if (Application::verboseLevel() > 0) {
+        Application::logStream()
+            << "II search took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - searchStart).count()
+            << " ms with " << jobs << " worker(s)" << std::endl;
     }
 
     // no such ii where some overlapping and still possible to schedule
@@ -650,6 +607,210 @@ BBSchedulerController::executeLoopPass(
     return true;
 }
 
+/**
+ * Test-schedules the loop with the given initiation interval.
+ *
+ * The scheduler undoes the test schedule, leaving the procedure DDG as it
+ * was.
+ *
+ * @return Result of BF2Scheduler::handleLoopDDG() in test mode, -1 also
+ *         if the loop scheduler gave up with an error.
+ */
+int
+BBSchedulerController::testLoopII(
+    TTAProgram::BasicBlock& bb, const TTAMachine::Machine& targetMachine,
+    BF2Scheduler& sched, unsigned int ii) {
+
+    if (Application::verboseLevel() > 0) {
+        Application::logStream() << "Testing with II=" << ii <<
+            std::endl;
+    }
+
+    // ddg of loop with back edges
+    DataDependenceGraph* loopDDG = bigDDG_->createSubgraph(bb, true);
+
+    SimpleResourceManager* rm =
+        SimpleResourceManager::createRM(targetMachine, ii);
+    rm->setDDG(loopDDG);
+
+    // when only testing, do not really need the prolog rm.
+    SimpleResourceManager* prologRM =
+        SimpleResourceManager::createRM(targetMachine);
+    prologRM->setDDG(loopDDG);
+
+    int loopScheduled = -1;
+    try {
+        loopScheduled = sched.handleLoopDDG(
+            *loopDDG, *rm, targetMachine, bb.tripCount(), prologRM, true);
+    } catch(ModuleRunTimeError& err) {
+        if (Application::verboseLevel() > 0) {
+            Application::logStream() << "\tLoop Scheduling failed: " <<
+                err.errorMessageStack() << std::endl;
+        }
+        loopScheduled = -1;
+    }
+    SimpleResourceManager::disposeRM(rm);
+    SimpleResourceManager::disposeRM(prologRM);
+
+    delete loopDDG;
+    return loopScheduled;
+}
+
+/**
+ * Test-schedules the loop with each of the given IIs in its own forked
+ * worker process.
+ *
+ * The loop test schedules modify the shared procedure DDG, so the workers
+ * must not share it. Once an II is known to work, the workers still
+ * testing larger IIs are stopped.
+ *
+ * @param iis The IIs to test, in ascending order.
+ * @return The test results in the order of iis, LoopIISearch::CANCELLED for the
+ *         stopped workers. A worker that dies without reporting counts as
+ *         a failed test.
+ */
+std::vector<int>
+BBSchedulerController::testLoopIIsInWorkers(
+    TTAProgram::BasicBlock& bb, const TTAMachine::Machine& targetMachine,
+    BF2Scheduler& sched, const std::vector<unsigned int>& iis) {
+
+    std::vector<int> results(iis.size(), -1);
+    std::vector<pid_t> pids(iis.size(), -1);
+    std::vector<int> fds(iis.size(), -1);
+
+    // make sure the buffered output is not duplicated by the workers
+    std::cout.flush();
+    std::cerr.flush();
+    Application::logStream().flush();
+
+    for (std::size_t i = 0; i < iis.size(); ++i) {
+        int pipeFds[2];
+        if (pipe(pipeFds) != 0) {
+            // test the rest in this process
+            results[i] = testLoopII(bb, targetMachine, sched, iis[i]);
+            continue;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(pipeFds[0]);
+            close(pipeFds[1]);
+            results[i] = testLoopII(bb, targetMachine, sched, iis[i]);
+            continue;
+        } else if (pid == 0) {
+            // the worker, which must never return to the caller nor
+            // unwind its stack, whatever the test schedule throws
+            int status = 1;
+            try {
+                close(pipeFds[0]);
+                int result = testLoopII(bb, targetMachine, sched, iis[i]);
+                if (write(pipeFds[1], &result, sizeof(result)) ==
+                    sizeof(result)) {
+                    status = 0;
+                }
+                close(pipeFds[1]);
+                std::cout.flush();
+                std::cerr.flush();
+            } catch (...) {
+                // the parent sees the closed pipe as a failed test
+            }
+            // skip the destructors and atexit handlers of the compiler
+            _exit(status);
+        }
+        close(pipeFds[1]);
+        pids[i] = pid;
+        fds[i] = pipeFds[0];
+    }
+
+    bool pending = true;
+    while (pending) {
+        std::vector<pollfd> polled;
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < iis.size(); ++i) {
+            if (pids[i] < 0) {
+                continue;
+            }
+            pollfd pfd;
+            pfd.fd = fds[i];
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            polled.push_back(pfd);
+            indices.push_back(i);
+        }
+        pending = !polled.empty();
+        if (!pending) {
+            break;
+        }
+        if (poll(&polled[0], polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // cannot wait for the results, stop all the workers
+            for (std::size_t i = 0; i < iis.size(); ++i) {
+                if (pids[i] >= 0) {
+                    kill(pids[i], SIGKILL);
+                    close(fds[i]);
+                    waitpid(pids[i], NULL, 0);
+                    pids[i] = -1;
+                }
+            }
+            break;
+        }
+        for (std::size_t p = 0; p < polled.size(); ++p) {
+            const std::size_t i = indices[p];
+            if (pids[i] < 0 || polled[p].revents == 0) {
+                continue;
+            }
+            // EOF without a result means the worker died
+            int result = -1;
+            if (read(fds[i], &result, sizeof(result)) != sizeof(result)) {
+                result = -1;
+            }
+            results[i] = result;
+            close(fds[i]);
+            waitpid(pids[i], NULL, 0);
+            pids[i] = -1;
+
+            if (result < 0) {
+                continue;
+            }
+            // the larger IIs cannot improve on this one
+            for (std::size_t j = i + 1; j < iis.size(); ++j) {
+                if (pids[j] < 0) {
+                    continue;
+                }
+                kill(pids[j], SIGKILL);
+                close(fds[j]);
+                waitpid(pids[j], NULL, 0);
+                pids[j] = -1;
+                results[j] = LoopIISearch::CANCELLED;
+                if (Application::verboseLevel() > 0) {
+                    Application::logStream()
+                        << "Cancelled testing II=" << iis[j] << std::endl;
+                }
+            }
+        }
+    }
+    return results;
+}
+
+/**
+ * Returns the number of IIs to test concurrently in the loop II search.
+ *
+ * Forking is safe only when the scheduler itself is not running other
+ * threads, so this is 1 when procedures are scheduled in parallel.
+ */
+int
+BBSchedulerController::loopIIJobs() const {
+    SchedulerCmdLineOptions* options =
+        dynamic_cast<SchedulerCmdLineOptions*>(
+            Application::cmdLineOptions());
+    if (options == NULL ||
+        (options_ != NULL && options_->schedulerJobs() > 1)) {
+        return 1;
+    }
+    return options->loopIIJobs();
+}
+
 std::pair<unsigned int, unsigned int>
 BBSchedulerController::calculateII(
         const BasicBlockNode& bbn,  const TTAMachine::Machine& targetMachine) {
@@ -47,6 +47,7 @@ class SchedYieldEmitter;
 class LLVMTCECmdLineOptions;
 class DDGPass;
 class DataDependenceGraph;
+class BF2Scheduler;
 
 namespace TTAProgram {
     class Program;
@@ -113,6 +114,13 @@ protected:
         const BasicBlockNode& bbn,  const TTAMachine::Machine& targetMachine);
 
 private:
+    int testLoopII(
+        TTAProgram::BasicBlock& bb, const TTAMachine::Machine& targetMachine,
+        BF2Scheduler& sched, unsigned int ii);
+    std::vector<int> testLoopIIsInWorkers(
+        TTAProgram::BasicBlock& bb, const TTAMachine::Machine& targetMachine,
+        BF2Scheduler& sched, const std::vector<unsigned int>& iis);
+    int loopIIJobs() const;
     
     /// The currently scheduled procedure.
     TTAProgram::Procedure* scheduledProcedure_;
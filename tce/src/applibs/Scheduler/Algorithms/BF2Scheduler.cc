@@ -1178,7 +1178,8 @@ void BF2Scheduler::countLoopInvariantValueUsages() {
     invariants_.clear();
     invariantsOfCount_.clear();
 
-    static int iaCounter= 0;
+    // only needs to be unique within the maps rebuilt by this call
+    int iaCounter = 0;
     for (int i = 0; i < ddg().programOperationCount(); i++) {
         ProgramOperation& po = ddg().programOperation(i);
         const Operation& op = po.operation();
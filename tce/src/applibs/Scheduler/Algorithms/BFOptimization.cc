@@ -838,7 +838,7 @@ void BFOptimization::unassignCopyFromPrologEpilog(
     prologMoves_.erase(&mn);
 }
 
-std::map<MoveNode*, MoveNode*, MoveNode::Comparator>
+thread_local std::map<MoveNode*, MoveNode*, MoveNode::Comparator>
 BFOptimization::prologMoves_;
 
 void BFOptimization::clearPrologMoves() {
@@ -146,4 +146,4 @@ BFUnscheduleFromBody::operator()() {
     return true;
 }
 
-int BFUnscheduleFromBody::recurseCounter_ = 0;
+thread_local int BFUnscheduleFromBody::recurseCounter_ = 0;
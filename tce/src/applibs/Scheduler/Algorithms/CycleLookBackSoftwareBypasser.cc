@@ -786,6 +786,6 @@ CycleLookBackSoftwareBypasser::printStats() {
               << "\tTrigger too early aborts: " << triggerAbortCount_ << std::endl;
 }
 
-int CycleLookBackSoftwareBypasser::bypassCount_ = 0;
-int CycleLookBackSoftwareBypasser::deadResultCount_ = 0;
-int CycleLookBackSoftwareBypasser::triggerAbortCount_ = 0;
+std::atomic<int> CycleLookBackSoftwareBypasser::bypassCount_(0);
+std::atomic<int> CycleLookBackSoftwareBypasser::deadResultCount_(0);
+std::atomic<int> CycleLookBackSoftwareBypasser::triggerAbortCount_(0);
@@ -33,6 +33,7 @@
 #ifndef TTA_CYCLE_LOOK_BACK_SOFTWARE_BYPASSER_HH
 #define TTA_CYCLE_LOOK_BACK_SOFTWARE_BYPASSER_HH
 
+#include <atomic>
 #include <map>
 #include <set>
 
@@ -121,9 +122,9 @@ private:
 
     MoveNodeSelector* selector_;
 
-    static int bypassCount_;
-    static int deadResultCount_;
-    static int triggerAbortCount_;
+    static std::atomic<int> bypassCount_;
+    static std::atomic<int> deadResultCount_;
+    static std::atomic<int> triggerAbortCount_;
 };
 
 #endif
@@ -60,10 +60,13 @@ InterPassData::~InterPassData() {
  */
 InterPassDatum&
 InterPassData::datum(const std::string& key) {
-    if (!MapTools::containsKey(data_, key))
+    std::lock_guard<std::mutex> guard(lock_);
+    std::map<std::string, InterPassDatum*>::const_iterator i =
+        data_.find(key);
+    if (i == data_.end())
         throw KeyNotFound(__FILE__, __LINE__, __func__);
 
-    return *data_[key];
+    return *i->second;
 }
 
 /**
@@ -73,6 +76,7 @@ InterPassData::datum(const std::string& key) {
  */
 bool
 InterPassData::hasDatum(const std::string& key) const {
+    std::lock_guard<std::mutex> guard(lock_);
     return MapTools::containsKey(data_, key);
 }
 
@@ -88,6 +92,7 @@ InterPassData::hasDatum(const std::string& key) const {
 void
 InterPassData::setDatum(const std::string& key, InterPassDatum* datum) {
 
+    std::lock_guard<std::mutex> guard(lock_);
     if (MapTools::containsKey(data_, key))
         delete data_[key];
     data_[key] = datum;
@@ -95,6 +100,7 @@ InterPassData::setDatum(const std::string& key, InterPassDatum* datum) {
 
 void
 InterPassData::removeDatum(const std::string& key) {
+    std::lock_guard<std::mutex> guard(lock_);
     if (MapTools::containsKey(data_, key)) {
         delete data_[key];
         data_.erase(key);
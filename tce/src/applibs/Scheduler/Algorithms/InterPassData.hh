@@ -34,6 +34,7 @@
 #define TTA_INTER_PASS_DATA_HH
 
 #include <map>
+#include <mutex>
 #include <string>
 #include "Exception.hh"
 
@@ -44,6 +45,9 @@ class InterPassDatum;
  *
  * Provides a generic "key-value" interface and shortcut methods for
  * accessing the most frequently used data.
+ *
+ * The container itself is safe to access from several scheduler threads;
+ * the returned datum objects are not locked.
  */
 class InterPassData {
 public:
@@ -57,6 +61,8 @@ public:
 private:
     /// container for the data
     std::map<std::string, InterPassDatum*> data_;
+    /// guards data_ against concurrent scheduler threads
+    mutable std::mutex lock_;
 };
 
 #endif
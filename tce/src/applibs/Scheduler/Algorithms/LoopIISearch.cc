@@ -0,0 +1,153 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file LoopIISearch.cc
+ *
+ * Definition of LoopIISearch class.
+ *
+ * @note rating: red
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "LoopIISearch.hh"
+
+const int LoopIISearch::CANCELLED = INT_MIN;
+
+/**
+ * Searches the II by testing one II at a time.
+ *
+ * The tested II splits the remaining range at one third, as the smaller
+ * IIs are the more likely to fail quickly.
+ *
+ * @param test Test-schedules the loop with an II.
+ * @param iiMin Smallest possible II, updated to the smallest working II.
+ * @param iiMax Largest II to try, updated to the end of the search range.
+ */
+void
+LoopIISearch::searchSerially(
+    const IITester& test, unsigned int& iiMin, unsigned int& iiMax) {
+
+    unsigned int smallestSuccess = INT_MAX;
+    int tryCount = 0;
+    while (iiMin <= iiMax) {
+
+        // split the search range by half.
+        unsigned int ii = (iiMin*2 + iiMax)/3;
+
+        // Do not binary search with a max that is not working schedule.
+        // Try the max on second round instead to fail quickly
+        // when there is no solution.
+        if (tryCount && smallestSuccess == INT_MAX) {
+            ii = iiMax;
+        }
+
+        // Have we already tested this and found that it works?
+        // Don't test again!
+        if (ii == smallestSuccess) {
+            break;
+        }
+
+        narrowRange(test(ii), ii, iiMin, iiMax, smallestSuccess);
+        tryCount++;
+    }
+}
+
+/**
+ * Searches the II by testing several IIs of the search range per round.
+ *
+ * The results of each round are applied in the ascending II order, in the
+ * same way as in the serial search, so the outcome does not depend on the
+ * order the tests finish in.
+ *
+ * @param test Test-schedules the loop with each II of a round.
+ * @param jobs Number of IIs to test per round.
+ * @param iiMin Smallest possible II, updated to the smallest working II.
+ * @param iiMax Largest II to try, updated to the end of the search range.
+ */
+void
+LoopIISearch::searchInBatches(
+    const IIBatchTester& test, int jobs, unsigned int& iiMin,
+    unsigned int& iiMax) {
+
+    unsigned int smallestSuccess = INT_MAX;
+    while (iiMin <= iiMax) {
+        // do not test again the II that is already known to work.
+        unsigned int high = (iiMax == smallestSuccess) ? iiMax - 1 : iiMax;
+        if (high < iiMin || high == UINT_MAX) {
+            break;
+        }
+        // spread the tested IIs evenly over the range, including both
+        // ends. The upper end fails quickly when there is no solution.
+        unsigned int count = std::min((unsigned int)jobs, high - iiMin + 1);
+        std::vector<unsigned int> iis;
+        if (count == 1) {
+            iis.push_back(iiMin);
+        } else {
+            for (unsigned int j = 0; j < count; ++j) {
+                iis.push_back(iiMin + (high - iiMin) * j / (count - 1));
+            }
+        }
+
+        std::vector<int> results = test(iis);
+
+        for (std::size_t i = 0; i < iis.size(); ++i) {
+            if (results[i] == CANCELLED ||
+                iis[i] < iiMin || iis[i] > iiMax) {
+                continue;
+            }
+            narrowRange(results[i], iis[i], iiMin, iiMax, smallestSuccess);
+        }
+    }
+}
+
+/**
+ * Narrows the II search range with the result of one test schedule.
+ *
+ * @param loopScheduled Result of the test schedule.
+ * @param ii The tested II.
+ * @param iiMin Smallest II not known to fail.
+ * @param iiMax Largest II worth trying.
+ * @param smallestSuccess Smallest II known to work.
+ */
+void
+LoopIISearch::narrowRange(
+    int loopScheduled, unsigned int ii, unsigned int& iiMin,
+    unsigned int& iiMax, unsigned int& smallestSuccess) {
+
+    // loop scheduler was slower than ordinary scheduler?
+    if (loopScheduled == 0) {
+        iiMax = ii -1;
+        smallestSuccess = ii;
+    } else {
+        // failed.
+        if (loopScheduled < 0) {
+            iiMin = ii+1;
+        } else { // ok.
+            iiMax = ii;
+            smallestSuccess = ii;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file LoopIISearch.hh
+ *
+ * Declaration of LoopIISearch class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_LOOP_II_SEARCH_HH
+#define TTA_LOOP_II_SEARCH_HH
+
+#include <functional>
+#include <vector>
+
+/**
+ * Searches the smallest initiation interval a loop can be scheduled with.
+ *
+ * The searches only decide which IIs to test. The test schedules are done
+ * by the given callbacks, which return the result of
+ * BF2Scheduler::handleLoopDDG() in test mode: negative if the loop could
+ * not be scheduled with the II, zero if the loop schedule was slower than
+ * the ordinary one.
+ */
+class LoopIISearch {
+public:
+    /// Test-schedules the loop with one II.
+    typedef std::function<int(unsigned int)> IITester;
+    /// Test-schedules the loop with each of the IIs given in ascending
+    /// order, returns the results in the same order.
+    typedef std::function<std::vector<int>(const std::vector<unsigned int>&)>
+    IIBatchTester;
+
+    /// Result of an II test that was stopped as no longer needed.
+    static const int CANCELLED;
+
+    static void searchSerially(
+        const IITester& test, unsigned int& iiMin, unsigned int& iiMax);
+    static void searchInBatches(
+        const IIBatchTester& test, int jobs, unsigned int& iiMin,
+        unsigned int& iiMax);
+
+private:
+    static void narrowRange(
+        int loopScheduled, unsigned int ii, unsigned int& iiMin,
+        unsigned int& iiMax, unsigned int& smallestSuccess);
+};
+
+#endif
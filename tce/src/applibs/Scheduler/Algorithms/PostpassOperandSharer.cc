@@ -227,8 +227,8 @@ void PostpassOperandSharer::printStats() {
     
 }
 
-unsigned int PostpassOperandSharer::moveCount_ = 0;
-unsigned int PostpassOperandSharer::operandCount_ = 0;
-unsigned int PostpassOperandSharer::removedOperands_ = 0;
-unsigned int PostpassOperandSharer::registerReads_ = 0;
-unsigned int PostpassOperandSharer::triggerCannotRemove_ = 0;
+std::atomic<unsigned int> PostpassOperandSharer::moveCount_(0);
+std::atomic<unsigned int> PostpassOperandSharer::operandCount_(0);
+std::atomic<unsigned int> PostpassOperandSharer::removedOperands_(0);
+std::atomic<unsigned int> PostpassOperandSharer::registerReads_(0);
+std::atomic<unsigned int> PostpassOperandSharer::triggerCannotRemove_(0);
@@ -85,16 +85,20 @@ RegisterRenamer::initialize() {
     TTAMachine::Machine::RegisterFileNavigator regNav =
         machine_.registerFileNavigator();
 
-    std::map<const TTAMachine::Machine*, 
-        std::vector <TTAMachine::RegisterFile*> >::iterator trCacheIter =
-        tempRegFileCache_.find(&machine_);
-
-    if (trCacheIter == tempRegFileCache_.end()) {
-        tempRegFiles_ = MachineConnectivityCheck::tempRegisterFiles(machine_);
-        tempRegFileCache_[&machine_] = 
-            tempRegFiles_;
-    } else {
-        tempRegFiles_ = trCacheIter->second;
+    {
+        std::lock_guard<std::mutex> guard(tempRegFileCacheLock_);
+        std::map<const TTAMachine::Machine*, 
+            std::vector <TTAMachine::RegisterFile*> >::iterator trCacheIter =
+            tempRegFileCache_.find(&machine_);
+
+        if (trCacheIter == tempRegFileCache_.end()) {
+            tempRegFiles_ =
+                MachineConnectivityCheck::tempRegisterFiles(machine_);
+            tempRegFileCache_[&machine_] = 
+                tempRegFiles_;
+        } else {
+            tempRegFiles_ = trCacheIter->second;
+        }
     }
 
     for (int i = 0; i < regNav.count(); i++) {
@@ -1032,3 +1036,5 @@ RegisterRenamer::findConnectedRFs(LiveRange& lr, bool allowLimm) {
 /// To avoid reanalysing machine every time hen new rr created.
 std::map<const TTAMachine::Machine*, std::vector <TTAMachine::RegisterFile*> >
 RegisterRenamer::tempRegFileCache_;
+
+std::mutex RegisterRenamer::tempRegFileCacheLock_;
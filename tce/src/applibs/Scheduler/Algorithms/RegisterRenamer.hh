@@ -34,6 +34,7 @@
 #define TTA_REGISTER_RENAMER_HH
 
 #include <climits>
+#include <mutex>
 
 #include "TCEString.hh"
 #include <set>
@@ -138,6 +139,7 @@ private:
 
     static std::map<const TTAMachine::Machine*, 
                     std::vector <TTAMachine::RegisterFile*> >tempRegFileCache_;
+    static std::mutex tempRegFileCacheLock_;
     std::vector <TTAMachine::RegisterFile*> tempRegFiles_;
 
     const TTAMachine::Machine& machine_;
@@ -490,6 +490,11 @@ ResourceConstraintAnalyzer::analyzeRegisterAntideps(
 
     delete trueDepGraph3; 
 
+    // the loop below checks for a true dependence path for every register
+    // antidep of the DDG, the true dependence graph does not change so
+    // build its reachability index once
+    trueDepGraph->findAllPaths();
+
     std::map<int, int> foundCounts;
 
     bool restrictingEdgeFound = false;
@@ -99,6 +99,11 @@ DataDependenceGraph::~DataDependenceGraph() {
             delete &node(i, false);
         }
         programOperations_.clear();
+    } else {
+        // nodes are owned by the root graph and outlive this subgraph
+        for (int i = 0; i < nodeCount(); i++) {
+            node(i, false).removeCycleListener(*this);
+        }
     }
     if (ownedBBN_ != NULL) {
         delete ownedBBN_;
@@ -143,6 +148,8 @@ DataDependenceGraph::addNode(MoveNode& moveNode) {
     if (moveNode.isMove()) {
         nodesOfMoves_[&moveNode.move()] = &moveNode;
     }
+    moveNode.addCycleListener(*this);
+    indexNode(moveNode);
 }
 
 /**
@@ -649,15 +656,70 @@ DataDependenceGraph::NodeSet
 DataDependenceGraph::movesAtCycle(int cycle) const {
 
     NodeSet moves;
-    for (int i = 0; i < nodeCount(); ++i) {
-        Node& n = node(i);
-        if (n.isScheduled() && n.cycle() == cycle)
-            moves.insert(&n);
+    CycleNodeMap::const_iterator bucket = nodesAtCycles_.find(cycle);
+    if (bucket == nodesAtCycles_.end()) {
+        return moves;
+    }
+    const NodeSet& placed = bucket->second;
+    for (NodeSet::const_iterator i = placed.begin(); i != placed.end(); ++i) {
+        if ((*i)->isScheduled())
+            moves.insert(*i);
     }
 
     return moves;
 }
 
+/**
+ * Adds a placed node to the cycle buckets.
+ *
+ * @param node The node. Nothing is done if it is not placed.
+ */
+void
+DataDependenceGraph::indexNode(MoveNode& node) {
+    if (node.isPlaced()) {
+        nodesAtCycles_[node.cycle()].insert(&node);
+    }
+}
+
+/**
+ * Removes a node from the cycle buckets.
+ *
+ * @param node The node. Nothing is done if it is not placed.
+ */
+void
+DataDependenceGraph::unindexNode(MoveNode& node) {
+    if (node.isPlaced()) {
+        nodeUnplaced(node, node.cycle());
+    }
+}
+
+/**
+ * Called by a node of the graph when it has been placed to a cycle.
+ *
+ * @param node The placed node.
+ */
+void
+DataDependenceGraph::nodePlaced(MoveNode& node) {
+    indexNode(node);
+}
+
+/**
+ * Called by a node of the graph when its cycle has been unset.
+ *
+ * @param node The node which is not placed anymore.
+ * @param oldCycle The cycle the node was placed in.
+ */
+void
+DataDependenceGraph::nodeUnplaced(MoveNode& node, int oldCycle) {
+    CycleNodeMap::iterator bucket = nodesAtCycles_.find(oldCycle);
+    if (bucket != nodesAtCycles_.end()) {
+        bucket->second.erase(&node);
+        if (bucket->second.empty()) {
+            nodesAtCycles_.erase(bucket);
+        }
+    }
+}
+
 /**
  * Returns the MoveNode that defines (writes the value of) the guard
  * the given move node is predicated with. If there are multiple,
@@ -705,6 +767,49 @@ DataDependenceGraph::guardDefMoves(const MoveNode& moveNode) {
     return guardDefMoves;
 }
 
+/**
+ * Tells whether the given move reads the given register as its source.
+ *
+ * @param n The move node.
+ * @param rf The register file.
+ * @param registerIndex Index of the register.
+ * @return True if the source of the move is the register.
+ */
+static bool
+readsRegister(
+    const MoveNode& n, const TTAMachine::BaseRegisterFile& rf,
+    int registerIndex) {
+
+    const TTAProgram::Terminal& source = n.move().source();
+    const TTAMachine::BaseRegisterFile* currentRF = NULL;
+    if (source.isImmediateRegister())
+        currentRF = &source.immediateUnit();
+    else if (source.isGPR())
+        currentRF = &source.registerFile();
+    else
+        return false;
+
+    return &rf == currentRF && source.index() == registerIndex;
+}
+
+/**
+ * Tells whether the given move writes the given register.
+ *
+ * @param n The move node.
+ * @param rf The register file.
+ * @param registerIndex Index of the register.
+ * @return True if the destination of the move is the register.
+ */
+static bool
+writesRegister(
+    const MoveNode& n, const TTAMachine::BaseRegisterFile& rf,
+    int registerIndex) {
+
+    const TTAProgram::Terminal& destination = n.move().destination();
+    return destination.isGPR() && &rf == &destination.registerFile() &&
+        destination.index() == registerIndex;
+}
+
 /**
  * Returns the MoveNode with highest cycle that reads the given register.
  *
@@ -718,31 +823,19 @@ DataDependenceGraph::lastScheduledRegisterRead(
     int registerIndex,
     int lastCycleToTest) const {
 
-    int lastCycle = -1;
-    MoveNode* lastFound = NULL;
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& source = n.move().source();
-        if (!n.isScheduled() || 
-            !(source.isImmediateRegister() || source.isGPR())) 
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-        if (source.isImmediateRegister())
-            currentRF = &source.immediateUnit();
-        else
-            currentRF = &source.registerFile();
-
-        if (&rf == currentRF && 
-            source.index() == registerIndex &&
-            n.cycle() > lastCycle &&
-            n.cycle() <= lastCycleToTest) {
-            lastCycle = n.cycle();
-            lastFound = &n;
+    for (CycleNodeMap::const_reverse_iterator c(
+             nodesAtCycles_.upper_bound(lastCycleToTest));
+         c != nodesAtCycles_.rend() && c->first > -1; ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && readsRegister(n, rf, registerIndex)) {
+                return &n;
+            }
         }
     }
-    return lastFound;
+    return NULL;
 }
 
 /**
@@ -759,31 +852,19 @@ DataDependenceGraph::firstScheduledRegisterRead(
     const TTAMachine::BaseRegisterFile& rf, 
     int registerIndex, int firstCycleToTest) const {
 
-    int firstCycle = INT_MAX;
-    MoveNode* firstFound = NULL;
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& source = n.move().source();
-        if (!n.isScheduled() || 
-            !(source.isImmediateRegister() || source.isGPR())) 
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-        if (source.isImmediateRegister())
-            currentRF = &source.immediateUnit();
-        else
-            currentRF = &source.registerFile();
-
-        if (&rf == currentRF && 
-            source.index() == registerIndex &&
-            n.cycle() < firstCycle &&
-            n.cycle() >= firstCycleToTest) {
-            firstCycle = n.cycle();
-            firstFound = &n;
+    for (CycleNodeMap::const_iterator c =
+             nodesAtCycles_.lower_bound(firstCycleToTest);
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && readsRegister(n, rf, registerIndex)) {
+                return &n;
+            }
         }
     }
-    return firstFound;
+    return NULL;
 }
 
 /**
@@ -797,26 +878,18 @@ MoveNode*
 DataDependenceGraph::firstScheduledRegisterWrite(
     const TTAMachine::BaseRegisterFile& rf, int registerIndex) const {
 
-    int firstCycle = INT_MAX;
-    MoveNode* firstFound = NULL;
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& destination = n.move().destination();
-        if (!n.isScheduled() || !destination.isGPR()) 
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-        currentRF = &destination.registerFile();
-
-        if (&rf == currentRF && 
-            destination.index() == registerIndex &&
-            n.cycle() < firstCycle) {
-            firstCycle = n.cycle();
-            firstFound = &n;
+    for (CycleNodeMap::const_iterator c = nodesAtCycles_.begin();
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && writesRegister(n, rf, registerIndex)) {
+                return &n;
+            }
         }
     }
-    return firstFound;
+    return NULL;
 }
 
 /**
@@ -1034,24 +1107,14 @@ DataDependenceGraph::lastScheduledRegisterReads(
     int killCycle = lastKill == NULL ? -1 : lastKill->cycle();
     NodeSet lastReads;
 
-    // first search last kill.
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& source = n.move().source();
-        if (!n.isScheduled() || 
-            !(source.isImmediateRegister() || source.isGPR())) 
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-        if (source.isImmediateRegister())
-            currentRF = &source.immediateUnit();
-        else
-            currentRF = &source.registerFile();
-
-        if (&rf == currentRF && 
-            source.index() == registerIndex) {
-            if (n.cycle() > killCycle) {
+    for (CycleNodeMap::const_iterator c =
+             nodesAtCycles_.upper_bound(killCycle);
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && readsRegister(n, rf, registerIndex)) {
                 lastReads.insert(&n);
             }
         }
@@ -1076,24 +1139,28 @@ DataDependenceGraph::lastScheduledRegisterGuardReads(
     int killCycle = lastKill == NULL ? -1 : lastKill->cycle();
     NodeSet lastGuards;
 
-    // first search last kill.
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-        TTAProgram::Move& move = n.move();
-        if (move.isUnconditional() || !n.isScheduled()) {
-            continue;
-        }
+    for (CycleNodeMap::const_iterator c =
+             nodesAtCycles_.upper_bound(killCycle);
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            TTAProgram::Move& move = n.move();
+            if (move.isUnconditional() || !n.isScheduled()) {
+                continue;
+            }
 
-        const TTAMachine::Guard* guard = &move.guard().guard();
-        const TTAMachine::RegisterGuard* rg =
-            dynamic_cast<const TTAMachine::RegisterGuard*>(guard);
-        if (rg == NULL) {
-            continue;
-        }
-        const TTAMachine::BaseRegisterFile* currentRF = rg->registerFile();
-        if (&rf == currentRF && 
-            rg->registerIndex() == registerIndex) {
-            if (n.cycle() > killCycle) {
+            const TTAMachine::Guard* guard = &move.guard().guard();
+            const TTAMachine::RegisterGuard* rg =
+                dynamic_cast<const TTAMachine::RegisterGuard*>(guard);
+            if (rg == NULL) {
+                continue;
+            }
+            const TTAMachine::BaseRegisterFile* currentRF =
+                rg->registerFile();
+            if (&rf == currentRF && 
+                rg->registerIndex() == registerIndex) {
                 lastGuards.insert(&n);
             }
         }
@@ -1116,27 +1183,21 @@ DataDependenceGraph::lastScheduledRegisterWrites(
 
     MoveNode* lastKill = lastScheduledRegisterKill(rf, registerIndex);
     int killCycle = lastKill == NULL ? -1 : lastKill->cycle();
-    NodeSet lastReads;
-
-    // first search last kill.
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& dest = n.move().destination();
-        if (!n.isScheduled() || !dest.isGPR())
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-            currentRF = &dest.registerFile();
-
-        if (&rf == currentRF && 
-            dest.index() == registerIndex) {
-            if (n.cycle() >= killCycle) {
-                lastReads.insert(&n);
+    NodeSet lastWrites;
+
+    for (CycleNodeMap::const_iterator c =
+             nodesAtCycles_.lower_bound(killCycle);
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && writesRegister(n, rf, registerIndex)) {
+                lastWrites.insert(&n);
             }
         }
     }
-    return lastReads;
+    return lastWrites;
 }
 
 /**
@@ -1158,20 +1219,13 @@ DataDependenceGraph::firstScheduledRegisterWrites(
     int killCycle = firstKill == NULL ? INT_MAX : firstKill->cycle();
     NodeSet firstWrites;
 
-    // first search last kill.
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& dest = n.move().destination();
-        if (!n.isScheduled() || !dest.isGPR())
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-            currentRF = &dest.registerFile();
-
-        if (&rf == currentRF && 
-            dest.index() == registerIndex) {
-            if (n.cycle() <= killCycle) {
+    for (CycleNodeMap::const_iterator c = nodesAtCycles_.begin();
+         c != nodesAtCycles_.upper_bound(killCycle); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && writesRegister(n, rf, registerIndex)) {
                 firstWrites.insert(&n);
             }
         }
@@ -1191,27 +1245,19 @@ MoveNode*
 DataDependenceGraph::lastScheduledRegisterKill(
     const TTAMachine::BaseRegisterFile& rf, int registerIndex) const {
 
-    int lastCycle = -1;
-    MoveNode* lastFound = NULL;
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& dest = n.move().destination();
-        if (!n.isScheduled() || !dest.isGPR())
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-            currentRF = &dest.registerFile();
-
-        if (&rf == currentRF && 
-            dest.index() == registerIndex &&
-            n.cycle() > lastCycle &&
-            n.move().isUnconditional()) {
-            lastCycle = n.cycle();
-            lastFound = &n;
+    for (CycleNodeMap::const_reverse_iterator c(nodesAtCycles_.rbegin());
+         c != nodesAtCycles_.rend() && c->first > -1; ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && writesRegister(n, rf, registerIndex) &&
+                n.move().isUnconditional()) {
+                return &n;
+            }
         }
     }
-    return lastFound;
+    return NULL;
 }
 
 /**
@@ -1225,27 +1271,19 @@ MoveNode*
 DataDependenceGraph::firstScheduledRegisterKill(
     const TTAMachine::BaseRegisterFile& rf, int registerIndex) const {
 
-    int firstCycle = INT_MAX;
-    MoveNode* firstFound = NULL;
-    for (int i = 0; i < nodeCount(); ++i) {
-        MoveNode& n = node(i);
-
-        TTAProgram::Terminal& dest = n.move().destination();
-        if (!n.isScheduled() || !dest.isGPR())
-            continue;
-
-        const TTAMachine::BaseRegisterFile* currentRF = NULL;
-            currentRF = &dest.registerFile();
-
-        if (&rf == currentRF && 
-            dest.index() == registerIndex &&
-            n.cycle() < firstCycle &&
-            n.move().isUnconditional()) {
-            firstCycle = n.cycle();
-            firstFound = &n;
+    for (CycleNodeMap::const_iterator c = nodesAtCycles_.begin();
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            MoveNode& n = **i;
+            if (n.isScheduled() && writesRegister(n, rf, registerIndex) &&
+                n.move().isUnconditional()) {
+                return &n;
+            }
         }
     }
-    return firstFound;
+    return NULL;
 }
 
 
@@ -1278,10 +1316,14 @@ DataDependenceGraph::NodeSet
 DataDependenceGraph::scheduledMoves() const {
 
     NodeSet moves;
-    for (int i = 0; i < nodeCount(); ++i) {
-        Node& n = node(i);
-        if (n.isScheduled())
-            moves.insert(&n);
+    for (CycleNodeMap::const_iterator c = nodesAtCycles_.begin();
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            if ((*i)->isScheduled())
+                moves.insert(*i);
+        }
     }
 
     return moves;
@@ -1699,59 +1741,62 @@ DataDependenceGraph::writeToXMLFile(std::string fileName) const {
 /**
  * Returns the smallest cycle of a move in the DDG.
  *
- * Current implementation is quite slow, so don't call in critical places.
- *
  * @return The smallest cycle of a move.
  */
 int
 DataDependenceGraph::smallestCycle() const {
 
-    int minCycle = INT_MAX;
-    for (int i = 0; i < nodeCount(); ++i) {
-        Node& n = node(i);
-        if (n.isScheduled())
-            minCycle = std::min(minCycle, n.cycle());
+    for (CycleNodeMap::const_iterator c = nodesAtCycles_.begin();
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            if ((*i)->isScheduled())
+                return c->first;
+        }
     }
 
-    return minCycle;
+    return INT_MAX;
 }
 
 /**
  * Returns the largest cycle of a move in the DDG.
  *
- * Current implementation is quite slow, so don't call in critical places.
- *
  * @return The largest cycle of a move.
  */
 int
 DataDependenceGraph::largestCycle() const {
 
-    int maxCycle = 0;
-    for (int i = 0; i < nodeCount(); ++i) {
-        Node& n = node(i);
-        if (n.isScheduled()) {
-            maxCycle = std::max(maxCycle, n.cycle());
+    for (CycleNodeMap::const_reverse_iterator c = nodesAtCycles_.rbegin();
+         c != nodesAtCycles_.rend() && c->first > 0; ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            if ((*i)->isScheduled())
+                return c->first;
         }
     }
 
-    return maxCycle;
+    return 0;
 }
 
 /**
  * Returns the count of nodes in the graph that have been scheduled.
  *
- * Current implementation is quite slow, so don't call in critical places.
- *
  * @return The count of scheduled nodes.
  */
 int
 DataDependenceGraph::scheduledNodeCount() const {
 
     int scheduledCount = 0;
-    for (int i = 0; i < nodeCount(); ++i) {
-        Node& n = node(i);
-        if (n.isScheduled()) 
-            ++scheduledCount;
+    for (CycleNodeMap::const_iterator c = nodesAtCycles_.begin();
+         c != nodesAtCycles_.end(); ++c) {
+        const NodeSet& placed = c->second;
+        for (NodeSet::const_iterator i = placed.begin(); i != placed.end();
+             ++i) {
+            if ((*i)->isScheduled()) 
+                ++scheduledCount;
+        }
     }
 
     return scheduledCount;
@@ -2607,6 +2652,42 @@ DataDependenceGraph::deleteNode(MoveNode& node) {
     delete &node;
 }
 
+/**
+ * Removes a node from this subgraph, leaving it to the parent graph.
+ *
+ * @param node MoveNode being dropped.
+ */
+void
+DataDependenceGraph::dropNode(MoveNode& node) {
+    if (hasNode(node)) {
+        unindexNode(node);
+        node.removeCycleListener(*this);
+    }
+    BoostGraph<MoveNode, DataDependenceEdge>::dropNode(node);
+}
+
+/**
+ * Removes a node from the graph and the related graphs of the subgraph
+ * tree.
+ *
+ * Also called when the removal is propagated from a parent or a child graph,
+ * so the cycle bookkeeping is updated here.
+ *
+ * @param node MoveNode being removed.
+ * @param modifierGraph The graph which initiated the removal.
+ */
+void
+DataDependenceGraph::removeNode(
+    MoveNode& node,
+    BoostGraph<MoveNode, DataDependenceEdge>* modifierGraph) {
+    if (hasNode(node)) {
+        unindexNode(node);
+        node.removeCycleListener(*this);
+    }
+    BoostGraph<MoveNode, DataDependenceEdge>::removeNode(
+        node, modifierGraph);
+}
+
 /**
  * Calculates a weight value for edges, to be used for 
  * path weight calculation for selector
@@ -4891,6 +4972,9 @@ DataDependenceGraph::removeIncomingGuardEdges(MoveNode& node) {
         DataDependenceEdge& edge = *graph_[ed];
         if (edge.guardUse() && edge.dependenceType() == 
             DataDependenceEdge::DEP_RAW) {
+            if (!edge.isBackEdge()) {
+                invalidatePathCache();
+            }
             boost::remove_edge(*ei, graph_);
 
             // removing messes up the iterator. start again from first.
@@ -4921,6 +5005,9 @@ DataDependenceGraph::removeOutgoingGuardWarEdges(MoveNode& node) {
         DataDependenceEdge& edge = *graph_[ed];
         if (edge.guardUse() && edge.dependenceType() == 
             DataDependenceEdge::DEP_WAR) {
+            if (!edge.isBackEdge()) {
+                invalidatePathCache();
+            }
             boost::remove_edge(*ei, graph_);
 
             // removing messes up the iterator. start again from first.
@@ -65,7 +65,8 @@ namespace TTAProgram {
 }
 
 class DataDependenceGraph : 
-    public BoostGraph<MoveNode, DataDependenceEdge> {
+    public BoostGraph<MoveNode, DataDependenceEdge>,
+    private MoveNode::CycleListener {
 public:
 
     struct UndoData {
@@ -227,6 +228,7 @@ public:
 
     void removeNode(MoveNode& node);
     void deleteNode(MoveNode& node);
+    virtual void dropNode(MoveNode& node);
 
     void setEdgeWeightHeuristics(EdgeWeightHeuristics ewh) {
         if (edgeWeightHeuristics_ != ewh) {
@@ -378,6 +380,15 @@ public:
     EdgeSet operationInEdges(const MoveNode& node) const;
 private:
 
+    virtual void removeNode(
+        MoveNode& node,
+        BoostGraph<MoveNode, DataDependenceEdge>* modifierGraph);
+
+    virtual void nodePlaced(MoveNode& node);
+    virtual void nodeUnplaced(MoveNode& node, int oldCycle);
+    void indexNode(MoveNode& node);
+    void unindexNode(MoveNode& node);
+
     bool queueRawPredecessors(
         NodeSet& queue, NodeSet& finalDest, NodeSet& predQueue,
         NodeSet& predFinalDest, bool guard) const;
@@ -406,6 +417,12 @@ private:
     POList programOperations_;
     std::map<const MoveNode*, BasicBlockNode*> moveNodeBlocks_;
 
+    /// The placed nodes of this graph bucketed by their cycles. Kept up to
+    /// date through the cycle listener interface of the nodes so cycle
+    /// based queries do not need to go through all the nodes.
+    typedef std::map<int, NodeSet> CycleNodeMap;
+    CycleNodeMap nodesAtCycles_;
+
     /// Dot printing related variables.
     /// Group the printed MoveNodes according to their cycles.
     bool cycleGrouping_;
@@ -39,6 +39,8 @@ IGNORE_COMPILER_WARNING("-Wunused-parameter")
 #include <llvm/CodeGen/MachineInstr.h>
 #include <llvm/CodeGen/MachineMemOperand.h>
 
+#include <deque>
+
 #include "AssocTools.hh"
 #include "ContainerTools.hh"
 #include "TCEString.hh"
@@ -2203,38 +2205,6 @@ DataDependenceGraphBuilder::iterateBBs(
     }
 }
 
-/**
- * Updates bookkeeping used for calculating register deaths.
- *
- * Marks registers used at or after some BB to it's predecessor BB's.
- *
- * @param bbd basic block to process.
- * @param firstTime whether this BB is analyzer for the first time.
- */
-void
-DataDependenceGraphBuilder::updatePreceedingRegistersUsedAfter(
-    BBData& bbd, bool firstTime) {
-    BasicBlockNode& bbn = *bbd.bblock_;
-    BasicBlock& bb = bbn.basicBlock();
-    BasicBlockNodeSet predecessors = cfg_->predecessors(bbn);
-    for (BasicBlockNodeSet::iterator predIter = predecessors.begin();
-         predIter != predecessors.end(); predIter++) {
-        BasicBlockNode* pred = *predIter;
-        BasicBlock& predBB = pred->basicBlock();
-        BBData& predData = *bbData_[pred];
-        size_t size = predBB.liveRangeData_->registersUsedAfter_.size();
-        AssocTools::append(
-            bb.liveRangeData_->registersUsedInOrAfter_, predBB.liveRangeData_->registersUsedAfter_);
-
-        // if updated, need to be handled again.
-        if (predBB.liveRangeData_->registersUsedAfter_.size() > size || firstTime) {
-            if (predData.state_ != BB_QUEUED) {
-                changeState(predData, BB_QUEUED);
-            }
-        }
-    }
-}
-
 /**
  * Sets outgoing data from this BB to incoming data of successors.
  *
@@ -2693,106 +2663,167 @@ void DataDependenceGraphBuilder::updateMemUse(
  *
  * This information is used for checking whether given register contains
  * live value at given cycle.
+ *
+ * Solves the backward liveness equations
+ *
+ *   usedInOrAfter(bb) = firstUses(bb) + (usedAfter(bb) - kills(bb))
+ *   usedAfter(pred) = union of usedInOrAfter of its successors
+ *
+ * with a worklist over dense register bitsets. The registers of the
+ * procedure are numbered once, so the fixpoint iteration does word-wide
+ * set operations instead of string set lookups. The results are stored
+ * in the string sets of LiveRangeData used by the rest of the scheduler.
  */
 void
 DataDependenceGraphBuilder::searchRegisterDeaths() {
 
-    // initializes states of all BB's to unreached.
-    initializeBBStates();
+    const int bbCount = cfg_->nodeCount();
+    RegisterIndex registers;
+    std::vector<RegisterBits> firstUses(bbCount);
+    std::vector<RegisterBits> kills(bbCount);
+    std::vector<RegisterBits> usedInOrAfter(bbCount);
+    std::vector<RegisterBits> usedAfter(bbCount);
+    std::vector<std::vector<int> > predecessors(bbCount);
 
-    // start from end of cfg. (sink nodes), queue them
-    ControlFlowGraph::NodeSet lastBBs = cfg_->sinkNodes();
-    for (ControlFlowGraph::NodeSet::iterator iter =
-             lastBBs.begin(); iter != lastBBs.end(); iter++) {
-        changeState(*(bbData_[*iter]), BB_QUEUED);
+    std::map<const BasicBlockNode*, int> bbIndices;
+    for (int bbi = 0; bbi < bbCount; bbi++) {
+        bbIndices[&cfg_->node(bbi)] = bbi;
     }
 
-    // then iterate over all BB's, going from BB to it's
-    // predecessors.
-    iterateRegisterDeaths();
-
-    // all should have gone thru, but if there are 4ever loop causing
-    // BB's not reachable from the end.
-    // we might want to handle those also.
-    while (!blocksByState_[BB_UNREACHED].empty()) {
-        if (Application::verboseLevel() > Application::VERBOSE_LEVEL_DEFAULT) {
-            Application::logStream() << "Warning: BB in 4ever loop!"
-                                     << std::endl;
-            Application::logStream() << "In procedure: " << cfg_->name() <<
-                std::endl;
-//            cfg.writeToDotFile("4everloop_bb.dot");
+    for (int bbi = 0; bbi < bbCount; bbi++) {
+        BasicBlockNode& bbn = cfg_->node(bbi);
+        BasicBlock& bb = bbn.basicBlock();
+        if (bb.liveRangeData_ == NULL) {
+            bb.liveRangeData_ = new LiveRangeData;
         }
-        changeState(**blocksByState_[BB_UNREACHED].begin(), BB_QUEUED);
+        LiveRangeData& lrd = *bb.liveRangeData_;
+        for (MoveNodeUseMapSet::const_iterator i = lrd.regFirstUses_.begin();
+             i != lrd.regFirstUses_.end(); i++) {
+            registers.add(i->first, firstUses[bbi]);
+        }
+        for (MoveNodeUseMapPair::const_iterator i = lrd.regKills_.begin();
+             i != lrd.regKills_.end(); i++) {
+            registers.add(i->first, kills[bbi]);
+        }
+        // the sets are only ever extended, keep what is already there
+        registers.add(lrd.registersUsedAfter_, usedAfter[bbi]);
+        registers.add(lrd.registersUsedInOrAfter_, usedInOrAfter[bbi]);
+
+        BasicBlockNodeSet preds = cfg_->predecessors(bbn);
+        for (BasicBlockNodeSet::iterator predIter = preds.begin();
+             predIter != preds.end(); predIter++) {
+            predecessors[bbi].push_back(bbIndices[*predIter]);
+        }
+    }
+
+    const size_t words = registers.wordCount();
+    for (int bbi = 0; bbi < bbCount; bbi++) {
+        firstUses[bbi].resize(words, 0);
+        kills[bbi].resize(words, 0);
+        usedInOrAfter[bbi].resize(words, 0);
+        usedAfter[bbi].resize(words, 0);
+    }
+
+    // start from the end of the cfg so that most blocks see their final
+    // input the first time they are processed
+    std::deque<int> worklist;
+    std::vector<bool> queued(bbCount, true);
+    for (int bbi = bbCount - 1; bbi >= 0; bbi--) {
+        worklist.push_back(bbi);
+    }
+    while (!worklist.empty()) {
+        const int bbi = worklist.front();
+        worklist.pop_front();
+        queued[bbi] = false;
+
+        RegisterBits& in = usedInOrAfter[bbi];
+        for (size_t w = 0; w < words; w++) {
+            in[w] |= firstUses[bbi][w] | (usedAfter[bbi][w] & ~kills[bbi][w]);
+        }
+        for (size_t p = 0; p < predecessors[bbi].size(); p++) {
+            const int pred = predecessors[bbi][p];
+            RegisterBits& out = usedAfter[pred];
+            bool changed = false;
+            for (size_t w = 0; w < words; w++) {
+                const RegisterBits::value_type merged = out[w] | in[w];
+                changed |= merged != out[w];
+                out[w] = merged;
+            }
+            if (changed && !queued[pred]) {
+                queued[pred] = true;
+                worklist.push_back(pred);
+            }
+        }
+    }
 
-        iterateRegisterDeaths();
+    for (int bbi = 0; bbi < bbCount; bbi++) {
+        LiveRangeData& lrd = *cfg_->node(bbi).basicBlock().liveRangeData_;
+        registers.names(usedAfter[bbi], lrd.registersUsedAfter_);
+        registers.names(usedInOrAfter[bbi], lrd.registersUsedInOrAfter_);
     }
+}
 
-    // free bb data
-    AssocTools::deleteAllValues(bbData_);
+/**
+ * Returns the dense index of the given register, numbering it if needed.
+ */
+unsigned int
+DataDependenceGraphBuilder::RegisterIndex::index(const TCEString& reg) {
+    std::map<TCEString, unsigned int>::const_iterator i = indices_.find(reg);
+    if (i != indices_.end()) {
+        return i->second;
+    }
+    const unsigned int index = names_.size();
+    indices_[reg] = index;
+    names_.push_back(reg);
+    return index;
 }
 
 /**
- * Iterates thru all queued BB's and find register deaths from them.
- *
- * Loops as long as something keeps changing.
+ * Adds the given register to the bitset.
  */
 void
-DataDependenceGraphBuilder::iterateRegisterDeaths() {
-
-    // loop as long as we have unprocessed/changed BB's
-    while (!blocksByState_[BB_QUEUED].empty()) {
-        std::list<BBData*>::iterator bbIter =
-            blocksByState_[BB_QUEUED].begin();
-        BBData& bbd = **bbIter;
-
-        // mark as ready
-        changeState(bbd, BB_READY);
-
-        if (updateRegistersUsedInOrAfter(bbd) || (!bbd.constructed_)) {
-            // if there asre more registers read after start of this BB,
-            // have to update this information to preceedign BBs,
-            // and check if they need to be reprocessed.
-            updatePreceedingRegistersUsedAfter(bbd, !bbd.constructed_);
-        }
-        bbd.constructed_ = true;
+DataDependenceGraphBuilder::RegisterIndex::add(
+    const TCEString& reg, RegisterBits& bits) {
+    const unsigned int i = index(reg);
+    if (bits.size() <= i / WORD_BITS) {
+        bits.resize(i / WORD_BITS + 1, 0);
     }
+    bits[i / WORD_BITS] |= RegisterBits::value_type(1) << (i % WORD_BITS);
 }
 
 /**
- * Updates bookkeeping about registers used in this or later BBs.
- *
- * This is a helper function used by searchRegisterDeaths() method.
- *
- * @param bbd Data about one basicblock.
- * @return whether the bookkeeping was changed,
-           ie the predecessors of this BB need to be reprocessed.
+ * Adds the given registers to the bitset.
  */
-bool
-DataDependenceGraphBuilder::updateRegistersUsedInOrAfter(
-    BBData& bbd) {
-    BasicBlock& bb = bbd.bblock_->basicBlock();
-    size_t size = bb.liveRangeData_->registersUsedInOrAfter_.size();
+void
+DataDependenceGraphBuilder::RegisterIndex::add(
+    const std::set<TCEString>& regs, RegisterBits& bits) {
+    for (std::set<TCEString>::const_iterator i = regs.begin();
+         i != regs.end(); i++) {
+        add(*i, bits);
+    }
+}
 
-    // if definition not here, it's earlier - copy.
-    // if definition here, not alive unless read here.
-    for (std::set<TCEString>::iterator i = bb.liveRangeData_->registersUsedAfter_.begin();
-         i != bb.liveRangeData_->registersUsedAfter_.end(); i++) {
-        // if not written in this, written earlier.
-        if (bb.liveRangeData_->regKills_.find(*i) == bb.liveRangeData_->regKills_.end()) {
-            bb.liveRangeData_->registersUsedInOrAfter_.insert(*i);
+/**
+ * Stores the names of the registers in the bitset to the given set.
+ */
+void
+DataDependenceGraphBuilder::RegisterIndex::names(
+    const RegisterBits& bits, std::set<TCEString>& regs) const {
+    regs.clear();
+    for (size_t w = 0; w < bits.size(); w++) {
+        for (RegisterBits::value_type word = bits[w]; word != 0;
+             word &= word - 1) {
+            regs.insert(names_[w * WORD_BITS + __builtin_ctzl(word)]);
         }
     }
+}
 
-    // reads in this BB.liveRangeData_-> Only reads whose defining value comes/can come
-    // outside this BB.liveRangeData_->
-    for (MoveNodeUseMapSet::iterator i = bb.liveRangeData_->regFirstUses_.begin();
-         i != bb.liveRangeData_->regFirstUses_.end(); i++) {
-        bb.liveRangeData_->registersUsedInOrAfter_.insert(i->first);
-    }
-    if (bb.liveRangeData_->registersUsedInOrAfter_.size() > size) {
-        return true;
-    }
-    return false;
+/**
+ * Returns the number of bitset words needed for the numbered registers.
+ */
+size_t
+DataDependenceGraphBuilder::RegisterIndex::wordCount() const {
+    return (names_.size() + WORD_BITS - 1) / WORD_BITS;
 }
 
 /**
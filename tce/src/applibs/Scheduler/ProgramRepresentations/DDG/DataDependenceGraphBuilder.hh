@@ -108,6 +108,7 @@ protected:
     typedef LiveRangeData::MoveNodeUseSet MoveNodeUseSet;
     typedef LiveRangeData::MoveNodeUseMapSet MoveNodeUseMapSet;
     typedef LiveRangeData::MoveNodeUseMap MoveNodeUseMap;
+    typedef LiveRangeData::MoveNodeUseMapPair MoveNodeUseMapPair;
     typedef LiveRangeData::MoveNodeUseSetPair MoveNodeUseSetPair;
     typedef LiveRangeData::MoveNodeUsePair MoveNodeUsePair;
 
@@ -146,11 +147,28 @@ protected:
     typedef std::map <BasicBlockNode*, BBData*> BBDataMap;
     typedef std::list<BBData*> BBDataList;
 
-    void updatePreceedingRegistersUsedAfter(
-        BBData& bbd, 
-        bool firstTime);
+    /// Register set of the liveness analysis, one bit per register.
+    typedef std::vector<unsigned long> RegisterBits;
 
-    bool updateRegistersUsedInOrAfter(BBData& bbd);
+    /**
+     * Dense numbering of the registers seen in the liveness analysis.
+     */
+    class RegisterIndex {
+    public:
+        unsigned int index(const TCEString& reg);
+        void add(const TCEString& reg, RegisterBits& bits);
+        void add(const std::set<TCEString>& regs, RegisterBits& bits);
+        void names(
+            const RegisterBits& bits, std::set<TCEString>& regs) const;
+        size_t wordCount() const;
+    private:
+        static const unsigned int WORD_BITS =
+            sizeof(RegisterBits::value_type) * 8;
+        /// Index of each register name.
+        std::map<TCEString, unsigned int> indices_;
+        /// Register names by index.
+        std::vector<TCEString> names_;
+    };
 
     bool updateRegistersAliveAfter(BBData& bbd);
 
@@ -168,7 +186,6 @@ protected:
     void iterateBBs(
         ConstructionPhase phase);
     void searchRegisterDeaths();
-    void iterateRegisterDeaths();
     
     void setSucceedingPredeps(
         BBData& bbd, 
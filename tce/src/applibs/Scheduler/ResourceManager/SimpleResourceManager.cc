@@ -56,7 +56,8 @@ using namespace TTAProgram;
  */
 SimpleResourceManager::SimpleResourceManager(
     const TTAMachine::Machine& machine, unsigned int ii):
-    ResourceManager(machine), director_(NULL),  initiationInterval_(ii) {
+    ResourceManager(machine), director_(NULL),  initiationInterval_(ii),
+    machineFingerprint_(machine.fingerprint()) {
 
     buildResourceModel(machine);
 }
@@ -65,21 +66,28 @@ SimpleResourceManager::SimpleResourceManager(
  * Factory method for creating resource managers.
  *
  * Checks a RM pool if a recyclable RM is found for same machine with same II,
- * if found gives that. If not found, creates a new RM.
+ * if found gives that. If not found, creates a new RM. The pooled RMs built
+ * before the machine was last edited are deleted instead of recycled.
  */
 SimpleResourceManager* 
 SimpleResourceManager::createRM(
     const TTAMachine::Machine& machine, unsigned int ii) {
-    std::map<int, std::list< SimpleResourceManager*> >& pool =
-        rmPool_[&machine];
-    std::list<SimpleResourceManager*>& iipool = pool[ii];
-    if (iipool.empty()) {
-        return new SimpleResourceManager(machine,ii);
-    } else {
-        SimpleResourceManager* rm = iipool.back();
-        iipool.pop_back();
-        return rm;
+    {
+        std::lock_guard<std::mutex> guard(rmPoolLock_);
+        std::map<int, std::list< SimpleResourceManager*> >& pool =
+            rmPool_[&machine];
+        std::list<SimpleResourceManager*>& iipool = pool[ii];
+        while (!iipool.empty()) {
+            SimpleResourceManager* rm = iipool.back();
+            iipool.pop_back();
+            if (rm->machineFingerprint_ == machine.fingerprint()) {
+                return rm;
+            }
+            delete rm;
+        }
     }
+    // building the resource model is the expensive part, do it unlocked
+    return new SimpleResourceManager(machine,ii);
 }
 
 /*
@@ -91,10 +99,11 @@ void SimpleResourceManager::disposeRM(
     SimpleResourceManager* rm, bool allowReuse) {
     if (rm == NULL) return;
     if (allowReuse) {
+        rm->clear();
+        std::lock_guard<std::mutex> guard(rmPoolLock_);
         std::map<int, std::list< SimpleResourceManager*> >& pool =
             rmPool_[&rm->machine()];
         pool[rm->initiationInterval()].push_back(rm);
-        rm->clear();
     } else {
         delete rm;
         ExecutionPipelineResourceTable::finalize();
@@ -630,6 +639,8 @@ std::map<const TTAMachine::Machine*,
          std::map<int, std::list< SimpleResourceManager*> > >
 SimpleResourceManager::rmPool_;
 
+std::mutex SimpleResourceManager::rmPoolLock_;
+
 void SimpleResourceManager::setMaxCycle(unsigned int maxCycle) {
     director_->setMaxCycle(maxCycle);
 }
@@ -37,6 +37,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "ResourceManager.hh"
 #include "AssignmentPlan.hh"
@@ -155,6 +156,8 @@ private:
     ResourceBuildDirector buildDirector_;
 
     unsigned int initiationInterval_;
+    /// Fingerprint of the machine when the resource model was built.
+    unsigned long machineFingerprint_;
 
     unsigned int resources;
     
@@ -162,6 +165,8 @@ private:
     static std::map<const TTAMachine::Machine*, 
                     std::map<int, std::list< SimpleResourceManager*> > >
     rmPool_;
+    /// Guards rmPool_ when procedures are scheduled in parallel.
+    static std::mutex rmPoolLock_;
 };
 
 #endif
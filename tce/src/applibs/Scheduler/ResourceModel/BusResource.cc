@@ -68,12 +68,7 @@ BusResource::~BusResource() {}
  */
 bool
 BusResource::isInUse(const int cycle) const {
-    ResourceRecordType::const_iterator i = 
-        resourceRecord_.find(instructionIndex(cycle));
-    if (i != resourceRecord_.end() && i->second != 0) {
-        return true;
-    }
-    return false;
+    return resourceRecord_.bitAt(instructionIndex(cycle));
 }
 
 /**
@@ -117,7 +112,7 @@ BusResource::isAvailable(
 void
 BusResource::assign(const int cycle, MoveNode& node) {
     if (canAssign(cycle, node)) {
-        resourceRecord_[instructionIndex(cycle)] = 1;
+        resourceRecord_.setBit(instructionIndex(cycle), true);
         increaseUseCount();
         return;
     }
@@ -133,7 +128,7 @@ BusResource::assign(const int cycle, MoveNode& node) {
 void
 BusResource::unassign(const int cycle, MoveNode&) {
     if (isInUse(cycle)) {
-        resourceRecord_[instructionIndex(cycle)] = 0;
+        resourceRecord_.setBit(instructionIndex(cycle), false);
         return;
     } else{
         std::string msg = "Bus ";
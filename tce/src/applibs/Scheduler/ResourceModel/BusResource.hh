@@ -35,8 +35,8 @@
 #define TTA_BUSRESOURCE_HH
 
 #include<string>
-#include <map>
 #include "SchedulingResource.hh"
+#include "CycleBitmap.hh"
 
 /**
  * An interface for scheduling resources of Resource Model
@@ -89,9 +89,8 @@ private:
     // number of connected sockets
     int socketCount_;
 
-    // map contains <Cycle : testCounter>
-    typedef std::map<int, int> ResourceRecordType;
-    ResourceRecordType resourceRecord_;
+    // occupancy of the bus, indexed by instruction index
+    CycleBitmap resourceRecord_;
 
 };
 
@@ -83,7 +83,7 @@ ExecutionPipelineResource::ExecutionPipelineResource(
     const TTAMachine::FunctionUnit& fu,
     const unsigned int ii) :
     SchedulingResource("ep_" + fu.name(), ii), 
-    resources(&ExecutionPipelineResourceTable::resourceTable(fu)),
+    resources(ExecutionPipelineResourceTable::resourceTable(fu)),
     cachedSize_(INT_MIN), maxCycle_(INT_MAX), ddg_(NULL), fu_(fu),
     operandShareCount_(0) {
 }
@@ -138,24 +138,16 @@ ExecutionPipelineResource::isInUse(const int cycle) const {
             return true;
         }
     }
-    if (modCycle >= (int)size()) {
+    if (modCycle < 0 || modCycle >= (int)size()) {
         /// Cycle is beyond already scheduled scope, not in use therefore
         return false;
     }
-    if (resources->numberOfResources() !=
-        (MapTools::valueForKeyNoThrow<ResourceReservationVector>(
-             fuExecutionPipeline_, modCycle)).size()) {
+    const ResourceReservationVector& rrv = fuExecutionPipeline_[modCycle];
+    if (resources->numberOfResources() != rrv.size()) {
         std::string msg = "Execution pipeline is missing resources!";
         throw ModuleRunTimeError(__FILE__, __LINE__, __func__, msg);
     }
     for (unsigned int i = 0; i < resources->numberOfResources(); i++) {
-        const ResourceReservationVector& rrv = 
-            MapTools::valueForKeyNoThrow<ResourceReservationVector>(
-                fuExecutionPipeline_, modCycle);
-        if (rrv.size() == 0) {
-            return false;
-        }
-                
         const ResourceReservation& rr = rrv[i];
 
         if (rr.first != NULL) {
@@ -518,17 +510,17 @@ ExecutionPipelineResource::assignDestination(
         int pIndex = resources->operationIndex(opName);
         for (unsigned int i = 0; i < resources->maximalLatency(); i++) {
             int modic = instructionIndex(cycle+i);
+            assert(modic >= 0);
+            ResourceReservationVector& rrv =
+                fuExecutionPipeline_.entry(modic);
             // then we can insert the resource usage.
             for (unsigned int j = 0 ; 
                  j < resources->numberOfResources(); j++) {
-                if (fuExecutionPipeline_[modic].size()
-                    == 0) {
-                    fuExecutionPipeline_[modic] =
-                        ResourceReservationVector(
-                            resources->numberOfResources());
+                if (rrv.size() == 0) {
+                    rrv = ResourceReservationVector(
+                        resources->numberOfResources());
                 }
-                ResourceReservation& rr = 
-                    fuExecutionPipeline_[modic][j];
+                ResourceReservation& rr = rrv[j];
                 if (resources->operationPipeline(pIndex,i,j)) {
                     if (rr.first != NULL) {
                         assert(rr.second == NULL&&"Resource already in use?");
@@ -745,8 +737,8 @@ ExecutionPipelineResource::unassignDestination(
 
     // Cannot trust size() since that one ignores empty pipeline
     // and here we need to go up to the maximalLatency.
-    size_t fuEpSize = fuExecutionPipeline_.size();
-    if ((instructionIndex(cycle + resources->maximalLatency() - 1))
+    int fuEpSize = fuExecutionPipeline_.endIndex();
+    if ((int)instructionIndex(cycle + resources->maximalLatency() - 1)
         >= fuEpSize) {
         std::string msg = "Unassigning operation longer then scope!";
         msg += " - cycle:";
@@ -763,7 +755,7 @@ ExecutionPipelineResource::unassignDestination(
             assert(
                 fuExecutionPipeline_[modic].size() != 0);
             ResourceReservation& rr = 
-                fuExecutionPipeline_[modic][j];
+                fuExecutionPipeline_.entry(modic)[j];
             if (rr.first == &node) {
                 assert(resources->operationPipeline(
                            resources->operationIndex(opName),i,j) &&
@@ -1264,7 +1256,7 @@ bool ExecutionPipelineResource::resourcesAllowTrigger(
         assigned(nRes, std::vector<bool>(rLat, false));
 
     unsigned int curSize = size();
-    unsigned int fupSize = fuExecutionPipeline_.size();
+    unsigned int fupSize = fuExecutionPipeline_.endIndex();
     for (unsigned int i = 0; i < rLat && canAssign; i++) {
         unsigned int modci = instructionIndex(cycle+i); 
         
@@ -1280,7 +1272,10 @@ bool ExecutionPipelineResource::resourcesAllowTrigger(
             }
         }
       
-        ResourceReservationVector& rrv = fuExecutionPipeline_[modci];
+        if (!fuExecutionPipeline_.contains(modci)) {
+            continue;
+        }
+        ResourceReservationVector& rrv = fuExecutionPipeline_.entry(modci);
         if (rrv.empty()) {
             continue;
         }
@@ -1315,7 +1310,8 @@ bool ExecutionPipelineResource::resourcesAllowTrigger(
         for (unsigned int j = 0; j < resources->numberOfResources(); j++) {
             if (assigned[j][i]) {
                 ResourceReservation& rr = 
-                    fuExecutionPipeline_[instructionIndex(cycle+i)][j];
+                    fuExecutionPipeline_.entry(
+                        instructionIndex(cycle+i))[j];
                 // clear the usage.
                 if (rr.first == &node) {
                     assert(rr.second == NULL);
@@ -1388,13 +1384,13 @@ ExecutionPipelineResource::size() const {
         return cachedSize_;
     }
 #endif
-    int length = fuExecutionPipeline_.size() - 1;
+    int length = fuExecutionPipeline_.endIndex() - 1;
     int dstCount = assignedDestinationNodes_.size();
     int srcCount = assignedSourceNodes_.size();
     // If there are no sources or destinations
     // assigned then the pipeline has to be empty.
     // No point searching whole empty range
-    if (length == -1 || (dstCount == 0 && srcCount ==0)) {
+    if (fuExecutionPipeline_.empty() || (dstCount == 0 && srcCount ==0)) {
         cachedSize_ = 0;
         return 0;
     }
@@ -1408,24 +1404,20 @@ ExecutionPipelineResource::size() const {
         stoppingCycle = std::min(stoppingCycle, srcMin);
     }
     // Don't go bellow smallest known assigned node
+    stoppingCycle = std::max(
+        stoppingCycle, std::max(fuExecutionPipeline_.firstIndex(), 0));
     for (int i = length; i >= stoppingCycle; i--) {
-	ResourceReservationTable::const_iterator iter =
-	    fuExecutionPipeline_.find(i);
-	if (iter == fuExecutionPipeline_.end()) {
-	    continue;
-	} else {
-	    const ResourceReservationVector& rrv = iter->second;
-	    if (rrv.size() == 0) {
-		continue;
-	    }
-
-	    for (unsigned int j = 0; j < resources->numberOfResources(); j++) {
-		const ResourceReservation& rr = rrv[j];
-		if (rr.first != NULL) {
-		    cachedSize_ = i + 1;
-		    return i + 1;
-		}
-	    }
+        const ResourceReservationVector& rrv = fuExecutionPipeline_[i];
+        if (rrv.size() == 0) {
+            continue;
+        }
+
+        for (unsigned int j = 0; j < resources->numberOfResources(); j++) {
+            const ResourceReservation& rr = rrv[j];
+            if (rr.first != NULL) {
+                cachedSize_ = i + 1;
+                return i + 1;
+            }
         }
     }
     cachedSize_ = 0;
@@ -39,10 +39,12 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include "SchedulingResource.hh"
 #include "MoveNode.hh"
 #include "SparseVectorMap.hh"
+#include "CycleTable.hh"
 
 class DataDependenceGraph;
 class ExecutionPipelineResourceTable;
@@ -164,8 +166,10 @@ private:
     OperandWriteMap;
 
     /// Type for resource reservation table, resource vector x latency.
-    /// Includes the ownerships of the reservation.
-    typedef SparseVector<ResourceReservationVector> ResourceReservationTable;
+    /// Includes the ownerships of the reservation. Dense between the first
+    /// and the last reserved instruction index; cycles without
+    /// reservations have an empty vector.
+    typedef CycleTable<ResourceReservationVector> ResourceReservationTable;
     
 
     //Copying forbidden
@@ -285,7 +289,7 @@ private:
 
     bool isDestOpOfMN(const MoveNode& mn, const ProgramOperation& po) const;
 
-    const ExecutionPipelineResourceTable* resources;
+    std::shared_ptr<const ExecutionPipelineResourceTable> resources;
 
     /// Stores one resource vector per cycle of scope for whole FU
     mutable ResourceReservationTable fuExecutionPipeline_;
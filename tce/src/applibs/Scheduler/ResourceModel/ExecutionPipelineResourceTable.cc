@@ -37,6 +37,7 @@
 #include "HWOperation.hh"
 #include "ExecutionPipeline.hh"
 #include "PipelineElement.hh"
+#include "Machine.hh"
 
 namespace TTAMachine {
     class FUPort;
@@ -157,34 +158,50 @@ ExecutionPipelineResourceTable::setLatency(
 /**
  * Gives an resource table for given FU. 
  * If no existing found, creates a new one.
+ *
+ * The table of the FU is reused as long as the fingerprint of the machine
+ * of the FU stays the same. Editing the operations, pipelines or ports of
+ * the FU changes the fingerprint, and the fingerprints are unique within
+ * the process, so a table is never reused for an edited FU or for a
+ * different FU that happens to be allocated at the address of a deleted
+ * one. A rebuilt table replaces the stale one in the cache; the resources
+ * which still use the stale one share its ownership. The tables of FUs
+ * without a machine are not cached.
  * 
  * @param fu function unit whose resource table we are asking for.
+ * @return The table.
  */
-const ExecutionPipelineResourceTable& 
+std::shared_ptr<const ExecutionPipelineResourceTable>
 ExecutionPipelineResourceTable::resourceTable(
     const TTAMachine::FunctionUnit& fu) {
-    
-    ResourceTableMap::iterator i = allResourceTables_.find(&fu);
 
-    if (i != allResourceTables_.end()) {
-        return *i->second;
-    } 
-
-    ExecutionPipelineResourceTable* newTable = 
-        new ExecutionPipelineResourceTable(fu);
-    allResourceTables_[&fu] = newTable;
-    return *newTable;
+    if (fu.machine() == NULL) {
+        return std::shared_ptr<const ExecutionPipelineResourceTable>(
+            new ExecutionPipelineResourceTable(fu));
+    }
+    const unsigned long fingerprint = fu.machine()->fingerprint();
+    
+    std::lock_guard<std::mutex> guard(tablesLock_);
+    FingerprintedTable& table = allResourceTables_[&fu];
+    if (table.second == NULL || table.first != fingerprint) {
+        table.first = fingerprint;
+        table.second.reset(new ExecutionPipelineResourceTable(fu));
+    }
+    return table.second;
 }
 
 /**
  * Delete all the resource tables.
- * This can be called after scheduling is done, 
- * when resource managers are longer used.
+ * This can be called after scheduling is done. The tables still used by
+ * resource managers are deleted with the last of them.
  */
 void
 ExecutionPipelineResourceTable::finalize() {
-    MapTools::deleteAllValues(allResourceTables_);
+    std::lock_guard<std::mutex> guard(tablesLock_);
+    allResourceTables_.clear();
 }
 
 ExecutionPipelineResourceTable::ResourceTableMap 
 ExecutionPipelineResourceTable::allResourceTables_;
+
+std::mutex ExecutionPipelineResourceTable::tablesLock_;
@@ -35,6 +35,8 @@
 
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace TTAMachine {
@@ -59,8 +61,8 @@ public:
 
     inline const std::string& name() const;
 
-    static const ExecutionPipelineResourceTable& resourceTable(
-        const TTAMachine::FunctionUnit& fu);
+    static std::shared_ptr<const ExecutionPipelineResourceTable>
+    resourceTable(const TTAMachine::FunctionUnit& fu);
 
     static void finalize();
 private:
@@ -82,8 +84,14 @@ private:
     /// Type for resource reservation table, resource vector x latency
     typedef std::vector<ResourceVector> ResourceTable;
 
-    typedef std::map<const TTAMachine::FunctionUnit*, 
-                     ExecutionPipelineResourceTable*> ResourceTableMap;
+    /// The fingerprint of the machine of the FU and the table built with
+    /// it, see resourceTable().
+    typedef std::pair<
+        unsigned long, std::shared_ptr<const ExecutionPipelineResourceTable> >
+    FingerprintedTable;
+
+    typedef std::map<const TTAMachine::FunctionUnit*, FingerprintedTable>
+    ResourceTableMap;
 
     /// Resource and ports vector width, depends on particular FU
     int numberOfResources_;
@@ -98,6 +106,8 @@ private:
 
     /// Contains these tables for all FU's
     static ResourceTableMap allResourceTables_;
+    /// Guards allResourceTables_ against concurrent schedulers.
+    static std::mutex tablesLock_;
 };
 
 #include "ExecutionPipelineResourceTable.icc"
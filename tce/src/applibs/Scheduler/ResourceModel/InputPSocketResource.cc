@@ -102,10 +102,13 @@ bool
 InputPSocketResource::canAssign(const int cycle, const MoveNode& node)
     const {
 
+    if (!occupied_.bitAt(cycle)) {
+        return true;
+    }
     ResourceRecordType::const_iterator iter = resourceRecord_.find(cycle);
     if (iter != resourceRecord_.end()) {
-        std::set<MoveNode*> movesInCycle = iter->second;
-        for (std::set<MoveNode*>::iterator it = movesInCycle.begin();
+        const std::set<MoveNode*>& movesInCycle = iter->second;
+        for (std::set<MoveNode*>::const_iterator it = movesInCycle.begin();
              it != movesInCycle.end(); it++) {
 #ifdef NO_OVERCOMMIT
             return false;
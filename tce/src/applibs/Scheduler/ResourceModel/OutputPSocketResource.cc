@@ -141,10 +141,13 @@ OutputPSocketResource::canAssign(const int cycle, const MoveNode& node)
             }
         }
 
-        ResourceRecordType::const_iterator iter = resourceRecord_.find(cycle);
+        ResourceRecordType::const_iterator iter = resourceRecord_.end();
+        if (occupied_.bitAt(cycle)) {
+            iter = resourceRecord_.find(cycle);
+        }
         if (iter != resourceRecord_.end()) {
-            std::set<MoveNode*> movesInCycle = iter->second;
-            for (std::set<MoveNode*>::iterator it = movesInCycle.begin();
+            const std::set<MoveNode*>& movesInCycle = iter->second;
+            for (std::set<MoveNode*>::const_iterator it = movesInCycle.begin();
                  it != movesInCycle.end(); it++) {
 #ifdef NO_OVERCOMMIT
                 return false;
@@ -62,12 +62,7 @@ PSocketResource::~PSocketResource() {}
  */
 bool
 PSocketResource::isInUse(const int cycle) const {
-    ResourceRecordType::const_iterator iter =
-        resourceRecord_.find(instructionIndex(cycle));
-    if (iter != resourceRecord_.end() && iter->second.size() > 0) {
-        return true;
-    }
-    return false;
+    return occupied_.bitAt(instructionIndex(cycle));
 }
 
 /**
@@ -78,6 +73,9 @@ PSocketResource::isInUse(const int cycle) const {
  */
 bool
 PSocketResource::isAvailable(const int cycle) const {
+    if (!occupied_.bitAt(instructionIndex(cycle))) {
+        return true;
+    }
     ResourceRecordType::const_iterator iter =
         resourceRecord_.find(instructionIndex(cycle));
     if (iter != resourceRecord_.end() && iter->second.size() > 0) {
@@ -104,6 +102,7 @@ PSocketResource::isAvailable(const int cycle) const {
 void
 PSocketResource::assign(const int cycle, MoveNode& mn) {
     resourceRecord_[instructionIndex(cycle)].insert(&mn);
+    occupied_.setBit(instructionIndex(cycle), true);
     increaseUseCount();
     return;
 }
@@ -118,7 +117,12 @@ PSocketResource::assign(const int cycle, MoveNode& mn) {
 void
 PSocketResource::unassign(const int cycle, MoveNode& mn) {
     if (isInUse(cycle)) {
-        resourceRecord_[instructionIndex(cycle)].erase(&mn);
+        std::set<MoveNode*>& movesInCycle =
+            resourceRecord_[instructionIndex(cycle)];
+        movesInCycle.erase(&mn);
+        if (movesInCycle.empty()) {
+            occupied_.setBit(instructionIndex(cycle), false);
+        }
         decreaseUseCount();
         return;
     }
@@ -136,6 +140,9 @@ PSocketResource::unassign(const int cycle, MoveNode& mn) {
 bool
 PSocketResource::canAssign(const int cycle, const MoveNode& node) const {
 
+    if (!occupied_.bitAt(cycle)) {
+        return true;
+    }
     ResourceRecordType::const_iterator iter = resourceRecord_.find(cycle);
     if (iter != resourceRecord_.end()) {
         const std::set<MoveNode*>& movesInCycle = iter->second;
@@ -169,4 +176,5 @@ void
 PSocketResource::clear() {
     SchedulingResource::clear();
     resourceRecord_.clear();
+    occupied_.clear();
 }
@@ -38,6 +38,7 @@
 #include <map>
 
 #include "SchedulingResource.hh"
+#include "CycleBitmap.hh"
 /**
  * An interface for scheduling resources of Resource Model.
  *
@@ -62,6 +63,9 @@ protected:
     typedef std::map<int, std::set<MoveNode*> > ResourceRecordType;
 
     ResourceRecordType resourceRecord_;
+    // Cycles in which resourceRecord_ holds at least one move, kept
+    // in sync with it for the constant time busy checks.
+    CycleBitmap occupied_;
 private:
     // Copying forbidden
     PSocketResource(const PSocketResource&);
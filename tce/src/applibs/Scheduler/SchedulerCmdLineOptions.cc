@@ -47,6 +47,7 @@ const std::string SchedulerCmdLineOptions::SWL_KILL_DEAD_RESULTS = "kill-dead-re
 const std::string SchedulerCmdLineOptions::SWL_BYPASS_DISTANCE = "bypass-distance";
 const std::string SchedulerCmdLineOptions::SWL_NO_DRE_BYPASS_DISTANCE = "bypass-distance-nodre";
 const std::string SchedulerCmdLineOptions::SWL_OPERAND_SHARE_DISTANCE = "operand-share-distance";
+const std::string SchedulerCmdLineOptions::SWL_LOOP_II_JOBS = "loop-ii-jobs";
 
 
 const std::string SchedulerCmdLineOptions::USAGE =
@@ -80,6 +81,12 @@ SchedulerCmdLineOptions::SchedulerCmdLineOptions(): CmdLineOptions(USAGE) {
         new BoolCmdLineOptionParser(
             SWL_LOOP_FLAG, "Use loop scheduler."));
 
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_LOOP_II_JOBS,
+            "Number of initiation intervals the loop scheduler tries "
+            "concurrently in worker processes. Default is 1."));
+
     addOption(
         new BoolCmdLineOptionParser(
             SWL_RENAME_REGISTERS, 
@@ -251,3 +258,20 @@ SchedulerCmdLineOptions::killDeadResults() const {
     } 
     return findOption(SWL_KILL_DEAD_RESULTS)->isFlagOn();
 }
+
+/**
+ * Returns the number of initiation intervals to test concurrently when
+ * searching the II of a software pipelined loop.
+ *
+ * @return The number of worker processes, 1 if not given or if not
+ *         positive.
+ */
+int
+SchedulerCmdLineOptions::loopIIJobs() const {
+    if (findOption(SWL_LOOP_II_JOBS)->isDefined() &&
+        findOption(SWL_LOOP_II_JOBS)->integer() > 0) {
+        return findOption(SWL_LOOP_II_JOBS)->integer();
+    } else {
+        return 1;
+    }
+}
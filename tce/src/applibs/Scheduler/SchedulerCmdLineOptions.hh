@@ -60,6 +60,7 @@ public:
     virtual int noDreBypassDistance() const;
     virtual int operandShareDistance() const;
     virtual bool killDeadResults() const;
+    virtual int loopIIJobs() const;
 private:
     /// Copying forbidden.
     SchedulerCmdLineOptions(const SchedulerCmdLineOptions&);
@@ -82,6 +83,8 @@ private:
     static const std::string SWL_NO_DRE_BYPASS_DISTANCE;
     static const std::string SWL_BYPASS_DISTANCE;
     static const std::string SWL_OPERAND_SHARE_DISTANCE;
+    /// Number of loop initiation intervals to test concurrently.
+    static const std::string SWL_LOOP_II_JOBS;
 };
 
 #endif
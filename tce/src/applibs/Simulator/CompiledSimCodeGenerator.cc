@@ -259,6 +259,7 @@ CompiledSimCodeGenerator::generateMakefile() {
         << "sources = $(wildcard *.cpp)" << endl
         << "objects = $(patsubst %.cpp,%.o,$(sources))" << endl
         << "dobjects = $(patsubst %.cpp,%.so,$(sources))" << endl
+        << "preprocessed = $(patsubst %.cpp,%.ii,$(sources))" << endl
         << "includes = " << includes << endl
         << "soflags = " << CompiledSimCompiler::COMPILED_SIM_SO_FLAGS << endl 
             
@@ -285,6 +286,13 @@ CompiledSimCodeGenerator::generateMakefile() {
         << "\t@rm -f $@.so.o" << endl
         << endl
             
+        // the preprocessed sources identify the cached objects, no line
+        // markers so they do not depend on the directory
+        << "preprocess: $(preprocessed)" << endl << endl
+        << "$(preprocessed): %.ii: %.cpp" << endl
+        << "\t$(CC) -E -P $(cppflags) $(opt_flags) $(includes) $< -o $@"
+        << endl << endl
+
         // use precompiled headers for more speed
         << "CompiledSimulationEngine.hh.gch:" << endl
         << "\t$(CC) $(cppflags) $(opt_flags) $(includes) "
@@ -292,7 +300,7 @@ CompiledSimCodeGenerator::generateMakefile() {
         << endl
             
         << "clean:" << endl
-        << "\t@rm -f $(dobjects) CompiledSimulationEngine.so CompiledSimulationEngine.hh.gch" << endl;
+        << "\t@rm -f $(dobjects) $(preprocessed) CompiledSimulationEngine.so CompiledSimulationEngine.hh.gch" << endl;
     
     makefile.close();
     currentFileName_.clear();
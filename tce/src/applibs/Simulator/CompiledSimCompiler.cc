@@ -30,9 +30,17 @@
  * @note rating: red
  */
 
+#include <unistd.h>
+#include <utime.h>
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <cstring>
 #include <ctime>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <utility>
 
 #include "CompiledSimCompiler.hh"
 #include "Conversion.hh"
@@ -73,13 +81,19 @@ const char* CompiledSimCompiler::COMPILED_SIM_SO_FLAGS = SHARED_CXX_FLAGS;
 const char* CompiledSimCompiler::COMPILED_SIM_SO_FLAGS = " -shared -fpic ";
 #endif
 
+/// The default size limit of the object cache in megabytes.
+const int DEFAULT_CACHE_SIZE = 1024;
+/// The size of the blocks the preprocessed sources are read in.
+const std::size_t SOURCE_BLOCK_SIZE = 64 * 1024;
+
 /**
  * The constructor
  */
 CompiledSimCompiler::CompiledSimCompiler() {
     
-    // Get number of threads
-    threadCount_ = 3;
+    // Get number of threads, defaults to the number of host cores
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    threadCount_ = cores > 0 ? static_cast<int>(cores) : 1;
     std::string USER_THREAD_COUNT = 
         Environment::environmentVariable("TTASIM_COMPILER_THREADS");
     if (USER_THREAD_COUNT != "") {
@@ -100,6 +114,30 @@ CompiledSimCompiler::CompiledSimCompiler() {
         Environment::environmentVariable("TTASIM_COMPILER_FLAGS");
     if (fl != "")
         globalCompileFlags_ = std::string(fl);
+
+    // Get the object cache directory
+    if (Environment::environmentVariable("TTASIM_NO_CACHE") == "") {
+        cacheDirectory_ = 
+            Environment::environmentVariable("TTASIM_CACHE_DIR");
+        if (cacheDirectory_ == "") {
+            cacheDirectory_ = Environment::compiledSimCachePath();
+        }
+        if (!FileSystem::fileIsDirectory(cacheDirectory_) &&
+            !FileSystem::createDirectory(cacheDirectory_)) {
+            cacheDirectory_ = "";
+        } else {
+            cacheDirectory_ = FileSystem::absolutePathOf(cacheDirectory_);
+        }
+    }
+
+    // Get the size limit of the object cache in megabytes, 0 for none
+    int cacheSize = DEFAULT_CACHE_SIZE;
+    std::string USER_CACHE_SIZE = 
+        Environment::environmentVariable("TTASIM_CACHE_SIZE");
+    if (USER_CACHE_SIZE != "") {
+        cacheSize = Conversion::toInt(USER_CACHE_SIZE);
+    }
+    cacheSizeLimit_ = static_cast<uintmax_t>(std::max(cacheSize, 0)) << 20;
 }
 
 /**
@@ -114,7 +152,14 @@ CompiledSimCompiler::~CompiledSimCompiler() {
  * In case environment variable TTASIM_COMPILER is set, it is used
  * to compile the simulation code, otherwise 'gcc' is used. The
  * count of compiler threads is read from TTASIM_COMPILER_THREADS,
- * and defaults to 3.
+ * and defaults to the number of host cores.
+ *
+ * The simulation function objects found from the object cache are reused
+ * and only the rest are compiled. The cache is located in
+ * TTASIM_CACHE_DIR, or in the user's TCE directory by default, and it
+ * can be disabled by setting TTASIM_NO_CACHE. The least recently used
+ * objects are removed from the cache once it grows over TTASIM_CACHE_SIZE
+ * megabytes.
  *
  * @param dirName a source directory containing the .cpp files and the Makefile
  * @param flags additional compile flags given by the user. for instance, "-O3"
@@ -127,10 +172,10 @@ CompiledSimCompiler::compileDirectory(
     const string& flags,
     bool verbose) const {
 
-    string command = 
+    string makeCommand = 
         "make -sC " + dirName + " CC=\"" + compiler_ + "\" opt_flags=\"" +
-        globalCompileFlags_ + " " + flags + " \" -j" +
-        Conversion::toString(threadCount_);
+        globalCompileFlags_ + " " + flags + " \"";
+    string command = makeCommand + " -j" + Conversion::toString(threadCount_);
 
     if (verbose) {
         Application::logStream()
@@ -139,7 +184,66 @@ CompiledSimCompiler::compileDirectory(
     }
 
     time_t startTime = std::time(NULL);
+
+    vector<string> sources;
+    vector<string> keys;
+    vector<bool> cached;
+    if (cacheDirectory_ != "") {
+        // The precompiled header is built before fetching the objects so
+        // the objects fetched from the cache are newer than it and make
+        // does not rebuild them. The sources are preprocessed in parallel
+        // with it.
+        string preprocessCommand = 
+            command + " CompiledSimulationEngine.hh.gch preprocess";
+        if (system(preprocessCommand.c_str()) != 0) {
+            return -1;
+        }
+        FileSystem::globPath(
+            dirName + FileSystem::DIRECTORY_SEPARATOR + "*.cpp", sources);
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            const string& source = sources.at(i);
+            const string preprocessed = preprocessedPath(source);
+            keys.push_back(
+                finishPreprocessedSource(preprocessed, "make " + flags) ?
+                cacheKey(preprocessed) : "");
+            string soPath = 
+                FileSystem::directoryOfPath(source) + 
+                FileSystem::DIRECTORY_SEPARATOR + 
+                FileSystem::fileNameBody(source) + ".so";
+            cached.push_back(
+                keys.back() != "" && 
+                fetchFromCache(keys.back(), preprocessed, soPath));
+            if (cached.back()) {
+                ++hits;
+            }
+        }
+        if (verbose) {
+            Application::logStream()
+                << "Reusing " << hits << " of " << sources.size()
+                << " simulation objects from " << cacheDirectory_ << endl;
+        }
+    }
+
     int retval = system(command.c_str());
+
+    if (retval == 0) {
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            if (cached.at(i) || keys.at(i) == "") {
+                continue;
+            }
+            const string& source = sources.at(i);
+            storeToCache(
+                keys.at(i), preprocessedPath(source),
+                FileSystem::directoryOfPath(source) + 
+                FileSystem::DIRECTORY_SEPARATOR + 
+                FileSystem::fileNameBody(source) + ".so");
+        }
+        if (cacheDirectory_ != "") {
+            evictFromCache();
+        }
+    }
+
     time_t endTime = std::time(NULL);
 
     time_t elapsed = endTime - startTime;
@@ -199,7 +303,8 @@ CompiledSimCompiler::compileFile(
 /**
  * Compiles a single C++ file to a shared library (.so)
  * 
- * Used for generating .so files in dynamic compiled simulation
+ * Used for generating .so files in dynamic compiled simulation. The
+ * library is fetched from the object cache instead, if found there.
  * 
  * @param path Path to the file
  * @param flags custom flags to be used for compiling
@@ -212,6 +317,296 @@ CompiledSimCompiler::compileToSO(
     const string& flags,
     bool verbose) const {
 
-    return compileFile(path, COMPILED_SIM_SO_FLAGS + flags, ".so", verbose);
+    string soPath = 
+        FileSystem::directoryOfPath(path) + 
+        FileSystem::DIRECTORY_SEPARATOR + 
+        FileSystem::fileNameBody(path) + ".so";
+
+    const string preprocessed = preprocessedPath(path);
+    string key;
+    if (cacheDirectory_ != "") {
+        if (preprocess(path, COMPILED_SIM_SO_FLAGS + flags) &&
+            finishPreprocessedSource(
+                preprocessed, COMPILED_SIM_SO_FLAGS + flags)) {
+            key = cacheKey(preprocessed);
+        }
+        if (key != "" && fetchFromCache(key, preprocessed, soPath)) {
+            if (verbose) {
+                Application::logStream() 
+                    << "Using cached simulation file " << path << endl;
+            }
+            return 0;
+        }
+    }
+
+    int retval = 
+        compileFile(path, COMPILED_SIM_SO_FLAGS + flags, ".so", verbose);
+    if (retval == 0 && key != "") {
+        storeToCache(key, preprocessed, soPath);
+        evictFromCache();
+    }
+    return retval;
+}
+
+/**
+ * Returns the object cache key of a preprocessed simulation source file.
+ *
+ * The key is formed of the length and a hash of the file contents. The
+ * key alone does not identify the object, the cached objects are stored
+ * with their preprocessed sources which are compared on fetching.
+ *
+ * @param preprocessedPath Path to the source file preprocessed and
+ *        finished with finishPreprocessedSource().
+ * @return The cache key, or an empty string if the file could not be
+ *         read, in which case the object is not to be cached.
+ */
+std::string
+CompiledSimCompiler::cacheKey(const std::string& preprocessedPath) const {
+
+    std::ifstream file(preprocessedPath.c_str(), std::ios::binary);
+    vector<char> block(SOURCE_BLOCK_SIZE);
+    std::size_t hash = 0;
+    uintmax_t length = 0;
+    while (file.read(&block[0], block.size()) || file.gcount() > 0) {
+        const std::size_t count = static_cast<std::size_t>(file.gcount());
+        boost::hash_combine(
+            hash, boost::hash_range(block.begin(), block.begin() + count));
+        length += count;
+    }
+    if (length == 0) {
+        return "";
+    }
+
+    std::string key = (Conversion::toHexString(length)).substr(2);
+    key += "_";
+    key += (Conversion::toHexString(hash)).substr(2);
+    return key;
+}
+
+/**
+ * Returns the path the preprocessed simulation source file is written to.
+ *
+ * @param path Path to the source file.
+ * @return Path to the preprocessed source file.
+ */
+std::string
+CompiledSimCompiler::preprocessedPath(const std::string& path) {
+    return 
+        FileSystem::directoryOfPath(path) + 
+        FileSystem::DIRECTORY_SEPARATOR + 
+        FileSystem::fileNameBody(path) + ".ii";
+}
+
+/**
+ * Preprocesses a single simulation source file.
+ *
+ * The preprocessing is done in the directory of the source file without
+ * line markers, so the result does not depend on where the file is
+ * generated. Source files compiled with the generated Makefile are
+ * preprocessed with its "preprocess" target instead.
+ *
+ * @param path Path to the source file.
+ * @param flags Custom flags the file is compiled with.
+ * @return True if the file was preprocessed to preprocessedPath(path).
+ */
+bool
+CompiledSimCompiler::preprocess(
+    const std::string& path, const std::string& flags) const {
+
+    vector<string> includePaths = Environment::includeDirPaths();
+    string includes;
+    for (vector<string>::const_iterator it = includePaths.begin(); 
+        it != includePaths.end(); ++it) {
+        includes += "-I" + *it + " ";
+    }
+    const string command = 
+        "cd " + FileSystem::directoryOfPath(path) + " && " + compiler_ + 
+        " -E -P " + includes + COMPILED_SIM_CPP_FLAGS + globalCompileFlags_ + 
+        " " + flags + " " + FileSystem::fileOfPath(path) + " -o " + 
+        FileSystem::fileOfPath(preprocessedPath(path)) + " 2>/dev/null";
+    return system(command.c_str()) == 0;
+}
+
+/**
+ * Appends the compiler, the flags and the TCE version to a preprocessed
+ * simulation source file.
+ *
+ * The preprocessed source includes the engine header describing the
+ * simulated machine and all the simulator and system headers the object
+ * depends on, so after this the file identifies the compiled object.
+ *
+ * @param preprocessedPath Path to the preprocessed source file.
+ * @param flags Custom flags the file is compiled with.
+ * @return False if the file was missing or empty, in which case the
+ *         object is not to be cached.
+ */
+bool
+CompiledSimCompiler::finishPreprocessedSource(
+    const std::string& preprocessedPath, const std::string& flags) const {
+
+    std::ofstream file(
+        preprocessedPath.c_str(), 
+        std::ios::out | std::ios::binary | std::ios::app);
+    if (!file || file.tellp() <= 0) {
+        return false;
+    }
+    file << endl << "// " << compiler_ << COMPILED_SIM_CPP_FLAGS 
+         << COMPILED_SIM_SO_FLAGS << globalCompileFlags_ << flags << " "
+         << Application::TCEVersionString() << endl;
+    return file.good();
+}
+
+/**
+ * Tells whether two files have the same contents.
+ *
+ * @param path1 Path to the first file.
+ * @param path2 Path to the second file.
+ * @return True if both files could be read and their contents are equal.
+ */
+bool
+CompiledSimCompiler::sameContents(
+    const std::string& path1, const std::string& path2) {
+
+    std::ifstream file1(path1.c_str(), std::ios::binary);
+    std::ifstream file2(path2.c_str(), std::ios::binary);
+    if (!file1 || !file2) {
+        return false;
+    }
+    vector<char> block1(SOURCE_BLOCK_SIZE);
+    vector<char> block2(SOURCE_BLOCK_SIZE);
+    while (true) {
+        file1.read(&block1[0], block1.size());
+        file2.read(&block2[0], block2.size());
+        const std::streamsize count = file1.gcount();
+        if (count != file2.gcount() ||
+            std::memcmp(&block1[0], &block2[0], count) != 0) {
+            return false;
+        }
+        if (count == 0) {
+            return !file1.bad() && !file2.bad();
+        }
+    }
+}
+
+/**
+ * Copies a cached simulation object to the given path.
+ *
+ * The object is fetched only if its preprocessed source equals the given
+ * one. The fetched object is marked as recently used.
+ *
+ * @param key The cache key of the object.
+ * @param preprocessedPath Path to the preprocessed source of the object.
+ * @param soPath Path to copy the object to.
+ * @return True if the object was found from the cache.
+ */
+bool
+CompiledSimCompiler::fetchFromCache(
+    const std::string& key, 
+    const std::string& preprocessedPath,
+    const std::string& soPath) const {
+
+    const string cached = 
+        cacheDirectory_ + FileSystem::DIRECTORY_SEPARATOR + key;
+    if (!FileSystem::fileExists(cached + ".so") ||
+        !sameContents(cached + ".ii", preprocessedPath)) {
+        return false;
+    }
+    try {
+        FileSystem::copy(cached + ".so", soPath);
+    } catch (const IOException&) {
+        return false;
+    }
+    utime((cached + ".so").c_str(), NULL);
+    return true;
+}
+
+/**
+ * Adds a compiled simulation object and its preprocessed source to the
+ * cache.
+ *
+ * The files are first copied to temporary files which are then renamed,
+ * thus concurrent simulators never see partially written files. The
+ * object is renamed first, so its preprocessed source is never found
+ * without it.
+ *
+ * @param key The cache key of the object.
+ * @param preprocessedPath Path to the preprocessed source of the object.
+ * @param soPath Path to the compiled object.
+ */
+void
+CompiledSimCompiler::storeToCache(
+    const std::string& key, 
+    const std::string& preprocessedPath,
+    const std::string& soPath) const {
+
+    const string cached = 
+        cacheDirectory_ + FileSystem::DIRECTORY_SEPARATOR + key;
+    const string temp = "." + Conversion::toString(getpid());
+    try {
+        FileSystem::copy(soPath, cached + ".so" + temp);
+        FileSystem::copy(preprocessedPath, cached + ".ii" + temp);
+    } catch (const IOException&) {
+        FileSystem::removeFileOrDirectory(cached + ".so" + temp);
+        FileSystem::removeFileOrDirectory(cached + ".ii" + temp);
+        return;
+    }
+    if (std::rename(
+            (cached + ".so" + temp).c_str(), (cached + ".so").c_str()) != 0 ||
+        std::rename(
+            (cached + ".ii" + temp).c_str(), (cached + ".ii").c_str()) != 0) {
+        FileSystem::removeFileOrDirectory(cached + ".so" + temp);
+        FileSystem::removeFileOrDirectory(cached + ".ii" + temp);
+    }
 }
 
+/**
+ * Removes the least recently used objects from the cache until it is
+ * within its size limit.
+ */
+void
+CompiledSimCompiler::evictFromCache() const {
+
+    if (cacheSizeLimit_ == 0) {
+        return;
+    }
+
+    vector<string> objects;
+    FileSystem::globPath(
+        cacheDirectory_ + FileSystem::DIRECTORY_SEPARATOR + "*.so", objects);
+    // (last use, cache file path without the extension)
+    vector<std::pair<std::time_t, string> > entries;
+    uintmax_t totalSize = 0;
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        const string entry = 
+            objects[i].substr(0, objects[i].length() - 3);
+        const uintmax_t objectSize = FileSystem::sizeInBytes(objects[i]);
+        const uintmax_t sourceSize = FileSystem::sizeInBytes(entry + ".ii");
+        if (objectSize != static_cast<uintmax_t>(-1)) {
+            totalSize += objectSize;
+        }
+        if (sourceSize != static_cast<uintmax_t>(-1)) {
+            totalSize += sourceSize;
+        }
+        entries.push_back(
+            std::make_pair(
+                FileSystem::lastModificationTime(objects[i]), entry));
+    }
+
+    std::sort(entries.begin(), entries.end());
+    for (std::size_t i = 0; 
+         i < entries.size() && totalSize > cacheSizeLimit_; ++i) {
+        const string& entry = entries[i].second;
+        const uintmax_t objectSize = FileSystem::sizeInBytes(entry + ".so");
+        const uintmax_t sourceSize = FileSystem::sizeInBytes(entry + ".ii");
+        if (!FileSystem::removeFileOrDirectory(entry + ".so")) {
+            continue;
+        }
+        FileSystem::removeFileOrDirectory(entry + ".ii");
+        if (objectSize != static_cast<uintmax_t>(-1)) {
+            totalSize -= std::min(totalSize, objectSize);
+        }
+        if (sourceSize != static_cast<uintmax_t>(-1)) {
+            totalSize -= std::min(totalSize, sourceSize);
+        }
+    }
+}
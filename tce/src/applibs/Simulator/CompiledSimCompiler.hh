@@ -34,6 +34,7 @@
 #define COMPILED_SIM_COMPILER_HH
 
 #include <string>
+#include <stdint.h>
 
 /**
  * A class for compiling the dynamic libraries used by the compiled simulator
@@ -58,6 +59,8 @@ public:
         const std::string& path,
         const std::string& flags = "",
         bool verbose = false) const;
+
+    std::string cacheKey(const std::string& preprocessedPath) const;
     
     /// cpp flags used for compiled simulation
     static const char* COMPILED_SIM_CPP_FLAGS;
@@ -70,6 +73,22 @@ private:
     CompiledSimCompiler(const CompiledSimCompiler&);
     /// Assignment not allowed.
     CompiledSimCompiler& operator=(const CompiledSimCompiler&);
+
+    static std::string preprocessedPath(const std::string& path);
+    static bool sameContents(
+        const std::string& path1, const std::string& path2);
+    bool preprocess(const std::string& path, const std::string& flags) const;
+    bool finishPreprocessedSource(
+        const std::string& preprocessedPath, const std::string& flags) const;
+    bool fetchFromCache(
+        const std::string& key, 
+        const std::string& preprocessedPath,
+        const std::string& soPath) const;
+    void storeToCache(
+        const std::string& key, 
+        const std::string& preprocessedPath,
+        const std::string& soPath) const;
+    void evictFromCache() const;
     
     /// Number of threads to use while compiling through a Makefile
     int threadCount_;
@@ -77,6 +96,10 @@ private:
     std::string compiler_;
     /// Global compile flags (from env variable)
     std::string globalCompileFlags_;
+    /// Directory of the cached simulation objects, empty if not in use
+    std::string cacheDirectory_;
+    /// Size limit of the object cache in bytes, 0 if not limited
+    uintmax_t cacheSizeLimit_;
 };
 
 #endif
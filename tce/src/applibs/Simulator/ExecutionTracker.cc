@@ -32,6 +32,7 @@
 
 #include "ExecutionTracker.hh"
 #include "ExecutionTrace.hh"
+#include "InstructionTraceWriter.hh"
 #include "Application.hh"
 #include "TTASimulationController.hh"
 #include "SimulatorToolbox.hh"
@@ -42,36 +43,44 @@
  * Constructor.
  *
  * @param subject The SimulationController which is observed.
- * @param traceDB The Execution Trace Database instance in which the
- *                trace is stored. Expects that the database is open
- *                for writing.
+ * @param traceDB The Execution Trace Database instance whose instruction
+ *                trace file the trace is stored in. 
+ * @exception IOException If the instruction trace file cannot be created.
  */
 ExecutionTracker::ExecutionTracker(
     TTASimulationController& subject,
     ExecutionTrace& traceDB) : Listener(),
-    subject_(subject), traceDB_(traceDB) {
+    subject_(subject), traceDB_(traceDB), 
+    writer_(new InstructionTraceWriter(traceDB.instructionTraceFileName())) {
     subject.frontend().eventHandler().registerListener(
         SimulationEventHandler::SE_CYCLE_END, this);
 }
 
 /**
  * Destructor.
+ *
+ * Writes the rest of the trace to the file.
  */
 ExecutionTracker::~ExecutionTracker() {
     subject_.frontend().eventHandler().unregisterListener(
         SimulationEventHandler::SE_CYCLE_END, this);
+    delete writer_;
+    writer_ = NULL;
 }
 
 /**
- * Stores instruction execution data in the trace database.
+ * Stores instruction execution data in the instruction trace.
+ *
+ * The trace is the only per-cycle record of the execution, the
+ * instruction_execution table of the trace database is filled from it
+ * when queried, see ExecutionTrace::instructionExecutions().
  *
- * If any error happens while writing the data, aborts program with
- * an error message.
+ * If any error happens while writing the data, logs an error message.
  */
 void 
 ExecutionTracker::handleEvent() {
     try {
-        traceDB_.addInstructionExecution(
+        writer_->addInstructionExecution(
             subject_.clockCount(), subject_.lastExecutedInstruction());
     } catch (const Exception& e) {
         debugLog("Error while writing TraceDB: " + e.errorMessage());
@@ -37,11 +37,13 @@
 
 class TTASimulationController;
 class ExecutionTrace;
+class InstructionTraceWriter;
 
 /**
  * Tracks the simulation execution.
  *
- * Stores execution data in execution trace.
+ * Stores the executed instruction of each cycle to the binary instruction
+ * trace file of the execution trace.
  */
 class ExecutionTracker : public Listener {
 public:
@@ -57,6 +59,8 @@ private:
     TTASimulationController& subject_;
     /// the trace database to store the trace to
     ExecutionTrace& traceDB_;
+    /// the writer of the instruction trace file
+    InstructionTraceWriter* writer_;
 };
 
 #endif
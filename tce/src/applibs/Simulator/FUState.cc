@@ -68,7 +68,8 @@ FUState::FUState() :
     ClockedState(), idle_(false), trigger_(false),
     nextOperation_(NULL), nextExecutor_(NULL),
     operationContext_(DEFAULT_FU_NAME),
-    activeExecutors_(0), detailedModel_(NULL) {
+    activeExecutors_(0), detailedModel_(NULL), activeList_(NULL),
+    activeIndex_(0), inActiveList_(false) {
 }
 
 /**
@@ -79,7 +80,8 @@ FUState::FUState() :
 FUState::FUState(const TCEString& name) :
     ClockedState(), idle_(false), trigger_(false),
     nextOperation_(NULL), nextExecutor_(NULL), operationContext_(name),
-    activeExecutors_(0), detailedModel_(NULL) {
+    activeExecutors_(0), detailedModel_(NULL), activeList_(NULL),
+    activeIndex_(0), inActiveList_(false) {
 }
 
 /**
@@ -200,6 +202,32 @@ FUState::advanceClock() {
     idle_ = (activeExecutors_ == 0 && context().isEmpty());
 }
 
+/**
+ * Sets the list of the FUs of the machine that may be busy.
+ *
+ * The FU adds itself to the list whenever it is triggered, the owner of
+ * the list removes it once the FU is idle. The FU is added to the list
+ * at once, as it is not idle when created.
+ *
+ * @param list The active FU list.
+ * @param index The index this FU is listed with.
+ */
+void
+FUState::setActiveList(std::vector<std::size_t>& list, std::size_t index) {
+    activeList_ = &list;
+    activeIndex_ = index;
+    inActiveList_ = false;
+    addToActiveList();
+}
+
+/**
+ * Tells that the owner of the active list removed this FU from it.
+ */
+void
+FUState::removedFromActiveList() {
+    inActiveList_ = false;
+}
+
 /**
  * Adds new input port state.
  *
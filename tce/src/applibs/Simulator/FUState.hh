@@ -38,6 +38,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "ClockedState.hh"
 #include "PortState.hh"
@@ -82,6 +83,10 @@ public:
         Operation& op,
         OperationExecutor* newExecutor);
 
+    void setActiveList(std::vector<std::size_t>& list, std::size_t index);
+    void addToActiveList();
+    void removedFromActiveList();
+
     virtual OperationExecutor* executor(Operation& op);
 
     virtual OperationContext& context();
@@ -138,6 +143,12 @@ private:
     /// such model per FU or none at all for now (could be possible to
     /// be one model per Operation).
     DetailedOperationSimulator* detailedModel_;
+    /// Indices of the FUs that may be busy, NULL if not tracked.
+    std::vector<std::size_t>* activeList_;
+    /// Index of this FU in the active list.
+    std::size_t activeIndex_;
+    /// True if this FU is in the active list.
+    bool inActiveList_;
 };
 
 #include "FUState.icc"
@@ -33,6 +33,7 @@
 
 #include "InstructionMemory.hh"
 #include "ExecutableInstruction.hh"
+#include "SimProgramBuilder.hh"
 #include "SequenceTools.hh"
 #include "Application.hh"
 #include "Conversion.hh"
@@ -46,7 +47,26 @@
  */
 InstructionMemory::InstructionMemory(
     InstructionAddress startAddress) : 
-    startAddress_(startAddress) {
+    startAddress_(startAddress), builder_(NULL) {
+}
+
+/**
+ * Constructor for an instruction memory that is built on demand.
+ *
+ * Each instruction is built by the given builder when it is accessed
+ * for the first time.
+ *
+ * @param startAddress The starting address of the instruction memory.
+ * @param instructionCount The count of instructions in the memory.
+ * @param builder The builder of the instructions, becomes owned by the
+ *                memory.
+ */
+InstructionMemory::InstructionMemory(
+    InstructionAddress startAddress,
+    std::size_t instructionCount,
+    SimProgramBuilder* builder) : 
+    startAddress_(startAddress), instructions_(instructionCount, NULL),
+    builder_(builder) {
 }
 
 /**
@@ -59,6 +79,8 @@ InstructionMemory::~InstructionMemory() {
         delete (*i);
     }   
     instructions_.clear();
+    delete builder_;
+    builder_ = NULL;
 }
 
 /**
@@ -81,6 +103,52 @@ void
 InstructionMemory::resetExecutionCounts() {
     for (InstructionContainer::iterator i = instructions_.begin();
          i != instructions_.end(); ++i) {
-        (*i)->resetExecutionCounts();
+        if (*i != NULL) {
+            (*i)->resetExecutionCounts();
+        }
     }
 }
+
+/**
+ * Returns the execution count of the instruction at the given address.
+ *
+ * Unlike instructionAtConst(), does not build the instruction in case it
+ * has never been accessed, thus can be used for collecting statistics of
+ * the whole program cheaply.
+ *
+ * @param address The instruction memory address of the instruction.
+ * @return The count of times the instruction has been executed.
+ * @exception OutOfRange If the instruction address is out of range.
+ */
+ClockCycleCount
+InstructionMemory::executionCount(InstructionAddress address) const {
+
+    const std::size_t index = address - startAddress_;
+    if (index >= instructions_.size()) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__, 
+            "Illegal instruction address " + 
+            Conversion::toString(address) + ".");
+    }
+    if (instructions_[index] == NULL) {
+        return 0;
+    }
+    return instructions_[index]->executionCount();
+}
+
+/**
+ * Builds the instruction at the given index on its first access.
+ *
+ * @param index The index of the instruction in the memory.
+ * @return The built instruction.
+ * @exception IllegalProgram If the instruction cannot be built.
+ */
+ExecutableInstruction&
+InstructionMemory::buildInstruction(std::size_t index) const {
+
+    assert(builder_ != NULL);
+    ExecutableInstruction* instruction = 
+        builder_->buildInstruction(startAddress_ + index);
+    instructions_[index] = instruction;
+    return *instruction;
+}
@@ -40,19 +40,28 @@
 #include "BaseType.hh"
 
 class ExecutableInstruction;
+class SimProgramBuilder;
 
 /**
  * Container for ExecutableInstructions.
+ *
+ * The instructions can be either added up front or built on demand on
+ * their first access by a SimProgramBuilder owned by the memory.
  */
 class InstructionMemory {
 public:
     InstructionMemory(InstructionAddress startAddress);
+    InstructionMemory(
+        InstructionAddress startAddress,
+        std::size_t instructionCount,
+        SimProgramBuilder* builder);
     virtual ~InstructionMemory();
     
     void addExecutableInstruction(ExecutableInstruction* instruction);
     ExecutableInstruction& instructionAt(InstructionAddress address);
     const ExecutableInstruction& instructionAtConst(
         InstructionAddress address) const;
+    ClockCycleCount executionCount(InstructionAddress address) const;
 
     void resetExecutionCounts();
 
@@ -62,14 +71,18 @@ private:
     /// Assignment not allowed.
     InstructionMemory& operator=(const InstructionMemory&);
 
+    ExecutableInstruction& buildInstruction(std::size_t index) const;
+
     /// Container for instructions.
     typedef std::vector<ExecutableInstruction*> InstructionContainer;
 
     /// The starting address of the instruction memory address space.
     InstructionAddress startAddress_;
 
-    /// All the instructions of the memory.
-    InstructionContainer instructions_;
+    /// All the instructions of the memory, NULL for the ones not built yet.
+    mutable InstructionContainer instructions_;
+    /// Builds the missing instructions on demand, NULL if all were added.
+    SimProgramBuilder* builder_;
 };
 
 #include  "InstructionMemory.icc"
@@ -155,6 +155,18 @@ LongImmediateUnitState::advanceClock() {
     }
 }
 
+/**
+ * Returns true if there are no pending register value updates.
+ *
+ * The clock of an idle unit need not be advanced.
+ *
+ * @return True if the update queue is empty.
+ */
+bool
+LongImmediateUnitState::isIdle() const {
+    return queue_.empty();
+}
+
 /**
  * Returns the register of the given index.
  *
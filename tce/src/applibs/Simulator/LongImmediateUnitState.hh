@@ -70,6 +70,8 @@ public:
     virtual void endClock();
     virtual void advanceClock();
 
+    bool isIdle() const;
+
 private:
     /// Copying not allowed.
     LongImmediateUnitState(const LongImmediateUnitState&);
@@ -79,6 +79,7 @@ MachineState::clear() {
     // Clear all caches
     busCache_.clear();
     fuCache_.clear();
+    activeFUs_.clear();
     portCache_.clear();
     longImmediateCache_.clear();
     rfCache_.clear();
@@ -266,6 +267,7 @@ void
 MachineState::addFUState(FUState* state, const std::string& name) {
     FUStates_[name] = state;
     fuCache_.push_back(state);
+    state->setActiveList(activeFUs_, fuCache_.size() - 1);
 }
 
 /**
@@ -326,7 +328,12 @@ MachineState::addGuardState(
     const TTAMachine::Guard& guard) {
 
     guards_[&guard] = state;
-    guardCache_.push_back(state);
+    // only guards with latency over one keep a value history that needs
+    // clocking, the rest read the guarded register directly
+    if (dynamic_cast<OneClockGuardState*>(state) == NULL &&
+        dynamic_cast<NullGuardState*>(state) == NULL) {
+        guardCache_.push_back(state);
+    }
 }
 
 /**
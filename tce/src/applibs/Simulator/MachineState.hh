@@ -34,6 +34,7 @@
 #ifndef TTA_MACHINE_STATE_HH
 #define TTA_MACHINE_STATE_HH
 
+#include <algorithm>
 #include <string>
 #include <map>
 #include <vector>
@@ -73,6 +74,7 @@ public:
     FUState& fuState(int index);
     void advanceClockOfAllFUStates();
     void endClockOfAllFUStates();
+    std::size_t activeFUStateCount() const;
     void advanceClockOfAllGuardStates();
     void advanceClockOfAllLongImmediateUnitStates();
     void resetAllFUs();
@@ -154,9 +156,13 @@ private:
     // Contains all states in vectors that are faster to iterate than maps.
     BusCache busCache_;
     FUCache fuCache_;
+    /// Indices of the FUs in fuCache_ that may be busy. The idle FUs are
+    /// removed from it when advancing the clock.
+    std::vector<std::size_t> activeFUs_;
     PortCache portCache_;
     LongImmediateUnitCache longImmediateCache_;
     RegisterFileCache rfCache_;
+    /// Only the guard states that need clocking (latency over one).
     GuardCache guardCache_;
 };
 
@@ -46,6 +46,8 @@
 #include "Operation.hh"
 #include "Machine.hh"
 #include "Program.hh"
+#include "CodeSnippet.hh"
+#include "Address.hh"
 
 /**
  * Constructor.
@@ -81,10 +83,26 @@ ProcedureTransferTracker::~ProcedureTransferTracker() {
 void 
 ProcedureTransferTracker::handleEvent() {
 
+    const InstructionAddress address = subject_.lastExecutedInstruction();
+
+    // usually the executed instruction is in the same procedure as the
+    // previous one, in which case it's found without searching the whole
+    // program
+    if (previousInstruction_ != NULL && 
+        previousInstruction_->isInProcedure()) {
+        const TTAProgram::CodeSnippet& procedure = 
+            previousInstruction_->parent();
+        if (procedure.startAddress().location() <= address &&
+            procedure.endAddress().location() > address) {
+            previousInstruction_ = &procedure.instructionAt(address);
+            return;
+        }
+    }
+
     // the instruction that WAS executed in the current cycle (this handles
     // clock cycle *end* events)
     const TTAProgram::Instruction& currentInstruction =
-        subject_.program().instructionAt(subject_.lastExecutedInstruction());
+        subject_.program().instructionAt(address);
 
     if (!currentInstruction.isInProcedure() ||
         (previousInstruction_ != NULL && &(currentInstruction.parent()) == 
@@ -63,7 +63,9 @@
 RFAccessTracker::RFAccessTracker(
     SimulatorFrontend& frontend, 
     const InstructionMemory& instructions) : 
-    frontend_(frontend), instructionExecutions_(instructions) {
+    frontend_(frontend), instructionExecutions_(instructions),
+    instructionAccesses_(frontend.program().instructionCount(), NULL),
+    startAddress_(frontend.program().startAddress().location()) {
     frontend.eventHandler().registerListener(
         SimulationEventHandler::SE_CYCLE_END, this);
     frontend.eventHandler().registerListener(
@@ -74,10 +76,104 @@ RFAccessTracker::RFAccessTracker(
  * Destructor.
  */
 RFAccessTracker::~RFAccessTracker() {
-    frontend_.eventHandler().registerListener(
+    frontend_.eventHandler().unregisterListener(
         SimulationEventHandler::SE_CYCLE_END, this);
     frontend_.eventHandler().unregisterListener(
         SimulationEventHandler::SE_SIMULATION_STOPPED, this);
+
+    for (std::size_t i = 0; i < instructionAccesses_.size(); ++i) {
+        if (instructionAccesses_[i] != &noConditionalAccesses_) {
+            delete instructionAccesses_[i];
+        }
+    }
+}
+
+/**
+ * Returns the index of the given register file in the access counters.
+ *
+ * @param rfName Name of the register file.
+ * @return The index of the register file.
+ */
+int
+RFAccessTracker::registerFileIndex(const std::string& rfName) {
+    std::map<std::string, int>::const_iterator i = rfIndices_.find(rfName);
+    if (i != rfIndices_.end()) {
+        return (*i).second;
+    }
+    const int index = rfNames_.size();
+    rfIndices_[rfName] = index;
+    rfNames_.push_back(rfName);
+    conditionalAccesses_.push_back(AccessCountTable());
+    readsInInstruction_.push_back(0);
+    writesInInstruction_.push_back(0);
+    return index;
+}
+
+/**
+ * Returns the register file accesses of the moves of the instruction at
+ * the given address.
+ *
+ * The accesses are collected from the program on the first execution of
+ * the instruction. Instructions without conditional register file accesses
+ * return an empty list as their accesses are counted from the instruction
+ * execution counts at the end of simulation.
+ *
+ * @param address The address of the instruction.
+ * @return The register file accesses of the moves of the instruction.
+ */
+const RFAccessTracker::MoveRFAccessList&
+RFAccessTracker::conditionalRFAccesses(InstructionAddress address) {
+
+    const std::size_t index = address - startAddress_;
+    if (index >= instructionAccesses_.size()) {
+        instructionAccesses_.resize(index + 1, NULL);
+    }
+    const MoveRFAccessList* accesses = instructionAccesses_[index];
+    if (accesses != NULL) {
+        return *accesses;
+    }
+
+    const TTAProgram::Instruction& instruction = 
+        frontend_.program().instructionAt(address);
+    if (!instruction.hasConditionalRegisterAccesses()) {
+        instructionAccesses_[index] = &noConditionalAccesses_;
+        return noConditionalAccesses_;
+    }
+
+    MoveRFAccessList* moveAccesses = 
+        new MoveRFAccessList(instruction.moveCount());
+    for (int i = 0; i < instruction.moveCount(); ++i) {
+        const TTAProgram::Move& move = instruction.move(i);
+        MoveRFAccess& access = (*moveAccesses)[i];
+        access.readRF = move.source().isGPR() ?
+            registerFileIndex(move.source().registerFile().name()) : -1;
+        access.writeRF = move.destination().isGPR() ?
+            registerFileIndex(move.destination().registerFile().name()) : -1;
+    }
+    instructionAccesses_[index] = moveAccesses;
+    return *moveAccesses;
+}
+
+/**
+ * Counts a cycle with the given concurrent accesses to a register file.
+ *
+ * @param rfIndex Index of the register file.
+ * @param writes Count of concurrent writes.
+ * @param reads Count of concurrent reads.
+ */
+void
+RFAccessTracker::addConditionalAccess(
+    int rfIndex, std::size_t writes, std::size_t reads) {
+
+    AccessCountTable& counts = conditionalAccesses_[rfIndex];
+    if (writes >= counts.size()) {
+        counts.resize(writes + 1);
+    }
+    std::vector<ClockCycleCount>& readCounts = counts[writes];
+    if (reads >= readCounts.size()) {
+        readCounts.resize(reads + 1, 0);
+    }
+    ++readCounts[reads];
 }
 
 /**
@@ -99,13 +195,16 @@ RFAccessTracker::handleEvent(int event) {
         while (currentInstruction != 
                &TTAProgram::NullInstruction::instance()) {
             
-            const ExecutableInstruction& execInstruction = 
-                instructionExecutions_.instructionAtConst(
-                    currentInstruction->address().location());
-            
             if (!currentInstruction->hasRegisterAccesses() ||
-                currentInstruction->hasConditionalRegisterAccesses() ||
-                execInstruction.executionCount() == 0) {
+                currentInstruction->hasConditionalRegisterAccesses()) {
+                currentInstruction = &program.nextInstruction(*currentInstruction);
+                continue;
+            }
+
+            const ClockCycleCount executionCount = 
+                instructionExecutions_.executionCount(
+                    currentInstruction->address().location());
+            if (executionCount == 0) {
                 currentInstruction = &program.nextInstruction(*currentInstruction);
                 continue;
             }           
@@ -131,54 +230,66 @@ RFAccessTracker::handleEvent(int event) {
 
                 ConcurrentRFAccess key(
                     (*i).first, (*i).second.get<0>(), (*i).second.get<1>());
-                totalAccesses_[key] += execInstruction.executionCount();
+                totalAccesses_[key] += executionCount;
             }
                 
             currentInstruction = &program.nextInstruction(*currentInstruction);
         }
 
         // add the access data of the instruction with the conditional accesses
-        ConcurrentRFAccessIndex::iterator i = conditionalAccesses_.begin();
-        for (; i != conditionalAccesses_.end(); ++i) {
-            ConcurrentRFAccess key = (*i).first;
-            totalAccesses_[key] += conditionalAccesses_[key];
+        for (std::size_t rf = 0; rf < conditionalAccesses_.size(); ++rf) {
+            const AccessCountTable& counts = conditionalAccesses_[rf];
+            for (std::size_t w = 0; w < counts.size(); ++w) {
+                for (std::size_t r = 0; r < counts[w].size(); ++r) {
+                    if (counts[w][r] == 0) {
+                        continue;
+                    }
+                    totalAccesses_[boost::make_tuple(rfNames_[rf], w, r)] +=
+                        counts[w][r];
+                }
+            }
         }
 
     } else if (event == SimulationEventHandler::SE_CYCLE_END) {
 
         const InstructionAddress& address = 
             frontend_.lastExecutedInstruction();
-        const TTAProgram::Instruction& instruction = 
-            frontend_.program().instructionAt(address);
-        if (!instruction.hasConditionalRegisterAccesses())
+        const MoveRFAccessList& accesses = conditionalRFAccesses(address);
+        if (accesses.empty())
             return;
 
-        accessesInInstruction_.clear();
-
         const ExecutableInstruction& execInstruction = 
             instructionExecutions_.instructionAtConst(address);
 
-        for (int i = 0; i < instruction.moveCount(); ++i) {
+        for (std::size_t i = 0; i < accesses.size(); ++i) {
             if (execInstruction.moveSquashed(i))
                 continue;
-            const TTAProgram::Move& move = instruction.move(i);
-            if (move.source().isGPR()) {
-                ++accessesInInstruction_[
-                    move.source().registerFile().name().c_str()].get<1>();
+            const MoveRFAccess& access = accesses[i];
+            if (access.readRF != -1) {
+                if (readsInInstruction_[access.readRF] == 0 &&
+                    writesInInstruction_[access.readRF] == 0) {
+                    rfsInInstruction_.push_back(access.readRF);
+                }
+                ++readsInInstruction_[access.readRF];
             }
 
-            if (move.destination().isGPR()) {
-                ++accessesInInstruction_[
-                    move.destination().registerFile().name().c_str()].get<0>();
+            if (access.writeRF != -1) {
+                if (readsInInstruction_[access.writeRF] == 0 &&
+                    writesInInstruction_[access.writeRF] == 0) {
+                    rfsInInstruction_.push_back(access.writeRF);
+                }
+                ++writesInInstruction_[access.writeRF];
             }
         }
 
-        for (RFAccessIndex::iterator i = accessesInInstruction_.begin();
-             i != accessesInInstruction_.end(); ++i) {
-            ++conditionalAccesses_[boost::make_tuple(
-                                       (*i).first, (*i).second.get<0>(), 
-                                       (*i).second.get<1>())];
+        for (std::size_t i = 0; i < rfsInInstruction_.size(); ++i) {
+            const int rf = rfsInInstruction_[i];
+            addConditionalAccess(
+                rf, writesInInstruction_[rf], readsInInstruction_[rf]);
+            writesInInstruction_[rf] = 0;
+            readsInInstruction_[rf] = 0;
         }
+        rfsInInstruction_.clear();
     } else {
         abortWithError("RFAccessTracker received an unknown event.");
     }
@@ -35,6 +35,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "boost/tuple/tuple.hpp"
 
@@ -80,17 +81,54 @@ private:
         const char*, /* funame */
         boost::tuple<std::size_t /* writes */, std::size_t /* reads */> >
     RFAccessIndex;
+    /// Register files read and written by a move as indices to rfNames_,
+    /// -1 in case the move does not access a register file.
+    struct MoveRFAccess {
+        int readRF;
+        int writeRF;
+    };
+    /// Register file accesses of the moves of an instruction.
+    typedef std::vector<MoveRFAccess> MoveRFAccessList;
+    /// Access counts of a register file indexed by the count of concurrent
+    /// writes and the count of concurrent reads.
+    typedef std::vector<std::vector<ClockCycleCount> > AccessCountTable;
+
+    const MoveRFAccessList& conditionalRFAccesses(
+        InstructionAddress address);
+    int registerFileIndex(const std::string& rfName);
+    void addConditionalAccess(
+        int rfIndex, std::size_t writes, std::size_t reads);
+
     /// the simulator frontend used to access simulation data
     SimulatorFrontend& frontend_;
     /// used to access instruction execution data
     const InstructionMemory& instructionExecutions_;
-    /// conditional register file accesses are counted in this container
-    ConcurrentRFAccessIndex conditionalAccesses_;  
+    /// conditional register file accesses are counted in this container,
+    /// indexed by the register file index
+    std::vector<AccessCountTable> conditionalAccesses_;
     /// total (conditional + unconditional) register file accesses are counted
     /// in this container
     ConcurrentRFAccessIndex totalAccesses_;  
     /// container used in collecting register accesses in an instruction
     RFAccessIndex accessesInInstruction_;
+    /// register file accesses of the executed instructions that have
+    /// conditional register file accesses, indexed by the offset of the
+    /// instruction address, NULL for instructions not analyzed yet
+    std::vector<const MoveRFAccessList*> instructionAccesses_;
+    /// shared by the instructions without conditional register accesses
+    const MoveRFAccessList noConditionalAccesses_;
+    /// the address of the first instruction of the program
+    InstructionAddress startAddress_;
+    /// names of the accessed register files by their indices
+    std::vector<std::string> rfNames_;
+    /// indices of the accessed register files by their names
+    std::map<std::string, int> rfIndices_;
+    /// counts of reads from each register file in the current instruction
+    std::vector<std::size_t> readsInInstruction_;
+    /// counts of writes to each register file in the current instruction
+    std::vector<std::size_t> writesInInstruction_;
+    /// register files accessed in the current instruction
+    std::vector<int> rfsInInstruction_;
 };
 
 #endif
@@ -644,6 +644,84 @@ public:
     }
 };
 
+/**
+ * Setting action that sets the flat memory model usage.
+ */
+class SetFlatMemoryModel {
+public:
+
+    /**
+     * Sets the flat memory model usage.
+     *
+     * @param interpreter To use to set the setting.
+     * @param newValue Value to set.
+     * @return True if setting was successful.
+     */
+    static bool execute(
+        SimulatorInterpreter&, SimulatorFrontend& simFront, bool newValue) {
+        simFront.setFlatMemoryModel(newValue);
+        return true;
+    }
+
+    /**
+     * Returns the default value of this setting.
+     *
+     * @return The default value.
+     */
+    static const DataObject& defaultValue() {
+        static DataObject defaultValue_("0");
+        return defaultValue_;
+    }
+    
+    /**
+     * Should the action warn if program & machine exist and value was changed
+     * 
+     * @return boolean value on whether or not to warn
+     */
+    static bool warnOnExistingProgramAndMachine() {
+        return true;
+    }
+};
+
+/**
+ * Setting action that sets the lazy building of the executable instructions.
+ */
+class SetLazyInstructionBuilding {
+public:
+
+    /**
+     * Sets the lazy building of the executable instructions.
+     *
+     * @param interpreter To use to set the setting.
+     * @param newValue Value to set.
+     * @return True if setting was successful.
+     */
+    static bool execute(
+        SimulatorInterpreter&, SimulatorFrontend& simFront, bool newValue) {
+        simFront.setLazyInstructionBuilding(newValue);
+        return true;
+    }
+
+    /**
+     * Returns the default value of this setting.
+     *
+     * @return The default value.
+     */
+    static const DataObject& defaultValue() {
+        static DataObject defaultValue_("1");
+        return defaultValue_;
+    }
+    
+    /**
+     * Should the action warn if program & machine exist and value was changed
+     * 
+     * @return boolean value on whether or not to warn
+     */
+    static bool warnOnExistingProgramAndMachine() {
+        return true;
+    }
+};
+
 /**
  * Constructor.
  *
@@ -695,6 +773,20 @@ SettingCommand::SettingCommand() :
                 SimulatorToolbox::textGenerator().text(
                     Texts::TXT_INTERP_SETTING_MEMORY_ACCESS_TRACKING).
                 str());
+
+    settings_["flat_memory"] =
+        new TemplatedSimulatorSetting<
+            BooleanSetting, SetFlatMemoryModel>(
+                SimulatorToolbox::textGenerator().text(
+                    Texts::TXT_INTERP_SETTING_FLAT_MEMORY).
+                str());
+
+    settings_["lazy_instruction_building"] =
+        new TemplatedSimulatorSetting<
+            BooleanSetting, SetLazyInstructionBuilding>(
+                SimulatorToolbox::textGenerator().text(
+                    Texts::TXT_INTERP_SETTING_LAZY_INSTRUCTION_BUILDING).
+                str());
     
     settings_["utilization_data_saving"] =
         new TemplatedSimulatorSetting<
@@ -31,6 +31,8 @@
  * @note rating: red
  */
 
+#include <memory>
+
 #include "boost/format.hpp"
 
 #include "SimProgramBuilder.hh"
@@ -88,7 +90,8 @@ using namespace TTAProgram;
  * Constructor.
  */
 SimProgramBuilder::SimProgramBuilder() : 
-    sequentialProgram_(false) {
+    sequentialProgram_(false), program_(NULL), state_(NULL),
+    lastProcedure_(NULL) {
 }
 
 /**
@@ -259,25 +262,12 @@ SimProgramBuilder::processMove(const Move& move, MachineState& state) {
     InlineImmediateValue* immediateSource = NULL;
 
     if (move.source().isImmediate()) {
+        checkJumpImmediate(move);
         // extend the immediate so we don't have to extend it
         // during runtime every time the move is simulated
         immediateSource = new InlineImmediateValue(move.bus().width());
         long immediate = move.source().value().sLongWordValue();
 
-        if (move.isControlFlowMove()) {
-            int targetWidth = move.destination().port().width();
-            if (targetWidth < MathTools::requiredBits(immediate)) {
-                TCEString errorMsg = 
-                    (boost::format(
-                        "Immediate of jump '%s' gets clipped due to the target "
-                        "port being too narrow. Wrong execution would occur.") 
-                     % move.toString()).str();
-                throw IllegalProgram(
-                    __FILE__, __LINE__, __func__, errorMsg);
-
-            }
-        }
-
         if (move.bus().signExtends()) {
             immediate = 
                 MathTools::signExtendTo(
@@ -294,13 +284,7 @@ SimProgramBuilder::processMove(const Move& move, MachineState& state) {
         source = processSourceTerminal(move.source(), state);
     }
     
-    BusState& bus = state.busState(move.bus().name());
-    if (&bus == &NullBusState::instance()) {
-        throw IllegalProgram(
-	    __FILE__, __LINE__, __func__, 
-	    SimulatorToolbox::textGenerator().text(
-            Texts::TXT_ILLEGAL_PROGRAM_BUS_STATE_NOT_FOUND).str());	
-    }
+    BusState& bus = findBusState(move, state);
     
     WritableState& destination = 
         *processBidirTerminal(move.destination(), state);
@@ -380,6 +364,135 @@ SimProgramBuilder::processMove(const Move& move, MachineState& state) {
     return NULL;
 }
 
+/**
+ * Checks that the immediate of a control flow move fits its target port.
+ *
+ * @param move The move with an immediate source.
+ * @exception IllegalProgram If the immediate would get clipped.
+ */
+void
+SimProgramBuilder::checkJumpImmediate(const Move& move) {
+    if (!move.isControlFlowMove()) {
+        return;
+    }
+    long immediate = move.source().value().sLongWordValue();
+    int targetWidth = move.destination().port().width();
+    if (targetWidth < MathTools::requiredBits(immediate)) {
+        TCEString errorMsg = 
+            (boost::format(
+                "Immediate of jump '%s' gets clipped due to the target "
+                "port being too narrow. Wrong execution would occur.") 
+             % move.toString()).str();
+        throw IllegalProgram(
+            __FILE__, __LINE__, __func__, errorMsg);
+    }
+}
+
+/**
+ * Finds the state of the bus of the given move.
+ *
+ * @param move The move.
+ * @param state The MachineState the move refers to.
+ * @return The bus state.
+ * @exception IllegalProgram If the machine state has no such bus.
+ */
+BusState&
+SimProgramBuilder::findBusState(const Move& move, MachineState& state) {
+    BusState& bus = state.busState(move.bus().name());
+    if (&bus == &NullBusState::instance()) {
+        throw IllegalProgram(
+	    __FILE__, __LINE__, __func__, 
+	    SimulatorToolbox::textGenerator().text(
+            Texts::TXT_ILLEGAL_PROGRAM_BUS_STATE_NOT_FOUND).str());	
+    }
+    return bus;
+}
+
+/**
+ * Finds the long immediate register the given immediate is written to.
+ *
+ * @param immediate The long immediate of an instruction.
+ * @param state The MachineState the immediate refers to.
+ * @return The register state.
+ * @exception IllegalProgram If the machine state has no such register.
+ */
+LongImmediateRegisterState&
+SimProgramBuilder::findImmediateRegister(
+    const Immediate& immediate, MachineState& state) {
+
+    assert(immediate.destination().isImmediateRegister());
+
+    // first fetch the LongImmediateUnitState, then fetch the
+    // LongImmediateRegisterState from it, because there is no such 
+    // object in MOM as LongImmediateRegister, nor any single registers
+    try {
+        LongImmediateUnitState& targetUnit = state.longImmediateUnitState(
+            immediate.destination().immediateUnit().name());
+
+        LongImmediateRegisterState& destination =
+            targetUnit.immediateRegister(immediate.destination().index());
+
+        if (&targetUnit == &NullLongImmediateUnitState::instance()) {
+            throw IllegalProgram(
+                __FILE__, __LINE__, __func__, 
+                SimulatorToolbox::textGenerator().text(
+                    Texts::TXT_ILLEGAL_PROGRAM_IU_STATE_NOT_FOUND).str());
+        }
+        return destination;
+    } catch (const IllegalParameters&) {
+        throw IllegalProgram(
+            __FILE__, __LINE__, __func__, 
+            SimulatorToolbox::textGenerator().text(
+                Texts::TXT_ILLEGAL_PROGRAM_IU_STATE_NOT_FOUND).str());
+    } catch (const OutOfRange&) {
+        throw IllegalProgram(
+            __FILE__, __LINE__, __func__, 
+            SimulatorToolbox::textGenerator().text(
+                Texts::TXT_ILLEGAL_PROGRAM_IU_STATE_NOT_FOUND).str());
+    }
+}
+
+/**
+ * Checks that a POM Instruction can be converted to an
+ * ExecutableInstruction, without creating it.
+ *
+ * Does the same state lookups and checks as processInstruction().
+ *
+ * @param instruction The instruction to check.
+ * @param state The MachineState the program refers to.
+ * @exception IllegalProgram If the instruction is illegal.
+ */
+void
+SimProgramBuilder::checkInstruction(
+    const Instruction& instruction, MachineState& state) {
+
+    for (int i = 0; i < instruction.immediateCount(); ++i) {
+        findImmediateRegister(instruction.immediate(i), state);
+    }
+
+    for (int j = 0; j < instruction.moveCount(); ++j) {
+        const Move& move = instruction.move(j);
+        try {
+            if (move.source().isImmediate()) {
+                checkJumpImmediate(move);
+            } else {
+                processSourceTerminal(move.source(), state);
+            }
+            findBusState(move, state);
+            processBidirTerminal(move.destination(), state);
+            if (!move.isUnconditional()) {
+                findGuardModel(move.guard().guard(), state);
+            }
+        } catch (const IllegalProgram& e) {
+            IllegalProgram ip(
+                e.fileName(), e.lineNum(), e.procedureName(),
+                e.errorMessage() + " Illegal move: " + 
+                POMDisassembler::disassemble(move));
+            throw ip;
+        }
+    }
+}
+
 /**
  * Processes a POM Instruction and produces an ExecutableInstruction.
  *
@@ -395,40 +508,11 @@ SimProgramBuilder::processInstruction(
 
     // process long immediates
     for (int i = 0; i < instruction.immediateCount(); ++i) {
-        assert(instruction.immediate(i).destination().isImmediateRegister());
-
-        // first fetch the LongImmediateUnitState, then fetch the
-        // LongImmediateRegisterState from it, because there is no such 
-        // object in MOM as LongImmediateRegister, nor any single registers
-        LongImmediateRegisterState* destination = NULL;
-        try {
-            LongImmediateUnitState& targetUnit = state.longImmediateUnitState(
-                instruction.immediate(i).destination().immediateUnit().name());
-
-            destination = &targetUnit.immediateRegister(
-                instruction.immediate(i).destination().index());
-
-            if (&targetUnit == &NullLongImmediateUnitState::instance()) {
-                throw IllegalProgram(
-                    __FILE__, __LINE__, __func__, 
-                    SimulatorToolbox::textGenerator().text(
-                        Texts::TXT_ILLEGAL_PROGRAM_IU_STATE_NOT_FOUND).str());
-            }
-        } catch (const IllegalParameters&) {
-            throw IllegalProgram(
-                __FILE__, __LINE__, __func__, 
-                SimulatorToolbox::textGenerator().text(
-                    Texts::TXT_ILLEGAL_PROGRAM_IU_STATE_NOT_FOUND).str());
-        } catch (const OutOfRange&) {
-            throw IllegalProgram(
-                __FILE__, __LINE__, __func__, 
-                SimulatorToolbox::textGenerator().text(
-                    Texts::TXT_ILLEGAL_PROGRAM_IU_STATE_NOT_FOUND).str());
-        }
-
+        LongImmediateRegisterState& destination =
+            findImmediateRegister(instruction.immediate(i), state);
         processedInstruction->addLongImmediateUpdateAction(
             new LongImmUpdateAction(instruction.immediate(i).value().value(),
-                                    *destination));
+                                    destination));
     }
     
     // process all the moves in the instruction
@@ -496,3 +580,112 @@ SimProgramBuilder::build(const Program& prog, MachineState& state) {
 
     return memory;
 }
+
+/**
+ * Creates an instruction memory that builds its instructions on demand.
+ *
+ * Only the instructions that are accessed get converted to their executable
+ * form, which keeps the simulator startup time and memory consumption low
+ * for large programs of which only a part gets executed. All the
+ * instructions are still checked, so an illegal program is rejected here
+ * like in build().
+ *
+ * @param prog Program from which the contents of instruction memory is
+ *             built. Must outlive the returned memory.
+ * @param state The MachineState the program refers to. Must outlive the
+ *              returned memory.
+ * @return The created instruction memory, owned by client.
+ * @exception IllegalProgram If the program is illegal.
+ */
+InstructionMemory*
+SimProgramBuilder::buildLazily(const Program& prog, MachineState& state) {
+    std::unique_ptr<SimProgramBuilder> builder(new SimProgramBuilder());
+    builder->sequentialProgram_ = 
+        (dynamic_cast<const UniversalMachine*>(
+            &prog.targetProcessor()) != NULL);
+    builder->program_ = &prog;
+    builder->state_ = &state;
+
+    const TTAProgram::Instruction* currentInstruction = NULL;
+    try {
+        for (int procIndex = 0; procIndex < prog.procedureCount(); 
+             ++procIndex) {
+            const Procedure& proc = prog.procedureAtIndex(procIndex);
+            for (int instrIndex = 0; instrIndex < proc.instructionCount(); 
+                 ++instrIndex) {
+                currentInstruction = &proc.instructionAtIndex(instrIndex);
+                builder->checkInstruction(*currentInstruction, state);
+            }
+        }
+    } catch (const Exception& e) {
+        throw IllegalProgram(
+            __FILE__, __LINE__, __func__, 
+            (boost::format("Error while processing instruction %d "
+                           "(with moves %s): %s") 
+             % currentInstruction->address().location()
+             % POMDisassembler::disassemble(*currentInstruction) 
+             % e.errorMessage()).str());
+    }
+
+    return new InstructionMemory(
+        prog.startAddress().location(), prog.instructionCount(),
+        builder.release());
+}
+
+/**
+ * Builds the executable instruction at the given address of the program
+ * given to buildLazily().
+ *
+ * Consecutive instructions are usually found from the same procedure, thus
+ * the procedure of the previous instruction is tried first.
+ *
+ * @param address The address of the instruction.
+ * @return The built instruction, owned by client.
+ * @exception IllegalProgram If there is no instruction at the address or
+ *                           building it fails.
+ */
+ExecutableInstruction*
+SimProgramBuilder::buildInstruction(InstructionAddress address) {
+    assert(program_ != NULL && state_ != NULL);
+
+    if (lastProcedure_ == NULL ||
+        lastProcedure_->startAddress().location() > address ||
+        lastProcedure_->endAddress().location() <= address) {
+
+        lastProcedure_ = NULL;
+        for (int i = 0; i < program_->procedureCount(); ++i) {
+            const Procedure& proc = program_->procedureAtIndex(i);
+            if (proc.startAddress().location() <= address &&
+                proc.endAddress().location() > address) {
+                lastProcedure_ = &proc;
+                break;
+            }
+        }
+        if (lastProcedure_ == NULL) {
+            throw IllegalProgram(
+                __FILE__, __LINE__, __func__, 
+                (boost::format("No instruction at address %d.") 
+                 % address).str());
+        }
+    }
+
+    const TTAProgram::Instruction* instruction = NULL;
+    try {
+        instruction = &lastProcedure_->instructionAt(address);
+    } catch (const KeyNotFound& e) {
+        throw IllegalProgram(
+            __FILE__, __LINE__, __func__, e.errorMessage());
+    }
+
+    try {
+        return processInstruction(*instruction, *state_);
+    } catch (const Exception& e) {
+        throw IllegalProgram(
+            __FILE__, __LINE__, __func__, 
+            (boost::format("Error while processing instruction %d "
+                           "(with moves %s): %s") 
+             % address
+             % POMDisassembler::disassemble(*instruction) 
+             % e.errorMessage()).str());
+    }
+}
@@ -35,6 +35,7 @@
 #define TTA_SIM_PROGRAM_BUILDER_HH
 
 #include "Exception.hh"
+#include "SimulatorConstants.hh"
 
 class StateLocator;
 class InstructionMemory;
@@ -43,6 +44,8 @@ class ExecutableMove;
 class MachineState;
 class StateData;
 class ReadableState;
+class BusState;
+class LongImmediateRegisterState;
 
 namespace TTAMachine {
     class Guard;
@@ -50,9 +53,11 @@ namespace TTAMachine {
 
 namespace TTAProgram {
     class Instruction;
+    class Immediate;
     class Move;
     class Terminal;
     class Program;
+    class Procedure;
 }
 
 /**
@@ -67,6 +72,11 @@ public:
     InstructionMemory* build(
         const TTAProgram::Program& prog, MachineState& state);
 
+    static InstructionMemory* buildLazily(
+        const TTAProgram::Program& prog, MachineState& state);
+
+    ExecutableInstruction* buildInstruction(InstructionAddress address);
+
 private:
     /// Copying not allowed.
     SimProgramBuilder(const SimProgramBuilder&);
@@ -88,8 +98,25 @@ private:
     ExecutableMove* processMove(
         const TTAProgram::Move& move, MachineState& state);
 
+    void checkJumpImmediate(const TTAProgram::Move& move);
+
+    BusState& findBusState(
+        const TTAProgram::Move& move, MachineState& state);
+
+    LongImmediateRegisterState& findImmediateRegister(
+        const TTAProgram::Immediate& immediate, MachineState& state);
+
+    void checkInstruction(
+        const TTAProgram::Instruction& instruction, MachineState& state);
+
     // is the source program a sequential program
     bool sequentialProgram_;
+    /// The program the instructions are built from on demand.
+    const TTAProgram::Program* program_;
+    /// The machine state the program refers to.
+    MachineState* state_;
+    /// The procedure of the previously built instruction.
+    const TTAProgram::Procedure* lastProcedure_;
 };
 
 #endif
@@ -81,6 +81,10 @@ using namespace TTAProgram;
  * @param memSys Memory system.
  * @param fuResourceConflictDetection Should the model detect FU resource
  * conflicts.
+ * @param detailedSimulation Should the FU stages be simulated.
+ * @param lazyInstructionBuilding Should the executable instructions be
+ * built on their first execution instead of at construction. The program
+ * is checked at construction in both cases.
  * @exception Exception Exceptions while building the simulation models
  * are thrown forward.
  */
@@ -89,7 +93,8 @@ SimulationController::SimulationController(
     const Machine& machine, 
     const Program& program,
     bool fuResourceConflictDetection,
-    bool detailedSimulation) :
+    bool detailedSimulation,
+    bool lazyInstructionBuilding) :
     TTASimulationController(frontend, machine, program),
     machineState_(NULL), gcu_(NULL) {
 
@@ -110,8 +115,13 @@ SimulationController::SimulationController(
     
     gcu_ = &machineState_->gcuState();
 
-    SimProgramBuilder programBuilder;
-    instructionMemory_ = programBuilder.build(program, *machineState_);
+    if (lazyInstructionBuilding) {
+        instructionMemory_ = 
+            SimProgramBuilder::buildLazily(program, *machineState_);
+    } else {
+        SimProgramBuilder programBuilder;
+        instructionMemory_ = programBuilder.build(program, *machineState_);
+    }
 
     findExitPoints(program, machine);
     reset();
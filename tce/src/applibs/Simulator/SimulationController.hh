@@ -49,7 +49,8 @@ public:
         const TTAMachine::Machine& machine, 
         const TTAProgram::Program& program,
         bool fuResourceConflictDetection = true,
-        bool detailedSimulation = false);
+        bool detailedSimulation = false,
+        bool lazyInstructionBuilding = true);
 
     virtual ~SimulationController();
 
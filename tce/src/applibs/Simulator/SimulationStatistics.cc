@@ -83,15 +83,17 @@ SimulationStatistics::calculate() {
         &program_.instructionAt(program_.startAddress().location());
     while (currentInstruction != &TTAProgram::NullInstruction::instance()) {
 
-        const ExecutableInstruction& execInstr = 
-            executionCounts_.instructionAtConst(
-                currentInstruction->address().location());
-        if (execInstr.executionCount() == 0) {
+        const InstructionAddress address = 
+            currentInstruction->address().location();
+        if (executionCounts_.executionCount(address) == 0) {
             currentInstruction = 
                 &program_.nextInstruction(*currentInstruction);
             continue;
         }
 
+        const ExecutableInstruction& execInstr = 
+            executionCounts_.instructionAtConst(address);
+
         for (std::size_t i = 0; i < statisticsTypes_.size(); ++i) {
             statisticsTypes_[i]->calculateForInstruction(
                 *currentInstruction, execInstr);
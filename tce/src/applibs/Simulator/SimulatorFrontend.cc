@@ -33,6 +33,7 @@
 
 #include <string>
 #include <fstream>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
@@ -103,6 +104,7 @@ POP_CLANG_DIAGS
 #include "MachineInfo.hh"
 #include "DirectAccessMemory.hh"
 #include "IdealSRAM.hh"
+#include "FlatMemory.hh"
 #include "RemoteMemory.hh"
 #include "MemoryProxy.hh"
 #include "DisassemblyFUPort.hh"
@@ -133,7 +135,8 @@ SimulatorFrontend::SimulatorFrontend(SimulationType backendType) :
     staticCompilation_(true), traceFileNameSetByUser_(false), outputStream_(0),
     memoryAccessTracking_(false), eventHandler_(NULL), lastRunCycleCount_(0),
     lastRunTime_(0.0), simulationTimeout_(0), leaveCompiledDirty_(false),
-    memorySystem_(NULL), zeroFillMemoriesOnReset_(true) {
+    memorySystem_(NULL), zeroFillMemoriesOnReset_(true),
+    flatMemoryModel_(false), lazyInstructionBuilding_(true) {
 
     if (backendType == SIM_COMPILED) {
         setFUResourceConflictDetection(false); // disabled by default
@@ -682,7 +685,8 @@ SimulatorFrontend::initializeSimulation() {
             simCon_ = 
              new SimulationController(
                     *this, *currentMachine_, *currentProgram_, 
-                    fuResourceConflictDetection_, detailedSimulation_);
+                    fuResourceConflictDetection_, detailedSimulation_,
+                    lazyInstructionBuilding_);
             machineState_ = 
                 &(dynamic_cast<SimulationController*>(simCon_)->machineState());
 
@@ -1617,7 +1621,7 @@ SimulatorFrontend::finishSimulation() {
             /// @note this expects that each instruction is 1 address long
             for (InstructionAddress a = firstAddress; a <= lastAddress; ++a) {
                 traceDB_->addInstructionExecutionCount(
-                    a, instructions.instructionAtConst(a).executionCount());
+                    a, instructions.executionCount(a));
             }
             
         }
@@ -1693,10 +1697,20 @@ SimulatorFrontend::initializeMemorySystem() {
                      space.start(), space.end(), space.width(), machine.isLittleEndian()));
              break;
         case SIM_NORMAL:
-             mem = MemorySystem::MemoryPtr(
-                 new IdealSRAM(
-                    space.start(), space.end(), space.width(), machine.isLittleEndian()));
-             break;
+            // the flat model is chosen per address space, the ones with
+            // MAU widths it does not support fall back to IdealSRAM
+            if (flatMemoryModel_ && FlatMemory::isSupported(space.width())) {
+                mem = MemorySystem::MemoryPtr(
+                    new FlatMemory(
+                        space.start(), space.end(), space.width(),
+                        machine.isLittleEndian()));
+            } else {
+                mem = MemorySystem::MemoryPtr(
+                    new IdealSRAM(
+                        space.start(), space.end(), space.width(),
+                        machine.isLittleEndian()));
+            }
+            break;
         case SIM_REMOTE:
         case SIM_CUSTOM:
              mem = MemorySystem::MemoryPtr(
@@ -1709,6 +1723,21 @@ SimulatorFrontend::initializeMemorySystem() {
             "Internal error: memory model not specified");
         }
 
+        // Size the pending write queue so the stores of all the LSUs
+        // accessing the memory fit in it without reallocation.
+        std::size_t lsuCount = 0;
+        int maxLatency = 1;
+        Machine::FunctionUnitNavigator fuNav =
+            machine.functionUnitNavigator();
+        for (int f = 0; f < fuNav.count(); ++f) {
+            const FunctionUnit& fu = *fuNav.item(f);
+            if (fu.addressSpace() == &space) {
+                ++lsuCount;
+                maxLatency = std::max(maxLatency, fu.maxLatency());
+            }
+        }
+        mem->setWriteRequestCapacity(lsuCount * maxLatency);
+
         // If memory tracking is enabled, memories are wrapped by a proxy
         // that tracks memory access.
         if (memoryAccessTracking_) {
@@ -2002,6 +2031,64 @@ SimulatorFrontend::memoryAccessTracking() const  {
     return memoryAccessTracking_;
 }
 
+/**
+ * Sets the usage of the contiguous FlatMemory model in the interpretive
+ * simulator.
+ *
+ * Address spaces with MAU widths not supported by FlatMemory are still
+ * modeled with IdealSRAM.
+ *
+ * NOTE: this affects future simulations only. That is, if a simulation is
+ * already initialized (program loaded), the old setting is used for that
+ * simulation.
+ *
+ * @param value Should the flat memory model be used.
+ */
+void
+SimulatorFrontend::setFlatMemoryModel(bool value) {
+    flatMemoryModel_ = value;
+}
+
+/**
+ * Returns true if the flat memory model is enabled.
+ *
+ * @return Returns current flat memory model setting.
+ */
+bool
+SimulatorFrontend::flatMemoryModel() const {
+    return flatMemoryModel_;
+}
+
+/**
+ * Sets the lazy building of the executable instructions on or off.
+ *
+ * When enabled, the interpretive simulator converts an instruction to its
+ * executable form only when the instruction is first executed. This
+ * speeds up loading large programs of which only a part gets executed.
+ * The program is checked when it is loaded in both cases. Enabled by
+ * default.
+ *
+ * NOTE: this affects future simulations only. That is, if a simulation is
+ * already initialized (program loaded), the old setting is used for that
+ * simulation.
+ *
+ * @param value Should the instructions be built lazily.
+ */
+void
+SimulatorFrontend::setLazyInstructionBuilding(bool value) {
+    lazyInstructionBuilding_ = value;
+}
+
+/**
+ * Returns true if the lazy building of the instructions is enabled.
+ *
+ * @return Returns current lazy instruction building setting.
+ */
+bool
+SimulatorFrontend::lazyInstructionBuilding() const {
+    return lazyInstructionBuilding_;
+}
+
 /**
  * Sets the printing of the next simulated instruction to the console.
  *
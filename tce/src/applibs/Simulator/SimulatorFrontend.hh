@@ -230,6 +230,12 @@ public:
     void setZeroFillMemoriesOnReset(bool val) 
         { zeroFillMemoriesOnReset_ = val; }
 
+    void setFlatMemoryModel(bool value);
+    bool flatMemoryModel() const;
+
+    void setLazyInstructionBuilding(bool value);
+    bool lazyInstructionBuilding() const;
+
     void setDetailedSimulation(bool val) 
         { detailedSimulation_ = val; }
 
@@ -371,6 +377,12 @@ protected:
     MemorySystem* memorySystem_;
     /// Set to true in case the memories should be set to zero at reset.
     bool zeroFillMemoriesOnReset_;
+    /// If this is enabled before initialization, the interpretive simulator
+    /// models the supported address spaces with FlatMemory.
+    bool flatMemoryModel_;
+    /// If this is enabled before initialization, the interpretive simulator
+    /// builds the executable instructions on demand.
+    bool lazyInstructionBuilding_;
     /// Set to true in case should build a detailed model which simulates
     /// FU stages, possibly with an external system-level model.
     bool detailedSimulation_;
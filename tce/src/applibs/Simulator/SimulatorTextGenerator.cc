@@ -461,6 +461,16 @@ SimulatorTextGenerator::SimulatorTextGenerator() {
         Texts::TXT_INTERP_SETTING_MEMORY_ACCESS_TRACKING,
         "Tracking of memory reads and writes.");
 
+    addText(
+        Texts::TXT_INTERP_SETTING_FLAT_MEMORY,
+        "Model byte-addressed data memories with a contiguous, "
+        "lazily allocated memory region.");
+
+    addText(
+        Texts::TXT_INTERP_SETTING_LAZY_INSTRUCTION_BUILDING,
+        "Convert each instruction to its executable form on its first "
+        "execution instead of when the program is loaded.");
+
     addText(
         Texts::TXT_INTERP_SETTING_UTILIZATION_SAVING,
         "Save processor utilization data to trace database after simulation.");
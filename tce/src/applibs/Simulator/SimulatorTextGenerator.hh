@@ -197,6 +197,8 @@ namespace Texts {
         TXT_NO_ADDRESS_SPACE_GIVEN,
         TXT_INTERP_SETTING_PROCEDURE_TRANSFER_TRACKING,
         TXT_INTERP_SETTING_MEMORY_ACCESS_TRACKING,
+        TXT_INTERP_SETTING_FLAT_MEMORY,
+        TXT_INTERP_SETTING_LAZY_INSTRUCTION_BUILDING,
         TXT_INTERP_SETTING_UTILIZATION_SAVING,
         TXT_INTERP_SETTING_PROFILE_SAVING,
         TXT_NO_PROGRAM_LOADED,
@@ -31,14 +31,17 @@
  */
 
 #include <string>
+#include <cmath>
 #include "boost/format.hpp"
 
 #include "Application.hh"
 #include "ExecutionTrace.hh"
 #include "Conversion.hh"
 #include "InstructionExecution.hh"
+#include "InstructionTraceReader.hh"
 #include "FileSystem.hh"
 #include "SQLite.hh"
+#include "SQLiteConnection.hh"
 #include "SimValue.hh"
 #include "RelationalDBQueryResult.hh"
 #include "DataObject.hh"
@@ -105,9 +108,29 @@ const std::string CQ_TOTALS =
 "       value_name TEXT NOT NULL,"
 "       integer_value INTEGER);";
 
+/// the prepared insert statements, in the order of ExecutionTrace::StatementID
+const char* const INSERT_QUERIES[] = {
+    "INSERT INTO instruction_execution(cycle, address) VALUES(?, ?);",
+    "INSERT INTO procedure_address_range(first_address, last_address, "
+    "procedure_name) VALUES(?, ?, ?);",
+    "INSERT INTO bus_activity(cycle, bus, segment, squash, "
+    "data_as_int, data_as_double) VALUES(?, ?, ?, ?, ?, ?);",
+    "INSERT INTO concurrent_register_file_access("
+    "register_file, reads, writes, count) VALUES(?, ?, ?, ?);",
+    "INSERT INTO register_access("
+    "register_file, register_index, reads, writes) VALUES(?, ?, ?, ?);",
+    "INSERT INTO fu_operation_triggers(function_unit, operation, count) "
+    "VALUES(?, ?, ?);",
+    "INSERT INTO bus_write_counts(bus, writes) VALUES(?, ?);",
+    "INSERT INTO socket_write_counts(socket, writes) VALUES(?, ?);",
+    "INSERT INTO totals(value_name, integer_value) VALUES(?, ?);"
+};
+
 /// the version number of the database schema
 const int DB_VERSION = 1;
 
+const std::size_t ExecutionTrace::DEFAULT_WRITE_BATCH_SIZE = 100000;
+
 /** 
  * Creates a new execution trace database.
  *
@@ -126,6 +149,10 @@ const int DB_VERSION = 1;
  * fileName.profile     The instruction execution counts, produced with
  *                      'profile_data_saving' setting of ttasim
  *                      (e.g. foobar.tpef.1.trace.profile).
+ * fileName.itrace      The binary instruction execution trace, produced
+ *                      with 'execution_trace' setting of ttasim
+ *                      (e.g. foobar.tpef.1.trace.itrace), see
+ *                      InstructionTraceWriter.
  *
  * @param fileName Full path to the traceDB file to be opened.
  * @return A pointer to opened execution trace database instance. Instance
@@ -146,9 +173,21 @@ ExecutionTrace::open(const std::string& fileName) {
         if (newDatabase) {
             traceDB->initialize();	
         } else {
-            // tests that the file is really a trace DB by querying the
-            // instruction_execution table
-            traceDB->instructionExecutions();
+            // the buffered or imported instruction executions must be
+            // newer than the existing ones, this also tests that the file
+            // is really a trace DB
+            RelationalDBQueryResult* result = 
+                traceDB->dbConnection_->query(
+                    "SELECT MAX(cycle) FROM instruction_execution");
+            if (result->hasNext()) {
+                result->next();
+                if (!result->data(0).isNull()) {
+                    traceDB->lastInstructionExecutionCycle_ = 
+                        result->data(0).integerValue();
+                }
+            }
+            delete result;
+            result = NULL;
         }
     } catch (const RelationalDBException& e) {
         delete traceDB;
@@ -161,13 +200,14 @@ ExecutionTrace::open(const std::string& fileName) {
 /**
  * Initializes the trace files.
  *
- * For the traceDB sqlite file, starts a new transaction. Transaction is 
- * committed in destructor. This consumes lots of memory but should 
- * reduce I/O to the minimum.
+ * For the traceDB sqlite file, starts a new transaction. The transaction
+ * is committed each time the buffered rows are written (see flush()) and
+ * in the destructor.
  */
 void
 ExecutionTrace::open() {
-    dbConnection_ = &db_->connect(fileName_);
+    dbConnection_ = dynamic_cast<SQLiteConnection*>(&db_->connect(fileName_));
+    assert(dbConnection_ != NULL);
     dbConnection_->beginTransaction();
 }
 
@@ -189,7 +229,13 @@ ExecutionTrace::ExecutionTrace(const std::string& fileName, bool readOnly) :
         std::fstream::in : 
         std::fstream::out | std::fstream::trunc),
     readOnly_(readOnly), db_(new SQLite()), 
-    dbConnection_(NULL), instructionExecution_(NULL)  {
+    dbConnection_(NULL), instructionExecution_(NULL), 
+    lastInstructionExecutionCycle_(-1),
+    writeBatchSize_(DEFAULT_WRITE_BATCH_SIZE) {
+
+    for (int i = 0; i < ST_COUNT; ++i) {
+        statements_[i] = NULL;
+    }
 }
 
 /**
@@ -208,6 +254,16 @@ ExecutionTrace::~ExecutionTrace() {
         }
 
         if (dbConnection_ != NULL) {
+            try {
+                flush();
+            } catch (const IOException& e) {
+                Application::writeToErrorLog(
+                    __FILE__, __LINE__, __func__, e.errorMessage());
+            }
+            for (int i = 0; i < ST_COUNT; ++i) {
+                dbConnection_->finalizeQuery(statements_[i]);
+                statements_[i] = NULL;
+            }
             dbConnection_->commit();
             try {
                 assert(db_ != NULL);
@@ -271,6 +327,10 @@ ExecutionTrace::initialize() {
 /**
  * Adds a new instruction execution record to the database.
  *
+ * The records are buffered and written in batches as long as the cycles
+ * are increasing, which makes them unique. Otherwise, the record is written
+ * immediately so a duplicate cycle is reported to the caller.
+ *
  * @param cycle The clock cycle on which the instruction execution happened.
  * @param address The address of the executed instruction.
  * @exception IOException In case an error in adding the data happened.
@@ -278,20 +338,37 @@ ExecutionTrace::initialize() {
 void
 ExecutionTrace::addInstructionExecution(
     ClockCycleCount cycle, InstructionAddress address) {
-    const std::string query =
-      (boost::format(
-        "INSERT INTO instruction_execution(cycle, address) VALUES(" 
-	"%.0f, %d);") % cycle % address).str();
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    InstructionExecutionRow row;
+    row.cycle = cycle;
+    row.address = address;
+
+    if (cycle > lastInstructionExecutionCycle_) {
+        lastInstructionExecutionCycle_ = cycle;
+        instructionExecutionBuffer_.push_back(row);
+        flushIfFull();
+    } else {
+        flush();
+        insertInstructionExecution(row);
     }
 }
 
+/**
+ * Writes an instruction execution record to the database.
+ *
+ * @param row The record.
+ * @exception IOException In case an error in adding the data happened.
+ */
+void
+ExecutionTrace::insertInstructionExecution(
+    const InstructionExecutionRow& row) {
+
+    sqlite3_stmt* stmt = statement(ST_INSTRUCTION_EXECUTION);
+    bind(stmt, 1, static_cast<long long>(row.cycle));
+    bind(stmt, 2, static_cast<long long>(row.address));
+    execute(stmt);
+}
+
 /**
  * Adds a new instruction execution count record to the database.
  *
@@ -335,25 +412,22 @@ void
 ExecutionTrace::addProcedureAddressRange(
     InstructionAddress firstAddress, InstructionAddress lastAddress,
     const std::string& procedureName) {
-    const std::string query =
-        "INSERT INTO procedure_address_range(first_address, last_address, "
-        "procedure_name) VALUES(" + 
-        Conversion::toString(firstAddress) + ", " + 
-        Conversion::toString(lastAddress) + ", '" + 
-        procedureName + "');";
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_PROCEDURE_ADDRESS_RANGE);
+    bind(stmt, 1, static_cast<long long>(firstAddress));
+    bind(stmt, 2, static_cast<long long>(lastAddress));
+    bind(stmt, 3, procedureName);
+    execute(stmt);
 }
 
 /**
  * Queries database for instruction execution entries. 
  *
+ * The simulator writes the executed instructions only to the binary
+ * instruction trace file. Its records newer than the ones in the
+ * instruction_execution table are imported to the table first, unless the
+ * database is read-only.
+ *
  * @return A handle object which can be used to traverse through the results. 
  *         The handle points to the first instruction execution in the list of 
  *         executions, sorted by the cycle.
@@ -366,6 +440,11 @@ ExecutionTrace::instructionExecutions() {
         instructionExecution_ = NULL;
     }
 
+    if (!readOnly_) {
+        importInstructionTrace();
+    }
+    flush();
+
     try {
         instructionExecution_ = new InstructionExecution(
             dbConnection_->query(
@@ -377,9 +456,78 @@ ExecutionTrace::instructionExecutions() {
     return *instructionExecution_;
 }
 
+/**
+ * Adds the records of the binary instruction trace file which are newer
+ * than the stored instruction executions to the database.
+ *
+ * Does nothing if there is no trace file. The writer flushes only whole
+ * records, thus a trace still being written is imported up to its last
+ * flushed record and the rest is imported on the next call.
+ *
+ * @exception IOException If the trace file is invalid or the records
+ *                        cannot be added.
+ */
+void
+ExecutionTrace::importInstructionTrace() {
+    if (!FileSystem::fileExists(instructionTraceFileName())) {
+        return;
+    }
+    InstructionTraceReader* trace = instructionTrace();
+    try {
+        // the reader of an empty trace has no current record
+        bool valid = true;
+        try {
+            trace->cycle();
+        } catch (const NotAvailable&) {
+            valid = false;
+        }
+        while (valid) {
+            if (trace->cycle() > lastInstructionExecutionCycle_) {
+                addInstructionExecution(trace->cycle(), trace->address());
+            }
+            valid = trace->hasNext();
+            if (valid) {
+                trace->next();
+            }
+        }
+    } catch (...) {
+        delete trace;
+        throw;
+    }
+    delete trace;
+}
+
+/**
+ * Returns the path of the binary instruction execution trace file.
+ *
+ * @return The path of the file.
+ */
+std::string
+ExecutionTrace::instructionTraceFileName() const {
+    return fileName_ + ".itrace";
+}
+
+/**
+ * Opens the binary instruction execution trace for reading.
+ *
+ * The trace is read directly from the memory mapped file, one executed
+ * cycle at a time, thus prefer this to instructionExecutions() for long
+ * traces.
+ *
+ * @return A reader pointing to the first executed cycle. Must be deleted by
+ *         the client after use.
+ * @exception IOException If the trace file could not be opened.
+ */
+InstructionTraceReader*
+ExecutionTrace::instructionTrace() const {
+    return new InstructionTraceReader(instructionTraceFileName());
+}
+
 /**
  * Adds a new bus activity record to the database.
  *
+ * The records are buffered and written in batches.
+ *
  * @param cycle The clock cycle in which the bus activity happened.
  * @param busId The name of the bus.
  * @param segmentId The name of the segment in the bus.
@@ -391,36 +539,40 @@ void
 ExecutionTrace::addBusActivity(
     ClockCycleCount cycle, const BusID& busId, const SegmentID& segmentId,
     bool squash, const SimValue& data) {
-    std::string query = 
-        "INSERT INTO bus_activity(cycle, bus, segment, squash, "
-        "data_as_int, data_as_double) VALUES(" + 
-        Conversion::toString(cycle) + ", '" + busId + "', '" + segmentId + 
-        "', ";
-
-    if (squash) 
-        query += "'TRUE'";
-    else
-        query += "'FALSE'";
-
-    std::string doubleString = Conversion::toString(data.doubleWordValue());
-    if (doubleString == "nan")
-        doubleString = "NULL";
-
-    if (!squash && &data != &NullSimValue::instance())
-        query += ", " + Conversion::toString(data.uIntWordValue()) + ", " + 
-            doubleString + ")";        
-    else
-        query += ", 0, 0.0)";
- 
 
-    assert(dbConnection_ != NULL);
+    busActivityBuffer_.push_back(BusActivityRow());
+    BusActivityRow& row = busActivityBuffer_.back();
+    row.cycle = cycle;
+    row.bus = busId;
+    row.segment = segmentId;
+    row.squash = squash;
+    row.hasData = !squash && &data != &NullSimValue::instance();
+    row.dataAsInt = row.hasData ? data.uIntWordValue() : 0;
+    row.dataAsDouble = row.hasData ? data.doubleWordValue() : 0.0;
+
+    flushIfFull();
+}
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(std::string("query: ") + query);
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+/**
+ * Writes a bus activity record to the database.
+ *
+ * @param row The record.
+ * @exception IOException In case an error in adding the data happened.
+ */
+void
+ExecutionTrace::insertBusActivity(const BusActivityRow& row) {
+
+    sqlite3_stmt* stmt = statement(ST_BUS_ACTIVITY);
+    bind(stmt, 1, static_cast<long long>(row.cycle));
+    bind(stmt, 2, row.bus);
+    bind(stmt, 3, row.segment);
+    bind(stmt, 4, std::string(row.squash ? "TRUE" : "FALSE"));
+    bind(stmt, 5, static_cast<long long>(row.dataAsInt));
+    // NaNs are stored as NULLs, the parameter is NULL if left unbound
+    if (!std::isnan(row.dataAsDouble)) {
+        bind(stmt, 6, row.dataAsDouble);
     }
+    execute(stmt);
 }
 
 /**
@@ -440,23 +592,13 @@ void
 ExecutionTrace::addConcurrentRegisterFileAccessCount(
     RegisterFileID registerFile, RegisterAccessCount reads,
     RegisterAccessCount writes, ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO concurrent_register_file_access("
-        "                register_file, reads, writes, count) "
-        "VALUES('" + registerFile + "', " +
-        Conversion::toString(reads) + ", " +
-        Conversion::toString(writes) + ", " +
-        Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_CONCURRENT_REGISTER_FILE_ACCESS);
+    bind(stmt, 1, registerFile);
+    bind(stmt, 2, static_cast<long long>(reads));
+    bind(stmt, 3, static_cast<long long>(writes));
+    bind(stmt, 4, static_cast<long long>(count));
+    execute(stmt);
 }
 
 /**
@@ -475,21 +617,13 @@ void
 ExecutionTrace::addRegisterAccessCount(
     RegisterFileID registerFile, RegisterID registerIndex,
     ClockCycleCount reads, ClockCycleCount writes) {
-    const std::string query =
-        (boost::format(
-            "INSERT INTO register_access("
-            "                register_file, register_index, reads, writes) "
-            "VALUES('%s', %d, %.0f, %.0f)") 
-         % registerFile % registerIndex % reads % writes).str();
 
-    assert(dbConnection_ != NULL);
-
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_REGISTER_ACCESS);
+    bind(stmt, 1, registerFile);
+    bind(stmt, 2, static_cast<long long>(registerIndex));
+    bind(stmt, 3, static_cast<long long>(reads));
+    bind(stmt, 4, static_cast<long long>(writes));
+    execute(stmt);
 }
 
 /**
@@ -546,21 +680,12 @@ void
 ExecutionTrace::addFunctionUnitOperationTriggerCount(
     FunctionUnitID functionUnit, OperationID operation,
     OperationTriggerCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO fu_operation_triggers("
-        "                function_unit, operation, count) "
-        "VALUES('" + functionUnit + "', '" + operation + "', " +
-        Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_FU_OPERATION_TRIGGERS);
+    bind(stmt, 1, functionUnit);
+    bind(stmt, 2, operation);
+    bind(stmt, 3, static_cast<long long>(count));
+    execute(stmt);
 }
 
 /**
@@ -629,19 +754,11 @@ ExecutionTrace::functionUnitOperationTriggerCounts(
  */
 void
 ExecutionTrace::addSocketWriteCount(SocketID socket, ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO socket_write_counts(socket, writes) "
-        "VALUES('" + socket + "', " + Conversion::toString(count) + ")";
 
-    assert(dbConnection_ != NULL);
-
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_SOCKET_WRITE_COUNTS);
+    bind(stmt, 1, socket);
+    bind(stmt, 2, static_cast<long long>(count));
+    execute(stmt);
 }
 
 /**
@@ -686,19 +803,11 @@ ExecutionTrace::socketWriteCount(SocketID socket) const {
  */
 void
 ExecutionTrace::addBusWriteCount(BusID bus, ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO bus_write_counts(bus, writes) "
-        "VALUES('" + bus + "', " + Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_BUS_WRITE_COUNTS);
+    bind(stmt, 1, bus);
+    bind(stmt, 2, static_cast<long long>(count));
+    execute(stmt);
 }
 
 /**
@@ -739,19 +848,11 @@ ExecutionTrace::busWriteCount(BusID bus) const {
  */
 void
 ExecutionTrace::setSimulatedCycleCount(ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO totals(value_name, integer_value) "
-        "VALUES('cycle_count', " + Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    sqlite3_stmt* stmt = statement(ST_TOTALS);
+    bind(stmt, 1, std::string("cycle_count"));
+    bind(stmt, 2, static_cast<long long>(count));
+    execute(stmt);
 }
 
 /**
@@ -785,3 +886,174 @@ ExecutionTrace::simulatedCycleCount() const {
         throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
     }
 }
+
+/**
+ * Sets the count of buffered rows that are written to the database in
+ * one transaction.
+ *
+ * Larger batches make writing long traces faster at the cost of memory.
+ *
+ * @param rows The count of rows, at least one.
+ */
+void
+ExecutionTrace::setWriteBatchSize(std::size_t rows) {
+    writeBatchSize_ = rows > 0 ? rows : 1;
+    flushIfFull();
+}
+
+/**
+ * Writes the buffered rows to the database and commits the transaction.
+ *
+ * Called automatically when the buffer is full, before the trace is
+ * queried, and when the trace is closed.
+ *
+ * @exception IOException In case an error in adding the data happened.
+ */
+void
+ExecutionTrace::flush() {
+
+    assert(dbConnection_ != NULL);
+
+    if (instructionExecutionBuffer_.empty() && busActivityBuffer_.empty()) {
+        return;
+    }
+
+    // the buffers are cleared also in case of an error so a failing row is
+    // not written again on the next flush
+    try {
+        for (std::size_t i = 0; i < instructionExecutionBuffer_.size(); ++i) {
+            insertInstructionExecution(instructionExecutionBuffer_[i]);
+        }
+        for (std::size_t i = 0; i < busActivityBuffer_.size(); ++i) {
+            insertBusActivity(busActivityBuffer_[i]);
+        }
+    } catch (const IOException&) {
+        instructionExecutionBuffer_.clear();
+        busActivityBuffer_.clear();
+        throw;
+    }
+    instructionExecutionBuffer_.clear();
+    busActivityBuffer_.clear();
+
+    try {
+        // commits the current transaction and starts a new one
+        dbConnection_->beginTransaction();
+    } catch (const RelationalDBException& e) {
+        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    }
+}
+
+/**
+ * Writes the buffered rows to the database in case the batch is full.
+ *
+ * @exception IOException In case an error in adding the data happened.
+ */
+void
+ExecutionTrace::flushIfFull() {
+    if (instructionExecutionBuffer_.size() + busActivityBuffer_.size() >= 
+        writeBatchSize_) {
+        flush();
+    }
+}
+
+/**
+ * Returns the prepared insert statement with the given id.
+ *
+ * The statement is compiled at its first use.
+ *
+ * @param id The statement.
+ * @return The statement.
+ * @exception IOException In case the statement could not be compiled.
+ */
+sqlite3_stmt*
+ExecutionTrace::statement(StatementID id) {
+
+    assert(dbConnection_ != NULL);
+
+    if (statements_[id] == NULL) {
+        try {
+            statements_[id] = 
+                dbConnection_->prepareStatement(INSERT_QUERIES[id]);
+        } catch (const RelationalDBException& e) {
+            throw IOException(
+                __FILE__, __LINE__, __func__, e.errorMessage());
+        }
+    }
+    return statements_[id];
+}
+
+/**
+ * Executes a prepared insert statement with the bound parameters.
+ *
+ * @param statement The statement.
+ * @exception IOException In case an error in adding the data happened.
+ */
+void
+ExecutionTrace::execute(sqlite3_stmt* statement) {
+    try {
+        dbConnection_->executePreparedStatement(statement);
+    } catch (const RelationalDBException& e) {
+        debugLog(
+            std::string("query: ") + sqlite3_sql(statement) + " failed!");
+        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    }
+}
+
+/**
+ * Binds an integer parameter of a prepared statement.
+ *
+ * @param statement The statement.
+ * @param column The index of the parameter, starting from 1.
+ * @param value The value.
+ * @exception IOException In case the value could not be bound.
+ */
+void
+ExecutionTrace::bind(sqlite3_stmt* statement, int column, long long value) {
+    try {
+        dbConnection_->throwIfSQLiteError(
+            sqlite3_bind_int64(statement, column, value));
+    } catch (const RelationalDBException& e) {
+        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    }
+}
+
+/**
+ * Binds a text parameter of a prepared statement.
+ *
+ * The value is copied, thus it does not need to outlive the execution.
+ *
+ * @param statement The statement.
+ * @param column The index of the parameter, starting from 1.
+ * @param value The value.
+ * @exception IOException In case the value could not be bound.
+ */
+void
+ExecutionTrace::bind(
+    sqlite3_stmt* statement, int column, const std::string& value) {
+    try {
+        dbConnection_->throwIfSQLiteError(
+            sqlite3_bind_text(
+                statement, column, value.c_str(), value.length(),
+                SQLITE_TRANSIENT));
+    } catch (const RelationalDBException& e) {
+        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    }
+}
+
+/**
+ * Binds a real parameter of a prepared statement.
+ *
+ * @param statement The statement.
+ * @param column The index of the parameter, starting from 1.
+ * @param value The value.
+ * @exception IOException In case the value could not be bound.
+ */
+void
+ExecutionTrace::bind(sqlite3_stmt* statement, int column, double value) {
+    try {
+        dbConnection_->throwIfSQLiteError(
+            sqlite3_bind_double(statement, column, value));
+    } catch (const RelationalDBException& e) {
+        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    }
+}
@@ -32,6 +32,7 @@
 #ifndef TTA_EXECUTION_TRACE_HH
 #define TTA_EXECUTION_TRACE_HH
  
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <list>
@@ -46,6 +47,9 @@
 
 
 class InstructionExecution;
+class InstructionTraceReader;
+class SQLiteConnection;
+struct sqlite3_stmt;
 
 /**
  * The main class of the Execution Trace Database (TraceDB).
@@ -181,8 +185,17 @@ public:
 
     InstructionExecution& instructionExecutions();
 
+    std::string instructionTraceFileName() const;
+    InstructionTraceReader* instructionTrace() const;
+
+    void setWriteBatchSize(std::size_t rows);
+    void flush();
+
     static ExecutionTrace* open(const std::string& fileName);
 
+    /// The default count of buffered rows written in one transaction.
+    static const std::size_t DEFAULT_WRITE_BATCH_SIZE;
+
     virtual ~ExecutionTrace();
     
 protected:
@@ -191,7 +204,48 @@ protected:
     void open();
 
 private:
+    /// The prepared insert statements, indices to statements_.
+    enum StatementID {
+        ST_INSTRUCTION_EXECUTION = 0,
+        ST_PROCEDURE_ADDRESS_RANGE,
+        ST_BUS_ACTIVITY,
+        ST_CONCURRENT_REGISTER_FILE_ACCESS,
+        ST_REGISTER_ACCESS,
+        ST_FU_OPERATION_TRIGGERS,
+        ST_BUS_WRITE_COUNTS,
+        ST_SOCKET_WRITE_COUNTS,
+        ST_TOTALS,
+        ST_COUNT ///< Count of the statements, not a statement.
+    };
+
+    /// A buffered instruction_execution row.
+    struct InstructionExecutionRow {
+        ClockCycleCount cycle;
+        InstructionAddress address;
+    };
+
+    /// A buffered bus_activity row.
+    struct BusActivityRow {
+        ClockCycleCount cycle;
+        BusID bus;
+        SegmentID segment;
+        bool squash;
+        /// False if the data columns are to be set to zero.
+        bool hasData;
+        UIntWord dataAsInt;
+        double dataAsDouble;
+    };
+
     void initialize();
+    sqlite3_stmt* statement(StatementID id);
+    void execute(sqlite3_stmt* statement);
+    void bind(sqlite3_stmt* statement, int column, long long value);
+    void bind(sqlite3_stmt* statement, int column, const std::string& value);
+    void bind(sqlite3_stmt* statement, int column, double value);
+    void insertInstructionExecution(const InstructionExecutionRow& row);
+    void insertBusActivity(const BusActivityRow& row);
+    void flushIfFull();
+    void importInstructionTrace();
 
     /// Filename of the trace database (sqlite file).
     const std::string& fileName_;
@@ -204,9 +258,19 @@ private:
     /// Handle to the sqlite trace database.
     RelationalDB* db_;
     /// Handle to the database connection;
-    RelationalDBConnection* dbConnection_;
+    SQLiteConnection* dbConnection_;
     /// Handle object for the queries of instruction executions.
     InstructionExecution* instructionExecution_;
+    /// The prepared insert statements, compiled at their first use.
+    sqlite3_stmt* statements_[ST_COUNT];
+    /// The instruction executions not yet written to the database.
+    std::vector<InstructionExecutionRow> instructionExecutionBuffer_;
+    /// The bus activities not yet written to the database.
+    std::vector<BusActivityRow> busActivityBuffer_;
+    /// The largest instruction execution cycle added so far, -1 if none.
+    ClockCycleCount lastInstructionExecutionCycle_;
+    /// The count of buffered rows that triggers a write and a commit.
+    std::size_t writeBatchSize_;
     
 };
 
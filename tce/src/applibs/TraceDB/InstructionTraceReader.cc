@@ -0,0 +1,199 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionTraceReader.cc
+ *
+ * Definition of InstructionTraceReader class.
+ *
+ * @note rating: red
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <boost/format.hpp>
+
+#include "InstructionTraceReader.hh"
+#include "InstructionTraceWriter.hh"
+
+/**
+ * Constructor.
+ *
+ * The reader is initialized to point to the first record of the trace,
+ * if any.
+ *
+ * @param fileName Path to the trace file.
+ * @exception IOException If the file could not be mapped or it is not an
+ *                        instruction trace file.
+ */
+InstructionTraceReader::InstructionTraceReader(const std::string& fileName) :
+    data_(NULL), size_(0), position_(0), valid_(false), cycle_(-1),
+    address_(0) {
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            (boost::format("Could not open instruction trace file '%s'.")
+             % fileName).str());
+    }
+    size_ = status.st_size;
+    if (size_ < InstructionTraceWriter::FILE_MAGIC_LENGTH) {
+        close(fd);
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            (boost::format("'%s' is not an instruction trace file.")
+             % fileName).str());
+    }
+
+    void* mapped = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            (boost::format("Could not map instruction trace file '%s'.")
+             % fileName).str());
+    }
+    data_ = static_cast<const unsigned char*>(mapped);
+    // the trace is read once from the beginning to the end
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+
+    if (std::memcmp(
+            data_, InstructionTraceWriter::FILE_MAGIC,
+            InstructionTraceWriter::FILE_MAGIC_LENGTH) != 0) {
+        munmap(mapped, size_);
+        data_ = NULL;
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            (boost::format("'%s' is not an instruction trace file.")
+             % fileName).str());
+    }
+    position_ = InstructionTraceWriter::FILE_MAGIC_LENGTH;
+
+    if (hasNext()) {
+        next();
+    }
+}
+
+/**
+ * Destructor.
+ */
+InstructionTraceReader::~InstructionTraceReader() {
+    if (data_ != NULL) {
+        munmap(const_cast<unsigned char*>(data_), size_);
+        data_ = NULL;
+    }
+}
+
+/**
+ * Returns the cycle count value of the current record.
+ *
+ * @return The cycle count.
+ * @exception NotAvailable If the trace is empty.
+ */
+ClockCycleCount
+InstructionTraceReader::cycle() const {
+    if (!valid_) {
+        throw NotAvailable(
+            __FILE__, __LINE__, __func__, 
+            "Tried to fetch data from an empty trace.");
+    }
+    return cycle_;
+}
+
+/**
+ * Returns the instruction address value of the current record.
+ *
+ * @return The instruction address value.
+ * @exception NotAvailable If the trace is empty.
+ */
+InstructionAddress
+InstructionTraceReader::address() const {
+    if (!valid_) {
+        throw NotAvailable(
+            __FILE__, __LINE__, __func__, 
+            "Tried to fetch data from an empty trace.");
+    }
+    return static_cast<InstructionAddress>(address_);
+}
+
+/**
+ * Advances the reader to the next record of the trace.
+ *
+ * @exception NotAvailable If there are no more records.
+ * @exception IOException If the trace file is truncated.
+ */
+void
+InstructionTraceReader::next() {
+    if (!hasNext()) {
+        throw NotAvailable(__FILE__, __LINE__, __func__, "No more results.");
+    }
+
+    const ULongWord cycleDelta = readNumber();
+    const ULongWord zigzag = readNumber();
+    const SLongWord addressDelta = 
+        static_cast<SLongWord>(zigzag >> 1) ^ 
+        -static_cast<SLongWord>(zigzag & 1);
+
+    const ULongWord nextAddress = valid_ ? address_ + 1 : 0;
+    cycle_ += cycleDelta;
+    address_ = nextAddress + addressDelta;
+    valid_ = true;
+}
+
+/**
+ * Returns true if there are more records available.
+ *
+ * @return True if more records are available.
+ */
+bool
+InstructionTraceReader::hasNext() const {
+    return position_ < size_;
+}
+
+/**
+ * Decodes a LEB128 encoded number at the current position.
+ *
+ * @return The number.
+ * @exception IOException If the file ends in the middle of the number.
+ */
+ULongWord
+InstructionTraceReader::readNumber() {
+    ULongWord value = 0;
+    for (unsigned shift = 0; position_ < size_; shift += 7) {
+        const unsigned char byte = data_[position_++];
+        value |= static_cast<ULongWord>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw IOException(
+        __FILE__, __LINE__, __func__, "Truncated instruction trace file.");
+}
@@ -0,0 +1,81 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionTraceReader.hh
+ *
+ * Declaration of InstructionTraceReader class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_INSTRUCTION_TRACE_READER_HH
+#define TTA_INSTRUCTION_TRACE_READER_HH
+
+#include <string>
+
+#include "Exception.hh"
+#include "SimulatorConstants.hh"
+
+/**
+ * Navigates through a binary instruction execution trace.
+ *
+ * Reads the files written by InstructionTraceWriter. The file is memory
+ * mapped and decoded one record at a time, thus traces of any length can
+ * be traversed without loading them to memory. The interface follows
+ * the one of InstructionExecution.
+ */
+class InstructionTraceReader {
+public:
+    InstructionTraceReader(const std::string& fileName);
+    virtual ~InstructionTraceReader();
+
+    ClockCycleCount cycle() const;
+    InstructionAddress address() const;
+
+    void next();
+    bool hasNext() const;
+
+private:
+    /// Copying not allowed.
+    InstructionTraceReader(const InstructionTraceReader&);
+    /// Assignment not allowed.
+    InstructionTraceReader& operator=(const InstructionTraceReader&);
+
+    ULongWord readNumber();
+
+    /// The mapped trace file.
+    const unsigned char* data_;
+    /// The size of the mapped file.
+    std::size_t size_;
+    /// Position of the next undecoded record in the file.
+    std::size_t position_;
+    /// Is there a current record?
+    bool valid_;
+    /// Cycle of the current record.
+    ClockCycleCount cycle_;
+    /// Address of the current record.
+    ULongWord address_;
+};
+
+#endif
@@ -0,0 +1,157 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionTraceWriter.cc
+ *
+ * Definition of InstructionTraceWriter class.
+ *
+ * @note rating: red
+ */
+
+#include <boost/format.hpp>
+
+#include "InstructionTraceWriter.hh"
+#include "Application.hh"
+
+const char InstructionTraceWriter::FILE_MAGIC[] = "TTAITRC1";
+const std::size_t InstructionTraceWriter::FILE_MAGIC_LENGTH = 8;
+
+/// The size of the record buffer in bytes.
+const std::size_t BUFFER_SIZE = 64 * 1024;
+/// The maximum length of an encoded number.
+const std::size_t MAX_NUMBER_LENGTH = 10;
+
+/**
+ * Constructor.
+ *
+ * Creates a new trace file, an existing file is overwritten. The file
+ * identifier is written immediately, so the trace can be read while it is
+ * being written.
+ *
+ * @param fileName Path to the trace file.
+ * @exception IOException If the file could not be created.
+ */
+InstructionTraceWriter::InstructionTraceWriter(const std::string& fileName) :
+    file_(
+        fileName.c_str(), 
+        std::ios::out | std::ios::binary | std::ios::trunc),
+    lastCycle_(-1), nextAddress_(0) {
+
+    if (!file_) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            (boost::format("Could not create instruction trace file '%s'.")
+             % fileName).str());
+    }
+    file_.write(FILE_MAGIC, FILE_MAGIC_LENGTH);
+    file_.flush();
+    buffer_.reserve(BUFFER_SIZE);
+}
+
+/**
+ * Destructor.
+ *
+ * Writes the buffered records to the file.
+ */
+InstructionTraceWriter::~InstructionTraceWriter() {
+    try {
+        flush();
+    } catch (const Exception& e) {
+        debugLog(
+            "Exception almost leaked from ~InstructionTraceWriter! "
+            "Message: " + e.errorMessage());
+    }
+    file_.close();
+}
+
+/**
+ * Adds an instruction execution record to the trace.
+ *
+ * @param cycle The clock cycle on which the instruction execution happened.
+ * @param address The address of the executed instruction.
+ * @exception InvalidData If the cycle is not newer than the cycle of the
+ *                        previous record.
+ * @exception IOException If writing the file failed.
+ */
+void
+InstructionTraceWriter::addInstructionExecution(
+    ClockCycleCount cycle, InstructionAddress address) {
+
+    if (cycle <= lastCycle_) {
+        throw InvalidData(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Instruction execution of cycle %d added after cycle %d.")
+             % cycle % lastCycle_).str());
+    }
+
+    if (buffer_.size() + 2 * MAX_NUMBER_LENGTH > BUFFER_SIZE) {
+        flush();
+    }
+
+    const SLongWord addressDelta = 
+        static_cast<SLongWord>(address) - 
+        static_cast<SLongWord>(nextAddress_);
+    writeNumber(static_cast<ULongWord>(cycle - lastCycle_));
+    writeNumber(
+        (static_cast<ULongWord>(addressDelta) << 1) ^ 
+        static_cast<ULongWord>(addressDelta >> 63));
+
+    lastCycle_ = cycle;
+    nextAddress_ = static_cast<ULongWord>(address) + 1;
+}
+
+/**
+ * Writes the buffered records to the file.
+ *
+ * @exception IOException If writing the file failed.
+ */
+void
+InstructionTraceWriter::flush() {
+    if (!buffer_.empty()) {
+        file_.write(
+            reinterpret_cast<const char*>(&buffer_[0]), buffer_.size());
+        buffer_.clear();
+    }
+    file_.flush();
+    if (!file_) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Writing the instruction trace file failed.");
+    }
+}
+
+/**
+ * Appends a LEB128 encoded number to the buffer.
+ *
+ * @param value The number.
+ */
+void
+InstructionTraceWriter::writeNumber(ULongWord value) {
+    while (value >= 0x80) {
+        buffer_.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(static_cast<unsigned char>(value));
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionTraceWriter.hh
+ *
+ * Declaration of InstructionTraceWriter class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_INSTRUCTION_TRACE_WRITER_HH
+#define TTA_INSTRUCTION_TRACE_WRITER_HH
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "Exception.hh"
+#include "SimulatorConstants.hh"
+
+/**
+ * Writes the instruction execution trace to a compact binary file.
+ *
+ * The file starts with the 8 byte FILE_MAGIC identifier which is followed
+ * by one record per executed cycle. A record consists of two LEB128
+ * encoded unsigned integers:
+ *
+ * 1. The difference of the cycle to the cycle of the previous record
+ *    (the "previous cycle" of the first record is -1).
+ * 2. The difference of the instruction address to the address following
+ *    the previous record's address (or to zero for the first record),
+ *    zigzag encoded to make small negative values short.
+ *
+ * Thus, sequential execution takes two bytes per cycle. The records are
+ * read with InstructionTraceReader.
+ */
+class InstructionTraceWriter {
+public:
+    InstructionTraceWriter(const std::string& fileName);
+    virtual ~InstructionTraceWriter();
+
+    void addInstructionExecution(
+        ClockCycleCount cycle, InstructionAddress address);
+
+    void flush();
+
+    /// The identifier in the beginning of the trace files.
+    static const char FILE_MAGIC[];
+    /// The length of the identifier.
+    static const std::size_t FILE_MAGIC_LENGTH;
+
+private:
+    /// Copying not allowed.
+    InstructionTraceWriter(const InstructionTraceWriter&);
+    /// Assignment not allowed.
+    InstructionTraceWriter& operator=(const InstructionTraceWriter&);
+
+    void writeNumber(ULongWord value);
+
+    /// The trace file.
+    std::ofstream file_;
+    /// The encoded records not yet written to the file.
+    std::vector<unsigned char> buffer_;
+    /// The cycle of the previous record.
+    ClockCycleCount lastCycle_;
+    /// The address following the address of the previous record.
+    ULongWord nextAddress_;
+};
+
+#endif
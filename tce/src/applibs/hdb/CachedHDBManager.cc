@@ -32,6 +32,8 @@
  */
 
 #include <iostream>
+#include <algorithm>
+#include <iterator>
 
 #include "CachedHDBManager.hh"
 #include "SQLiteConnection.hh"
@@ -46,6 +48,8 @@
 #include "Application.hh"
 #include "HDBTypes.hh"
 #include "HDBRegistry.hh"
+#include "FunctionUnit.hh"
+#include "HWOperation.hh"
 
 using namespace HDB;
 
@@ -56,7 +60,7 @@ using namespace HDB;
  * @throw IOException if an error occured opening the HDB file.
  */
 CachedHDBManager::CachedHDBManager(const std::string& hdbFile)
-    : HDBManager(hdbFile) {
+    : HDBManager(hdbFile), snapshotEnabled_(false), snapshot_(NULL) {
     lastModificationTime_ = FileSystem::lastModificationTime(hdbFile);
     lastSizeInBytes_ = FileSystem::sizeInBytes(hdbFile);
 }
@@ -73,6 +77,8 @@ CachedHDBManager::~CachedHDBManager() {
     MapTools::deleteAllValues(rfImplCache_);
 
     costEstimationPluginValueCache_.clear();     
+    delete snapshot_;
+    snapshot_ = NULL;
 }
 
 
@@ -125,6 +131,7 @@ CachedHDBManager::removeFUArchitecture(RowID archID) const {
         delete (*iter).second;
         fuArchCache_.erase(iter);
     }
+    invalidateSnapshot();
 
     HDBManager::removeFUArchitecture(archID);
 }
@@ -173,6 +180,7 @@ CachedHDBManager::removeRFArchitecture(RowID archID) const {
         delete (*iter).second;
         rfArchCache_.erase(iter);
     }
+    invalidateSnapshot();
 
     HDBManager::removeRFArchitecture(archID);
 }
@@ -337,6 +345,7 @@ void
 CachedHDBManager::removeFUEntry(RowID id) const {
 
     costEstimationPluginValueCache_.clear();     
+    invalidateSnapshot();
     HDBManager::removeFUEntry(id);
 }
 
@@ -350,6 +359,7 @@ void
 CachedHDBManager::removeRFEntry(RowID id) const {
 
     costEstimationPluginValueCache_.clear();     
+    invalidateSnapshot();
     HDBManager::removeRFEntry(id);
 }
 
@@ -590,8 +600,229 @@ CachedHDBManager::validateCache() const {
     MapTools::deleteAllValues(fuImplCache_);
     MapTools::deleteAllValues(rfImplCache_);
     costEstimationPluginValueCache_.clear();
+    invalidateSnapshot();
 
     // set current size and modification time
     lastModificationTime_ = modTime;
     lastSizeInBytes_ = byteSize;
 }
+
+/**
+ * Enables or disables answering the entry queries from the snapshot.
+ *
+ * @param enabled True to use the snapshot.
+ */
+void
+CachedHDBManager::setSnapshotEnabled(bool enabled) {
+    snapshotEnabled_ = enabled;
+    if (!enabled) {
+        invalidateSnapshot();
+    }
+}
+
+/**
+ * Returns the snapshot of the tables used by the entry queries.
+ *
+ * The snapshot is read from the HDB on the first call after it has been
+ * enabled or invalidated.
+ *
+ * @return The snapshot, or NULL if it is disabled or could not be read.
+ */
+const CachedHDBManager::Snapshot*
+CachedHDBManager::snapshot() const {
+
+    if (!snapshotEnabled_) {
+        return NULL;
+    }
+    validateCache();
+    if (snapshot_ != NULL) {
+        return snapshot_;
+    }
+
+    Snapshot* snapshot = new Snapshot();
+    RelationalDBQueryResult* result = NULL;
+    try {
+        result = getDBConnection()->query(
+            "SELECT operation_pipeline.fu_arch, operation.name "
+            "FROM operation_pipeline, operation "
+            "WHERE operation_pipeline.operation=operation.id;");
+        while (result->hasNext()) {
+            result->next();
+            snapshot->fuArchitecturesByOperation[
+                result->data(1).stringValue()].insert(
+                    result->data(0).integerValue());
+        }
+        delete result;
+
+        result = getDBConnection()->query(
+            "SELECT id, architecture FROM fu "
+            "WHERE architecture IS NOT NULL;");
+        while (result->hasNext()) {
+            result->next();
+            snapshot->fuEntriesByArchitecture[
+                result->data(1).integerValue()].insert(
+                    result->data(0).integerValue());
+        }
+        delete result;
+
+        result = getDBConnection()->query(
+            "SELECT rf.id, rf_architecture.read_ports, "
+            "rf_architecture.write_ports, rf_architecture.bidir_ports, "
+            "rf_architecture.max_reads, rf_architecture.max_writes, "
+            "rf_architecture.latency, rf_architecture.guard_support, "
+            "rf_architecture.guard_latency, rf_architecture.width, "
+            "rf_architecture.size FROM rf, rf_architecture "
+            "WHERE rf.architecture=rf_architecture.id;");
+        while (result->hasNext()) {
+            result->next();
+            RFEntryRow row;
+            row.id = result->data(0).integerValue();
+            row.maxReads = result->data(4).integerValue();
+            row.maxWrites = result->data(5).integerValue();
+            row.latency = result->data(6).integerValue();
+            row.guardSupport = result->data(7).boolValue();
+            row.guardLatency = result->data(8).integerValue();
+            row.width = result->data(9).isNull() ?
+                0 : result->data(9).integerValue();
+            row.size = result->data(10).isNull() ?
+                0 : result->data(10).integerValue();
+            RFPortCounts ports(
+                result->data(1).integerValue(),
+                std::make_pair(
+                    result->data(2).integerValue(),
+                    result->data(3).integerValue()));
+            snapshot->rfEntriesByPorts.insert(std::make_pair(ports, row));
+        }
+        delete result;
+    } catch (const Exception& e) {
+        debugLog(e.errorMessage());
+        delete result;
+        delete snapshot;
+        return NULL;
+    }
+
+    snapshot_ = snapshot;
+    return snapshot_;
+}
+
+/**
+ * Drops the snapshot so that it is read again when needed.
+ */
+void
+CachedHDBManager::invalidateSnapshot() const {
+    delete snapshot_;
+    snapshot_ = NULL;
+}
+
+/**
+ * Returns a set of FU entry IDs that have a corresponding architecture
+ * with the given one.
+ *
+ * Uses the snapshot if it is enabled, see HDBManager for the semantics.
+ *
+ * @param fu The FU architecture.
+ * @return Set of FU entry IDs.
+ */
+std::set<RowID>
+CachedHDBManager::fuEntriesByArchitecture(
+    const TTAMachine::FunctionUnit& fu) const {
+
+    const Snapshot* data = snapshot();
+    if (data == NULL || fu.operationCount() == 0) {
+        return HDBManager::fuEntriesByArchitecture(fu);
+    }
+
+    // architectures with all the operations of the FU
+    std::set<RowID> candidates;
+    for (int i = 0; i < fu.operationCount(); i++) {
+        std::map<std::string, std::set<RowID> >::const_iterator archs =
+            data->fuArchitecturesByOperation.find(fu.operation(i)->name());
+        if (archs == data->fuArchitecturesByOperation.end()) {
+            return std::set<RowID>();
+        }
+        if (i == 0) {
+            candidates = archs->second;
+            continue;
+        }
+        std::set<RowID> common;
+        std::set_intersection(
+            candidates.begin(), candidates.end(),
+            archs->second.begin(), archs->second.end(),
+            std::inserter(common, common.begin()));
+        candidates.swap(common);
+    }
+
+    std::set<RowID> entryIDs;
+    for (std::set<RowID>::const_iterator i = candidates.begin();
+         i != candidates.end(); i++) {
+        try {
+            if (!isMatchingArchitecture(fu, fuArchitectureByIDConst(*i))) {
+                continue;
+            }
+        } catch (const Exception& e) {
+            debugLog(e.errorMessage());
+            continue;
+        }
+        std::map<RowID, std::set<RowID> >::const_iterator entries =
+            data->fuEntriesByArchitecture.find(*i);
+        if (entries != data->fuEntriesByArchitecture.end()) {
+            entryIDs.insert(entries->second.begin(), entries->second.end());
+        }
+    }
+    return entryIDs;
+}
+
+/**
+ * Returns a set of RF entry IDs that have the described architecture.
+ *
+ * Uses the snapshot if it is enabled, see HDBManager for the semantics of
+ * the parameters.
+ *
+ * @return Set of RF entry IDs.
+ */
+std::set<RowID>
+CachedHDBManager::rfEntriesByArchitecture(
+    int readPorts,
+    int writePorts,
+    int bidirPorts,
+    int maxReads,
+    int maxWrites,
+    int latency,
+    bool guardSupport,
+    int guardLatency,
+    int width,
+    int size) const {
+
+    const Snapshot* data = snapshot();
+    if (data == NULL) {
+        return HDBManager::rfEntriesByArchitecture(
+            readPorts, writePorts, bidirPorts, maxReads, maxWrites,
+            latency, guardSupport, guardLatency, width, size);
+    }
+
+    typedef std::multimap<RFPortCounts, RFEntryRow>::const_iterator
+        RowIter;
+    std::pair<RowIter, RowIter> rows = data->rfEntriesByPorts.equal_range(
+        RFPortCounts(readPorts, std::make_pair(writePorts, bidirPorts)));
+
+    std::set<RowID> entryIDs;
+    for (RowIter i = rows.first; i != rows.second; i++) {
+        const RFEntryRow& row = i->second;
+        if (row.maxReads < maxReads || row.maxWrites < maxWrites ||
+            row.latency > latency) {
+            continue;
+        }
+        if (guardSupport &&
+            (!row.guardSupport || row.guardLatency != guardLatency)) {
+            continue;
+        }
+        if (size != 0 && row.size != 0 && row.size != size) {
+            continue;
+        }
+        if (width != 0 && row.width != 0 && row.width != width) {
+            continue;
+        }
+        entryIDs.insert(row.id);
+    }
+    return entryIDs;
+}
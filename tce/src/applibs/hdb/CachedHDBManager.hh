@@ -53,6 +53,13 @@ namespace HDB {
  * significant speedups if the same objects are queried repeatedly without
  * any modifications to the related data in the HDB.
  *
+ * The FU and RF entry queries used in implementation selection can also be
+ * answered from a snapshot of the related tables, which is read in one go
+ * and indexed in memory. The snapshot is used only when enabled with
+ * setSnapshotEnabled(), because entries added to the HDB through this
+ * manager are seen only after the snapshot is invalidated by a change of
+ * the HDB file.
+ *
  * IMPORTANT NOTE:
  *
  * If a new function which modifies or removes cached objects is added
@@ -115,7 +122,53 @@ public:
         const CostEstimationData& match, bool useCompiledQueries = false,
         RelationalDBQueryResult* compiledQuery = NULL) const;
 
+    // Queries using the snapshot, if enabled
+    void setSnapshotEnabled(bool enabled);
+
+    virtual std::set<RowID> fuEntriesByArchitecture(
+        const TTAMachine::FunctionUnit& fu) const;
+
+    virtual std::set<RowID> rfEntriesByArchitecture(
+        int readPorts,
+        int writePorts,
+        int bidirPorts,
+        int maxReads,
+        int maxWrites,
+        int latency,
+        bool guardSupport,
+        int guardLatency = 0,
+        int width = 0,
+        int size = 0) const;
+
 private:
+    /// RF entry with the architecture data used in entry queries.
+    struct RFEntryRow {
+        RowID id;
+        int maxReads;
+        int maxWrites;
+        int latency;
+        bool guardSupport;
+        int guardLatency;
+        /// 0 if the width is parametrized
+        int width;
+        /// 0 if the size is parametrized
+        int size;
+    };
+
+    /// Number of read, write and bidirectional ports of an RF.
+    typedef std::pair<int, std::pair<int, int> > RFPortCounts;
+
+    /// In-memory copy of the tables used by the entry queries.
+    struct Snapshot {
+        /// FU architecture IDs by the names of their operations.
+        std::map<std::string, std::set<RowID> > fuArchitecturesByOperation;
+        /// FU entry IDs by their architecture ID.
+        std::map<RowID, std::set<RowID> > fuEntriesByArchitecture;
+        /// RF entries by their port counts.
+        std::multimap<RFPortCounts, RFEntryRow> rfEntriesByPorts;
+    };
+
+
     CachedHDBManager(const std::string& hdbFile);
 
     // Private queries using cache.
@@ -126,6 +179,9 @@ private:
     // Checks if cache is invalid.
     void validateCache() const;
 
+    const Snapshot* snapshot() const;
+    void invalidateSnapshot() const;
+
     /// FU Architecture cache.
     mutable std::map<RowID, FUArchitecture*> fuArchCache_;
     /// RF Architecture cache.
@@ -146,6 +202,11 @@ private:
     mutable std::time_t lastModificationTime_;
     /// used to detect modifications to the HDB file (which invalidates cache)
     mutable uintmax_t lastSizeInBytes_;
+
+    /// true if entry queries are answered from the snapshot
+    bool snapshotEnabled_;
+    /// the snapshot, NULL until loaded
+    mutable Snapshot* snapshot_;
 };
 
 } // End namespace HDB.
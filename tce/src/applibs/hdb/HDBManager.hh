@@ -148,10 +148,10 @@ public:
 
     virtual RFArchitecture* rfArchitectureByID(RowID id) const;
 
-    std::set<RowID> fuEntriesByArchitecture(
+    virtual std::set<RowID> fuEntriesByArchitecture(
         const TTAMachine::FunctionUnit& fu) const;
 
-    std::set<RowID> rfEntriesByArchitecture(
+    virtual std::set<RowID> rfEntriesByArchitecture(
         int readPorts,
         int writePorts,
         int bidirPorts,
@@ -266,6 +266,9 @@ protected:
         bool createBindableQuery = false) const;
     RelationalDBConnection* getDBConnection() const;
 
+    static bool isMatchingArchitecture(
+        const TTAMachine::FunctionUnit& fu, const FUArchitecture& arch);
+
     HDBManager(const std::string& hdbFile);
 
 private:
@@ -344,8 +347,6 @@ private:
         const CostEstimationData& match, 
         std::string& query) const;
 
-    static bool isMatchingArchitecture(
-        const TTAMachine::FunctionUnit& fu, const FUArchitecture& arch);
     static bool areCompatiblePipelines(
         const PipelineElementUsageTable& table);
     static void insertFileFormats(RelationalDBConnection& connection);
@@ -182,6 +182,39 @@ HDBRegistry::loadFromSearchPaths() {
     }
 }
 
+/**
+ * Replaces the HDB connections inherited from the parent process with new
+ * ones.
+ *
+ * To be called in a forked child process before it uses any HDB. SQLite
+ * connections must not be used across a fork(), so the inherited managers
+ * are abandoned without closing their connections, which belong to the
+ * parent, and the same HDB files are opened again. Any references to the
+ * abandoned managers must not be used after this.
+ */
+void
+HDBRegistry::reopenAfterFork() {
+
+    std::vector<std::string> paths;
+    std::map<const std::string, CachedHDBManager*>::const_iterator iter =
+        registry_.begin();
+    for (; iter != registry_.end(); iter++) {
+        paths.push_back(iter->first);
+    }
+    // the inherited managers are leaked on purpose, deleting them would
+    // close the connections of the parent process
+    registry_.clear();
+
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        try {
+            CachedHDBManager::instance(paths[i]);
+        } catch (const Exception& e) {
+            errorMessages_.push_back(
+                "Error in '" + paths[i] + "': " + e.errorMessage() + ".");
+        }
+    }
+}
+
 /**
  * Returns the HDB from given index.
  *
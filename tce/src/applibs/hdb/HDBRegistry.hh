@@ -57,6 +57,7 @@ public:
     std::string hdbPath(unsigned int index);
     int hdbErrorCount();
     std::string hdbErrorMessage(unsigned int index);
+    void reopenAfterFork();
 
 private:
     /// HDB registry must be created with instance() method.
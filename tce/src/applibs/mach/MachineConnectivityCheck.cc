@@ -35,6 +35,7 @@
 
 #include "MachineConnectivityCheck.hh"
 #include "MachineInfo.hh"
+#include "MachineConnectivityOracle.hh"
 #include "Application.hh"
 #include "Bus.hh"
 #include "Segment.hh"
@@ -114,14 +115,15 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::Port& destinationPort,
     const Guard* guard) {
 
-    // TODO: replace this cache's second value(bool) with set of buses.
-    PortPortBoolMap::const_iterator
-        i = portPortCache_.find(PortPortPair(&sourcePort, &destinationPort));
-    if (i != portPortCache_.end()) {
-        if (i->second == false || guard == NULL) {
-            return i->second;
-        }
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(
+            *sourcePort.parentUnit(), *destinationPort.parentUnit());
+    if (oracle) {
+        return oracle->shareBus(
+            oracle->destinationBuses(sourcePort),
+            oracle->sourceBuses(destinationPort), guard);
     }
+
     std::set<const TTAMachine::Bus*> sourceBuses;
     MachineConnectivityCheck::appendConnectedDestinationBuses(
         sourcePort, sourceBuses);
@@ -133,8 +135,6 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(sourceBuses, destinationBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        portPortCache_[PortPortPair(&sourcePort,&destinationPort)] = true;
-
         if (guard == NULL) {
             return true;
         }
@@ -148,7 +148,6 @@ MachineConnectivityCheck::isConnected(
              
         return false; // bus found but lacks the guards
     } else {
-        portPortCache_[PortPortPair(&sourcePort,&destinationPort)] = false;
         return false;
     }
 }
@@ -167,8 +166,16 @@ MachineConnectivityCheck::canTransportImmediate(
     const TTAMachine::BaseRegisterFile& destRF,
     const Guard* guard) {
 
-    std::set<const TTAMachine::Bus*> buses;
-    MachineConnectivityCheck::appendConnectedSourceBuses(destRF, buses);
+    std::vector<const TTAMachine::Bus*> buses;
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(destRF, destRF);
+    if (oracle) {
+        buses = oracle->buses(oracle->sourceBuses(destRF));
+    } else {
+        std::set<const TTAMachine::Bus*> busSet;
+        appendConnectedSourceBuses(destRF, busSet);
+        buses.assign(busSet.begin(), busSet.end());
+    }
 
     for (auto bus : buses) {
         int requiredBits = 
@@ -203,9 +210,17 @@ MachineConnectivityCheck::canTransportImmediate(
     const TTAMachine::Port& destinationPort,
     const Guard* guard) {
 
-    std::set<const TTAMachine::Bus*> buses;
-    MachineConnectivityCheck::appendConnectedSourceBuses(
-        destinationPort, buses);
+    std::vector<const TTAMachine::Bus*> buses;
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(
+            *destinationPort.parentUnit(), *destinationPort.parentUnit());
+    if (oracle) {
+        buses = oracle->buses(oracle->sourceBuses(destinationPort));
+    } else {
+        std::set<const TTAMachine::Bus*> busSet;
+        appendConnectedSourceBuses(destinationPort, busSet);
+        buses.assign(busSet.begin(), busSet.end());
+    }
 
     for (auto i = buses.begin(); i != buses.end(); ++i) {
         const TTAMachine::Bus& bus = **i;
@@ -258,11 +273,14 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::Port& destPort) {
 
-    RfPortBoolMap::const_iterator
-        i = rfPortCache_.find(RfPortPair(&sourceRF, &destPort));
-    if (i != rfPortCache_.end()) {
-        return i->second;
-    }    
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(sourceRF, *destPort.parentUnit());
+    if (oracle) {
+        return oracle->shareBus(
+            oracle->destinationBuses(sourceRF),
+            oracle->sourceBuses(destPort));
+    }
+
     std::set<const TTAMachine::Bus*> destBuses = connectedSourceBuses(destPort);
     std::set<const TTAMachine::Bus*> srcBuses;
 
@@ -276,13 +294,7 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(
         srcBuses, destBuses, sharedBuses);
-    if (sharedBuses.size() > 0) {
-        rfPortCache_[RfPortPair(&sourceRF,&destPort)] = true;
-        return true;
-    } else {
-        rfPortCache_[RfPortPair(&sourceRF,&destPort)] = false;
-        return false;
-    }
+    return sharedBuses.size() > 0;
 }
 
 /**
@@ -300,14 +312,15 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::BaseRegisterFile& destRF,
     const TTAMachine::Guard* guard) {
-    
-    RfRfBoolMap::const_iterator
-        i = rfRfCache_.find(RfRfPair(&sourceRF, &destRF));
-    if (i != rfRfCache_.end()) {
-        if (i->second == false || guard == NULL) {
-            return i->second;
-        }
+
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(sourceRF, destRF);
+    if (oracle) {
+        return oracle->shareBus(
+            oracle->destinationBuses(sourceRF),
+            oracle->sourceBuses(destRF), guard);
     }
+
     std::set<const TTAMachine::Bus*> srcBuses;
     appendConnectedDestinationBuses(sourceRF, srcBuses);
 
@@ -317,7 +330,6 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(srcBuses, dstBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = true;
         if (guard == NULL) {
             return true;
         }
@@ -330,7 +342,6 @@ MachineConnectivityCheck::isConnected(
         }
         return false; // bus found but lacks the guards
     } else {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = false;
         return false;
     }
 }
@@ -349,7 +360,14 @@ bool
 MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::FunctionUnit& destFU) {
-    
+
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(sourceRF, destFU);
+    if (oracle) {
+        return oracle->shareBus(
+            oracle->destinationBuses(sourceRF), oracle->sourceBuses(destFU));
+    }
+
     std::set<const TTAMachine::Bus*> srcBuses;
     appendConnectedDestinationBuses(sourceRF, srcBuses);
 
@@ -376,10 +394,12 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::Port& sourcePort,
     const TTAMachine::RegisterFile& destRF) {
 
-    PortRfBoolMap::const_iterator
-        i = portRfCache_.find(PortRfPair(&sourcePort, &destRF));
-    if (i != portRfCache_.end()) {
-        return i->second;
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(*sourcePort.parentUnit(), destRF);
+    if (oracle) {
+        return oracle->shareBus(
+            oracle->destinationBuses(sourcePort),
+            oracle->sourceBuses(destRF));
     }
 
     std::set<const TTAMachine::Bus*> sourceBuses =
@@ -395,14 +415,7 @@ MachineConnectivityCheck::isConnected(
     
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(sourceBuses, destBuses, sharedBuses);
-
-    if (sharedBuses.size() > 0) {
-        portRfCache_[PortRfPair(&sourcePort,&destRF)] = true;
-        return true;
-    } else {
-        portRfCache_[PortRfPair(&sourcePort,&destRF)] = false;
-        return false;
-    }
+    return sharedBuses.size() > 0;
 }
 
 /**
@@ -1354,12 +1367,23 @@ MachineConnectivityCheck::addAnnotatedFUs(std::set<TCEString>& candidateFUs,
 
 }
 
-/* These are static */
-MachineConnectivityCheck::PortPortBoolMap MachineConnectivityCheck::portPortCache_;
-MachineConnectivityCheck::RfRfBoolMap MachineConnectivityCheck::rfRfCache_;
-MachineConnectivityCheck::RfPortBoolMap MachineConnectivityCheck::rfPortCache_;
-MachineConnectivityCheck::PortRfBoolMap MachineConnectivityCheck::portRfCache_;
+/**
+ * Returns the connectivity oracle for queries between two units.
+ *
+ * @param a The first unit.
+ * @param b The second unit.
+ * @return The oracle of the machine of the units, or an empty pointer if
+ * the units are not in the same machine.
+ */
+std::shared_ptr<const MachineConnectivityOracle>
+MachineConnectivityCheck::connectivityOracle(
+    const TTAMachine::Unit& a, const TTAMachine::Unit& b) {
 
+    if (a.machine() == NULL || a.machine() != b.machine()) {
+        return std::shared_ptr<const MachineConnectivityOracle>();
+    }
+    return MachineConnectivityOracle::oracle(*a.machine());
+}
 
 bool
 MachineConnectivityCheck::hasConditionalMoves(
@@ -1425,27 +1449,28 @@ MachineConnectivityCheck::isConnectedWithBothGuards(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::BaseRegisterFile& destRF,
     std::pair<const RegisterFile*,int> guardReg) {
-    
-    RfRfBoolMap::const_iterator
-        i = rfRfCache_.find(RfRfPair(&sourceRF, &destRF));
-    if (i != rfRfCache_.end()) {
-        if (i->second == false) {
-            return false;
-        }
-    }
-    std::set<const TTAMachine::Bus*> srcBuses;
-    appendConnectedDestinationBuses(sourceRF, srcBuses);
 
-    std::set<const TTAMachine::Bus*> dstBuses;
-    appendConnectedSourceBuses(destRF, dstBuses);
+    std::vector<const TTAMachine::Bus*> sharedBuses;
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        connectivityOracle(sourceRF, destRF);
+    if (oracle) {
+        sharedBuses = oracle->sharedBuses(
+            oracle->destinationBuses(sourceRF), oracle->sourceBuses(destRF));
+    } else {
+        std::set<const TTAMachine::Bus*> srcBuses;
+        appendConnectedDestinationBuses(sourceRF, srcBuses);
 
-    std::set<const TTAMachine::Bus*> sharedBuses;
-    SetTools::intersection(srcBuses, dstBuses, sharedBuses);
+        std::set<const TTAMachine::Bus*> dstBuses;
+        appendConnectedSourceBuses(destRF, dstBuses);
+
+        std::set<const TTAMachine::Bus*> busSet;
+        SetTools::intersection(srcBuses, dstBuses, busSet);
+        sharedBuses.assign(busSet.begin(), busSet.end());
+    }
 
     bool trueOK = false;
     bool falseOK = false;
     if (sharedBuses.size() > 0) {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = true;
         for (auto bus: sharedBuses) {
             std::pair<bool, bool> guardsOK = hasBothGuards(bus, guardReg);
             trueOK |= guardsOK.first;
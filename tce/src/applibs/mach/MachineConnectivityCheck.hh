@@ -35,6 +35,7 @@
 
 #include <set>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "MachineCheck.hh"
@@ -44,6 +45,7 @@
 class TCEString;
 class MoveNode;
 class Operation;
+class MachineConnectivityOracle;
 
 namespace TTAMachine {
     class Port;
@@ -221,27 +223,9 @@ public:
 protected:
     MachineConnectivityCheck(const std::string& shortDesc_);
 private:
-    typedef std::pair<const TTAMachine::Port*,const TTAMachine::Port*> 
-    PortPortPair;
-
-    typedef std::pair<const TTAMachine::BaseRegisterFile*,
-                      const TTAMachine::BaseRegisterFile*> RfRfPair;
-    
-    typedef std::pair<const TTAMachine::BaseRegisterFile*,
-                      const TTAMachine::Port*> RfPortPair;
-    
-    typedef std::pair<const TTAMachine::Port*,
-                      const TTAMachine::BaseRegisterFile*> PortRfPair;
-
-    typedef std::map<PortPortPair,bool> PortPortBoolMap;
-    typedef std::map<RfRfPair,bool> RfRfBoolMap;
-    typedef std::map<RfPortPair,bool> RfPortBoolMap;
-    typedef std::map<PortRfPair,bool> PortRfBoolMap;
-
-    static PortPortBoolMap portPortCache_;
-    static RfRfBoolMap rfRfCache_;
-    static RfPortBoolMap rfPortCache_;
-    static PortRfBoolMap portRfCache_;
+    static std::shared_ptr<const MachineConnectivityOracle>
+    connectivityOracle(
+        const TTAMachine::Unit& a, const TTAMachine::Unit& b);
 };
 
 #endif
@@ -0,0 +1,319 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityOracle.cc
+ *
+ * Implementation of MachineConnectivityOracle class.
+ *
+ * @note rating: red
+ */
+
+#include <limits>
+
+#include "MachineConnectivityOracle.hh"
+#include "Machine.hh"
+#include "Bus.hh"
+#include "Segment.hh"
+#include "Socket.hh"
+#include "Port.hh"
+#include "Unit.hh"
+#include "ControlUnit.hh"
+#include "Guard.hh"
+
+using namespace TTAMachine;
+
+/// Number of buses in one word of a BusMask.
+static const int WORD_BITS = std::numeric_limits<unsigned long>::digits;
+
+/// Oracles of at most this many machines are kept by oracle().
+static const unsigned int MAX_CACHED_ORACLES = 64;
+
+/**
+ * Builds the connectivity tables of the given machine.
+ *
+ * @param mach The machine.
+ */
+MachineConnectivityOracle::MachineConnectivityOracle(const Machine& mach) :
+    machine_(mach), version_(mach.connectivityVersion()) {
+
+    Machine::BusNavigator busNav = mach.busNavigator();
+    for (int i = 0; i < busNav.count(); i++) {
+        buses_.push_back(busNav.item(i));
+    }
+    const int words = (buses_.size() + WORD_BITS - 1) / WORD_BITS;
+    unconnected_.sources.resize(words, 0);
+    unconnected_.destinations.resize(words, 0);
+
+    Machine::FunctionUnitNavigator fuNav = mach.functionUnitNavigator();
+    for (int i = 0; i < fuNav.count(); i++) {
+        addUnit(*fuNav.item(i));
+    }
+    Machine::RegisterFileNavigator rfNav = mach.registerFileNavigator();
+    for (int i = 0; i < rfNav.count(); i++) {
+        addUnit(*rfNav.item(i));
+    }
+    Machine::ImmediateUnitNavigator iuNav = mach.immediateUnitNavigator();
+    for (int i = 0; i < iuNav.count(); i++) {
+        addUnit(*iuNav.item(i));
+    }
+    if (mach.controlUnit() != NULL) {
+        addUnit(*mach.controlUnit());
+    }
+}
+
+/**
+ * Destructor.
+ */
+MachineConnectivityOracle::~MachineConnectivityOracle() {
+}
+
+/**
+ * Records the bus connections of the ports of a unit and of the unit.
+ *
+ * @param unit The unit.
+ */
+void
+MachineConnectivityOracle::addUnit(const Unit& unit) {
+
+    Connections& unitConns = unitConnections_[&unit];
+    unitConns = unconnected_;
+
+    for (int p = 0; p < unit.portCount(); p++) {
+        const Port& port = *unit.port(p);
+        Connections& portConns = portConnections_[&port];
+        portConns = unconnected_;
+
+        const Socket* sockets[] = { port.inputSocket(), port.outputSocket() };
+        BusMask* masks[] = { &portConns.sources, &portConns.destinations };
+        for (int s = 0; s < 2; s++) {
+            if (sockets[s] == NULL) {
+                continue;
+            }
+            for (int i = 0; i < sockets[s]->segmentCount(); i++) {
+                const Bus* bus = sockets[s]->segment(i)->parentBus();
+                for (unsigned int b = 0; b < buses_.size(); b++) {
+                    if (buses_[b] == bus) {
+                        (*masks[s])[b / WORD_BITS] |= 1UL << (b % WORD_BITS);
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (unsigned int w = 0; w < unitConns.sources.size(); w++) {
+            unitConns.sources[w] |= portConns.sources[w];
+            unitConns.destinations[w] |= portConns.destinations[w];
+        }
+    }
+}
+
+/**
+ * Returns an up to date oracle of the given machine.
+ *
+ * The oracles are shared and rebuilt only when the connectivity of the
+ * machine has changed since the last call.
+ *
+ * @param mach The machine.
+ * @return The oracle.
+ */
+std::shared_ptr<const MachineConnectivityOracle>
+MachineConnectivityOracle::oracle(const Machine& mach) {
+
+    // repeated queries of one thread on one machine do not need the lock
+    static thread_local std::shared_ptr<const MachineConnectivityOracle>
+        lastOracle;
+    if (lastOracle && &lastOracle->machine_ == &mach &&
+        lastOracle->isUpToDate()) {
+        return lastOracle;
+    }
+
+    std::lock_guard<std::mutex> guard(oraclesLock_);
+    OracleMap::iterator i = oracles_.find(&mach);
+    if (i == oracles_.end() || !i->second->isUpToDate()) {
+        if (i == oracles_.end() && oracles_.size() >= MAX_CACHED_ORACLES) {
+            // entries of deleted machines are never looked up again
+            oracles_.clear();
+        }
+        std::shared_ptr<const MachineConnectivityOracle> newOracle(
+            new MachineConnectivityOracle(mach));
+        oracles_[&mach] = newOracle;
+        lastOracle = newOracle;
+    } else {
+        lastOracle = i->second;
+    }
+    return lastOracle;
+}
+
+/**
+ * Tells whether the connectivity of the machine is still the one the
+ * oracle was built for.
+ *
+ * @return True if the oracle can still be used.
+ */
+bool
+MachineConnectivityOracle::isUpToDate() const {
+    return machine_.connectivityVersion() == version_;
+}
+
+/**
+ * Returns the number of buses in the masks.
+ */
+int
+MachineConnectivityOracle::busCount() const {
+    return buses_.size();
+}
+
+/**
+ * Returns the bus of the given bit of the masks.
+ *
+ * @param index The bit index.
+ * @return The bus.
+ */
+const Bus&
+MachineConnectivityOracle::bus(int index) const {
+    return *buses_.at(index);
+}
+
+/**
+ * Returns the buses the given port can read from.
+ *
+ * @param port The port.
+ * @return The buses. Empty for ports unknown to the oracle.
+ */
+const MachineConnectivityOracle::BusMask&
+MachineConnectivityOracle::sourceBuses(const Port& port) const {
+    PortConnectionMap::const_iterator i = portConnections_.find(&port);
+    return i == portConnections_.end() ?
+        unconnected_.sources : i->second.sources;
+}
+
+/**
+ * Returns the buses the given port can write to.
+ *
+ * @param port The port.
+ * @return The buses. Empty for ports unknown to the oracle.
+ */
+const MachineConnectivityOracle::BusMask&
+MachineConnectivityOracle::destinationBuses(const Port& port) const {
+    PortConnectionMap::const_iterator i = portConnections_.find(&port);
+    return i == portConnections_.end() ?
+        unconnected_.destinations : i->second.destinations;
+}
+
+/**
+ * Returns the buses any port of the given unit can read from.
+ *
+ * @param unit The unit.
+ * @return The buses. Empty for units unknown to the oracle.
+ */
+const MachineConnectivityOracle::BusMask&
+MachineConnectivityOracle::sourceBuses(const Unit& unit) const {
+    UnitConnectionMap::const_iterator i = unitConnections_.find(&unit);
+    return i == unitConnections_.end() ?
+        unconnected_.sources : i->second.sources;
+}
+
+/**
+ * Returns the buses any port of the given unit can write to.
+ *
+ * @param unit The unit.
+ * @return The buses. Empty for units unknown to the oracle.
+ */
+const MachineConnectivityOracle::BusMask&
+MachineConnectivityOracle::destinationBuses(const Unit& unit) const {
+    UnitConnectionMap::const_iterator i = unitConnections_.find(&unit);
+    return i == unitConnections_.end() ?
+        unconnected_.destinations : i->second.destinations;
+}
+
+/**
+ * Tells whether two bus sets have a common bus.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @param guard If given, the common bus must also support this guard.
+ * @return True if such a bus exists.
+ */
+bool
+MachineConnectivityOracle::shareBus(
+    const BusMask& a, const BusMask& b, const Guard* guard) const {
+
+    for (unsigned int w = 0; w < a.size(); w++) {
+        unsigned long shared = a[w] & b[w];
+        if (shared == 0) {
+            continue;
+        }
+        if (guard == NULL) {
+            return true;
+        }
+        for (int bit = 0; bit < WORD_BITS; bit++) {
+            if ((shared & (1UL << bit)) != 0 &&
+                buses_[w * WORD_BITS + bit]->hasGuard(*guard)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the buses which are in both of the given sets.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @return The common buses.
+ */
+std::vector<const Bus*>
+MachineConnectivityOracle::sharedBuses(
+    const BusMask& a, const BusMask& b) const {
+
+    BusMask shared(a.size(), 0);
+    for (unsigned int w = 0; w < a.size(); w++) {
+        shared[w] = a[w] & b[w];
+    }
+    return buses(shared);
+}
+
+/**
+ * Returns the buses of a set.
+ *
+ * @param mask The set.
+ * @return The buses in the order of the machine.
+ */
+std::vector<const Bus*>
+MachineConnectivityOracle::buses(const BusMask& mask) const {
+
+    std::vector<const Bus*> result;
+    for (unsigned int w = 0; w < mask.size(); w++) {
+        for (int bit = 0; mask[w] != 0 && bit < WORD_BITS; bit++) {
+            if ((mask[w] & (1UL << bit)) != 0) {
+                result.push_back(buses_[w * WORD_BITS + bit]);
+            }
+        }
+    }
+    return result;
+}
+
+MachineConnectivityOracle::OracleMap MachineConnectivityOracle::oracles_;
+std::mutex MachineConnectivityOracle::oraclesLock_;
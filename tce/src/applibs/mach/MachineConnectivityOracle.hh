@@ -0,0 +1,122 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityOracle.hh
+ *
+ * Declaration of MachineConnectivityOracle class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_MACHINE_CONNECTIVITY_ORACLE_HH
+#define TTA_MACHINE_CONNECTIVITY_ORACLE_HH
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace TTAMachine {
+    class Machine;
+    class Bus;
+    class Port;
+    class Unit;
+    class Guard;
+}
+
+/**
+ * Precomputed bus connectivity of the ports and units of a machine.
+ *
+ * The sets of buses each port and unit can read from and write to are
+ * stored as bitmasks, so connectivity queries are answered by intersecting
+ * the masks instead of walking the sockets and segments every time.
+ *
+ * An oracle describes the machine at the time it was built. Use oracle()
+ * to get one that is kept up to date with the connectivity of the machine.
+ */
+class MachineConnectivityOracle {
+public:
+    /// Set of buses. Bit i is set for bus(i).
+    typedef std::vector<unsigned long> BusMask;
+
+    explicit MachineConnectivityOracle(const TTAMachine::Machine& mach);
+    virtual ~MachineConnectivityOracle();
+
+    static std::shared_ptr<const MachineConnectivityOracle> oracle(
+        const TTAMachine::Machine& mach);
+
+    bool isUpToDate() const;
+
+    int busCount() const;
+    const TTAMachine::Bus& bus(int index) const;
+
+    const BusMask& sourceBuses(const TTAMachine::Port& port) const;
+    const BusMask& destinationBuses(const TTAMachine::Port& port) const;
+    const BusMask& sourceBuses(const TTAMachine::Unit& unit) const;
+    const BusMask& destinationBuses(const TTAMachine::Unit& unit) const;
+
+    bool shareBus(
+        const BusMask& a, const BusMask& b,
+        const TTAMachine::Guard* guard = NULL) const;
+    std::vector<const TTAMachine::Bus*> sharedBuses(
+        const BusMask& a, const BusMask& b) const;
+    std::vector<const TTAMachine::Bus*> buses(const BusMask& mask) const;
+
+private:
+    /// The buses a port or unit reads from and writes to.
+    struct Connections {
+        BusMask sources;
+        BusMask destinations;
+    };
+    typedef std::unordered_map<const TTAMachine::Port*, Connections>
+    PortConnectionMap;
+    typedef std::unordered_map<const TTAMachine::Unit*, Connections>
+    UnitConnectionMap;
+
+    void addUnit(const TTAMachine::Unit& unit);
+
+    /// The machine the oracle describes.
+    const TTAMachine::Machine& machine_;
+    /// Connectivity stamp of the machine when the oracle was built.
+    unsigned long version_;
+    /// The buses of the machine in the order of their bits in the masks.
+    std::vector<const TTAMachine::Bus*> buses_;
+    /// Connections of the ports of the machine.
+    PortConnectionMap portConnections_;
+    /// Connections of the units of the machine, unions of their ports.
+    UnitConnectionMap unitConnections_;
+    /// Returned for components without connections.
+    Connections unconnected_;
+
+    typedef std::map<const TTAMachine::Machine*,
+                     std::shared_ptr<const MachineConnectivityOracle> >
+    OracleMap;
+    /// The oracles returned by oracle(), by machine.
+    static OracleMap oracles_;
+    /// Guards oracles_ against concurrent schedulers.
+    static std::mutex oraclesLock_;
+};
+
+#endif
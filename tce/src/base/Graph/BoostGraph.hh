@@ -37,27 +37,9 @@
 #ifndef TTA_BOOST_GRAPH_HH
 #define TTA_BOOST_GRAPH_HH
 
-#include <boost/version.hpp>
-
-#if BOOST_VERSION < 103500
-// from boost v1.35 (missing from 1.34 making findAllPaths() fail)
-#include <boost/graph/detail/edge.hpp>
-
-namespace boost {
-    namespace detail {
-        template <class D, class V>
-        inline bool
-        operator<(const detail::edge_desc_impl<D,V>& a, 
-                  const detail::edge_desc_impl<D,V>& b) {
-            return a.get_property() < b.get_property();
-        }
-    }
-}
-
-#endif
-
 #include <map>
 #include <set>
+#include <vector>
 
 // these need to be included before Boost so we include a working
 // and warning-free hash_map
@@ -289,6 +271,15 @@ protected:
     // fast node removal
     void replaceNodeWithLastNode(GraphNode& dest);
 
+    // maintenance of the reachability index used by hasPath()
+    void invalidatePathCache() const;
+    void updatePathCacheOnAdd(const NodeDescriptor& nd);
+    void updatePathCacheOnConnect(
+        const NodeDescriptor& tail, const NodeDescriptor& head,
+        const GraphEdge& e);
+    bool pathCacheReaches(
+        const NodeDescriptor& src, const NodeDescriptor& dest) const;
+
     // internal implementation of path-length-related things.
     void calculatePathLengths() const;
 
@@ -376,8 +367,11 @@ protected:
     std::set<Edge*> ownedEdges_;
     bool allowLoopEdges_;
     
-    // cache to speed up hasPath(), call findAllPaths() to initialize
-    typedef std::vector<std::vector<int> > PathCache;
+    // cache to speed up hasPath(), call findAllPaths() to initialize.
+    // Row n is a bitset of the node descriptors reachable from node n
+    // through non-back edges.
+    typedef unsigned long PathCacheWord;
+    typedef std::vector<std::vector<PathCacheWord> > PathCache;
     mutable PathCache* pathCache_;
 };
 
@@ -36,6 +36,8 @@
 #ifndef TTA_GRAPH_EDGE_HH
 #define TTA_GRAPH_EDGE_HH
 
+#include <atomic>
+
 #include "TCEString.hh"
 
 /**
@@ -72,7 +74,7 @@ public:
 
 private:
     int edgeID_;
-    static int edgeCounter_;
+    static std::atomic<int> edgeCounter_;
 };
 
 #endif
@@ -34,6 +34,7 @@
 #ifndef TTA_GRAPH_NODE_HH
 #define TTA_GRAPH_NODE_HH
 
+#include <atomic>
 #include <string>
 
 /**
@@ -61,7 +62,7 @@ public:
     };
 private:
     int nodeID_;
-    static int idCounter_;
+    static std::atomic<int> idCounter_;
 };
 
 #include "GraphNode.icc"
@@ -249,6 +249,7 @@ ExecutionPipeline::removeAllResourceUses() {
     opReads_.clear();
 
     FunctionUnit* parent = parent_->parentUnit();
+    parent->structureChanged();
 
     // clean up pipeline elements
     for (ResourceSet::const_iterator iter = usedResources.begin();
@@ -896,6 +897,7 @@ ExecutionPipeline::internalAddResourceUse(
     for (int cycle = start; cycle < start + duration; cycle++) {
         resourceUsage_[cycle].insert(used);
     }
+    parent_->parentUnit()->structureChanged();
 }
 
 
@@ -921,6 +923,7 @@ ExecutionPipeline::internalAddPortUse(
     for (int cycle = start; cycle < start + duration; cycle++) {
         toModify[cycle].insert(operand);
     }
+    parent_->parentUnit()->structureChanged();
 }
 
 
@@ -956,6 +959,7 @@ ExecutionPipeline::internalRemoveResourceUse(
 
     FunctionUnit* fu = parent_->parentUnit();
     fu->cleanup(name);
+    fu->structureChanged();
 }
 
 
@@ -984,6 +988,7 @@ ExecutionPipeline::internalRemoveOperandUse(
     }
 
     adjustLatency(0);
+    parent_->parentUnit()->structureChanged();
 }
 
 
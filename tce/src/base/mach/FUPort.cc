@@ -227,6 +227,9 @@ FUPort::setTriggering(bool triggers) {
         setsOpcode_ = false;
     }
     triggers_ = triggers;
+    if (parentUnit() != NULL) {
+        parentUnit()->structureChanged();
+    }
 }
 
 
@@ -478,6 +481,9 @@ FUPort::noRegister() const {
 void
 FUPort::setNoRegister(bool noRegister) {
     noRegister_ = noRegister;
+    if (parentUnit() != NULL) {
+        parentUnit()->structureChanged();
+    }
 }
     
 }
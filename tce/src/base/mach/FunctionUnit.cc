@@ -290,6 +290,7 @@ FunctionUnit::addOperation(HWOperation& operation) {
 
     if (!FunctionUnit::hasOperation(operation.name())) {
         operations_.push_back(&operation);
+        structureChanged();
     } else {
         string procName = "FunctionUnit::addOperation";
         throw ComponentAlreadyExists(__FILE__, __LINE__, procName);
@@ -311,6 +312,7 @@ FunctionUnit::deleteOperation(HWOperation& operation) {
         bool removed = ContainerTools::removeValueIfExists(operations_,
                                                            &operation);
         assert(removed);
+        structureChanged();
     } else {
         if (!ContainerTools::containsValue(operations_, &operation)) {
             string procName = "FunctionUnit::deleteOperation";
@@ -474,6 +476,7 @@ FunctionUnit::addPipelineElement(PipelineElement& element) {
         throw ComponentAlreadyExists(__FILE__, __LINE__, procName);
     } else {
         pipelineElements_.push_back(&element);
+        structureChanged();
     }
 }
 
@@ -495,6 +498,7 @@ FunctionUnit::deletePipelineElement(PipelineElement& element) {
     bool removed = ContainerTools::removeValueIfExists(
         pipelineElements_, &element);
     assert(removed);
+    structureChanged();
 }
 
 
@@ -640,6 +644,19 @@ FunctionUnit::cleanup(const std::string& resource) {
     delete toDelete;
 }
 
+/**
+ * Gives the machine of the function unit a new fingerprint.
+ *
+ * Called when the operations, the pipelines, the pipeline elements or the
+ * operand bindings of the unit change, see Machine::fingerprint().
+ */
+void
+FunctionUnit::structureChanged() {
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
+}
+
 
 /**
  * Removes registration of the function unit from its current machine.
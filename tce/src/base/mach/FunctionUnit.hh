@@ -100,6 +100,8 @@ public:
 
     virtual void cleanup(const std::string& resource);
 
+    void structureChanged();
+
     virtual void unsetMachine();
 
     virtual ObjectState* saveState() const;
@@ -176,6 +176,7 @@ HWOperation::setName(const std::string& name) {
     }
 
     name_ = lowerName;
+    parentUnit()->structureChanged();
 }
 
 /**
@@ -279,6 +280,7 @@ HWOperation::bindPort(int operand, const FUPort& port) {
 
     operandBinding_[operand] = &port;
     port.updateBindingString();
+    parentUnit()->structureChanged();
 }
 
 /**
@@ -290,6 +292,7 @@ void
 HWOperation::unbindPort(const FUPort& port) {
     MapTools::removeItemsByValue(operandBinding_, &port);
     port.updateBindingString();
+    parentUnit()->structureChanged();
 }
 
 
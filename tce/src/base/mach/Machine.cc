@@ -33,6 +33,7 @@
 
 #include <string>
 #include <set>
+#include <atomic>
 #include <boost/functional/hash.hpp>
 
 #include "Machine.hh"
@@ -69,6 +70,9 @@ const string Machine::OSKEY_TRIGGER_INVALIDATES_OLD_RESULTS
 	= "trigger-invalidates";
 const string Machine::OSKEY_FUNCTION_UNITS_ORDERED = "fu-ordered";
 
+/// Source of the connectivity stamps and fingerprints of all machines.
+static std::atomic<unsigned long> connectivityVersionCounter(0);
+
 /**
  * Constructor.
  */
@@ -78,7 +82,9 @@ Machine::Machine() :
     dummyMachineTester_(new DummyMachineTester(*this)),
     EMPTY_ITEMP_NAME_("no_limm"), alwaysWriteResults_(false), 
     triggerInvalidatesResults_(false), fuOrdered_(false),
-    littleEndian_(true), bitness64_(false) {
+    littleEndian_(true), bitness64_(false),
+    connectivityVersion_(++connectivityVersionCounter),
+    fingerprint_(connectivityVersion_) {
 
     new InstructionTemplate(EMPTY_ITEMP_NAME_, *this);
 }
@@ -96,7 +102,9 @@ Machine::Machine(const Machine& old) :
     machineTester_(new MachineTester(*this)), 
     dummyMachineTester_(new DummyMachineTester(*this)),
     littleEndian_(old.littleEndian_),
-    bitness64_(old.bitness64_) {
+    bitness64_(old.bitness64_),
+    connectivityVersion_(++connectivityVersionCounter),
+    fingerprint_(connectivityVersion_) {
     
     ObjectState* state = old.saveState();
     loadState(state);
@@ -318,6 +326,7 @@ Machine::setGlobalControl(ControlUnit& unit) {
         unit.setMachine(*this);
     } else {
         controlUnit_ = &unit;
+        connectivityChanged();
     }
 }
 
@@ -545,6 +554,7 @@ Machine::unsetGlobalControl() {
     } else {
         if (controlUnit_->machine() == NULL) {
             controlUnit_ = NULL;
+            connectivityChanged();
         } else {
             controlUnit_->unsetMachine();
         }
@@ -903,6 +913,61 @@ Machine::hash() const {
     return hash;
 }
 
+/**
+ * Returns a stamp of the current interconnection of the machine.
+ *
+ * The stamp changes whenever buses, sockets or units are added or removed,
+ * sockets are attached to or detached from ports and segments, or the
+ * direction of a socket changes. The stamps are unique within the process,
+ * so a cache keyed on the machine address and the stamp is never
+ * confused by a new machine at the address of a deleted one.
+ *
+ * @return The connectivity stamp.
+ */
+unsigned long
+Machine::connectivityVersion() const {
+    return connectivityVersion_;
+}
+
+/**
+ * Gives the machine a new connectivity stamp.
+ *
+ * Called by the components of the machine when the interconnection changes.
+ * Gives the machine also a new fingerprint.
+ */
+void
+Machine::connectivityChanged() {
+    connectivityVersion_ = ++connectivityVersionCounter;
+    fingerprint_ = connectivityVersion_;
+}
+
+/**
+ * Returns a stamp of the current structure of the machine.
+ *
+ * The stamp changes whenever the connectivity stamp changes, and also
+ * when operations, pipelines, pipeline elements, operand bindings or
+ * ports of the units are added, removed or edited. Like the connectivity
+ * stamps, the fingerprints are unique within the process, so caches of
+ * data derived from the units can be keyed on the unit and the
+ * fingerprint of its machine.
+ *
+ * @return The fingerprint.
+ */
+unsigned long
+Machine::fingerprint() const {
+    return fingerprint_;
+}
+
+/**
+ * Gives the machine a new fingerprint.
+ *
+ * Called by the components of the machine when they are edited.
+ */
+void
+Machine::structureChanged() {
+    fingerprint_ = ++connectivityVersionCounter;
+}
+
 /*
  * Returns true if result value always needs to be written to GPR.
  *
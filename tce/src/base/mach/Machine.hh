@@ -138,6 +138,12 @@ public:
 
     TCEString hash() const;
 
+    unsigned long connectivityVersion() const;
+    void connectivityChanged();
+
+    unsigned long fingerprint() const;
+    void structureChanged();
+
     bool hasOperation(const TCEString& opName) const;
 
     /**
@@ -314,6 +320,10 @@ private:
     bool littleEndian_;
     // True in case the machine is 64-bit. Also has to be little-endian.
     bool bitness64_;
+    /// Stamp of the current interconnection, see connectivityVersion().
+    unsigned long connectivityVersion_;
+    /// Stamp of the current structure, see fingerprint().
+    unsigned long fingerprint_;
 };
 }
 
@@ -106,6 +106,7 @@ PipelineElement::setName(const std::string& name) {
     }
 
     name_ = name;
+    parentUnit()->structureChanged();
 }
 
 bool PipelineElement::Comparator::operator()(
@@ -34,6 +34,7 @@
 #include "Port.hh"
 #include "Unit.hh"
 #include "Socket.hh"
+#include "Machine.hh"
 #include "ImmediateUnit.hh"
 #include "ControlUnit.hh"
 #include "MachineTester.hh"
@@ -215,6 +216,7 @@ Port::attachSocket(Socket& socket) {
     // bookeeping of Socket internal state - private Socket operation
     // reserved solely to Port class!
     socket.attachPort(*this);
+    parentUnit()->machine()->connectivityChanged();
 
     // sanity check
     if (socket2_ != NULL) {
@@ -247,6 +249,14 @@ Port::detachSocket(Socket& socket) {
     // bookeeping of Socket internal state - private Socket operation
     // reserved solely to Port class!
     socket.detachPort(*this);
+
+    Machine* mach = socket.machine();
+    if (mach == NULL && parentUnit() != NULL) {
+        mach = parentUnit()->machine();
+    }
+    if (mach != NULL) {
+        mach->connectivityChanged();
+    }
 }
 
 /**
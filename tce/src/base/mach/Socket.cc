@@ -140,7 +140,10 @@ Socket::setDirection(Direction direction) {
 
     MachineTester& tester = machine()->machineTester();
     if (tester.canSetDirection(*this, direction)) {
-        direction_ = direction;
+        if (direction_ != direction) {
+            direction_ = direction;
+            machine()->connectivityChanged();
+        }
     } else {
         string errorMsg = MachineTestReporter::socketDirectionSettingError(
             *this, direction, tester);
@@ -178,6 +181,7 @@ Socket::attachBus(Segment& bus) {
         const Connection* conn = new Connection(*this, bus);
         busses_.push_back(conn);
         bus.attachSocket(*this);
+        machine()->connectivityChanged();
     } else {
         assert(false);
     }
@@ -228,6 +232,10 @@ Socket::detachBus(Segment& bus) {
     if (segmentCount() == 0) {
         direction_ = UNKNOWN;
     }
+
+    if (machine() != NULL) {
+        machine()->connectivityChanged();
+    }
 }
 
 /**
@@ -0,0 +1,581 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file FlatMemory.cc
+ *
+ * Definition of FlatMemory class.
+ *
+ * @note rating: red
+ */
+
+#include <sys/mman.h>
+#include <cstring>
+#include <string>
+
+#include <boost/format.hpp>
+
+#include "FlatMemory.hh"
+#include "Exception.hh"
+
+/**
+ * Constructor. Create a model for a given memory.
+ *
+ * The storage for the whole address space is reserved, but the host
+ * allocates the pages only when they are accessed.
+ *
+ * @param start First address of the memory.
+ * @param end Last address of the memory.
+ * @param MAUSize Bit width of the minimum addressable unit of the memory.
+ * @param littleEndian True if the memory is accessed in little endian.
+ * @exception OutOfRange If the MAU width is not supported or the address
+ *                       range cannot be stored.
+ */
+FlatMemory::FlatMemory(
+    ULongWord start, ULongWord end, Word MAUSize, bool littleEndian) :
+    Memory(start, end, MAUSize, littleEndian), start_(start),
+    size_(addressSpaceSize(start, end)), data_(NULL) {
+
+    if (!isSupported(MAUSize)) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "FlatMemory supports only 8 bit MAUs.");
+    }
+    mapStorage();
+}
+
+/**
+ * Destructor.
+ *
+ * Releases the storage of the memory contents.
+ */
+FlatMemory::~FlatMemory() {
+    unmapStorage();
+}
+
+/**
+ * Returns true in case the memory model can be used for the given MAU width.
+ *
+ * @param MAUSize Bit width of the minimum addressable unit.
+ * @return True if the MAU width is supported.
+ */
+bool
+FlatMemory::isSupported(Word MAUSize) {
+    return MAUSize == BYTE_BITWIDTH;
+}
+
+/**
+ * Returns the number of MAUs in an address range.
+ *
+ * @param start First address of the range.
+ * @param end Last address of the range.
+ * @return The number of MAUs.
+ * @exception OutOfRange If the range is empty or its size does not fit
+ *                       in ULongWord.
+ */
+ULongWord
+FlatMemory::addressSpaceSize(ULongWord start, ULongWord end) {
+    if (end < start || end - start == ~static_cast<ULongWord>(0)) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Address range %d-%d is too large for the memory model.")
+             % start % end).str());
+    }
+    return end - start + 1;
+}
+
+/**
+ * Reserves the zero initialized storage for the address space.
+ *
+ * @exception OutOfRange If the host cannot reserve the address range.
+ */
+void
+FlatMemory::mapStorage() {
+    void* storage = mmap(
+        NULL, size_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (storage == MAP_FAILED) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Could not reserve %d bytes for the memory model.")
+             % size_).str());
+    }
+    data_ = static_cast<Byte*>(storage);
+}
+
+/**
+ * Releases the storage of the address space.
+ */
+void
+FlatMemory::unmapStorage() {
+    if (data_ != NULL) {
+        munmap(data_, size_);
+        data_ = NULL;
+    }
+}
+
+/**
+ * Checks the legality of an access and returns its offset in the storage.
+ *
+ * @param address The first address of the access.
+ * @param size Number of MAUs accessed.
+ * @return The offset of the first MAU in the storage.
+ * @exception OutOfRange in case the range is illegal.
+ */
+ULongWord
+FlatMemory::checkedOffset(ULongWord address, int size) const {
+
+    const ULongWord offset = address - start_;
+    if (address < start_ || size < 0 ||
+        static_cast<ULongWord>(size) > size_ ||
+        offset > size_ - size) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Memory access at %d of size %d is out of the address space.")
+             % address % size).str());
+    }
+    return offset;
+}
+
+/**
+ * Writes a single memory location.
+ *
+ * No range checking.
+ *
+ * @param address The target address.
+ * @param data The data to write.
+ */
+void
+FlatMemory::write(ULongWord address, MAU data) {
+    data_[address - start_] = static_cast<Byte>(data);
+}
+
+/**
+ * Reads a single memory location.
+ *
+ * No range checking.
+ *
+ * @param address The address to read.
+ * @return The data read.
+ */
+Memory::MAU
+FlatMemory::read(ULongWord address) {
+    return data_[address - start_];
+}
+
+/**
+ * Reads up to 8 MAUs from the given storage offset.
+ *
+ * @param offset The offset of the first MAU, assumed to be in range.
+ * @param size Number of MAUs to read, at most 8.
+ * @param bigEndian True if the MAUs are in big endian order.
+ * @param data The read value.
+ */
+void
+FlatMemory::load(
+    ULongWord offset, int size, bool bigEndian, ULongWord& data) const {
+
+    const Byte* source = data_ + offset;
+    // Byte order must be reversed if it differs from the host one.
+    const bool swap = bigEndian != (WORDS_BIGENDIAN == 1);
+
+    switch (size) {
+    case 1:
+        data = *source;
+        return;
+    case 2: {
+        uint16_t value;
+        std::memcpy(&value, source, sizeof(value));
+        data = swap ? __builtin_bswap16(value) : value;
+        return;
+    }
+    case 4: {
+        uint32_t value;
+        std::memcpy(&value, source, sizeof(value));
+        data = swap ? __builtin_bswap32(value) : value;
+        return;
+    }
+    case 8: {
+        uint64_t value;
+        std::memcpy(&value, source, sizeof(value));
+        data = swap ? __builtin_bswap64(value) : value;
+        return;
+    }
+    default:
+        break;
+    }
+
+    data = 0;
+    for (int i = 0; i < size; ++i) {
+        const int shift = bigEndian ? (size - 1 - i) * 8 : i * 8;
+        data |= static_cast<ULongWord>(source[i]) << shift;
+    }
+}
+
+/**
+ * Lays out up to 8 MAUs of the given value in the memory byte order.
+ *
+ * @param size Number of MAUs to produce, at most 8.
+ * @param data The value to encode.
+ * @param bigEndian True if the MAUs should be in big endian order.
+ * @param target The buffer to write the MAUs to.
+ */
+void
+FlatMemory::encode(int size, ULongWord data, bool bigEndian, Byte* target) {
+
+    const bool swap = bigEndian != (WORDS_BIGENDIAN == 1);
+
+    switch (size) {
+    case 1:
+        *target = static_cast<Byte>(data);
+        return;
+    case 2: {
+        uint16_t value = static_cast<uint16_t>(data);
+        value = swap ? __builtin_bswap16(value) : value;
+        std::memcpy(target, &value, sizeof(value));
+        return;
+    }
+    case 4: {
+        uint32_t value = static_cast<uint32_t>(data);
+        value = swap ? __builtin_bswap32(value) : value;
+        std::memcpy(target, &value, sizeof(value));
+        return;
+    }
+    case 8: {
+        uint64_t value = data;
+        value = swap ? __builtin_bswap64(value) : value;
+        std::memcpy(target, &value, sizeof(value));
+        return;
+    }
+    default:
+        break;
+    }
+
+    for (int i = 0; i < size; ++i) {
+        const int shift = bigEndian ? (size - 1 - i) * 8 : i * 8;
+        target[i] = static_cast<Byte>(data >> shift);
+    }
+}
+
+/**
+ * Buffers a write to be committed at the next advanceClock().
+ *
+ * Writes of all widths go to the same queue, so they are committed in
+ * the order they were issued. Values written to more than 8 MAUs are
+ * zero extended.
+ *
+ * @param address The address to write.
+ * @param size Number of MAUs to write.
+ * @param data The data to write.
+ * @param bigEndian True if the MAUs should be written in big endian order.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::queueWrite(
+    ULongWord address, int size, ULongWord data, bool bigEndian) {
+
+    PendingWrite request;
+    request.offset = checkedOffset(address, size);
+    request.size = size;
+    request.bigEndian = bigEndian;
+    if (size > static_cast<int>(sizeof(ULongWord))) {
+        request.wideData = data;
+    } else {
+        encode(size, data, bigEndian, request.data);
+    }
+    pendingWrites_.push_back(request);
+}
+
+/**
+ * Writes units of data to the memory in big endian at the next clock advance.
+ *
+ * @param address The address to write.
+ * @param size Number of MAUs to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeBE(ULongWord address, int size, ULongWord data) {
+    queueWrite(address, size, data, true);
+}
+
+/**
+ * Writes units of data to the memory in little endian at the next clock
+ * advance.
+ *
+ * @param address The address to write.
+ * @param size Number of MAUs to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeLE(ULongWord address, int size, ULongWord data) {
+    queueWrite(address, size, data, false);
+}
+
+/**
+ * Writes units of data to the memory in big endian immediately.
+ *
+ * @param address The address to write.
+ * @param size Number of MAUs to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeDirectlyBE(ULongWord address, int size, ULongWord data) {
+    if (size > static_cast<int>(sizeof(ULongWord))) {
+        Memory::writeDirectlyBE(address, size, data);
+        return;
+    }
+    encode(size, data, true, data_ + checkedOffset(address, size));
+}
+
+/**
+ * Writes units of data to the memory in little endian immediately.
+ *
+ * @param address The address to write.
+ * @param size Number of MAUs to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeDirectlyLE(ULongWord address, int size, ULongWord data) {
+    if (size > static_cast<int>(sizeof(ULongWord))) {
+        Memory::writeDirectlyLE(address, size, data);
+        return;
+    }
+    encode(size, data, false, data_ + checkedOffset(address, size));
+}
+
+/**
+ * Reads units of data from the memory in big endian.
+ *
+ * @param address The address to read.
+ * @param size Number of MAUs to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::readBE(ULongWord address, int size, ULongWord& data) {
+    if (size > static_cast<int>(sizeof(ULongWord))) {
+        Memory::readBE(address, size, data);
+        return;
+    }
+    load(checkedOffset(address, size), size, true, data);
+}
+
+/**
+ * Reads units of data from the memory in little endian.
+ *
+ * @param address The address to read.
+ * @param size Number of MAUs to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::readLE(ULongWord address, int size, ULongWord& data) {
+    if (size > static_cast<int>(sizeof(ULongWord))) {
+        Memory::readLE(address, size, data);
+        return;
+    }
+    load(checkedOffset(address, size), size, false, data);
+}
+
+/**
+ * Writes a FloatWord to the memory in big endian.
+ *
+ * @param address The address to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeBE(ULongWord address, FloatWord data) {
+    uint32_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, sizeof(bits), bits, true);
+}
+
+/**
+ * Writes a DoubleWord to the memory in big endian.
+ *
+ * @param address The address to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeBE(ULongWord address, DoubleWord data) {
+    uint64_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, sizeof(bits), bits, true);
+}
+
+/**
+ * Writes a FloatWord to the memory in little endian.
+ *
+ * @param address The address to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeLE(ULongWord address, FloatWord data) {
+    uint32_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, sizeof(bits), bits, false);
+}
+
+/**
+ * Writes a DoubleWord to the memory in little endian.
+ *
+ * @param address The address to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::writeLE(ULongWord address, DoubleWord data) {
+    uint64_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, sizeof(bits), bits, false);
+}
+
+/**
+ * Reads a FloatWord from the memory in big endian.
+ *
+ * @param address The address to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::readBE(ULongWord address, FloatWord& data) {
+    ULongWord bits;
+    load(checkedOffset(address, sizeof(data)), sizeof(data), true, bits);
+    const uint32_t bits32 = static_cast<uint32_t>(bits);
+    std::memcpy(&data, &bits32, sizeof(data));
+}
+
+/**
+ * Reads a DoubleWord from the memory in big endian.
+ *
+ * @param address The address to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::readBE(ULongWord address, DoubleWord& data) {
+    ULongWord bits;
+    load(checkedOffset(address, sizeof(data)), sizeof(data), true, bits);
+    const uint64_t bits64 = bits;
+    std::memcpy(&data, &bits64, sizeof(data));
+}
+
+/**
+ * Reads a FloatWord from the memory in little endian.
+ *
+ * @param address The address to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::readLE(ULongWord address, FloatWord& data) {
+    ULongWord bits;
+    load(checkedOffset(address, sizeof(data)), sizeof(data), false, bits);
+    const uint32_t bits32 = static_cast<uint32_t>(bits);
+    std::memcpy(&data, &bits32, sizeof(data));
+}
+
+/**
+ * Reads a DoubleWord from the memory in little endian.
+ *
+ * @param address The address to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+FlatMemory::readLE(ULongWord address, DoubleWord& data) {
+    ULongWord bits;
+    load(checkedOffset(address, sizeof(data)), sizeof(data), false, bits);
+    const uint64_t bits64 = bits;
+    std::memcpy(&data, &bits64, sizeof(data));
+}
+
+/**
+ * Advances clock for one cycle.
+ *
+ * Commits all pending write requests to the memory in the order they
+ * were initiated.
+ */
+void
+FlatMemory::advanceClock() {
+    const int valueSize = static_cast<int>(sizeof(ULongWord));
+    for (std::size_t i = 0; i < pendingWrites_.size(); ++i) {
+        const PendingWrite& request = pendingWrites_[i];
+        Byte* target = data_ + request.offset;
+        if (request.size <= valueSize) {
+            std::memcpy(target, request.data, request.size);
+            continue;
+        }
+        // the value is zero extended to the width of the write
+        std::memset(target, 0, request.size);
+        if (request.bigEndian) {
+            target += request.size - valueSize;
+        }
+        encode(valueSize, request.wideData, request.bigEndian, target);
+    }
+    pendingWrites_.clear();
+}
+
+/**
+ * Resets the memory.
+ *
+ * Clears any pending write requests.
+ */
+void
+FlatMemory::reset() {
+    pendingWrites_.clear();
+    Memory::reset();
+}
+
+/**
+ * Sets the number of write requests that can be pending without
+ * reallocating the request buffer.
+ *
+ * @param requests The number of requests.
+ */
+void
+FlatMemory::setWriteRequestCapacity(std::size_t requests) {
+    pendingWrites_.reserve(requests);
+}
+
+/**
+ * Fills the whole memory with zeros.
+ *
+ * The storage is remapped which returns the touched pages to the host
+ * instead of writing over the whole address space.
+ */
+void
+FlatMemory::fillWithZeros() {
+    unmapStorage();
+    mapStorage();
+}
@@ -0,0 +1,142 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file FlatMemory.hh
+ *
+ * Declaration of FlatMemory class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_FLAT_MEMORY_HH
+#define TTA_FLAT_MEMORY_HH
+
+#include <vector>
+
+#include "Memory.hh"
+
+/**
+ * Memory model that stores the whole address space in a single contiguous
+ * host memory region.
+ *
+ * The region is reserved with an anonymous mmap() so the host OS allocates
+ * (and zero fills) the pages lazily at their first access. Thus, like with
+ * the PagedArray based models, large but sparsely used address spaces do
+ * not consume host memory, while the storage can be indexed directly
+ * with (address - start) without page table lookups.
+ *
+ * The multi-MAU accesses of 1, 2, 4 and 8 MAUs are implemented with
+ * a single range check followed by a word-sized copy and a possible
+ * byte swap instead of the MAU-at-a-time loops of the base class.
+ * Writes of all widths are buffered in a single queue until advanceClock()
+ * like in IdealSRAM so loads in the same cycle do not see them, and they
+ * are committed in the order they were issued.
+ *
+ * Only address spaces with 8-bit MAUs are supported.
+ */
+class FlatMemory : public Memory {
+public:
+    FlatMemory(
+        ULongWord start, ULongWord end, Word MAUSize, bool littleEndian);
+    virtual ~FlatMemory();
+
+    virtual void write(ULongWord address, MAU data) override;
+    virtual Memory::MAU read(ULongWord address) override;
+
+    virtual void writeBE(ULongWord address, int size, ULongWord data)
+        override;
+    virtual void writeLE(ULongWord address, int size, ULongWord data)
+        override;
+    virtual void writeDirectlyBE(ULongWord address, int size, ULongWord data)
+        override;
+    virtual void writeDirectlyLE(ULongWord address, int size, ULongWord data)
+        override;
+    virtual void readBE(ULongWord address, int size, ULongWord& data)
+        override;
+    virtual void readLE(ULongWord address, int size, ULongWord& data)
+        override;
+
+    virtual void writeBE(ULongWord address, FloatWord data) override;
+    virtual void writeBE(ULongWord address, DoubleWord data) override;
+    virtual void writeLE(ULongWord address, FloatWord data) override;
+    virtual void writeLE(ULongWord address, DoubleWord data) override;
+    virtual void readBE(ULongWord address, FloatWord& data) override;
+    virtual void readBE(ULongWord address, DoubleWord& data) override;
+    virtual void readLE(ULongWord address, FloatWord& data) override;
+    virtual void readLE(ULongWord address, DoubleWord& data) override;
+
+    using Memory::write;
+    using Memory::read;
+
+    virtual void advanceClock() override;
+    virtual void reset() override;
+    virtual void fillWithZeros() override;
+    virtual void setWriteRequestCapacity(std::size_t requests) override;
+
+    static bool isSupported(Word MAUSize);
+
+private:
+    /// A buffered write. Writes of at most 8 MAUs are stored already in
+    /// memory byte order, the wider ones are unpacked at commit.
+    struct PendingWrite {
+        /// Offset of the first MAU from the start of the address space.
+        ULongWord offset;
+        /// The MAUs to write, if at most 8.
+        Byte data[8];
+        /// The value to write, if wider than 8 MAUs.
+        ULongWord wideData;
+        /// Number of MAUs to write.
+        int size;
+        /// True if a wide value is written in big endian order.
+        bool bigEndian;
+    };
+
+    /// Copying not allowed.
+    FlatMemory(const FlatMemory&);
+    /// Assignment not allowed.
+    FlatMemory& operator=(const FlatMemory&);
+
+    static ULongWord addressSpaceSize(ULongWord start, ULongWord end);
+    void mapStorage();
+    void unmapStorage();
+    ULongWord checkedOffset(ULongWord address, int size) const;
+    void load(
+        ULongWord offset, int size, bool bigEndian, ULongWord& data) const;
+    static void encode(
+        int size, ULongWord data, bool bigEndian, Byte* target);
+    void queueWrite(
+        ULongWord address, int size, ULongWord data, bool bigEndian);
+
+    /// Starting point of the address space.
+    ULongWord start_;
+    /// Number of MAUs in the address space.
+    ULongWord size_;
+    /// The contiguous storage of the address space contents.
+    Byte* data_;
+    /// Writes waiting for the next advanceClock(). The vector is cleared
+    /// but not deallocated at commit so its storage is reused.
+    std::vector<PendingWrite> pendingWrites_;
+};
+
+#endif
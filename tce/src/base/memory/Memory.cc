@@ -31,6 +31,7 @@
  */
 
 #include <cstddef>
+#include <cstring>
 #include <ios>
 
 #include <boost/format.hpp>
@@ -194,16 +195,7 @@ void
 Memory::writeBE(ULongWord address, int count, ULongWord data) {
 
     checkRange(address, count);
-
-    Memory::MAU MAUData[MAX_ACCESS_SIZE];
-    unpackBE(data, count, MAUData);
-
-    WriteRequest* request = new WriteRequest();
-    request->data_ = new MAU[count];
-    std::memcpy(request->data_, MAUData, count*sizeof(MAU));
-    request->size_ = count;
-    request->address_ = address;
-    writeRequests_->push_back(request);
+    queueWrite(address, count, data, true);
 }
 
 
@@ -221,16 +213,7 @@ void
 Memory::writeLE(ULongWord address, int count, ULongWord data) {
 
     checkRange(address, count);
-
-    Memory::MAU MAUData[MAX_ACCESS_SIZE];
-    unpackLE(data, count, MAUData);
-
-    WriteRequest* request = new WriteRequest();
-    request->data_ = new MAU[count];
-    std::memcpy(request->data_, MAUData, count*sizeof(MAU));
-    request->size_ = count;
-    request->address_ = address;
-    writeRequests_->push_back(request);
+    queueWrite(address, count, data, false);
 }
 
 /**
@@ -353,30 +336,9 @@ Memory::writeBE(ULongWord address, FloatWord data) {
 
     checkRange(address, MAUS);
 
-    union castUnion {
-        FloatWord d;
-        Byte maus[MAUS];
-    };
-
-    castUnion cast;
-    cast.d = data;
-
-    WriteRequest* request = new WriteRequest();
-    request->data_ = new MAU[MAUS];
-    request->size_ = MAUS;
-    request->address_ = address;
-
-    for (std::size_t i = 0; i < MAUS; ++i) {
-        UIntWord data;
-        // Byte order must be reversed if host is not bigendian.
-        #if WORDS_BIGENDIAN == 1
-        data = cast.maus[i];
-        #else
-        data = cast.maus[MAUS - 1 - i];
-        #endif
-        request->data_[i] = data;
-    }
-    writeRequests_->push_back(request);
+    uint32_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, MAUS, bits, true);
 }
 
 /**
@@ -398,30 +360,9 @@ Memory::writeLE(ULongWord address, FloatWord data) {
 
     checkRange(address, MAUS);
 
-    union castUnion {
-        FloatWord d;
-        Byte maus[MAUS];
-    };
-
-    castUnion cast;
-    cast.d = data;
-
-    WriteRequest* request = new WriteRequest();
-    request->data_ = new MAU[MAUS];
-    request->size_ = MAUS;
-    request->address_ = address;
-
-    for (std::size_t i = 0; i < MAUS; ++i) {
-        UIntWord data;
-        // Byte order must be reversed if host is not bigendian.
-        #if WORDS_BIGENDIAN == 0
-        data = cast.maus[i];
-        #else
-        data = cast.maus[MAUS - 1 - i];
-        #endif
-        request->data_[i] = data;
-    }
-    writeRequests_->push_back(request);
+    uint32_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, MAUS, bits, false);
 }
 
 
@@ -555,30 +496,9 @@ Memory::writeBE(ULongWord address, DoubleWord data) {
 
     checkRange(address, MAUS);
 
-    union castUnion {
-        DoubleWord d;
-        Byte maus[MAUS];
-    };
-
-    castUnion cast;
-    cast.d = data;
-
-    WriteRequest* request = new WriteRequest();
-    request->data_ = new MAU[MAUS];
-    request->size_ = MAUS;
-    request->address_ = address;
-
-    for (std::size_t i = 0; i < MAUS; ++i) {
-        UIntWord data;
-        // Byte order must be reversed if host is not bigendian.
-        #if WORDS_BIGENDIAN == 1
-        data = cast.maus[i];
-        #else
-        data = cast.maus[MAUS - 1 - i];
-        #endif
-        request->data_[i] = data;
-    }
-    writeRequests_->push_back(request);
+    uint64_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, MAUS, bits, true);
 }
 
 /**
@@ -600,30 +520,9 @@ Memory::writeLE(ULongWord address, DoubleWord data) {
 
     checkRange(address, MAUS);
 
-    union castUnion {
-        DoubleWord d;
-        Byte maus[MAUS];
-    };
-
-    castUnion cast;
-    cast.d = data;
-
-    WriteRequest* request = new WriteRequest();
-    request->data_ = new MAU[MAUS];
-    request->size_ = MAUS;
-    request->address_ = address;
-
-    for (std::size_t i = 0; i < MAUS; ++i) {
-        UIntWord data;
-        // Byte order must be reversed if host is not bigendian.
-        #if WORDS_BIGENDIAN == 0
-        data = cast.maus[i];
-        #else
-        data = cast.maus[MAUS - 1 - i];
-        #endif
-        request->data_[i] = data;
-    }
-    writeRequests_->push_back(request);
+    uint64_t bits;
+    std::memcpy(&bits, &data, sizeof(bits));
+    queueWrite(address, MAUS, bits, false);
 }
 
 /**
@@ -714,16 +613,45 @@ Memory::fillWithZeros() {
  */
 void
 Memory::reset() {
-    RequestQueue::iterator iter = writeRequests_->begin();
-    while (iter != writeRequests_->end()) {
-        delete[] (*iter)->data_;
-        (*iter)->data_ = NULL;
-        delete (*iter);
-        ++iter;
-    }
     writeRequests_->clear();
 }
 
+/**
+ * Sets the number of write requests that can be pending without growing
+ * the request queue.
+ *
+ * The queue grows on demand in case more writes are initiated in a cycle,
+ * setting the capacity beforehand just avoids reallocation during
+ * simulation.
+ *
+ * @param requests The number of requests.
+ */
+void
+Memory::setWriteRequestCapacity(std::size_t requests) {
+    writeRequests_->reserve(requests);
+}
+
+/**
+ * Queues a write request to be committed at the next clock advance.
+ *
+ * The range of the access must be checked by the caller.
+ *
+ * @param address The address to write.
+ * @param count Number of MAUs to write.
+ * @param data The data to write.
+ * @param bigEndian True if the data is unpacked in big endian order.
+ */
+void
+Memory::queueWrite(
+    ULongWord address, int count, ULongWord data, bool bigEndian) {
+
+    WriteRequest& request = writeRequests_->push();
+    request.data_ = data;
+    request.address_ = address;
+    request.size_ = count;
+    request.bigEndian_ = bigEndian;
+}
+
 /**
  * Packs MAUs to UIntWord.
  *
@@ -818,19 +746,19 @@ Memory::unpackLE(
 void
 Memory::advanceClock() {
 
-    RequestQueue::iterator iter = writeRequests_->begin();
-    while (iter != writeRequests_->end()) {
-        WriteRequest* req = (*iter);
-        for (int i = 0; i < req->size_; ++i) {
-            write(req->address_ + i, req->data_[i]);
+    Memory::MAU MAUData[MAX_ACCESS_SIZE];
+    while (!writeRequests_->empty()) {
+        const WriteRequest& req = writeRequests_->front();
+        if (req.bigEndian_) {
+            unpackBE(req.data_, req.size_, MAUData);
+        } else {
+            unpackLE(req.data_, req.size_, MAUData);
+        }
+        for (int i = 0; i < req.size_; ++i) {
+            write(req.address_ + i, MAUData[i]);
         }
-        delete[] (*iter)->data_;
-        (*iter)->data_ = NULL;
-        delete (*iter);
-        ++iter;
+        writeRequests_->pop();
     }
-
-    writeRequests_->clear();
 }
 
 /**
@@ -35,10 +35,12 @@
 #ifndef TTA_MEMORY_MODEL_HH
 #define TTA_MEMORY_MODEL_HH
 
+#include <cstddef>
+
 #include "BaseType.hh"
 
 struct WriteRequest;
-struct RequestQueue;
+class RequestQueue;
 
 //////////////////////////////////////////////////////////////////////////////
 // Memory
@@ -113,6 +115,8 @@ public:
     virtual void reset();
     virtual void fillWithZeros();
 
+    virtual void setWriteRequestCapacity(std::size_t requests);
+
     virtual ULongWord start() { return start_; }
     virtual ULongWord end() { return end_; }
     virtual ULongWord MAUSize() { return MAUSize_; }
@@ -125,6 +129,9 @@ protected:
     void packLE(const Memory::MAUTable data, int size, ULongWord& value);
     void unpackLE(const ULongWord& value, int size, Memory::MAUTable data);
     
+    void queueWrite(
+        ULongWord address, int count, ULongWord data, bool bigEndian);
+
     bool littleEndian_;
 private:
     /// Copying not allowed.
@@ -30,12 +30,116 @@
  * @note rating: red
  */
 
-#include "Memory.hh"
+#include <cassert>
+
 #include "WriteRequest.hh"
 
 WriteRequest::WriteRequest() :
-    data_(NULL),
-    dataSize_(0),
+    data_(0),
     address_(0),
-    size_(0) {
+    size_(0),
+    bigEndian_(false) {
+}
+
+/**
+ * Constructor.
+ *
+ * @param capacity The number of requests the queue holds without growing.
+ */
+RequestQueue::RequestQueue(std::size_t capacity) :
+    requests_(NULL), capacity_(0), head_(0), count_(0) {
+    resize(capacity);
+}
+
+/**
+ * Destructor.
+ */
+RequestQueue::~RequestQueue() {
+    delete[] requests_;
+    requests_ = NULL;
+}
+
+/**
+ * Appends a new request to the end of the queue.
+ *
+ * Grows the request table in case it is full.
+ *
+ * @return The request slot to fill in.
+ */
+WriteRequest&
+RequestQueue::push() {
+    if (count_ == capacity_) {
+        resize(capacity_ * 2);
+    }
+    WriteRequest& request = requests_[(head_ + count_) & (capacity_ - 1)];
+    ++count_;
+    return request;
+}
+
+/**
+ * Returns the oldest request in the queue.
+ *
+ * The queue must not be empty.
+ *
+ * @return The oldest request.
+ */
+const WriteRequest&
+RequestQueue::front() const {
+    assert(count_ > 0);
+    return requests_[head_];
+}
+
+/**
+ * Removes the oldest request from the queue.
+ *
+ * The queue must not be empty.
+ */
+void
+RequestQueue::pop() {
+    assert(count_ > 0);
+    head_ = (head_ + 1) & (capacity_ - 1);
+    --count_;
+}
+
+/**
+ * Removes all requests from the queue.
+ */
+void
+RequestQueue::clear() {
+    head_ = 0;
+    count_ = 0;
+}
+
+/**
+ * Makes sure the queue can hold at least the given number of requests
+ * without growing.
+ *
+ * @param capacity The number of requests.
+ */
+void
+RequestQueue::reserve(std::size_t capacity) {
+    if (capacity > capacity_) {
+        resize(capacity);
+    }
+}
+
+/**
+ * Reallocates the request table keeping the queued requests in order.
+ *
+ * @param capacity The minimum new capacity, rounded up to a power of two.
+ */
+void
+RequestQueue::resize(std::size_t capacity) {
+    std::size_t newCapacity = 1;
+    while (newCapacity < capacity || newCapacity < count_) {
+        newCapacity *= 2;
+    }
+    WriteRequest* newRequests = new WriteRequest[newCapacity];
+    for (std::size_t i = 0; i < count_; ++i) {
+        newRequests[i] = requests_[(head_ + i) & (capacity_ - 1)];
+    }
+    delete[] requests_;
+    requests_ = newRequests;
+    capacity_ = newCapacity;
+    head_ = 0;
 }
@@ -33,28 +33,71 @@
 #ifndef WRITE_REQUEST_HH
 #define WRITE_REQUEST_HH
 
-#include <vector>
 #include <cstddef>
 
+#include "BaseType.hh"
+
 /**
 * Models an uncommitted write request.
+*
+* The data is stored packed into a single word and unpacked to MAUs only
+* when the request is committed, so the request needs no separately
+* allocated MAU table.
 */
 struct WriteRequest {
     WriteRequest();
     /// Data to be written.
-    Memory::MAUTable data_;
-    /// Data table size.
-    std::size_t dataSize_;
+    ULongWord data_;
     /// Address to be written to.
-    Word address_;
-    /// Size of the data to be read/written.
+    ULongWord address_;
+    /// Size of the data to be written as MAUs.
     int size_;
+    /// True if the data is to be unpacked in big endian MAU order.
+    bool bigEndian_;
 };
 
 /**
- * A "typedef" for request queue
+ * A FIFO ring buffer of uncommitted write requests.
+ *
+ * The requests are stored by value in a preallocated table so queuing
+ * and committing stores does not allocate memory. In case more requests
+ * are initiated in a cycle than fit the table, the table is grown, after
+ * which the larger capacity is kept.
  */
-struct RequestQueue : public std::vector<WriteRequest*> {
+class RequestQueue {
+public:
+    explicit RequestQueue(std::size_t capacity = DEFAULT_CAPACITY);
+    ~RequestQueue();
+
+    WriteRequest& push();
+    const WriteRequest& front() const;
+    void pop();
+    void clear();
+
+    bool empty() const { return count_ == 0; }
+    std::size_t size() const { return count_; }
+    std::size_t capacity() const { return capacity_; }
+    void reserve(std::size_t capacity);
+
+    /// The default number of requests the queue can hold without growing.
+    static const std::size_t DEFAULT_CAPACITY = 16;
+
+private:
+    /// Copying not allowed.
+    RequestQueue(const RequestQueue&);
+    /// Assignment not allowed.
+    RequestQueue& operator=(const RequestQueue&);
+
+    void resize(std::size_t capacity);
+
+    /// The request table, its size is always a power of two.
+    WriteRequest* requests_;
+    /// Number of request slots in the table.
+    std::size_t capacity_;
+    /// Index of the oldest request.
+    std::size_t head_;
+    /// Number of queued requests.
+    std::size_t count_;
 };
 
 #endif
@@ -42,6 +42,7 @@
 #include "tce_config.h"
 #include "OperationContext.hh"
 #include "SimValue.hh"
+#include "SimValueKernels.hh"
 #include "OperationBehavior.hh"
 #include "Operation.hh"
 #include "Memory.hh"
@@ -68,6 +68,7 @@ using std::string;
 OperationPoolPimpl::OperationTable OperationPoolPimpl::operationCache_;
 OperationIndex* OperationPoolPimpl::index_(NULL);
 const llvm::MCInstrInfo* OperationPoolPimpl::llvmTargetInstrInfo_(NULL);
+std::recursive_mutex OperationPoolPimpl::cacheLock_;
 
 /**
  * The constructor
@@ -75,6 +76,7 @@ const llvm::MCInstrInfo* OperationPoolPimpl::llvmTargetInstrInfo_(NULL);
 OperationPoolPimpl::OperationPoolPimpl() {
     // if this is a first created instance of OperationPool,
     // initialize the OperationIndex instance with the search paths
+    std::lock_guard<std::recursive_mutex> guard(cacheLock_);
     if (index_ == NULL) {
         index_ = new OperationIndex();
         vector<string> paths = Environment::osalPaths();
@@ -98,6 +100,7 @@ OperationPoolPimpl::~OperationPoolPimpl() {
  */
 void 
 OperationPoolPimpl::cleanupCache() {
+    std::lock_guard<std::recursive_mutex> guard(cacheLock_);
     AssocTools::deleteAllValues(operationCache_);
     delete index_;
     index_ = NULL;
@@ -115,6 +118,7 @@ OperationPoolPimpl::cleanupCache() {
 Operation&
 OperationPoolPimpl::operation(const char* name) {
   
+    std::lock_guard<std::recursive_mutex> guard(cacheLock_);
     OperationTable::iterator it = 
         operationCache_.find(StringTools::stringToLower(name));
     if (it != operationCache_.end()) {
@@ -229,6 +233,7 @@ bool
 OperationPoolPimpl::sharesState(const Operation& op) {
     if (op.affectsCount() > 0 || op.affectedByCount() > 0)
         return true;
+    std::lock_guard<std::recursive_mutex> guard(cacheLock_);
     for (const auto& entry : operationCache_) {
         const Operation& other = *entry.second;
         if (other.dependsOn(op))
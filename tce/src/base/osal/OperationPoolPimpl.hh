@@ -35,6 +35,7 @@
 
 #include <string>
 #include <map>
+#include <mutex>
 #include "tce_config.h"
 
 class OperationPool;
@@ -91,6 +92,9 @@ private:
     /// instead of .opp XML files. Used when calling the TCE scheduler from
     /// non-TTA LLVM targets.
     static const llvm::MCInstrInfo* llvmTargetInstrInfo_;
+    /// Guards the static caches; recursive as loading an operation may
+    /// construct further OperationPools.
+    static std::recursive_mutex cacheLock_;
 };
 
 #endif
@@ -35,6 +35,7 @@
  * @note rating: red
  */
 
+#include <mutex>
 #include <set>
 
 #include <iostream>
@@ -79,6 +80,7 @@ InstructionReferenceImpl::~InstructionReferenceImpl() {
  */
 void 
 InstructionReferenceImpl::nullify() {
+    std::lock_guard<std::recursive_mutex> guard(refMan_->lock_);
     // the set is modified inside so cannot iterate normally.
     // get the first as long as there are some.
     while (!refs_.empty()) {
@@ -93,11 +95,16 @@ InstructionReferenceImpl::nullify() {
 /** 
  * A new reference has been created for the instruction handled by
  * this object. Adds it to the list. 
+ *
+ * References to the instructions of a program may be copied and destroyed
+ * by several scheduler threads at once, so the list is guarded by the lock
+ * of the reference manager.
  * 
  * @param InstructionReference new reference.
  */
 void 
 InstructionReferenceImpl::addRef(InstructionReference& ref) {
+    std::lock_guard<std::recursive_mutex> guard(refMan_->lock_);
     refs_.insert(&ref);
 }
 
@@ -112,6 +119,9 @@ InstructionReferenceImpl::addRef(InstructionReference& ref) {
  */
 bool 
 InstructionReferenceImpl::removeRef(InstructionReference& ref) {
+    // the guard refers to the lock of the manager, thus it can be released
+    // after this object has been deleted
+    std::lock_guard<std::recursive_mutex> guard(refMan_->lock_);
     assert(refs_.find(&ref) != refs_.end());
     refs_.erase(&ref);
     if (refs_.empty()) {
@@ -132,6 +142,7 @@ InstructionReferenceImpl::removeRef(InstructionReference& ref) {
  */
 void 
 InstructionReferenceImpl::merge(InstructionReferenceImpl& other) {
+    std::lock_guard<std::recursive_mutex> guard(refMan_->lock_);
     // copy this in order to prevent it being deleted on last iteration
     std::set<InstructionReference*> otherRefs = other.refs_;
     for (std::set<InstructionReference*>::iterator iter = 
@@ -69,6 +69,7 @@ InstructionReferenceManager::~InstructionReferenceManager() {
  */
 InstructionReference
 InstructionReferenceManager::createReference(Instruction& ins) {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     RefMap::const_iterator iter = references_.find(&ins);
     if (iter == references_.end()) {
         InstructionReferenceImpl* newRef = 
@@ -92,6 +93,7 @@ InstructionReferenceManager::createReference(Instruction& ins) {
  */
 void
 InstructionReferenceManager::replace(Instruction& insA, Instruction& insB) {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     RefMap::iterator itera = references_.find(&insA);
     if (itera == references_.end()) {
         throw InstanceNotFound(
@@ -121,6 +123,7 @@ InstructionReferenceManager::replace(Instruction& insA, Instruction& insB) {
  */ 
 void
 InstructionReferenceManager::clearReferences() {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     // nullify modifies so take new iter every round.
     for (RefMap::iterator iter = references_.begin(); 
          iter != references_.end(); iter = references_.begin()) {
@@ -139,6 +142,7 @@ InstructionReferenceManager::clearReferences() {
  */
 bool
 InstructionReferenceManager::hasReference(Instruction& ins) const {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return references_.find(&ins) != references_.end();
 }
 
@@ -147,6 +151,7 @@ InstructionReferenceManager::hasReference(Instruction& ins) const {
  */
 unsigned int
 InstructionReferenceManager::referenceCount(Instruction& ins) const {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     RefMap::const_iterator iter = references_.find(&ins);
     if (iter == references_.end()) {
         return 0;
@@ -161,6 +166,7 @@ InstructionReferenceManager::referenceCount(Instruction& ins) const {
  */
 void 
 InstructionReferenceManager::referenceDied(Instruction* ins) {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     RefMap::iterator iter = references_.find(ins);
     assert (iter != references_.end());
     assert (iter->second->count() == 0);
@@ -63,6 +63,7 @@
 #define TTA_INSTRUCTION_REFERENCE_MANAGER_HH
 
 #include <map>
+#include <mutex>
 #include "Exception.hh"
 #include "InstructionReferenceImpl.hh"
 
@@ -100,6 +101,13 @@ private:
 
     /// Instruction references to maintain.
     RefMap references_;
+    /// Guards references_ when procedures sharing this manager are
+    /// scheduled in parallel. Recursive as merging and nullifying
+    /// references calls back referenceDied().
+    mutable std::recursive_mutex lock_;
+
+    /// The reference bookkeeping of the impls is guarded by lock_ too.
+    friend class InstructionReferenceImpl;
 public:
 
     class Iterator {
@@ -38,6 +38,7 @@
 
 #include <iostream>
 #include <climits>
+#include <algorithm>
 #include <boost/format.hpp>
 
 #include "MoveNode.hh"
@@ -430,8 +431,15 @@ MoveNode::setCycle(const int newcycle) {
         msg += ".";
         throw InvalidData(__FILE__, __LINE__, __func__, msg);
     }
+    bool wasPlaced = placed_;
     cycle_ = newcycle;
     placed_ = true;
+
+    if (!wasPlaced) {
+        for (std::size_t i = 0; i < cycleListeners_.size(); i++) {
+            cycleListeners_[i]->nodePlaced(*this);
+        }
+    }
 }
 
 /**
@@ -444,8 +452,43 @@ MoveNode::unsetCycle() {
         std::string msg = "MoveNode is not placed.";
         throw InvalidData(__FILE__, __LINE__, __func__, msg);
     }
+    int oldCycle = cycle_;
     cycle_ = 0;
     placed_ = false;
+
+    for (std::size_t i = 0; i < cycleListeners_.size(); i++) {
+        cycleListeners_[i]->nodeUnplaced(*this, oldCycle);
+    }
+}
+
+/**
+ * Registers an object to be notified when the node's cycle changes.
+ *
+ * Registering the same listener twice has no effect.
+ *
+ * @param listener The listener to register.
+ */
+void
+MoveNode::addCycleListener(CycleListener& listener) {
+    if (std::find(
+            cycleListeners_.begin(), cycleListeners_.end(), &listener) ==
+        cycleListeners_.end()) {
+        cycleListeners_.push_back(&listener);
+    }
+}
+
+/**
+ * Unregisters a cycle listener of the node.
+ *
+ * @param listener The listener to unregister.
+ */
+void
+MoveNode::removeCycleListener(CycleListener& listener) {
+    std::vector<CycleListener*>::iterator i = std::find(
+        cycleListeners_.begin(), cycleListeners_.end(), &listener);
+    if (i != cycleListeners_.end()) {
+        cycleListeners_.erase(i);
+    }
 }
 
 /**
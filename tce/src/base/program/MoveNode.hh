@@ -64,6 +64,18 @@ namespace TTAProgram{
 class MoveNode : public GraphNode {
 public:
 
+    /**
+     * Interface for bookkeeping which follows the cycles of nodes.
+     *
+     * Notified when a node is placed to a cycle or its cycle is unset.
+     */
+    class CycleListener {
+    public:
+        virtual ~CycleListener() {}
+        virtual void nodePlaced(MoveNode& node) = 0;
+        virtual void nodeUnplaced(MoveNode& node, int oldCycle) = 0;
+    };
+
     explicit MoveNode(std::shared_ptr<TTAProgram::Move> newmove);
     virtual ~MoveNode();
 
@@ -92,6 +104,9 @@ public:
     void unsetCycle();
     int cycle() const;
 
+    void addCycleListener(CycleListener& listener);
+    void removeCycleListener(CycleListener& listener);
+
     int earliestResultReadCycle() const;
     int latestTriggerWriteCycle() const;
     int guardLatency() const;
@@ -158,6 +173,9 @@ private:
 
     /// This is in scheduling frontier(used in Bubblefish scheduler)
     bool isInFrontier_;
+
+    /// Objects notified when the node is placed or unplaced.
+    std::vector<CycleListener*> cycleListeners_;
 };
 
 #include "MoveNode.icc"
@@ -734,7 +734,7 @@ ProgramOperation::hasConstantOperand() const {
     return false;
 }
 
-unsigned int ProgramOperation::idCounter = 0;
+std::atomic<unsigned int> ProgramOperation::idCounter(0);
 
 const TTAMachine::FunctionUnit*
 ProgramOperation::scheduledFU() const {
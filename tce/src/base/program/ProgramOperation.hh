@@ -34,6 +34,7 @@
 #ifndef TCE_PROGRAM_OPERATION_HH
 #define TCE_PROGRAM_OPERATION_HH
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <vector>
@@ -155,7 +156,7 @@ private:
     // all output moves
     MoveVector allOutputMoves_;
     unsigned int poId_;
-    static unsigned int idCounter;
+    static std::atomic<unsigned int> idCounter;
     // Reference to original LLVM MachineInstruction
     const llvm::MachineInstr* mInstr_;
 };
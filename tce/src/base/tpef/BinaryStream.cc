@@ -33,6 +33,12 @@
  * @note rating: yellow
  */
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#include <cstring>
 #include <string>
 #include <fstream>
 #include <cassert>
@@ -48,7 +54,9 @@ using std::ios;
 namespace TPEF {
 
 BinaryStream::BinaryStream(std::ostream& stream, bool littleEndian): 
-    fileName_(""), extOStream_(&stream), littleEndianStorage_(littleEndian) {
+    fileName_(""), extOStream_(&stream), littleEndianStorage_(littleEndian),
+    mappedData_(NULL), mappedSize_(0), mappedPosition_(0),
+    mappedEof_(false) {
 }
 
 /**
@@ -61,7 +69,9 @@ BinaryStream::BinaryStream(std::ostream& stream, bool littleEndian):
  * @note The initial read and write positions of the stream are 0.
  */
 BinaryStream::BinaryStream(std::string name, bool littleEndian): 
-    fileName_(name), extOStream_(NULL), littleEndianStorage_(littleEndian) {
+    fileName_(name), extOStream_(NULL), littleEndianStorage_(littleEndian),
+    mappedData_(NULL), mappedSize_(0), mappedPosition_(0),
+    mappedEof_(false) {
 }
 
 /**
@@ -202,6 +212,15 @@ BinaryStream::readWord() {
 void
 BinaryStream::readByteBlock(Byte* buffer, unsigned int howmany) {
     try {
+        if (mappedData_ == NULL && !iStream_.is_open()) {
+            openInput(fileName_);
+        }
+        if (inputAvailable(howmany, sizeof(Byte))) {
+            std::memcpy(buffer, mappedData_ + mappedPosition_, howmany);
+            mappedPosition_ += howmany;
+            return;
+        }
+
         for (unsigned int i = 0; i < howmany; i++) {
             buffer[i] = getByte();
         }
@@ -231,6 +250,24 @@ BinaryStream::readByteBlock(Byte* buffer, unsigned int howmany) {
 void
 BinaryStream::readHalfWordBlock(HalfWord* buffer, unsigned int howmany) {
     try {
+        if (mappedData_ == NULL && !iStream_.is_open()) {
+            openInput(fileName_);
+        }
+        if (inputAvailable(howmany, sizeof(HalfWord))) {
+            // decode the whole block straight from the mapping
+            const Byte* data = mappedData_ + mappedPosition_;
+            for (unsigned int i = 0; i < howmany; i++) {
+                if (littleEndianStorage_) {
+                    buffer[i] = data[0] | (data[1] << 8);
+                } else {
+                    buffer[i] = (data[0] << 8) | data[1];
+                }
+                data += sizeof(HalfWord);
+            }
+            mappedPosition_ += howmany * sizeof(HalfWord);
+            return;
+        }
+
         for (unsigned int i = 0; i < howmany; i++) {
             buffer[i] = readHalfWord();
         }
@@ -260,6 +297,32 @@ BinaryStream::readHalfWordBlock(HalfWord* buffer, unsigned int howmany) {
 void
 BinaryStream::readWordBlock(Word* buffer, unsigned int howmany) {
     try {
+        if (mappedData_ == NULL && !iStream_.is_open()) {
+            openInput(fileName_);
+        }
+        if (inputAvailable(howmany, sizeof(Word))) {
+            // decode the whole block straight from the mapping
+            const Byte* data = mappedData_ + mappedPosition_;
+            for (unsigned int i = 0; i < howmany; i++) {
+                if (littleEndianStorage_) {
+                    buffer[i] =
+                        static_cast<Word>(data[0]) |
+                        (static_cast<Word>(data[1]) << 8) |
+                        (static_cast<Word>(data[2]) << 16) |
+                        (static_cast<Word>(data[3]) << 24);
+                } else {
+                    buffer[i] =
+                        (static_cast<Word>(data[0]) << 24) |
+                        (static_cast<Word>(data[1]) << 16) |
+                        (static_cast<Word>(data[2]) << 8) |
+                        static_cast<Word>(data[3]);
+                }
+                data += sizeof(Word);
+            }
+            mappedPosition_ += howmany * sizeof(Word);
+            return;
+        }
+
         for (unsigned int i = 0; i < howmany; i++) {
             buffer[i] = readWord();
         }
@@ -454,6 +517,8 @@ BinaryStream::writeWordBlock(Word* words, unsigned int howmany) {
 /**
  * Opens the binary file for input.
  *
+ * The file is memory mapped unless it is already open for writing.
+ *
  * @param name Name of the input file.
  * @exception UnreachableStream If file is not found or is unreadable.
  * @note The initial read position is 0.
@@ -465,6 +530,10 @@ BinaryStream::openInput(std::string name) {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
+    if (!oStream_.is_open() && mapInput(name)) {
+        return;
+    }
+
     iStream_.open(name.c_str());
 
     if (!iStream_.is_open()) {
@@ -479,6 +548,65 @@ BinaryStream::openInput(std::string name) {
     iStream_.tie(&oStream_);
 }
 
+/**
+ * Memory maps the binary file for input.
+ *
+ * Empty files and files that cannot be mapped are left to the file
+ * stream.
+ *
+ * @param name Name of the input file.
+ * @return True if the file was mapped.
+ */
+bool
+BinaryStream::mapInput(std::string name) {
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) ||
+        status.st_size == 0 ||
+        static_cast<unsigned long long>(status.st_size) > UINT_MAX) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    mappedData_ = static_cast<const Byte*>(mapped);
+    mappedSize_ = status.st_size;
+    mappedPosition_ = 0;
+    mappedEof_ = false;
+    return true;
+}
+
+/**
+ * Switches reading of a memory mapped file to the file stream.
+ *
+ * The read position and the eof status are preserved. Done when the file
+ * gets opened for writing, since the mapping does not follow the writes.
+ */
+void
+BinaryStream::unmapInput() {
+    unsigned int position = mappedPosition_;
+    bool eof = mappedEof_;
+
+    munmap(const_cast<Byte*>(mappedData_), mappedSize_);
+    mappedData_ = NULL;
+    mappedSize_ = 0;
+    mappedPosition_ = 0;
+    mappedEof_ = false;
+
+    openInput(fileName_);
+    iStream_.seekg(position);
+    if (eof) {
+        iStream_.setstate(ios::eofbit | ios::failbit);
+    }
+}
+
 /**
  * Opens the binary file for output.
  *
@@ -513,6 +641,10 @@ BinaryStream::openOutput(std::string name) {
         throw UnreachableStream(
             __FILE__, __LINE__, __func__, error);
     }
+
+    if (mappedData_ != NULL) {
+        unmapInput();
+    }
 }
 
 /**
@@ -520,6 +652,10 @@ BinaryStream::openOutput(std::string name) {
  */
 void
 BinaryStream::close() {
+    if (mappedData_ != NULL) {
+        munmap(const_cast<Byte*>(mappedData_), mappedSize_);
+        mappedData_ = NULL;
+    }
     if (iStream_.is_open()) {
         iStream_.close();
     }
@@ -542,7 +678,7 @@ BinaryStream::readPosition() {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    if (!iStream_.is_open()) {
+    if (mappedData_ == NULL && !iStream_.is_open()) {
         try {
             openInput(fileName_);
         } catch (const UnreachableStream& error) {
@@ -553,6 +689,11 @@ BinaryStream::readPosition() {
         }
     }
 
+    if (mappedData_ != NULL) {
+        // the position of a file stream is unknown after reading past eof
+        return mappedEof_ ? UINT_MAX : mappedPosition_;
+    }
+
     if (iStream_.bad()) {
         throw UnreachableStream(__FILE__, __LINE__,
                                 "BinaryStream::readPosition", fileName_);
@@ -610,7 +751,7 @@ BinaryStream::setReadPosition(unsigned int position) {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    if (!iStream_.is_open()) {
+    if (mappedData_ == NULL && !iStream_.is_open()) {
         try {
             openInput(fileName_);
 
@@ -621,6 +762,15 @@ BinaryStream::setReadPosition(unsigned int position) {
             throw newException;
         }
     }
+
+    if (mappedData_ != NULL) {
+        if (position <= mappedSize_) {
+            mappedEof_ = false;
+        }
+        mappedPosition_ = position;
+        return;
+    }
+
     if (iStream_.bad()) {
         throw UnreachableStream(
             __FILE__, __LINE__, __func__, fileName_);
@@ -703,7 +853,7 @@ BinaryStream::endOfFile() {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    if (!iStream_.is_open()) {
+    if (mappedData_ == NULL && !iStream_.is_open()) {
         try {
             openInput(fileName_);
 
@@ -715,6 +865,10 @@ BinaryStream::endOfFile() {
         }
     }
 
+    if (mappedData_ != NULL) {
+        return mappedEof_;
+    }
+
     if (iStream_.bad()) {
         throw UnreachableStream(
             __FILE__, __LINE__, __func__, fileName_);
@@ -755,7 +909,7 @@ BinaryStream::sizeOfFile() {
         setWritePosition(currentPos);
         return fileSize;
 
-    } else if (!iStream_.is_open()) {
+    } else if (mappedData_ == NULL && !iStream_.is_open()) {
         try {
             openInput(fileName_);
 
@@ -767,6 +921,10 @@ BinaryStream::sizeOfFile() {
         }
     }
 
+    if (mappedData_ != NULL) {
+        return mappedSize_;
+    }
+
     if (iStream_.bad()) {
         throw UnreachableStream(
             __FILE__, __LINE__, __func__, fileName_);
@@ -54,6 +54,10 @@ namespace TPEF {
  * be converted to the standard byte order of TTA Program Exchange
  * Format files which adheres to the byte order of the ADF the TPEF
  * is associated with (by default big endian).
+ *
+ * A file that is only read is memory mapped and decoded directly from
+ * the mapping. Once the file is opened for writing, reading continues
+ * through a file stream so that the written data is seen.
  */
 class BinaryStream {
 public:
@@ -99,6 +103,15 @@ private:
     /// big endian otherwise.
     bool littleEndianStorage_;
 
+    /// Contents of the input file if it is memory mapped, NULL otherwise.
+    const Byte* mappedData_;
+    /// Size of the memory mapped input file.
+    unsigned int mappedSize_;
+    /// Read position in the memory mapped input file.
+    unsigned int mappedPosition_;
+    /// True if reading past the end of the memory mapped file was tried.
+    bool mappedEof_;
+
     /// Assignment not allowed.
     BinaryStream& operator=(BinaryStream& old);
     /// Copying not allowed.
@@ -106,7 +119,10 @@ private:
 
     void openInput(std::string name);
     void openOutput(std::string name);
+    bool mapInput(std::string name);
+    void unmapInput();
     void close();
+    bool inputAvailable(unsigned int count, unsigned int size) const;
     Byte getByte();
     void putByte(Byte byte);
 
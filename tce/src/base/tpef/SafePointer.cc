@@ -79,7 +79,7 @@ SafePointerSet* SafePointer::aliveSafePointers_ = new SafePointerSet;
  * Constructor.
  *
  */
-SafePointerList::SafePointerList() : reference_(NULL) {
+SafePointerList::SafePointerList() : reference_(NULL), mapReferences_(0) {
 }
 
 /**
@@ -87,7 +87,7 @@ SafePointerList::SafePointerList() : reference_(NULL) {
  *
  */
 SafePointerList::SafePointerList(SafePointerList &aList) :
-    reference_(aList.reference_) {
+    reference_(aList.reference_), mapReferences_(0) {
 
     for (SafePointerListType::iterator i = aList.list_.begin();
          i != aList.list_.end(); i++) {
@@ -420,28 +420,23 @@ SafePointer::sectionKeyFor(const SafePointable* obj) {
 void
 SafePointer::notifyDeleted(const SafePointable* obj) {
 
-    if (!MapTools::containsKey(*referenceMap_, obj)) {
+    ReferenceMap::iterator entry = referenceMap_->find(obj);
+    if (entry == referenceMap_->end()) {
         return;
     }
 
-    SafePointerList *listOfObj = (*referenceMap_)[obj];
+    SafePointerList *listOfObj = (*entry).second;
 
     assert(listOfObj != NULL);
     listOfObj->cleanup();
 
+    referenceMap_->erase(entry);
+
     // if the safe pointer list we just cleaned up is not referenced in any
-    // map anymore, it can be deleted safely
-
-    // TODO: for hashmap implementation this will take *very* long time
-    //       so fix this before change typedefs in SafePointer.hh
-    if (!MapTools::containsValue(*sectionMap_,       listOfObj) &&
-        !MapTools::containsValue(*sectionIndexMap_,  listOfObj) &&
-        !MapTools::containsValue(*sectionOffsetMap_, listOfObj) &&
-        !MapTools::containsValue(*fileOffsetMap_,    listOfObj)) {
+    // key map either, it can be deleted safely
+    if (listOfObj->removeMapReference() == 0) {
         delete listOfObj;
     }
-
-    referenceMap_->erase(obj);
 }
 
 /**
@@ -38,12 +38,12 @@
 
 #include <cstddef> // NULL
 #include <set>
-#include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <list>
 #include <iterator>
 #include <sstream>
 
-//#include "hash_map.hh"
 #include "Application.hh"
 #include "ReferenceKey.hh"
 #include "Exception.hh" // IllegalParameters, UnresolvedReference
@@ -94,19 +94,22 @@ public:
 
     LengthType length() const;
 
+    void addMapReference();
+    unsigned int removeMapReference();
+
 private:
     /// Object that SafePointers in this list are pointing to.
     SafePointable* reference_;
 
     /// Container for SafePointers.
     SafePointerListType list_;
+
+    /// Number of key and reference map entries that store this list.
+    unsigned int mapReferences_;
 };
 
 /**
- * Class containing all the hash functions if hash_map is
- * used. However the use of hash_map will make program very slow
- * unless MapTools::containsValue() is not optimised for 
- * hash_tables or that function should be circumvented.
+ * Hash functions for the keys of the reference manager maps.
  */
 class HashFunctions {
 public:
@@ -135,40 +138,37 @@ public:
     size_t operator()(const SafePointable* const & key) const {
         return reinterpret_cast<size_t>(key);
     }
-};
 
-// TODO: for hash map implementation check SafePointer.cc line 424 TODO
-//       MapTools::containsValue call takes very long time for hash maps..
+    size_t operator()(
+        const std::pair<const SafePointable*, void*>& key) const {
+        return reinterpret_cast<size_t>(key.first) ^
+            (reinterpret_cast<size_t>(key.second) >> 4);
+    }
+};
 
 /// Unordered set of SafePointers.
-typedef std::set<SafePointer*> SafePointerSet;
+typedef std::unordered_set<SafePointer*> SafePointerSet;
 
 /// Map for SafePointers that are requested using SectionIndexKeys.
-typedef std::map<SectionIndexKey, SafePointerList*> SectionIndexMap;
-//typedef hash_map<SectionIndexKey, SafePointerList*,
-//                 HashFunctions> SectionIndexMap;
+typedef std::unordered_map<SectionIndexKey, SafePointerList*,
+                           HashFunctions> SectionIndexMap;
 
 /// Map for SafePointers that are requested using SectionOffsetKeys.
-typedef std::map<SectionOffsetKey, SafePointerList*> SectionOffsetMap;
-//typedef hash_map<SectionOffsetKey, SafePointerList*,
-//                 HashFunctions> SectionOffsetMap;
+typedef std::unordered_map<SectionOffsetKey, SafePointerList*,
+                           HashFunctions> SectionOffsetMap;
 
 /// Map for SafePointers that are requested using FileOffsetKeys.
-typedef std::map<FileOffsetKey, SafePointerList*> FileOffsetMap;
-//typedef hash_map<FileOffsetKey, SafePointerList*,
-//                 HashFunctions> FileOffsetMap;
+typedef std::unordered_map<FileOffsetKey, SafePointerList*,
+                           HashFunctions> FileOffsetMap;
 
 /// Map for SafePointers that are requested using SectionKeys.
-typedef std::map<SectionKey, SafePointerList*> SectionMap;
-//typedef hash_map<SectionKey, SafePointerList*,
-//                 HashFunctions> SectionMap;
-
+typedef std::unordered_map<SectionKey, SafePointerList*,
+                           HashFunctions> SectionMap;
 
 /// Map for resolved references, that is SafePointers that are pointing to
 /// the created object.
-typedef std::map<const SafePointable*, SafePointerList*> ReferenceMap;
-//typedef hash_map<const SafePointable*, SafePointerList*,
-//                 HashFunctions> ReferenceMap;
+typedef std::unordered_map<const SafePointable*, SafePointerList*,
+                           HashFunctions> ReferenceMap;
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -337,7 +337,8 @@ private:
     /// Key type for cache, void* is pointer to key map
     /// (sectioMap_, sectionOffsetMap, ...)
     typedef std::pair<const SafePointable*, void*> KeyForCacheKey;
-    typedef std::map<KeyForCacheKey,const ReferenceKey*> KeyForCacheMap;
+    typedef std::unordered_map<KeyForCacheKey, const ReferenceKey*,
+                               HashFunctions> KeyForCacheMap;
 
     /// Map for cache.
     static KeyForCacheMap* keyForCache_;
@@ -0,0 +1,71 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CycleBitmap.hh
+ *
+ * Declaration of CycleBitmap class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_CYCLE_BITMAP_HH
+#define TTA_CYCLE_BITMAP_HH
+
+#include "CycleTable.hh"
+
+/**
+ * A dense, growable bit set indexed by instruction cycle.
+ *
+ * Used by the scheduler resource model to record per-cycle occupancy of
+ * resources so that the "is this cycle taken?" question is a word load
+ * and a mask instead of a tree lookup. The bitmap grows on demand when
+ * bits are set; reading beyond the stored range returns false. Only the
+ * words between the smallest and the largest set index are stored, so
+ * the bitmaps of schedules starting at large cycles stay small. Negative
+ * indices are allowed.
+ */
+class CycleBitmap {
+public:
+    CycleBitmap();
+
+    bool bitAt(int index) const;
+    void setBit(int index, bool value);
+    void clear();
+
+private:
+    /// Storage word for the bits.
+    typedef unsigned long Word;
+    /// Number of bits in one storage word.
+    static const unsigned int WORD_BITS = sizeof(Word) * 8;
+
+    static int wordIndex(int index);
+    static Word bitMask(int index);
+
+    /// The storage words indexed by the word index of the bits.
+    CycleTable<Word> words_;
+};
+
+#include "CycleBitmap.icc"
+
+#endif
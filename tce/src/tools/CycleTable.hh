@@ -0,0 +1,70 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CycleTable.hh
+ *
+ * Declaration of CycleTable class template.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_CYCLE_TABLE_HH
+#define TTA_CYCLE_TABLE_HH
+
+#include <vector>
+
+/**
+ * A dense table of items indexed by instruction cycle.
+ *
+ * Only the window between the smallest and the largest index written so
+ * far is stored, and the window starts where the table is first written.
+ * Thus the schedulers which start from a large cycle, such as the
+ * bottom-up ones, do not allocate the cycles below it. Reading outside
+ * of the window returns a default constructed item.
+ */
+template <typename T>
+class CycleTable {
+public:
+    CycleTable();
+
+    const T& operator[](int index) const;
+    T& entry(int index);
+    bool contains(int index) const;
+    int firstIndex() const;
+    int endIndex() const;
+    bool empty() const;
+    void clear();
+
+private:
+    /// The items of the window, the first one is at index first_.
+    std::vector<T> items_;
+    /// Index of the first item of the window.
+    int first_;
+    /// Returned for the indices outside of the window.
+    const T none_;
+};
+
+#include "CycleTable.icc"
+
+#endif
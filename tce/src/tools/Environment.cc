@@ -1108,6 +1108,22 @@ Environment::llvmtceCachePath() {
     return path;
 }
 
+/**
+ * Returns full path to the default compiled simulation object cache
+ * directory.
+ */
+string
+Environment::compiledSimCachePath() {
+
+    std::string path =
+        FileSystem::homeDirectory() +
+        FileSystem::DIRECTORY_SEPARATOR + string(".tce") +
+        FileSystem::DIRECTORY_SEPARATOR + string("ttasim") +
+        FileSystem::DIRECTORY_SEPARATOR + string("cache");
+
+    return path;
+}
+
 /**
  * Returns full paths to implementation tester vhdl testbench template 
  * directory
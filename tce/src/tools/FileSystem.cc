@@ -38,6 +38,7 @@
 #include <glob.h>
 #include <cerrno>
 #include <cstdio>
+#include <cstdlib> // for mkdtemp
 #include <unistd.h> // for truncate
 #include <sys/types.h> // for truncate
 
@@ -55,7 +56,6 @@ IGNORE_CLANG_WARNING("-Wkeyword-macro")
 POP_CLANG_DIAGS
 #include <boost/format.hpp>
 
-#include "MathTools.hh"
 #include "tce_config.h"
 
 using std::string;
@@ -430,27 +430,30 @@ FileSystem::createDirectory(const std::string& path) {
 
 /**
  * Creates a temporary directory to the given path
- * 
+ *
+ * The directory is created atomically with a name unique to the caller, so
+ * concurrent processes (also forked ones sharing the same random number
+ * generator state) never get the same directory. The missing directories
+ * of the given path are created first.
+ *
  * @param path Path to create the temporary directory in
  * @return Full path to the generated temporary directory. Empty string on error
  */
 std::string 
 FileSystem::createTempDirectory(const std::string& path) {
-    const int RANDOM_CHARS = 10;
     const string DS(DIRECTORY_SEPARATOR);
-    string tempDir = path + DS + "tmp_tce_";
-    
-    for (int i = 0; i < RANDOM_CHARS || fileExists(tempDir); ++i) {
-        tempDir += static_cast<char>(MathTools::random('0', '9'));
-        tempDir += static_cast<char>(MathTools::random('a', 'z'));
-        tempDir += static_cast<char>(MathTools::random('A', 'Z'));
+    string tempDir = path + DS + "tmp_tce_XXXXXXXXXX";
+
+    if (!fileExists(path) && !createDirectory(path)) {
+        return "";
     }
-    
-    if (!createDirectory (tempDir)) {
+
+    std::vector<char> buffer(tempDir.begin(), tempDir.end());
+    buffer.push_back('\0');
+    if (mkdtemp(&buffer[0]) == NULL) {
         return "";
-    } else {
-        return tempDir;
     }
+    return string(&buffer[0]);
 }
 
 /**
@@ -86,6 +86,7 @@ Informer::findListenerSlot(int event, Listener* listener) {
 bool
 Informer::registerListener(int event, Listener* listener) {
     findListenerSlot(event, listener);
+    updateListenerCounts();
     return true;
 }
 
@@ -105,5 +106,24 @@ Informer::unregisterListener(int event, Listener* listener) {
     std::size_t index = findListenerSlot(event, listener);
     ListenerList::iterator i = eventListeners_.begin() + index;
     eventListeners_.erase(i);
+    updateListenerCounts();
     return true;
 }
+
+/**
+ * Recomputes the per-event listener counts used by hasListeners().
+ */
+void
+Informer::updateListenerCounts() {
+    listenerCounts_.clear();
+    for (std::size_t i = 0; i < eventListeners_.size(); ++i) {
+        const int event = eventListeners_[i].first;
+        if (event < 0) {
+            continue;
+        }
+        if (static_cast<std::size_t>(event) >= listenerCounts_.size()) {
+            listenerCounts_.resize(event + 1, 0);
+        }
+        ++listenerCounts_[event];
+    }
+}
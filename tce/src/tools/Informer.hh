@@ -56,13 +56,17 @@ public:
     virtual ~Informer();
 
     void handleEvent(int event);
+    bool hasListeners(int event) const;
     virtual bool registerListener(int event, Listener* listener);
     virtual bool unregisterListener(int event, Listener* listener);
 
 private:
     std::size_t findListenerSlot(int event, Listener* listener);
+    void updateListenerCounts();
     typedef std::vector<std::pair<int, Listener*> > ListenerList;
     ListenerList eventListeners_;
+    /// Number of listeners of each non-negative event, indexed by event.
+    std::vector<std::size_t> listenerCounts_;
 
 };
 
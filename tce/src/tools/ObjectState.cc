@@ -32,6 +32,8 @@
  */
 
 
+#include <boost/functional/hash.hpp>
+
 #include "ObjectState.hh"
 #include "Conversion.hh"
 #include "SequenceTools.hh"
@@ -517,6 +519,37 @@ ObjectState::operator!=(const ObjectState& object) {
     return false;
 }
 
+/**
+ * Returns a hash of the whole ObjectState tree.
+ *
+ * Trees which are equal according to operator!= hash to the same value,
+ * so the order of the attributes does not matter while the order of the
+ * children does. Cheaper than serializing the tree for comparison.
+ *
+ * @return The hash value.
+ */
+std::size_t
+ObjectState::hash() const {
+
+    std::size_t seed = 0;
+    boost::hash_combine(seed, name_);
+    boost::hash_combine(seed, value_);
+
+    std::size_t attributes = 0;
+    for (size_t i = 0; i < attributes_.size(); i++) {
+        std::size_t attributeHash = 0;
+        boost::hash_combine(attributeHash, attributes_[i].name);
+        boost::hash_combine(attributeHash, attributes_[i].value);
+        attributes += attributeHash;
+    }
+    boost::hash_combine(seed, attributes);
+
+    for (size_t i = 0; i < children_.size(); i++) {
+        boost::hash_combine(seed, children_[i]->hash());
+    }
+    return seed;
+}
+
 /**
  * Generates a common beginning of error messages.
  *
@@ -34,6 +34,7 @@
 #ifndef TTA_OBJECT_STATE_HH
 #define TTA_OBJECT_STATE_HH
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -114,6 +115,8 @@ public:
 
     bool operator!=(const ObjectState& object);
 
+    std::size_t hash() const;
+
 private:
     /// Table of child ObjectState.
     typedef std::vector<ObjectState*> ChildTable;
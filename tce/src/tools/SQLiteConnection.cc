@@ -291,3 +291,51 @@ SQLiteConnection::finalizeQuery(sqlite3_stmt* statement) {
 
     throwIfSQLiteError(sqlite3_finalize(statement));
 }
+
+/**
+ * Compiles a statement that can be executed multiple times.
+ *
+ * The parameters of the statement are bound with the sqlite3_bind_*()
+ * functions before each executePreparedStatement() call. Avoids parsing
+ * the SQL for each executed row. The statement must be freed with
+ * finalizeQuery() before closing the connection.
+ *
+ * @param queryString The SQL statement with parameter placeholders.
+ * @return The compiled statement.
+ * @exception RelationalDBException In case a database error occured.
+ */
+sqlite3_stmt*
+SQLiteConnection::prepareStatement(const std::string& queryString) {
+    if (connection_ == NULL) {
+        throw RelationalDBException(
+            __FILE__, __LINE__, "SQLiteConnection::prepareStatement()",
+            "Not connected!");
+    }
+
+    sqlite3_stmt* stmt = NULL;
+    const char* dummy = NULL;
+    throwIfSQLiteError(sqlite3_prepare_v2(
+        connection_, queryString.c_str(), queryString.length(),
+        &stmt, &dummy));
+    return stmt;
+}
+
+/**
+ * Executes a prepared statement that changes the database.
+ *
+ * The statement is reset and its parameter bindings are cleared after the
+ * execution so it is ready for binding the next row, also in case the
+ * execution failed.
+ *
+ * @param statement The statement created with prepareStatement().
+ * @exception RelationalDBException In case a database error occured.
+ */
+void
+SQLiteConnection::executePreparedStatement(sqlite3_stmt* statement) {
+    assert(statement != NULL);
+
+    int result = sqlite3_step(statement);
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+    throwIfSQLiteError(result);
+}
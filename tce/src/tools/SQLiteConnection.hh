@@ -68,6 +68,9 @@ public:
 
     void finalizeQuery(sqlite3_stmt* statement);
 
+    sqlite3_stmt* prepareStatement(const std::string& queryString);
+    void executePreparedStatement(sqlite3_stmt* statement);
+
 private:
     sqlite3_stmt* compileQuery(const std::string& queryString);
 
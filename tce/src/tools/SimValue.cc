@@ -32,11 +32,48 @@
  * @note rating: red
  */
 
+#include <algorithm>
+
 #include "SimValue.hh"
 #include "MathTools.hh"
 #include "Conversion.hh"
 #include "TCEString.hh"
 
+namespace {
+
+/// Number of out-of-line storage block sizes, from twice the inline size
+/// up to SIMVALUE_MAX_BYTE_SIZE.
+const int STORAGE_CLASS_COUNT = 5;
+/// Maximum number of free blocks of each size kept for reuse per thread.
+const unsigned MAX_FREE_BLOCKS = 64;
+
+/// A released storage block, linked to the free list of its size class.
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+/// Free lists of released storage blocks, one per size class.
+thread_local FreeBlock* freeBlocks[STORAGE_CLASS_COUNT];
+/// Lengths of the free lists.
+thread_local unsigned freeBlockCounts[STORAGE_CLASS_COUNT];
+
+/**
+ * Returns the size class of an out-of-line block holding the given bytes.
+ */
+inline int
+storageClass(size_t byteCount, size_t& blockSize) {
+    int sizeClass = 0;
+    blockSize = 2 * SIMVALUE_INLINE_BYTE_SIZE;
+    while (blockSize < byteCount) {
+        blockSize *= 2;
+        ++sizeClass;
+    }
+    assert(sizeClass < STORAGE_CLASS_COUNT);
+    return sizeClass;
+}
+
+}
+
 /**
  * Default constructor.
  *
@@ -44,6 +81,7 @@
  * width of SIMULATOR_MAX_INTWORD_BITWIDTH bits.
  */
 SimValue::SimValue() :
+    rawData_(inlineData_), capacity_(SIMVALUE_INLINE_BYTE_SIZE),
     mask_(~ULongWord(0)) {
 
     setBitWidth(SIMULATOR_MAX_LONGWORD_BITWIDTH);
@@ -55,6 +93,7 @@ SimValue::SimValue() :
  * @param width The bit width of the created SimValue.
  */
 SimValue::SimValue(int width) :
+    rawData_(inlineData_), capacity_(SIMVALUE_INLINE_BYTE_SIZE),
     mask_(~ULongWord(0)) {
 
     setBitWidth(width);
@@ -68,6 +107,7 @@ SimValue::SimValue(int width) :
  * @param width The bit width of the created SimValue.
  */
 SimValue::SimValue(SLongWord value, int width) :
+    rawData_(inlineData_), capacity_(SIMVALUE_INLINE_BYTE_SIZE),
     mask_(~ULongWord(0)) {
 
     setBitWidth(width);
@@ -87,7 +127,9 @@ SimValue::SimValue(SLongWord value, int width) :
  *
  * @param source The source object from which to copy data.
  */
-SimValue::SimValue(const SimValue& source) {
+SimValue::SimValue(const SimValue& source) :
+    rawData_(inlineData_), capacity_(SIMVALUE_INLINE_BYTE_SIZE) {
+
     deepCopy(source);
 }
 
@@ -110,6 +152,7 @@ void
 SimValue::setBitWidth(int width) {
     assert(width <= SIMD_WORD_WIDTH);
 
+    reserveBytes((width + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH);
     bitWidth_ = width;
     if (BYTE_BITWIDTH * sizeof(mask_) > static_cast<size_t>(width)) {
         mask_ = ~((~ULongWord(0)) << bitWidth_);
@@ -283,7 +326,11 @@ SimValue::operator=(const SimValue& source) {
     const size_t SRC_BYTE_COUNT =
         (source.bitWidth_ + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
 
-    memcpy(rawData_, source.rawData_, SRC_BYTE_COUNT);
+    // the bytes above the destination width are not part of the value,
+    // copy only as many of them as the destination has room for
+    memcpy(
+        rawData_, source.rawData_,
+        std::min(SRC_BYTE_COUNT, static_cast<size_t>(capacity_)));
     if (SRC_BYTE_COUNT < DST_BYTE_COUNT) {
         memset(rawData_+SRC_BYTE_COUNT, 0, DST_BYTE_COUNT-SRC_BYTE_COUNT);
     } else if (bitWidth_ % BYTE_BITWIDTH) {
@@ -306,6 +353,7 @@ SimValue::deepCopy(const SimValue& source) {
     const size_t BYTE_COUNT =
         (source.bitWidth_ + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
 
+    reserveBytes(BYTE_COUNT);
     memcpy(rawData_, source.rawData_, BYTE_COUNT);
     bitWidth_ = source.bitWidth_;
     mask_ = source.mask_;
@@ -1225,6 +1273,7 @@ SimValue::setValue(TCEString hexValue) {
         // Add padding zero bytes in case the hexValue defines less
         // bytes than the width of the value.
         paddingBytes = (VALUE_BITWIDTH - bitWidth_) / 8;
+        reserveBytes(VALUE_BITWIDTH / 8 + paddingBytes);
         for (size_t i = 0; i < paddingBytes; ++i)
             rawData_[VALUE_BITWIDTH / 8 + i] = 0;
     }
@@ -1237,6 +1286,7 @@ SimValue::setValue(TCEString hexValue) {
     int byteWidth = VALUE_BITWIDTH / 8;
     if (VALUE_BITWIDTH % 8 != 0) ++byteWidth;
 
+    reserveBytes(byteWidth);
     swapByteOrder(bigEndianData, byteWidth, rawData_);
 }
 
@@ -1251,7 +1301,8 @@ SimValue::clearToZero(int bitWidth) {
 
     const size_t BYTE_COUNT = (bitWidth + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
 
-    memset(rawData_, 0, BYTE_COUNT);
+    memset(
+        rawData_, 0, std::min(BYTE_COUNT, static_cast<size_t>(capacity_)));
 }
 
 /**
@@ -1275,7 +1326,7 @@ SimValue::dump() const {
 
     // Convert the raw data buffer to hex string values one byte at a time.
     // Also, remove "0x" from the front of the hex string for each hex value.
-    for (int i = SIMVALUE_MAX_BYTE_SIZE - 1; i >= 0; --i) {
+    for (int i = capacity_ - 1; i >= 0; --i) {
         unsigned int value =
             static_cast<unsigned int>(rawData_[i]);
         result += Conversion::toHexString(value, 2).substr(2);
@@ -1284,6 +1335,63 @@ SimValue::dump() const {
     return result;
 }
 
+/**
+ * Makes sure rawData_ can hold at least the given number of bytes.
+ *
+ * Moves the value to a larger pooled block if needed. The old bytes are
+ * preserved and the new ones cleared to zero.
+ *
+ * @param byteCount The number of bytes needed.
+ */
+void
+SimValue::reserveBytes(size_t byteCount) {
+    if (byteCount <= static_cast<size_t>(capacity_)) {
+        return;
+    }
+    assert(byteCount <= SIMVALUE_MAX_BYTE_SIZE);
+
+    size_t blockSize = 0;
+    const int sizeClass = storageClass(byteCount, blockSize);
+    Byte* storage = NULL;
+    if (freeBlocks[sizeClass] != NULL) {
+        FreeBlock* block = freeBlocks[sizeClass];
+        freeBlocks[sizeClass] = block->next;
+        --freeBlockCounts[sizeClass];
+        storage = reinterpret_cast<Byte*>(block);
+    } else {
+        storage = new Byte[blockSize];
+    }
+    memcpy(storage, rawData_, capacity_);
+    memset(storage + capacity_, 0, blockSize - capacity_);
+
+    if (rawData_ != inlineData_) {
+        releaseStorage();
+    }
+    rawData_ = storage;
+    capacity_ = blockSize;
+}
+
+/**
+ * Returns the out-of-line storage to the pool of the calling thread.
+ *
+ * Leaves the value with its inline storage only.
+ */
+void
+SimValue::releaseStorage() {
+    size_t blockSize = 0;
+    const int sizeClass = storageClass(capacity_, blockSize);
+    if (freeBlockCounts[sizeClass] < MAX_FREE_BLOCKS) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(rawData_);
+        block->next = freeBlocks[sizeClass];
+        freeBlocks[sizeClass] = block;
+        ++freeBlockCounts[sizeClass];
+    } else {
+        delete[] rawData_;
+    }
+    rawData_ = inlineData_;
+    capacity_ = SIMVALUE_INLINE_BYTE_SIZE;
+}
+
 /**
  * Copies the byte order from source array in opposite order to target array.
  *
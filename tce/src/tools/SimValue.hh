@@ -41,6 +41,9 @@
 
 #define SIMD_WORD_WIDTH 4096
 #define SIMVALUE_MAX_BYTE_SIZE (SIMD_WORD_WIDTH / BYTE_BITWIDTH)
+/// Bytes stored inside the SimValue object, wider values are stored
+/// out of line.
+#define SIMVALUE_INLINE_BYTE_SIZE 16
 
 class TCEString;
 
@@ -90,6 +93,11 @@ class TCEString;
  * since it is automatic and is done only if the user's machine is a
  * little-endian machine. However, users shouldn't access the public 
  * rawData_ member directly unless they know exactly what they are doing.
+ *
+ * Values of at most SIMVALUE_INLINE_BYTE_SIZE bytes are stored inside the
+ * object. Wider values get storage from a per-thread pool of
+ * power-of-two sized blocks, which is kept when the value is narrowed
+ * again. rawData_ is valid for at least the bytes of the current width.
  */
 
 class SimValue {
@@ -98,7 +106,11 @@ public:
     explicit SimValue(int width);
     explicit SimValue(SLongWord value, int width);
     SimValue(const SimValue& source);
-    ~SimValue() {}
+    ~SimValue() {
+        if (rawData_ != inlineData_) {
+            releaseStorage();
+        }
+    }
 
     int width() const;
     void setBitWidth(int width);
@@ -174,21 +186,29 @@ public:
     TCEString dump() const;
 
     /// Array that contains SimValue's underlaying bytes in little endian.
-    Byte rawData_[SIMVALUE_MAX_BYTE_SIZE];
+    Byte* rawData_;
 
     /// The bitwidth of the value.
     int bitWidth_;
 
 private:
+    void reserveBytes(size_t byteCount);
+    void releaseStorage();
+
     /// @todo Create more optimal 4-byte and 2-byte swapper functions for
     /// 2 and 4 byte values. The more optimal swapper would load all bytes
     /// to int or short int and shift the values to their correct places,
     /// which would reduce memory accesses.
     void swapByteOrder(const Byte* from, size_t byteCount, Byte* to) const;
 
+    /// Number of bytes available in rawData_.
+    int capacity_;
+
     /// Mask for masking extra bits when returning unsigned value.
     ULongWord mask_;
 
+    /// Storage of values that fit in SIMVALUE_INLINE_BYTE_SIZE bytes.
+    Byte inlineData_[SIMVALUE_INLINE_BYTE_SIZE];
 };
 
 //////////////////////////////////////////////////////////////////////////////
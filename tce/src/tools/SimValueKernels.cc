@@ -0,0 +1,473 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimValueKernels.cc
+ *
+ * Implementation of SimValueKernels class.
+ *
+ * The lane loops are written with the GCC vector extensions so the
+ * compiler emits whole-register instructions for the target they are
+ * compiled for. On x86 each loop is compiled three times, for the
+ * baseline, AVX2 and AVX-512, and the variant is picked once per process
+ * from the host CPU features.
+ *
+ * @note This file is used in compiled simulation. Keep dependencies *clean*
+ * @note rating: red
+ */
+
+#include <cassert>
+#include <cstring>
+#include <stdint.h>
+
+#include "SimValueKernels.hh"
+#include "SimValue.hh"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMVALUE_KERNELS_X86 1
+#endif
+
+#define KERNEL_INLINE inline __attribute__((always_inline))
+
+namespace {
+
+/// Bytes processed per iteration of the lane loops.
+const size_t VECTOR_BYTES = 64;
+
+/// Instruction set extensions the lane loops are compiled for.
+enum HostISA {
+    ISA_BASELINE,
+    ISA_AVX2,
+    ISA_AVX512
+};
+
+/**
+ * Returns the widest supported instruction set extension of the host.
+ */
+HostISA
+hostISA() {
+#ifdef SIMVALUE_KERNELS_X86
+    static const HostISA isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512bw")) {
+            return ISA_AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            return ISA_AVX2;
+        }
+        return ISA_BASELINE;
+    }();
+    return isa;
+#else
+    return ISA_BASELINE;
+#endif
+}
+
+/// Host integer type of a lane.
+template <int WIDTH, bool SIGNED> struct LaneType;
+template <> struct LaneType<8, false> { typedef uint8_t type; };
+template <> struct LaneType<16, false> { typedef uint16_t type; };
+template <> struct LaneType<32, false> { typedef uint32_t type; };
+template <> struct LaneType<64, false> { typedef uint64_t type; };
+template <> struct LaneType<8, true> { typedef int8_t type; };
+template <> struct LaneType<16, true> { typedef int16_t type; };
+template <> struct LaneType<32, true> { typedef int32_t type; };
+template <> struct LaneType<64, true> { typedef int64_t type; };
+
+// Lane operations. V is a vector of VECTOR_BYTES / sizeof(T) lanes of T.
+
+struct AddOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = a + b;
+    }
+};
+
+struct SubOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = a - b;
+    }
+};
+
+struct MulOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = a * b;
+    }
+};
+
+struct ShlOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = a << (b & static_cast<T>(sizeof(T) * 8 - 1));
+    }
+};
+
+/// Arithmetic with signed, logical with unsigned lanes.
+struct ShrOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = a >> (b & static_cast<T>(sizeof(T) * 8 - 1));
+    }
+};
+
+struct EqOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = (V)(a == b) & 1;
+    }
+};
+
+/// Signed or unsigned by the lane type.
+struct GtOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        result = (V)(a > b) & 1;
+    }
+};
+
+/// Signed or unsigned by the lane type.
+struct MinOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        const V aSmaller = (V)(a < b);
+        result = (a & aSmaller) | (b & ~aSmaller);
+    }
+};
+
+/// Signed or unsigned by the lane type.
+struct MaxOp {
+    template <typename T, typename V>
+    static KERNEL_INLINE void
+    apply(const V& a, const V& b, V& result) {
+        const V aGreater = (V)(a > b);
+        result = (a & aGreater) | (b & ~aGreater);
+    }
+};
+
+/**
+ * Applies the operation to chunks of VECTOR_BYTES bytes.
+ */
+template <typename Op, typename T>
+KERNEL_INLINE void
+laneLoop(const Byte* a, const Byte* b, Byte* result, size_t chunks) {
+    typedef T Vector __attribute__((vector_size(VECTOR_BYTES)));
+    for (size_t i = 0; i < chunks; ++i) {
+        Vector x, y, z;
+        memcpy(&x, a + i * VECTOR_BYTES, VECTOR_BYTES);
+        memcpy(&y, b + i * VECTOR_BYTES, VECTOR_BYTES);
+        Op::template apply<T, Vector>(x, y, z);
+        memcpy(result + i * VECTOR_BYTES, &z, VECTOR_BYTES);
+    }
+}
+
+template <typename Op, typename T>
+void
+baselineLoop(const Byte* a, const Byte* b, Byte* result, size_t chunks) {
+    laneLoop<Op, T>(a, b, result, chunks);
+}
+
+#ifdef SIMVALUE_KERNELS_X86
+template <typename Op, typename T>
+__attribute__((target("avx2"))) void
+avx2Loop(const Byte* a, const Byte* b, Byte* result, size_t chunks) {
+    laneLoop<Op, T>(a, b, result, chunks);
+}
+
+template <typename Op, typename T>
+__attribute__((target("avx512f,avx512bw"))) void
+avx512Loop(const Byte* a, const Byte* b, Byte* result, size_t chunks) {
+    laneLoop<Op, T>(a, b, result, chunks);
+}
+#endif
+
+/**
+ * Returns the number of bytes the lanes of the result occupy.
+ */
+size_t
+laneBytes(const SimValue& result, int laneWidth) {
+    assert(
+        laneWidth == 8 || laneWidth == 16 || laneWidth == 32 ||
+        laneWidth == 64);
+    assert(result.width() % laneWidth == 0);
+    return result.width() / BYTE_BITWIDTH;
+}
+
+/**
+ * Copies lanes between SimValue storage and host byte order.
+ *
+ * SimValue keeps each lane in little-endian order, big-endian hosts need
+ * to swap the bytes of every lane.
+ */
+void
+convertLanes(const Byte* from, size_t byteCount, Byte* to, size_t laneSize) {
+#if HOST_BIGENDIAN == 1
+    for (size_t lane = 0; lane < byteCount; lane += laneSize) {
+        for (size_t i = 0; i < laneSize; ++i) {
+            to[lane + i] = from[lane + laneSize - 1 - i];
+        }
+    }
+#else
+    (void)laneSize;
+    memcpy(to, from, byteCount);
+#endif
+}
+
+/**
+ * Computes result = Op(a, b) lane by lane with T typed lanes.
+ */
+template <typename Op, typename T>
+void
+laneKernel(const SimValue& a, const SimValue& b, SimValue& result) {
+    const size_t bytes = result.width() / BYTE_BITWIDTH;
+    assert(a.width() >= result.width() && b.width() >= result.width());
+
+    // copies padded to whole chunks also make aliasing operands safe
+    const size_t chunks = (bytes + VECTOR_BYTES - 1) / VECTOR_BYTES;
+    alignas(VECTOR_BYTES) Byte x[SIMVALUE_MAX_BYTE_SIZE];
+    alignas(VECTOR_BYTES) Byte y[SIMVALUE_MAX_BYTE_SIZE];
+    alignas(VECTOR_BYTES) Byte z[SIMVALUE_MAX_BYTE_SIZE];
+    convertLanes(a.rawData_, bytes, x, sizeof(T));
+    convertLanes(b.rawData_, bytes, y, sizeof(T));
+    memset(x + bytes, 0, chunks * VECTOR_BYTES - bytes);
+    memset(y + bytes, 0, chunks * VECTOR_BYTES - bytes);
+
+    switch (hostISA()) {
+#ifdef SIMVALUE_KERNELS_X86
+    case ISA_AVX512:
+        avx512Loop<Op, T>(x, y, z, chunks);
+        break;
+    case ISA_AVX2:
+        avx2Loop<Op, T>(x, y, z, chunks);
+        break;
+#endif
+    default:
+        baselineLoop<Op, T>(x, y, z, chunks);
+        break;
+    }
+    convertLanes(z, bytes, result.rawData_, sizeof(T));
+}
+
+/**
+ * Selects the lane type of the kernel by the lane width.
+ */
+template <typename Op, bool SIGNED>
+void
+dispatchLaneWidth(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+
+    laneBytes(result, laneWidth);
+    switch (laneWidth) {
+    case 8:
+        laneKernel<Op, typename LaneType<8, SIGNED>::type>(a, b, result);
+        break;
+    case 16:
+        laneKernel<Op, typename LaneType<16, SIGNED>::type>(a, b, result);
+        break;
+    case 32:
+        laneKernel<Op, typename LaneType<32, SIGNED>::type>(a, b, result);
+        break;
+    default:
+        laneKernel<Op, typename LaneType<64, SIGNED>::type>(a, b, result);
+        break;
+    }
+}
+
+}
+
+/**
+ * Lane-wise addition, wrapping on overflow.
+ */
+void
+SimValueKernels::add(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<AddOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise subtraction, wrapping on overflow.
+ */
+void
+SimValueKernels::sub(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<SubOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise multiplication, keeping the low half of the products.
+ */
+void
+SimValueKernels::mul(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<MulOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise left shift.
+ */
+void
+SimValueKernels::shl(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<ShlOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise arithmetic right shift.
+ */
+void
+SimValueKernels::shr(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<ShrOp, true>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise logical right shift.
+ */
+void
+SimValueKernels::shru(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<ShrOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise equality comparison.
+ */
+void
+SimValueKernels::eq(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<EqOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise signed greater than comparison.
+ */
+void
+SimValueKernels::gt(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<GtOp, true>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise unsigned greater than comparison.
+ */
+void
+SimValueKernels::gtu(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<GtOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise signed minimum.
+ */
+void
+SimValueKernels::min(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<MinOp, true>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise unsigned minimum.
+ */
+void
+SimValueKernels::minu(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<MinOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise signed maximum.
+ */
+void
+SimValueKernels::max(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<MaxOp, true>(a, b, result, laneWidth);
+}
+
+/**
+ * Lane-wise unsigned maximum.
+ */
+void
+SimValueKernels::maxu(
+    const SimValue& a, const SimValue& b, SimValue& result, int laneWidth) {
+    dispatchLaneWidth<MaxOp, false>(a, b, result, laneWidth);
+}
+
+/**
+ * Permutes the lanes of a.
+ *
+ * Result lane i is the lane of a selected by lane i of indices, modulo
+ * the number of lanes in the result.
+ *
+ * @param a The lanes to permute.
+ * @param indices The lane indices, in lanes of laneWidth bits.
+ * @param result The permuted lanes.
+ * @param laneWidth The lane width in bits.
+ */
+void
+SimValueKernels::shuffle(
+    const SimValue& a, const SimValue& indices, SimValue& result,
+    int laneWidth) {
+
+    const size_t bytes = laneBytes(result, laneWidth);
+    assert(a.width() >= result.width() && indices.width() >= result.width());
+
+    const size_t laneSize = laneWidth / BYTE_BITWIDTH;
+    const size_t laneCount = bytes / laneSize;
+    if (laneCount == 0) {
+        return;
+    }
+    Byte lanes[SIMVALUE_MAX_BYTE_SIZE];
+    alignas(sizeof(uint64_t)) Byte selectors[SIMVALUE_MAX_BYTE_SIZE];
+    memcpy(lanes, a.rawData_, bytes);
+    convertLanes(indices.rawData_, bytes, selectors, laneSize);
+
+    for (size_t i = 0; i < laneCount; ++i) {
+        uint64_t selector = 0;
+        switch (laneSize) {
+        case 1:
+            selector = selectors[i];
+            break;
+        case 2:
+            selector = reinterpret_cast<const uint16_t*>(selectors)[i];
+            break;
+        case 4:
+            selector = reinterpret_cast<const uint32_t*>(selectors)[i];
+            break;
+        default:
+            selector = reinterpret_cast<const uint64_t*>(selectors)[i];
+            break;
+        }
+        memcpy(
+            result.rawData_ + i * laneSize,
+            lanes + (selector % laneCount) * laneSize, laneSize);
+    }
+}
@@ -0,0 +1,109 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimValueKernels.hh
+ *
+ * Declaration of SimValueKernels class.
+ *
+ * @note This file is used in compiled simulation. Keep dependencies *clean*
+ * @note rating: red
+ */
+
+#ifndef TTA_SIM_VALUE_KERNELS_HH
+#define TTA_SIM_VALUE_KERNELS_HH
+
+class SimValue;
+
+/**
+ * Lane-parallel arithmetic on the storage of wide SimValues.
+ *
+ * Each function treats its operands as vectors of laneWidth-bit lanes
+ * (8, 16, 32 or 64) and computes as many lanes as fit in the width of the
+ * result. The operands must be at least as wide as the result, and the
+ * result width must be a multiple of the lane width. The result may be
+ * one of the operands.
+ *
+ * The kernels are meant for OSAL behaviors of vector operations and
+ * for compiled simulation code, for example:
+ *
+ *   SimValueKernels::add(IO(1), IO(2), IO(3), 32);
+ *
+ * On x86 hosts the widest available of AVX-512, AVX2 and the baseline SSE
+ * code is chosen at run time. Other hosts use the portable version.
+ *
+ * Comparisons set each result lane to 1 when the comparison holds and
+ * to 0 otherwise, like the scalar comparison operations. Shift amounts
+ * are taken from the lanes of the second operand modulo the lane width.
+ */
+class SimValueKernels {
+public:
+    static void add(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void sub(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void mul(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+
+    static void shl(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void shr(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void shru(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+
+    static void eq(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void gt(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void gtu(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+
+    static void min(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void minu(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void max(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+    static void maxu(
+        const SimValue& a, const SimValue& b, SimValue& result,
+        int laneWidth);
+
+    static void shuffle(
+        const SimValue& a, const SimValue& indices, SimValue& result,
+        int laneWidth);
+};
+
+#endif
@@ -63,6 +63,9 @@
 #include "Application.hh"
 #include "DataObject.hh"
 #include "AssocTools.hh"
+#include "ExecutionTrace.hh"
+#include "Program.hh"
+#include "AddressSpace.hh"
 
 using std::string;
 using namespace HDB;
@@ -86,6 +89,8 @@ public:
     void testStrictMatchWithInterpolatingRFPlugin();
     void testInterpolatingFUPlugin();
     void testStrictMatchWithInterpolatingFUPlugin();
+    void testMemoizedEstimates();
+    void testMemoizedEnergyEstimates();
 
 private:
     Estimator estimator_;
@@ -294,4 +299,101 @@ InterpolatingPluginTest::testStrictMatchWithInterpolatingFUPlugin() {
     TS_ASSERT_EQUALS(fuCompDelay, 7777);
 }
 
+/**
+ * Test that memoized estimates are shared by equal units only.
+ */
+void
+InterpolatingPluginTest::testMemoizedEstimates() {
+
+    ADFSerializer serializer;
+    serializer.setSourceFile(ADF_FILE);
+    Machine* machine = serializer.readMachine();
+    Machine* otherMachine = serializer.readMachine();
+
+    RegisterFile* rf = machine->registerFileNavigator().item(0);
+    RegisterFile* otherRF = otherMachine->registerFileNavigator().item(0);
+
+    UnitImplementationLocation rfImpl(HDB_FILE, 247, "RF");
+    MachineImplementation idf;
+    rfImpl.setParent(idf);
+
+    // an equal RF of another machine gets the same estimate
+    AreaInGates rfArea = estimator_.registerFileArea(*rf, rfImpl);
+    TS_ASSERT_DELTA(
+        estimator_.registerFileArea(*otherRF, rfImpl), rfArea, EPSILON);
+
+    // a changed RF is estimated again, W: 32, S: 2 matches entry 96
+    otherRF->setWidth(32);
+    TS_ASSERT_DELTA(
+        estimator_.registerFileArea(*otherRF, rfImpl), 878.25, EPSILON);
+    TS_ASSERT_DELTA(
+        estimator_.registerFileArea(*rf, rfImpl), rfArea, EPSILON);
+
+    delete machine;
+    delete otherMachine;
+}
+
+/**
+ * Tests that the memoized register file energies equal the ones estimated
+ * again, and that they are not reused for a different usage of the RF.
+ */
+void
+InterpolatingPluginTest::testMemoizedEnergyEstimates() {
+
+    const string TRACE_FILE = "data" + DS + "energy.tracedb";
+    const string OTHER_TRACE_FILE = "data" + DS + "other_energy.tracedb";
+    FileSystem::removeFileOrDirectory(TRACE_FILE);
+    FileSystem::removeFileOrDirectory(OTHER_TRACE_FILE);
+
+    ADFSerializer serializer;
+    serializer.setSourceFile(ADF_FILE);
+    Machine* machine = serializer.readMachine();
+    Machine* otherMachine = serializer.readMachine();
+
+    RegisterFile* rf = machine->registerFileNavigator().item(0);
+    RegisterFile* otherRF = otherMachine->registerFileNavigator().item(0);
+    TTAProgram::Program program(
+        *machine->addressSpaceNavigator().item(0));
+
+    UnitImplementationLocation rfImpl(HDB_FILE, 247, "RF");
+    MachineImplementation idf;
+    rfImpl.setParent(idf);
+
+    ExecutionTrace* trace = ExecutionTrace::open(TRACE_FILE);
+    trace->addConcurrentRegisterFileAccessCount(rf->name(), 1, 0, 10);
+    trace->addConcurrentRegisterFileAccessCount(rf->name(), 1, 1, 5);
+    trace->setSimulatedCycleCount(100);
+
+    ExecutionTrace* otherTrace = ExecutionTrace::open(OTHER_TRACE_FILE);
+    otherTrace->addConcurrentRegisterFileAccessCount(rf->name(), 1, 0, 20);
+    otherTrace->setSimulatedCycleCount(100);
+
+    Estimator fresh;
+    EnergyInMilliJoules energy =
+        fresh.registerFileEnergy(*rf, rfImpl, program, *trace);
+    EnergyInMilliJoules otherEnergy =
+        fresh.registerFileEnergy(*rf, rfImpl, program, *otherTrace);
+    TS_ASSERT(energy > 0.0);
+    TS_ASSERT(otherEnergy > 0.0);
+    TS_ASSERT(otherEnergy != energy);
+
+    // an equal RF with equal usage gets the memoized estimate, a different
+    // usage is estimated again
+    TS_ASSERT_EQUALS(
+        estimator_.registerFileEnergy(*rf, rfImpl, program, *trace), energy);
+    TS_ASSERT_EQUALS(
+        estimator_.registerFileEnergy(*otherRF, rfImpl, program, *trace),
+        energy);
+    TS_ASSERT_EQUALS(
+        estimator_.registerFileEnergy(*otherRF, rfImpl, program, *otherTrace),
+        otherEnergy);
+
+    delete trace;
+    delete otherTrace;
+    delete machine;
+    delete otherMachine;
+    FileSystem::removeFileOrDirectory(TRACE_FILE);
+    FileSystem::removeFileOrDirectory(OTHER_TRACE_FILE);
+}
+
 #endif
@@ -0,0 +1,243 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BitVectorTest.hh
+ *
+ * A test suite for BitVector and the image writers reading it.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BIT_VECTOR_TEST_HH
+#define TTA_BIT_VECTOR_TEST_HH
+
+#include <TestSuite.h>
+#include <sstream>
+#include <string>
+#include <boost/timer.hpp>
+
+#include "BitVector.hh"
+#include "AsciiImageWriter.hh"
+#include "HexImageWriter.hh"
+#include "RawImageWriter.hh"
+#include "Application.hh"
+
+/**
+ * Class that tests BitVector.
+ */
+class BitVectorTest : public CxxTest::TestSuite {
+public:
+    void testPushBack();
+    void testFields();
+    void testSubVectorAndCompare();
+    void testWriters();
+    void testWriterBenchmark();
+
+private:
+    static std::string toString(const BitVector& bits);
+};
+
+//#define BENCHMARKING_ENABLED
+
+/// Number of instructions in the benchmark image.
+#define BENCHMARK_INSTRUCTIONS 200000
+/// Width of the instructions in the benchmark image.
+#define BENCHMARK_INSTRUCTION_WIDTH 217
+
+/**
+ * Returns the bits as 1's and 0's.
+ */
+std::string
+BitVectorTest::toString(const BitVector& bits) {
+    std::string result;
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        result += bits[i] ? '1' : '0';
+    }
+    return result;
+}
+
+/**
+ * Tests appending bits and integers.
+ */
+void
+BitVectorTest::testPushBack() {
+
+    BitVector bits;
+    TS_ASSERT(bits.empty());
+    bits.pushBack(true);
+    bits.pushBack(5, 3);
+    bits.push_back(false);
+    TS_ASSERT_EQUALS(toString(bits), "11010");
+
+    // fields are added most significant bit first and may cross words
+    bits.pushBack(0xFFFFFFFFFFFFFFFFULL, 64);
+    TS_ASSERT_EQUALS(bits.size(), 69u);
+    TS_ASSERT_EQUALS(bits.field(4, 2), 1u);
+    TS_ASSERT_EQUALS(bits.field(5, 64), 0xFFFFFFFFFFFFFFFFULL);
+
+    // widths over the integer width are filled with zeros
+    BitVector wide;
+    wide.pushBack(3, 70);
+    TS_ASSERT_EQUALS(wide.size(), 70u);
+    TS_ASSERT_EQUALS(toString(wide), std::string(68, '0') + "11");
+
+    BitVector both;
+    both.pushBack(1, 1);
+    both.pushBack(bits);
+    both.pushBack(wide);
+    TS_ASSERT_EQUALS(toString(both), "1" + toString(bits) + toString(wide));
+
+    TS_ASSERT_THROWS(bits.at(69), OutOfRange);
+    TS_ASSERT(bits.at(68));
+
+    int count = 0;
+    for (BitVector::const_iterator i = bits.begin(); i != bits.end(); i++) {
+        count += *i;
+    }
+    TS_ASSERT_EQUALS(count, 67);
+}
+
+/**
+ * Tests reading and overwriting fields and single bits.
+ */
+void
+BitVectorTest::testFields() {
+
+    BitVector bits;
+    bits.pushBack(0, 128);
+    bits.setField(60, 0xABC, 12);
+    TS_ASSERT_EQUALS(bits.field(60, 12), 0xABCu);
+    TS_ASSERT_EQUALS(bits.field(56, 8), 0x0Au);
+    TS_ASSERT_EQUALS(bits.field(64, 8), 0xBCu);
+
+    bits.setField(60, 0x123, 8);
+    TS_ASSERT_EQUALS(bits.field(60, 12), 0x23Cu);
+
+    bits[0] = true;
+    bits[127] = bits[0];
+    TS_ASSERT(bits[127]);
+    bits[0] = false;
+    TS_ASSERT(!bits[0]);
+    TS_ASSERT_EQUALS(bits.field(120, 8), 1u);
+
+    TS_ASSERT_THROWS(bits.field(120, 9), OutOfRange);
+    TS_ASSERT_THROWS(bits.setField(0, 0, 65), OutOfRange);
+}
+
+/**
+ * Tests sub vectors and the comparison operators.
+ */
+void
+BitVectorTest::testSubVectorAndCompare() {
+
+    BitVector bits;
+    bits.pushBack(0x5, 4);
+    bits.pushBack(0xF0F0F0F0F0F0F0F0ULL, 64);
+    bits.pushBack(0x3, 2);
+
+    BitVector sub(bits, 2, 69);
+    TS_ASSERT_EQUALS(toString(sub), toString(bits).substr(2));
+    TS_ASSERT_THROWS(BitVector(bits, 5, 70), OutOfRange);
+
+    BitVector same(bits, 0, 69);
+    TS_ASSERT(same == bits);
+    same[69] = false;
+    TS_ASSERT(same != bits);
+    TS_ASSERT(same < bits);
+    TS_ASSERT(!(bits < same));
+
+    // a prefix is ordered first
+    BitVector prefix(bits, 0, 67);
+    TS_ASSERT(prefix < bits);
+    TS_ASSERT(!(bits < prefix));
+}
+
+/**
+ * Tests that the writers produce the expected images.
+ */
+void
+BitVectorTest::testWriters() {
+
+    BitVector bits;
+    bits.pushBack(0x1234, 16);
+    bits.pushBack(0x5, 3);
+
+    std::ostringstream ascii;
+    AsciiImageWriter(bits, 8).writeImage(ascii);
+    TS_ASSERT_EQUALS(ascii.str(), "00010010\n00110100\n10100000");
+
+    std::ostringstream raw;
+    RawImageWriter(bits).writeImage(raw);
+    TS_ASSERT_EQUALS(raw.str(), std::string("\x12\x34\xA0", 3));
+
+    BitVector words;
+    words.pushBack(0x2F, 6);
+    words.pushBack(0x01, 6);
+    std::ostringstream hex;
+    HexImageWriter(words, 6).writeImage(hex);
+    TS_ASSERT_EQUALS(hex.str(), "2f\n01\n");
+}
+
+/**
+ * Measures writing a large program image.
+ */
+void
+BitVectorTest::testWriterBenchmark() {
+#ifdef BENCHMARKING_ENABLED
+    boost::timer t;
+    BitVector bits;
+    for (int i = 0; i < BENCHMARK_INSTRUCTIONS; i++) {
+        BitVector instruction;
+        for (int field = 0; field < BENCHMARK_INSTRUCTION_WIDTH / 31;
+             field++) {
+            instruction.pushBack(i * 2654435761u + field, 31);
+        }
+        instruction.pushBack(
+            i, BENCHMARK_INSTRUCTION_WIDTH % 31);
+        bits.pushBack(instruction);
+    }
+    Application::logStream()
+        << "encoding: " << t.elapsed() << " s" << std::endl;
+
+    t.restart();
+    std::ostringstream ascii;
+    AsciiImageWriter(bits, BENCHMARK_INSTRUCTION_WIDTH).writeImage(ascii);
+    Application::logStream()
+        << "ascii image: " << t.elapsed() << " s" << std::endl;
+
+    t.restart();
+    std::ostringstream raw;
+    RawImageWriter(bits).writeImage(raw);
+    Application::logStream()
+        << "binary image: " << t.elapsed() << " s" << std::endl;
+
+    t.restart();
+    std::ostringstream hex;
+    HexImageWriter(bits, BENCHMARK_INSTRUCTION_WIDTH).writeImage(hex);
+    Application::logStream()
+        << "hex image: " << t.elapsed() << " s" << std::endl;
+#endif
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file LoopIISearchTest.hh
+ *
+ * A test suite for LoopIISearch.
+ *
+ * @note rating: red
+ */
+
+#ifndef LOOP_II_SEARCH_TEST_HH
+#define LOOP_II_SEARCH_TEST_HH
+
+#include <TestSuite.h>
+#include <vector>
+
+#include "LoopIISearch.hh"
+
+/**
+ * A loop which schedules with the IIs from firstWorking on, but not faster
+ * than the ordinary schedule from firstSlower on.
+ */
+class TestedLoop {
+public:
+    TestedLoop(unsigned int firstWorking, unsigned int firstSlower) :
+        firstWorking_(firstWorking), firstSlower_(firstSlower) {}
+
+    int test(unsigned int ii) {
+        tested.push_back(ii);
+        if (ii < firstWorking_) {
+            return -1;
+        }
+        return ii < firstSlower_ ? 1 : 0;
+    }
+
+    /// Cancels the tests of the IIs after the first working one, like the
+    /// worker processes are stopped.
+    std::vector<int> testBatch(const std::vector<unsigned int>& iis) {
+        std::vector<int> results(iis.size(), LoopIISearch::CANCELLED);
+        for (std::size_t i = 0; i < iis.size(); ++i) {
+            results[i] = test(iis[i]);
+            if (results[i] >= 0) {
+                break;
+            }
+        }
+        return results;
+    }
+
+    /// The tested IIs in the order of the tests.
+    std::vector<unsigned int> tested;
+
+private:
+    unsigned int firstWorking_;
+    unsigned int firstSlower_;
+};
+
+class LoopIISearchTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testBatchesFindTheSerialII();
+    void testNoWorkingII();
+
+private:
+    static void search(
+        TestedLoop& loop, int jobs, unsigned int& iiMin,
+        unsigned int& iiMax);
+};
+
+/**
+ * Called before each test.
+ */
+void
+LoopIISearchTest::setUp() {
+}
+
+
+/**
+ * Called after each test.
+ */
+void
+LoopIISearchTest::tearDown() {
+}
+
+/**
+ * Searches the II of the loop serially or in batches of the given size.
+ */
+void
+LoopIISearchTest::search(
+    TestedLoop& loop, int jobs, unsigned int& iiMin, unsigned int& iiMax) {
+
+    if (jobs <= 1) {
+        LoopIISearch::searchSerially(
+            [&](unsigned int ii) { return loop.test(ii); }, iiMin, iiMax);
+    } else {
+        LoopIISearch::searchInBatches(
+            [&](const std::vector<unsigned int>& iis) {
+                return loop.testBatch(iis);
+            }, jobs, iiMin, iiMax);
+    }
+}
+
+/**
+ * Tests that searching in batches of any size ends up with the II the
+ * serial search picks.
+ */
+void
+LoopIISearchTest::testBatchesFindTheSerialII() {
+
+    const unsigned int MIN_II = 1;
+    const unsigned int MAX_II = 40;
+    for (unsigned int working = MIN_II; working <= MAX_II + 1; ++working) {
+        for (unsigned int slower = working; slower <= MAX_II + 2;
+             slower += 3) {
+            TestedLoop serialLoop(working, slower);
+            unsigned int serialMin = MIN_II;
+            unsigned int serialMax = MAX_II;
+            search(serialLoop, 1, serialMin, serialMax);
+            const bool found = serialMin <= serialMax;
+            TS_ASSERT_EQUALS(found, working < slower && working <= MAX_II);
+            if (found) {
+                TS_ASSERT_EQUALS(serialMin, working);
+            }
+
+            for (int jobs = 2; jobs <= 9; ++jobs) {
+                TestedLoop loop(working, slower);
+                unsigned int iiMin = MIN_II;
+                unsigned int iiMax = MAX_II;
+                search(loop, jobs, iiMin, iiMax);
+                TS_ASSERT_EQUALS(iiMin <= iiMax, found);
+                if (found) {
+                    TS_ASSERT_EQUALS(iiMin, serialMin);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Tests that the search ends without testing an II twice when no II
+ * works.
+ */
+void
+LoopIISearchTest::testNoWorkingII() {
+
+    for (int jobs = 1; jobs <= 4; ++jobs) {
+        TestedLoop loop(100, 100);
+        unsigned int iiMin = 3;
+        unsigned int iiMax = 20;
+        search(loop, jobs, iiMin, iiMax);
+        TS_ASSERT(iiMin > iiMax);
+        for (std::size_t i = 0; i < loop.tested.size(); ++i) {
+            for (std::size_t j = i + 1; j < loop.tested.size(); ++j) {
+                TS_ASSERT_DIFFERS(loop.tested[i], loop.tested[j]);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file DDGConstructionBenchMarkTest.hh
+ *
+ * A benchmark for the construction of procedure-level data dependence
+ * graphs, including the register liveness analysis.
+ *
+ * @note rating: red
+ */
+
+#ifndef DDG_CONSTRUCTION_BENCHMARK_TEST_HH
+#define DDG_CONSTRUCTION_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+#include <cfloat>
+#include <boost/timer.hpp>
+
+#include "DataDependenceGraph.hh"
+#include "DataDependenceGraphBuilder.hh"
+#include "BinaryStream.hh"
+#include "BinaryReader.hh"
+#include "TPEFProgramFactory.hh"
+#include "Program.hh"
+#include "Procedure.hh"
+#include "UniversalMachine.hh"
+#include "ControlFlowGraph.hh"
+#include "BasicBlock.hh"
+#include "LiveRangeData.hh"
+#include "Application.hh"
+
+class DDGConstructionBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testDeathInformation();
+    void testConstructionSpeed();
+
+private:
+    TTAProgram::Program* program_;
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define BENCHMARK_ROUNDS 3
+#define BUILDS_PER_ROUND 200
+
+/// The benchmarked program, add larger ones here.
+#define BENCHMARK_PROGRAM "../DataDependenceGraphTest/data/arrmul.tpef"
+
+/**
+ * Loads the benchmarked program.
+ */
+void
+DDGConstructionBenchMarkTest::setUp() {
+    TPEF::BinaryStream binaryStream(BENCHMARK_PROGRAM);
+    TPEF::Binary* tpef = TPEF::BinaryReader::readBinary(binaryStream);
+    assert(tpef != NULL);
+    TTAProgram::TPEFProgramFactory factory(
+        *tpef, &UniversalMachine::instance());
+    program_ = factory.build();
+    delete tpef;
+}
+
+/**
+ * Frees the benchmarked program.
+ */
+void
+DDGConstructionBenchMarkTest::tearDown() {
+    delete program_;
+    program_ = NULL;
+}
+
+/**
+ * Tests that the registers used after each basic block are the ones
+ * read by its successors before they are overwritten.
+ */
+void
+DDGConstructionBenchMarkTest::testDeathInformation() {
+    for (int p = 0; p < program_->procedureCount(); p++) {
+        ControlFlowGraph cfg(program_->procedure(p));
+        DataDependenceGraphBuilder builder;
+        DataDependenceGraph* ddg = builder.build(
+            cfg, DataDependenceGraph::ALL_ANTIDEPS,
+            UniversalMachine::instance(), &UniversalMachine::instance());
+
+        for (int i = 0; i < cfg.nodeCount(); i++) {
+            BasicBlockNode& bbn = cfg.node(i);
+            if (!bbn.isNormalBB()) {
+                continue;
+            }
+            std::set<TCEString> expected;
+            ControlFlowGraph::NodeSet succs = cfg.successors(bbn);
+            for (ControlFlowGraph::NodeSet::iterator s = succs.begin();
+                 s != succs.end(); s++) {
+                LiveRangeData& succ = *(*s)->basicBlock().liveRangeData_;
+                for (LiveRangeData::MoveNodeUseMapSet::iterator u =
+                         succ.regFirstUses_.begin();
+                     u != succ.regFirstUses_.end(); u++) {
+                    expected.insert(u->first);
+                }
+                for (std::set<TCEString>::iterator r =
+                         succ.registersUsedAfter_.begin();
+                     r != succ.registersUsedAfter_.end(); r++) {
+                    if (succ.regKills_.find(*r) == succ.regKills_.end()) {
+                        expected.insert(*r);
+                    }
+                }
+            }
+            TS_ASSERT(
+                bbn.basicBlock().liveRangeData_->registersUsedAfter_ ==
+                expected);
+        }
+        delete ddg;
+    }
+}
+
+/**
+ * Measures the construction time of the DDGs of all procedures.
+ */
+void
+DDGConstructionBenchMarkTest::testConstructionSpeed() {
+#ifdef BENCHMARKING_ENABLED
+    Application::logStream()
+        << "BENCHMARK_PROGRAM " << BENCHMARK_PROGRAM << std::endl
+        << "BENCHMARK_ROUNDS " << BENCHMARK_ROUNDS << std::endl
+        << "BUILDS_PER_ROUND " << BUILDS_PER_ROUND << std::endl;
+
+    std::vector<ControlFlowGraph*> cfgs;
+    for (int p = 0; p < program_->procedureCount(); p++) {
+        cfgs.push_back(new ControlFlowGraph(program_->procedure(p)));
+    }
+
+    double best = DBL_MAX;
+    int nodes = 0;
+    for (int round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        boost::timer t;
+        for (int b = 0; b < BUILDS_PER_ROUND; ++b) {
+            for (size_t c = 0; c < cfgs.size(); ++c) {
+                DataDependenceGraphBuilder builder;
+                DataDependenceGraph* ddg = builder.build(
+                    *cfgs[c], DataDependenceGraph::ALL_ANTIDEPS,
+                    UniversalMachine::instance(),
+                    &UniversalMachine::instance());
+                nodes += ddg->nodeCount();
+                delete ddg;
+            }
+        }
+        best = std::min(best, t.elapsed());
+    }
+    TS_ASSERT(nodes > 0);
+
+    Application::logStream()
+        << "DDG construction: "
+        << best * 1000.0 / BUILDS_PER_ROUND << " ms per program"
+        << std::endl;
+
+    for (size_t c = 0; c < cfgs.size(); ++c) {
+        delete cfgs[c];
+    }
+#endif
+}
+
+#endif
@@ -74,6 +74,8 @@ public:
 
     void testSWBypassing();
 
+    void testCycleIndex();
+
     MoveNode& findMoveNodeById(DataDependenceGraph& ddg, int id);
 };
 
@@ -940,5 +942,111 @@ DataDependenceGraphTest::testSWBypassing() {
     
 }
 
+/**
+ * Tests that the moves of the cycles are followed in the graph and its
+ * subgraphs when the nodes are placed, unplaced, removed and dropped.
+ */
+void
+DataDependenceGraphTest::testCycleIndex() {
+
+    TPEF::BinaryStream binaryStream("data/rallocated_arrmul.tpef");
+    ADFSerializer adfSerializer;
+    adfSerializer.setSourceFile("data/10_bus_full_connectivity.adf");
+    TTAMachine::Machine* machine = adfSerializer.readMachine();
+
+    TPEF::Binary* tpef_ = TPEF::BinaryReader::readBinary(binaryStream);
+    assert(tpef_ != NULL);
+    TTAProgram::TPEFProgramFactory factory(
+        *tpef_, *machine, &UniversalMachine::instance());
+    TTAProgram::Program* currentProgram = factory.build();
+
+    ControlFlowGraph cfg(currentProgram->procedure(1));
+    DataDependenceGraphBuilder builder;
+    DataDependenceGraph* ddg =
+        builder.build(cfg, DataDependenceGraph::ALL_ANTIDEPS, *machine);
+
+    for (int i = 0; i < ddg->nodeCount(); i++) {
+        if (ddg->node(i).isPlaced()) {
+            ddg->node(i).unsetCycle();
+        }
+    }
+    TS_ASSERT_EQUALS(ddg->scheduledNodeCount(), 0);
+
+    BasicBlockNode* bbn = NULL;
+    for (int i = 0; i < cfg.nodeCount() && bbn == NULL; i++) {
+        if (cfg.node(i).isNormalBB() &&
+            cfg.node(i).basicBlock().instructionCount() > 1) {
+            bbn = &cfg.node(i);
+        }
+    }
+    TS_ASSERT(bbn != NULL);
+    DataDependenceGraph* sg = ddg->createSubgraph(bbn->basicBlock());
+    TS_ASSERT(sg->nodeCount() > 1);
+
+    MoveNode& a = sg->node(0);
+    MoveNode& b = sg->node(1);
+    TS_ASSERT(a.isAssigned());
+    TS_ASSERT(b.isAssigned());
+
+    // place, unplace and re-place
+    a.setCycle(5);
+    b.setCycle(5);
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(5).size(), 2u);
+    TS_ASSERT_EQUALS(sg->movesAtCycle(5).size(), 2u);
+    TS_ASSERT_EQUALS(sg->scheduledNodeCount(), 2);
+
+    a.unsetCycle();
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(5).size(), 1u);
+    TS_ASSERT_EQUALS(sg->movesAtCycle(5).size(), 1u);
+    TS_ASSERT_EQUALS(sg->scheduledNodeCount(), 1);
+
+    a.setCycle(7);
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(5).size(), 1u);
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(7).count(&a), 1u);
+    TS_ASSERT_EQUALS(sg->movesAtCycle(7).count(&a), 1u);
+    TS_ASSERT_EQUALS(sg->smallestCycle(), 5);
+    TS_ASSERT_EQUALS(sg->largestCycle(), 7);
+
+    // a dropped node is followed only by the parent graph
+    sg->dropNode(b);
+    TS_ASSERT(sg->movesAtCycle(5).empty());
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(5).count(&b), 1u);
+    b.unsetCycle();
+    b.setCycle(3);
+    TS_ASSERT(ddg->movesAtCycle(5).empty());
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(3).count(&b), 1u);
+    TS_ASSERT(sg->movesAtCycle(3).empty());
+    TS_ASSERT_EQUALS(ddg->smallestCycle(), 3);
+    TS_ASSERT_EQUALS(sg->smallestCycle(), 7);
+
+    // a node removed through the subgraph leaves both graphs
+    MoveNode* added = new MoveNode(a.move().copy());
+    sg->addNode(*added);
+    added->setCycle(7);
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(7).size(), 2u);
+    TS_ASSERT_EQUALS(sg->movesAtCycle(7).size(), 2u);
+    sg->removeNode(*added);
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(7).size(), 1u);
+    TS_ASSERT_EQUALS(sg->movesAtCycle(7).size(), 1u);
+    added->unsetCycle();
+    added->setCycle(9);
+    TS_ASSERT(ddg->movesAtCycle(9).empty());
+    delete added;
+
+    // the nodes outlive a subgraph deleted while they are placed
+    ddg->detachSubgraph(*sg);
+    delete sg;
+    a.unsetCycle();
+    TS_ASSERT(ddg->movesAtCycle(7).empty());
+    a.setCycle(9);
+    TS_ASSERT_EQUALS(ddg->movesAtCycle(9).count(&a), 1u);
+    TS_ASSERT_EQUALS(ddg->scheduledNodeCount(), 2);
+    TS_ASSERT_EQUALS(ddg->largestCycle(), 9);
+
+    delete ddg;
+    delete currentProgram;
+    delete machine;
+}
+
 #endif
 
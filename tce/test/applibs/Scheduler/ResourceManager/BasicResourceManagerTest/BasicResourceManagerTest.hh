@@ -35,6 +35,7 @@
 #define BASIC_RESOURCE_MANAGER_TEST_HH
 
 #include <iostream>
+#include <climits>
 #include <TestSuite.h>
 #include "SimpleResourceManager.hh"
 #include "CriticalPathBBMoveNodeSelector.hh"
@@ -85,6 +86,7 @@ public:
     void testMULConflict();
     void testLIMMPSocketReads();
     void testNoRegisterTriggerInvalidates();
+    void testSchedulingAtLargeCycles();
 
 };
 
@@ -1191,4 +1193,60 @@ BasicResourceManagerTest::testNoRegisterTriggerInvalidates() {
     delete targetMachine;
 
 }
+/**
+ * Tests scheduling a basic block starting from the first cycle of the
+ * bottom-up schedulers, far from cycle zero.
+ */
+void
+BasicResourceManagerTest::testSchedulingAtLargeCycles() {
+
+    const int start = INT_MAX / 1024;
+    try {
+        TTAMachine::Machine* targetMachine =
+            TTAMachine::Machine::loadFromADF(
+                "data/10_bus_full_connectivity.adf");
+        TTAProgram::Program* srcProgram =
+            TTAProgram::Program::loadFromUnscheduledTPEF(
+                "data/arrmul_reg_allocated_10_bus.tpef", *targetMachine);
+
+        TTAProgram::Procedure& procedure = srcProgram->procedure(0);
+        {
+        ControlFlowGraph cfg(procedure);
+        CriticalPathBBMoveNodeSelector selector(
+            cfg.node(0).basicBlock(), *targetMachine);
+        SimpleResourceManager* rm =
+            SimpleResourceManager::createRM(*targetMachine);
+
+        int cycle = 0;
+        MoveNodeGroup moves = selector.candidates();
+        SCHEDULE(1, start);
+        SCHEDULE(0, start);
+        SCHEDULE(2, start);
+        TS_ASSERT(moves.node(0).cycle() >= start);
+        TS_ASSERT(moves.node(2).cycle() > moves.node(0).cycle());
+
+        // the result read has to stay after the trigger also when
+        // rescheduled
+        const int triggerCycle = moves.node(0).cycle();
+        TS_ASSERT_THROWS_NOTHING(rm->unassign(moves.node(2)));
+        TS_ASSERT(!rm->canAssign(triggerCycle - 1, moves.node(2)));
+        TS_ASSERT_THROWS_NOTHING(
+            rm->assign(
+                rm->earliestCycle(start, moves.node(2)), moves.node(2)));
+        TS_ASSERT(moves.node(2).cycle() > triggerCycle);
+
+        moves = selector.candidates();
+        SCHEDULE(1, start);
+        SCHEDULE(0, start);
+        TS_ASSERT(moves.node(0).cycle() >= start);
+        SimpleResourceManager::disposeRM(rm, false);
+        }
+        delete srcProgram;
+        delete targetMachine;
+    } catch (const Exception& e) {
+        std::cerr << e.errorMessage() << std::endl;
+        TS_FAIL("testSchedulingAtLargeCycles failed");
+    }
+}
+
 #endif
@@ -0,0 +1,161 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ResourceModelBenchMarkTest.hh
+ *
+ * A benchmark for the per-cycle occupancy queries of the scheduler
+ * resource model.
+ *
+ * @note rating: red
+ */
+
+#ifndef RESOURCE_MODEL_BENCHMARK_TEST_HH
+#define RESOURCE_MODEL_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+#include <cfloat>
+#include <boost/timer.hpp>
+
+#include "BusResource.hh"
+#include "InputPSocketResource.hh"
+#include "MoveNode.hh"
+#include "Application.hh"
+
+class ResourceModelBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testBusOccupancy();
+    void testModuloOccupancy();
+    void testCanAssignThroughput();
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define BENCHMARK_ROUNDS 3
+#define SCHEDULED_CYCLES 20000
+#define QUERY_COUNT (50*1000000)
+
+/**
+ * Tests that the bus occupancy follows assignments and unassignments.
+ */
+void
+ResourceModelBenchMarkTest::testBusOccupancy() {
+
+    BusResource bus("bus", 32, 0, 0, 32, 2);
+    MoveNode node;
+
+    TS_ASSERT(bus.canAssign(0, node));
+    TS_ASSERT(bus.canAssign(1000, node));
+    bus.assign(1000, node);
+    TS_ASSERT(bus.isInUse(1000));
+    TS_ASSERT(!bus.canAssign(1000, node));
+    TS_ASSERT(bus.canAssign(999, node));
+    TS_ASSERT(bus.canAssign(1001, node));
+
+    bus.unassign(1000, node);
+    TS_ASSERT(!bus.isInUse(1000));
+    TS_ASSERT_THROWS(bus.unassign(1000, node), ModuleRunTimeError);
+
+    bus.assign(5, node);
+    bus.clear();
+    TS_ASSERT(!bus.isInUse(5));
+
+    InputPSocketResource socket("socket");
+    TS_ASSERT(!socket.isInUse(3));
+    socket.assign(3, node);
+    TS_ASSERT(socket.isInUse(3));
+    TS_ASSERT(!socket.isInUse(4));
+    socket.unassign(3, node);
+    TS_ASSERT(!socket.isInUse(3));
+    TS_ASSERT(socket.canAssign(3, node));
+}
+
+/**
+ * Tests that the occupancy wraps around the initiation interval.
+ */
+void
+ResourceModelBenchMarkTest::testModuloOccupancy() {
+
+    BusResource bus("bus", 32, 0, 0, 32, 2, 4);
+    MoveNode node;
+
+    bus.assign(6, node);
+    TS_ASSERT(bus.isInUse(2));
+    TS_ASSERT(bus.isInUse(10));
+    TS_ASSERT(!bus.canAssign(14, node));
+    TS_ASSERT(bus.canAssign(7, node));
+
+    bus.unassign(2, node);
+    TS_ASSERT(!bus.isInUse(6));
+}
+
+/**
+ * Measures the number of canAssign() queries per second on a bus
+ * which is busy every other cycle.
+ */
+void
+ResourceModelBenchMarkTest::testCanAssignThroughput() {
+#ifdef BENCHMARKING_ENABLED
+    Application::logStream()
+        << "BENCHMARK_ROUNDS " << BENCHMARK_ROUNDS << std::endl
+        << "SCHEDULED_CYCLES " << SCHEDULED_CYCLES << std::endl
+        << "QUERY_COUNT " << QUERY_COUNT << std::endl;
+
+    BusResource bus("bus", 32, 0, 0, 32, 2);
+    InputPSocketResource socket("socket");
+    MoveNode node;
+    for (int cycle = 0; cycle < SCHEDULED_CYCLES; cycle += 2) {
+        bus.assign(cycle, node);
+        socket.assign(cycle, node);
+    }
+
+    double bestBus = DBL_MAX;
+    double bestSocket = DBL_MAX;
+    int freeCycles = 0;
+    for (int round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        boost::timer t;
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            freeCycles += bus.canAssign(i % SCHEDULED_CYCLES, node);
+        }
+        bestBus = std::min(bestBus, t.elapsed());
+
+        t.restart();
+        // only the free cycles, the busy ones need real moves to
+        // check the guards
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            freeCycles += socket.canAssign(
+                (2 * i + 1) % SCHEDULED_CYCLES, node);
+        }
+        bestSocket = std::min(bestSocket, t.elapsed());
+    }
+    TS_ASSERT_EQUALS(freeCycles, BENCHMARK_ROUNDS * QUERY_COUNT / 2 * 3);
+
+    Application::logStream()
+        << "BusResource::canAssign: "
+        << QUERY_COUNT / (bestBus * 1e6) << " Mcalls/s" << std::endl
+        << "InputPSocketResource::canAssign: "
+        << QUERY_COUNT / (bestSocket * 1e6) << " Mcalls/s" << std::endl;
+#endif
+}
+
+#endif
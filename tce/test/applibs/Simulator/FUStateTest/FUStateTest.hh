@@ -64,6 +64,10 @@
 #include "BuslessExecutableMove.hh"
 #include "AssocTools.hh"
 #include "StringTools.hh"
+#include "Conversion.hh"
+#ifdef FU_CLOCK_BENCHMARK
+#include <boost/timer.hpp>
+#endif
 
 using std::cout;
 using std::endl;
@@ -72,6 +76,10 @@ using std::endl;
 // conflict detection models (takes hours to complete)
 // #define CONFLICT_DETECTOR_BENCHMARK 
 
+// define this if want to run the benchmark of clocking only the active FUs
+// of a machine against clocking all of them
+// #define FU_CLOCK_BENCHMARK
+
 /**
  * Test class for FUState.
  */
@@ -87,8 +95,17 @@ public:
     void testOneCycleOperationExecutor();
     void testSimpleOperationExecutor();
     void testMemoryAccessingFUState();
+    void testActiveFUStates();
 
     void testConflictDetectionModelBenchmark();
+    void testFUClockBenchmark();
+
+private:
+    static void addAdderFUStates(
+        MachineState& machineState, Operation& add, int count);
+    static void triggerAdd(
+        MachineState& machineState, int index, int operand1, int operand2);
+    static int addResult(MachineState& machineState, int index);
 
 #ifdef CONFLICT_DETECTOR_BENCHMARK 
 public:
@@ -654,6 +671,127 @@ FUStateTest::benchmarkSimulateLazyFSA() {
 
 #endif
 
+/**
+ * Adds FUStates with a one cycle adder to a machine state.
+ *
+ * The FUs are named "fu0", "fu1"... and have ports "in1", "in2t", the
+ * opcode setting port "in2t.testadd" and "out1".
+ *
+ * @param machineState The machine state.
+ * @param add The add operation.
+ * @param count The number of FUs to add.
+ */
+void
+FUStateTest::addAdderFUStates(
+    MachineState& machineState, Operation& add, int count) {
+
+    for (int i = 0; i < count; ++i) {
+        const std::string name = "fu" + Conversion::toString(i);
+        FUState* fu = new FUState();
+        InputPortState* in1 = new InputPortState(*fu, 32);
+        TriggeringInputPortState* in2t =
+            new TriggeringInputPortState(*fu, 32);
+        OpcodeSettingVirtualInputPortState* opcode =
+            new OpcodeSettingVirtualInputPortState(add, *fu, *in2t);
+        OutputPortState* out1 = new OutputPortState(*fu, 32);
+
+        OneCycleOperationExecutor executor(*fu);
+        executor.addBinding(1, *in1);
+        executor.addBinding(2, *in2t);
+        executor.addBinding(3, *out1);
+        fu->addOperationExecutor(executor, add);
+
+        fu->addInputPortState(*in1);
+        fu->addInputPortState(*in2t);
+        fu->addInputPortState(*opcode);
+        fu->addOutputPortState(*out1);
+
+        machineState.addFUState(fu, name);
+        machineState.addPortState(in1, "in1", name);
+        machineState.addPortState(in2t, "in2t", name);
+        machineState.addPortState(opcode, "in2t.testadd", name);
+        machineState.addPortState(out1, "out1", name);
+    }
+}
+
+/**
+ * Writes the operands of an addition to an FU added by addAdderFUStates().
+ *
+ * @param machineState The machine state.
+ * @param index The index of the FU.
+ * @param operand1 The first operand.
+ * @param operand2 The second, triggering operand.
+ */
+void
+FUStateTest::triggerAdd(
+    MachineState& machineState, int index, int operand1, int operand2) {
+
+    const std::string name = "fu" + Conversion::toString(index);
+    SimValue value(32);
+    value = operand1;
+    machineState.portState("in1", name).setValue(value);
+    value = operand2;
+    machineState.portState("in2t.testadd", name).setValue(value);
+}
+
+/**
+ * Returns the value of the output port of an FU added by
+ * addAdderFUStates().
+ *
+ * @param machineState The machine state.
+ * @param index The index of the FU.
+ * @return The value of the output port.
+ */
+int
+FUStateTest::addResult(MachineState& machineState, int index) {
+    return machineState.portState(
+        "out1", "fu" + Conversion::toString(index)).value().intValue();
+}
+
+/**
+ * Tests that only the triggered and busy FUs are clocked by the machine
+ * state, and that they are clocked in the order they were added.
+ */
+void
+FUStateTest::testActiveFUStates() {
+
+    OperationPool pool;
+    Operation& add = pool.operation("TESTADD");
+    TS_ASSERT_DIFFERS(&add, &NullOperation::instance());
+
+    MachineState machineState;
+    addAdderFUStates(machineState, add, 4);
+
+    // the new FUs are not known to be idle before their clock is advanced
+    TS_ASSERT_EQUALS(machineState.activeFUStateCount(), 4u);
+    machineState.endClockOfAllFUStates();
+    machineState.advanceClockOfAllFUStates();
+    TS_ASSERT_EQUALS(machineState.activeFUStateCount(), 0u);
+
+    triggerAdd(machineState, 2, 2, 3);
+    TS_ASSERT_EQUALS(machineState.activeFUStateCount(), 1u);
+    machineState.endClockOfAllFUStates();
+    machineState.advanceClockOfAllFUStates();
+    TS_ASSERT_EQUALS(addResult(machineState, 2), 5);
+
+    // triggering in the reverse order of the FUs
+    triggerAdd(machineState, 3, 10, 20);
+    triggerAdd(machineState, 1, 100, 200);
+    triggerAdd(machineState, 3, 1, 2);
+    TS_ASSERT(machineState.activeFUStateCount() <= 3u);
+    machineState.endClockOfAllFUStates();
+    machineState.advanceClockOfAllFUStates();
+    TS_ASSERT_EQUALS(addResult(machineState, 1), 300);
+    TS_ASSERT_EQUALS(addResult(machineState, 3), 3);
+    TS_ASSERT_EQUALS(addResult(machineState, 2), 5);
+
+    machineState.endClockOfAllFUStates();
+    machineState.advanceClockOfAllFUStates();
+    TS_ASSERT_EQUALS(machineState.activeFUStateCount(), 0u);
+    TS_ASSERT_EQUALS(addResult(machineState, 1), 300);
+    TS_ASSERT_EQUALS(addResult(machineState, 3), 3);
+}
+
 /**
  * Run benchmarks for the different conflict detection models.
  */
@@ -673,4 +811,64 @@ FUStateTest::testConflictDetectionModelBenchmark() {
 #endif
 }
 
+/**
+ * Benchmarks clocking the FUs of a machine with one busy FU out of many.
+ *
+ * The cycles per second are reported for visiting every FU, as the
+ * machine state did before keeping the list of the active FUs, and for
+ * visiting the active FUs only.
+ */
+void
+FUStateTest::testFUClockBenchmark() {
+#ifdef FU_CLOCK_BENCHMARK
+    const int FU_COUNT = 64;
+    const int CYCLES = 10000000;
+
+    OperationPool pool;
+    Operation& add = pool.operation("TESTADD");
+    SimValue operand(32);
+    operand = 1;
+
+    MachineState allFUs;
+    addAdderFUStates(allFUs, add, FU_COUNT);
+    PortState& allTrigger = allFUs.portState("in2t.testadd", "fu0");
+    std::vector<FUState*> fus;
+    for (int i = 0; i < allFUs.FUStateCount(); ++i) {
+        fus.push_back(&allFUs.fuState(i));
+    }
+    boost::timer t;
+    for (int cycle = 0; cycle < CYCLES; ++cycle) {
+        allTrigger.setValue(operand);
+        for (std::size_t i = 0; i < fus.size(); ++i) {
+            if (!fus[i]->isIdle()) {
+                fus[i]->endClock();
+            }
+        }
+        for (std::size_t i = 0; i < fus.size(); ++i) {
+            if (!fus[i]->isIdle()) {
+                fus[i]->advanceClock();
+            }
+        }
+    }
+    const double allTime = t.elapsed();
+
+    MachineState activeFUs;
+    addAdderFUStates(activeFUs, add, FU_COUNT);
+    PortState& activeTrigger = activeFUs.portState("in2t.testadd", "fu0");
+    t.restart();
+    for (int cycle = 0; cycle < CYCLES; ++cycle) {
+        activeTrigger.setValue(operand);
+        activeFUs.endClockOfAllFUStates();
+        activeFUs.advanceClockOfAllFUStates();
+    }
+    const double activeTime = t.elapsed();
+
+    std::cout
+        << std::endl << "Clocking " << FU_COUNT << " FUs with one busy:"
+        << std::endl << "all FUs:    " << CYCLES / allTime << " cycles/s"
+        << std::endl << "active FUs: " << CYCLES / activeTime << " cycles/s"
+        << std::endl;
+#endif
+}
+
 #endif
@@ -0,0 +1,133 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionMemoryTest.hh
+ *
+ * A test suite for InstructionMemory.
+ *
+ * @note rating: red
+ */
+
+#ifndef INSTRUCTION_MEMORY_TEST_HH
+#define INSTRUCTION_MEMORY_TEST_HH
+
+#include <TestSuite.h>
+
+#include "InstructionMemory.hh"
+#include "ExecutableInstruction.hh"
+#include "Exception.hh"
+
+class InstructionMemoryTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testExecutionCount();
+    void testExecutionCountOfUnbuiltInstructions();
+
+private:
+    static bool executionCountThrows(
+        const InstructionMemory& memory, InstructionAddress address);
+};
+
+/// The address of the first instruction of the tested memories.
+const InstructionAddress START_ADDRESS = 8;
+
+/**
+ * Called before each test.
+ */
+void
+InstructionMemoryTest::setUp() {
+}
+
+
+/**
+ * Called after each test.
+ */
+void
+InstructionMemoryTest::tearDown() {
+}
+
+/**
+ * Tells whether asking the execution count of the given address fails.
+ *
+ * @param memory The instruction memory.
+ * @param address The instruction address.
+ * @return True if OutOfRange was thrown.
+ */
+bool
+InstructionMemoryTest::executionCountThrows(
+    const InstructionMemory& memory, InstructionAddress address) {
+
+    try {
+        memory.executionCount(address);
+    } catch (const OutOfRange&) {
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Tests that the execution counts of the instructions are returned.
+ */
+void
+InstructionMemoryTest::testExecutionCount() {
+
+    InstructionMemory memory(START_ADDRESS);
+    for (int i = 0; i < 3; ++i) {
+        memory.addExecutableInstruction(new ExecutableInstruction());
+    }
+    memory.instructionAt(START_ADDRESS + 1).execute();
+    memory.instructionAt(START_ADDRESS + 1).execute();
+    memory.instructionAt(START_ADDRESS + 2).execute();
+
+    TS_ASSERT_EQUALS(memory.executionCount(START_ADDRESS), 0u);
+    TS_ASSERT_EQUALS(memory.executionCount(START_ADDRESS + 1), 2u);
+    TS_ASSERT_EQUALS(memory.executionCount(START_ADDRESS + 2), 1u);
+    TS_ASSERT(executionCountThrows(memory, START_ADDRESS + 3));
+    TS_ASSERT(executionCountThrows(memory, START_ADDRESS - 1));
+
+    memory.resetExecutionCounts();
+    TS_ASSERT_EQUALS(memory.executionCount(START_ADDRESS + 1), 0u);
+    TS_ASSERT_EQUALS(memory.executionCount(START_ADDRESS + 2), 0u);
+}
+
+/**
+ * Tests that the instructions of a memory built on demand are not built
+ * for asking their execution counts.
+ *
+ * The memory has no builder, so building an instruction would fail.
+ */
+void
+InstructionMemoryTest::testExecutionCountOfUnbuiltInstructions() {
+
+    InstructionMemory memory(START_ADDRESS, 4, NULL);
+    for (InstructionAddress a = START_ADDRESS; a < START_ADDRESS + 4; ++a) {
+        TS_ASSERT_EQUALS(memory.executionCount(a), 0u);
+    }
+    TS_ASSERT(executionCountThrows(memory, START_ADDRESS + 4));
+    memory.resetExecutionCounts();
+}
+
+#endif
@@ -0,0 +1,252 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file RFAccessTrackerTest.hh
+ *
+ * A test suite for RFAccessTracker.
+ *
+ * @note rating: red
+ */
+
+#ifndef RF_ACCESS_TRACKER_TEST_HH
+#define RF_ACCESS_TRACKER_TEST_HH
+
+#include <TestSuite.h>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "SimulatorFrontend.hh"
+#include "SimulationEventHandler.hh"
+#include "RFAccessTracker.hh"
+#include "ExecutableInstruction.hh"
+#include "Listener.hh"
+#include "Program.hh"
+#include "Instruction.hh"
+#include "Move.hh"
+#include "Terminal.hh"
+#include "RegisterFile.hh"
+#include "Address.hh"
+#include "FileSystem.hh"
+#include "boost/tuple/tuple_comparison.hpp"
+
+using std::string;
+
+/**
+ * Counts the concurrent register file accesses of each cycle by
+ * collecting them to maps, as RFAccessTracker did before the accesses
+ * were cached.
+ *
+ * The cycles of the instructions with conditional register file accesses
+ * are counted separately from the rest.
+ */
+class ReferenceRFAccessCounter : public Listener {
+public:
+    ReferenceRFAccessCounter(SimulatorFrontend& frontend) :
+        frontend_(frontend) {
+        frontend_.eventHandler().registerListener(
+            SimulationEventHandler::SE_CYCLE_END, this);
+    }
+
+    virtual ~ReferenceRFAccessCounter() {
+        frontend_.eventHandler().unregisterListener(
+            SimulationEventHandler::SE_CYCLE_END, this);
+    }
+
+    virtual void handleEvent() {
+        const InstructionAddress address =
+            frontend_.lastExecutedInstruction();
+        const TTAProgram::Instruction& instruction =
+            frontend_.program().instructionAt(address);
+        const ExecutableInstruction& execInstruction =
+            frontend_.lastExecInstruction();
+        const bool conditional =
+            instruction.hasConditionalRegisterAccesses();
+        ++executions[address];
+
+        // register file name -> (writes, reads)
+        std::map<string, std::pair<std::size_t, std::size_t> > accesses;
+        for (int i = 0; i < instruction.moveCount(); ++i) {
+            if (conditional && execInstruction.moveSquashed(i)) {
+                continue;
+            }
+            const TTAProgram::Move& move = instruction.move(i);
+            if (move.source().isGPR()) {
+                ++accesses[move.source().registerFile().name()].second;
+            }
+            if (move.destination().isGPR()) {
+                ++accesses[move.destination().registerFile().name()].first;
+            }
+        }
+
+        RFAccessTracker::ConcurrentRFAccessIndex& counts =
+            conditional ? conditionalAccesses : unconditionalAccesses;
+        for (std::map<string, std::pair<std::size_t, std::size_t> >::
+                 const_iterator i = accesses.begin();
+             i != accesses.end(); ++i) {
+            ++counts[boost::make_tuple(
+                    i->first, i->second.first, i->second.second)];
+        }
+    }
+
+    /// Total accesses of both the conditional and the unconditional ones.
+    RFAccessTracker::ConcurrentRFAccessIndex totalAccesses() const {
+        RFAccessTracker::ConcurrentRFAccessIndex total =
+            unconditionalAccesses;
+        for (RFAccessTracker::ConcurrentRFAccessIndex::const_iterator i =
+                 conditionalAccesses.begin();
+             i != conditionalAccesses.end(); ++i) {
+            total[i->first] += i->second;
+        }
+        return total;
+    }
+
+    /// Cycles of the instructions with conditional register file accesses.
+    RFAccessTracker::ConcurrentRFAccessIndex conditionalAccesses;
+    /// Cycles of the other instructions.
+    RFAccessTracker::ConcurrentRFAccessIndex unconditionalAccesses;
+    /// Execution counts of the instructions.
+    std::map<InstructionAddress, ClockCycleCount> executions;
+
+private:
+    SimulatorFrontend& frontend_;
+};
+
+class RFAccessTrackerTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testConcurrentAccessesMatchReference();
+    void testConcurrentAccessesMatchReferenceLazily();
+
+private:
+    void simulate(bool lazy);
+};
+
+/// The machine the program is scheduled for.
+const string MACHINE = "data/3_bus_reduced_connectivity_shortimms.adf";
+
+/// A scheduled program.
+const string PROGRAM = "data/3_bus_reduced_connectivity_shortimms.tpef";
+
+/// The trace database the RF accesses are saved to.
+const string TRACE_DB = "data/rf_access_test.trace";
+
+/// The cycle the simulation is stopped at before resuming it.
+const double STOP_CYCLE = 100;
+
+/**
+ * Called before each test.
+ */
+void
+RFAccessTrackerTest::setUp() {
+}
+
+
+/**
+ * Called after each test.
+ */
+void
+RFAccessTrackerTest::tearDown() {
+    FileSystem::removeFileOrDirectory(TRACE_DB);
+}
+
+/**
+ * Simulates the test program with the RF access tracking enabled.
+ *
+ * The simulation is stopped once in the middle and resumed. Each time it
+ * stops, the concurrent RF accesses and the instruction execution counts
+ * must equal the ones collected cycle by cycle.
+ *
+ * @param lazy True if the instructions are to be built lazily.
+ */
+void
+RFAccessTrackerTest::simulate(bool lazy) {
+
+    SimulatorFrontend frontend;
+    frontend.setLazyInstructionBuilding(lazy);
+    frontend.setRFAccessTracing(true);
+    frontend.setTraceDBFileName(TRACE_DB);
+    frontend.loadMachine(MACHINE);
+    frontend.loadProgram(PROGRAM);
+
+    {
+        ReferenceRFAccessCounter reference(frontend);
+
+        frontend.step(STOP_CYCLE);
+        TS_ASSERT(!frontend.hasSimulationEnded());
+        TS_ASSERT(!reference.unconditionalAccesses.empty());
+        TS_ASSERT(
+            frontend.rfAccessTracker().accessDataBase() ==
+            reference.totalAccesses());
+
+        frontend.run();
+        TS_ASSERT(frontend.hasSimulationEnded());
+        TS_ASSERT(
+            frontend.rfAccessTracker().accessDataBase() ==
+            reference.totalAccesses());
+
+        const RFAccessTracker::ConcurrentRFAccessIndex total =
+            reference.totalAccesses();
+        for (RFAccessTracker::ConcurrentRFAccessIndex::const_iterator i =
+                 total.begin(); i != total.end(); ++i) {
+            TS_ASSERT_EQUALS(
+                frontend.rfAccessTracker().concurrentRegisterFileAccessCount(
+                    i->first.get<0>(), i->first.get<1>(),
+                    i->first.get<2>()), i->second);
+        }
+
+        ClockCycleCount cycles = 0;
+        for (std::map<InstructionAddress, ClockCycleCount>::const_iterator i =
+                 reference.executions.begin();
+             i != reference.executions.end(); ++i) {
+            TS_ASSERT_EQUALS(
+                frontend.executableInstructionAt(i->first).executionCount(),
+                i->second);
+            cycles += i->second;
+        }
+        TS_ASSERT_EQUALS(cycles, frontend.cycleCount());
+    }
+}
+
+/**
+ * Tests that the concurrent RF accesses are counted like before caching
+ * the accesses of the instructions.
+ */
+void
+RFAccessTrackerTest::testConcurrentAccessesMatchReference() {
+    simulate(false);
+}
+
+/**
+ * Tests the same with the instructions built on their first execution,
+ * when the never executed instructions have no execution counts.
+ */
+void
+RFAccessTrackerTest::testConcurrentAccessesMatchReferenceLazily() {
+    simulate(true);
+}
+
+#endif
@@ -0,0 +1,229 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimProgramBuilderTest.hh
+ *
+ * A test suite for the eager and lazy instruction building of
+ * SimProgramBuilder.
+ *
+ * @note rating: red
+ */
+
+#ifndef SIM_PROGRAM_BUILDER_TEST_HH
+#define SIM_PROGRAM_BUILDER_TEST_HH
+
+#include <TestSuite.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SimulatorFrontend.hh"
+#include "Machine.hh"
+#include "Bus.hh"
+#include "RegisterFile.hh"
+#include "Program.hh"
+#include "Instruction.hh"
+#include "Move.hh"
+#include "Terminal.hh"
+#include "TerminalImmediate.hh"
+#include "Address.hh"
+#include "SimValue.hh"
+#include "Exception.hh"
+
+using std::string;
+using namespace TTAMachine;
+using namespace TTAProgram;
+
+class SimProgramBuilderTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testLazyBuildingMatchesEager();
+    void testIllegalProgram();
+
+private:
+    void simulate(
+        bool lazy, std::vector<InstructionAddress>& trace,
+        std::vector<string>& registers, ClockCycleCount& cycles);
+    Program* illegalProgram(const Machine& machine, Bus& unknownBus);
+};
+
+/// The machine the program is scheduled for.
+const string MACHINE = "data/3_bus_reduced_connectivity_shortimms.adf";
+
+/// A scheduled program.
+const string PROGRAM = "data/3_bus_reduced_connectivity_shortimms.tpef";
+
+/// Maximum number of simulated cycles.
+const int MAX_CYCLES = 20000;
+
+/**
+ * Called before each test.
+ */
+void
+SimProgramBuilderTest::setUp() {
+}
+
+
+/**
+ * Called after each test.
+ */
+void
+SimProgramBuilderTest::tearDown() {
+}
+
+/**
+ * Simulates the test program cycle by cycle.
+ *
+ * @param lazy True if the instructions are to be built lazily.
+ * @param trace The program counters of the simulated cycles.
+ * @param registers The contents of the register files in the end.
+ * @param cycles The count of simulated cycles.
+ */
+void
+SimProgramBuilderTest::simulate(
+    bool lazy, std::vector<InstructionAddress>& trace,
+    std::vector<string>& registers, ClockCycleCount& cycles) {
+
+    SimulatorFrontend frontend;
+    frontend.setLazyInstructionBuilding(lazy);
+    frontend.loadMachine(MACHINE);
+    frontend.loadProgram(PROGRAM);
+
+    for (int i = 0; i < MAX_CYCLES && !frontend.hasSimulationEnded(); ++i) {
+        trace.push_back(frontend.programCounter());
+        frontend.step(1);
+    }
+    TS_ASSERT_EQUALS(
+        frontend.programErrorReportCount(SimulatorFrontend::RES_FATAL), 0u);
+
+    const Machine::RegisterFileNavigator rfNav =
+        frontend.machine().registerFileNavigator();
+    for (int i = 0; i < rfNav.count(); ++i) {
+        registers.push_back(
+            frontend.registerFileValue(rfNav.item(i)->name()));
+    }
+    cycles = frontend.cycleCount();
+}
+
+/**
+ * Tests that the lazily built instructions simulate exactly like the ones
+ * built when the program is loaded.
+ */
+void
+SimProgramBuilderTest::testLazyBuildingMatchesEager() {
+
+    std::vector<InstructionAddress> eagerTrace;
+    std::vector<string> eagerRegisters;
+    ClockCycleCount eagerCycles = 0;
+    simulate(false, eagerTrace, eagerRegisters, eagerCycles);
+
+    std::vector<InstructionAddress> lazyTrace;
+    std::vector<string> lazyRegisters;
+    ClockCycleCount lazyCycles = 0;
+    simulate(true, lazyTrace, lazyRegisters, lazyCycles);
+
+    TS_ASSERT(eagerCycles > 0);
+    TS_ASSERT_EQUALS(lazyCycles, eagerCycles);
+    TS_ASSERT(lazyTrace == eagerTrace);
+    TS_ASSERT_EQUALS(lazyRegisters.size(), eagerRegisters.size());
+    TS_ASSERT(lazyRegisters == eagerRegisters);
+}
+
+/**
+ * Loads the test program and makes its first instruction illegal.
+ *
+ * A move that uses a bus the machine does not have is added to the
+ * instruction.
+ *
+ * @param machine The machine the program is loaded for.
+ * @param unknownBus A bus that is not in the machine.
+ * @return The program, owned by the caller.
+ */
+Program*
+SimProgramBuilderTest::illegalProgram(
+    const Machine& machine, Bus& unknownBus) {
+
+    Program* program = Program::loadFromTPEF(PROGRAM, machine);
+    Instruction& first =
+        program->instructionAt(program->startAddress().location());
+
+    Instruction* withMove = &first;
+    for (int i = 0; withMove->moveCount() == 0; ++i) {
+        withMove = &program->instructionAt(
+            program->startAddress().location() + i);
+    }
+    first.addMove(
+        std::make_shared<Move>(
+            new TerminalImmediate(SimValue(0, unknownBus.width())),
+            withMove->move(0).destination().copy(), unknownBus));
+    return program;
+}
+
+/**
+ * Tests that an illegal program is rejected when it is loaded, also when
+ * the instructions are built lazily.
+ */
+void
+SimProgramBuilderTest::testIllegalProgram() {
+
+    Bus unknownBus("no_such_bus", 32, 32, Machine::ZERO);
+    // the programs must outlive the simulators
+    std::unique_ptr<Program> eagerProgram;
+    std::unique_ptr<Program> lazyProgram;
+
+    SimulatorFrontend eager;
+    eager.setLazyInstructionBuilding(false);
+    eager.loadMachine(MACHINE);
+    eagerProgram.reset(illegalProgram(eager.machine(), unknownBus));
+    bool rejected = false;
+    try {
+        eager.loadProgram(*eagerProgram);
+    } catch (const Exception&) {
+        rejected = true;
+    }
+    TS_ASSERT(rejected);
+
+    SimulatorFrontend lazy;
+    TS_ASSERT(lazy.lazyInstructionBuilding());
+    lazy.loadMachine(MACHINE);
+    lazyProgram.reset(illegalProgram(lazy.machine(), unknownBus));
+    rejected = false;
+    try {
+        lazy.loadProgram(*lazyProgram);
+    } catch (const IllegalProgram& e) {
+        rejected = true;
+        TS_ASSERT(
+            e.errorMessage().find("Error while processing instruction") !=
+            string::npos);
+    } catch (const Exception&) {
+        rejected = true;
+    }
+    TS_ASSERT(rejected);
+    TS_ASSERT_EQUALS(
+        lazy.programErrorReportCount(SimulatorFrontend::RES_FATAL), 0u);
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ExecutionTraceBenchMarkTest.hh
+ *
+ * A benchmark for writing long execution traces.
+ *
+ * @note rating: red
+ */
+
+#ifndef EXECUTION_TRACE_BENCHMARK_TEST_HH
+#define EXECUTION_TRACE_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+#include <string>
+#include <boost/timer.hpp>
+
+#include "ExecutionTrace.hh"
+#include "InstructionExecution.hh"
+#include "SimValue.hh"
+#include "Conversion.hh"
+#include "Application.hh"
+
+class ExecutionTraceBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testBatchedWriting();
+    void testTraceWriteThroughput();
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define TRACED_CYCLE_COUNT (4*1000000)
+/// Bus activity records written per cycle, i.e., the number of buses.
+#define BUSES 4
+
+/**
+ * Tests that the rows written in several batches are all found from the
+ * database, in order.
+ */
+void
+ExecutionTraceBenchMarkTest::testBatchedWriting() {
+
+    const std::string fileName = "data/batched.tdb";
+    const ClockCycleCount cycles = 10000;
+
+    ExecutionTrace* trace = ExecutionTrace::open(fileName);
+    trace->setWriteBatchSize(1000);
+    SimValue data(32);
+    for (ClockCycleCount cycle = 0; cycle < cycles; ++cycle) {
+        trace->addInstructionExecution(cycle, cycle % 100);
+        data = static_cast<UIntWord>(cycle);
+        trace->addBusActivity(cycle, "B1", "seg1", false, data);
+    }
+    trace->setSimulatedCycleCount(cycles);
+    delete trace;
+    trace = NULL;
+
+    trace = ExecutionTrace::open(fileName);
+    TS_ASSERT_EQUALS(trace->simulatedCycleCount(), cycles);
+
+    InstructionExecution& executions = trace->instructionExecutions();
+    ClockCycleCount count = 0;
+    while (true) {
+        TS_ASSERT_EQUALS(executions.cycle(), count);
+        TS_ASSERT_EQUALS(
+            executions.address(), static_cast<InstructionAddress>(count % 100));
+        ++count;
+        if (!executions.hasNext()) {
+            break;
+        }
+        executions.next();
+    }
+    TS_ASSERT_EQUALS(count, cycles);
+
+    // appending must not collide with the existing cycles
+    TS_ASSERT_THROWS(
+        trace->addInstructionExecution(cycles - 1, 0), IOException);
+    TS_ASSERT_THROWS_NOTHING(trace->addInstructionExecution(cycles, 0));
+    delete trace;
+    trace = NULL;
+}
+
+/**
+ * Measures the speed of writing a multi-million-cycle trace with an
+ * instruction execution and bus activity records in each cycle.
+ */
+void
+ExecutionTraceBenchMarkTest::testTraceWriteThroughput() {
+#ifdef BENCHMARKING_ENABLED
+    Application::logStream()
+        << "TRACED_CYCLE_COUNT " << TRACED_CYCLE_COUNT << std::endl
+        << "BUSES " << BUSES << std::endl;
+
+    ExecutionTrace* trace = ExecutionTrace::open("data/benchmark.tdb");
+    std::string busNames[BUSES];
+    for (int bus = 0; bus < BUSES; ++bus) {
+        busNames[bus] = "B" + Conversion::toString(bus);
+    }
+    SimValue data(32);
+    
+    boost::timer t;
+    for (ClockCycleCount cycle = 0; cycle < TRACED_CYCLE_COUNT; ++cycle) {
+        trace->addInstructionExecution(cycle, cycle % 4096);
+        data = static_cast<UIntWord>(cycle);
+        for (int bus = 0; bus < BUSES; ++bus) {
+            trace->addBusActivity(
+                cycle, busNames[bus], "seg1", bus % 2 == 1, data);
+        }
+    }
+    trace->setSimulatedCycleCount(TRACED_CYCLE_COUNT);
+    delete trace;
+    trace = NULL;
+    double elapsed = t.elapsed();
+
+    Application::logStream()
+        << "trace writing: " << TRACED_CYCLE_COUNT / (elapsed * 1e3) 
+        << " kcycles/s (" << elapsed << " s)" << std::endl;
+#endif
+}
+
+#endif
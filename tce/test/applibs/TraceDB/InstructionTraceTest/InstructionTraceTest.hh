@@ -0,0 +1,179 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionTraceTest.hh
+ *
+ * A test suite for InstructionTraceWriter and InstructionTraceReader.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_INSTRUCTION_TRACE_TEST_HH
+#define TTA_INSTRUCTION_TRACE_TEST_HH
+
+#include <TestSuite.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "InstructionTraceWriter.hh"
+#include "InstructionTraceReader.hh"
+#include "ExecutionTrace.hh"
+#include "InstructionExecution.hh"
+#include "FileSystem.hh"
+
+class InstructionTraceTest : public CxxTest::TestSuite {
+public:
+    void testEmptyTrace();
+    void testRoundTrip();
+    void testInvalidInput();
+    void testImportToTraceDB();
+};
+
+/**
+ * Tests reading a trace without records.
+ */
+void
+InstructionTraceTest::testEmptyTrace() {
+    const std::string fileName = "data/empty.itrace";
+    {
+        InstructionTraceWriter writer(fileName);
+    }
+    InstructionTraceReader reader(fileName);
+    TS_ASSERT_EQUALS(reader.hasNext(), false);
+    TS_ASSERT_THROWS(reader.cycle(), NotAvailable);
+    TS_ASSERT_THROWS(reader.address(), NotAvailable);
+    TS_ASSERT_THROWS(reader.next(), NotAvailable);
+}
+
+/**
+ * Tests that sequential execution, jumps in both directions and gaps in
+ * the cycles are read back as written, and that sequential execution is
+ * stored compactly.
+ */
+void
+InstructionTraceTest::testRoundTrip() {
+    const std::string fileName = "data/roundtrip.itrace";
+    std::vector<std::pair<ClockCycleCount, InstructionAddress> > records;
+
+    ClockCycleCount cycle = 0;
+    InstructionAddress address = 0;
+    for (int i = 0; i < 100000; ++i) {
+        records.push_back(std::make_pair(cycle, address));
+        ++cycle;
+        ++address;
+    }
+    records.push_back(std::make_pair(cycle + 1000000000LL, 0xfffffff0u));
+    records.push_back(std::make_pair(cycle + 1000000001LL, 3u));
+    records.push_back(std::make_pair(cycle + 1000000002LL, 3u));
+
+    {
+        InstructionTraceWriter writer(fileName);
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            writer.addInstructionExecution(
+                records[i].first, records[i].second);
+        }
+        TS_ASSERT_THROWS(
+            writer.addInstructionExecution(records.back().first, 0),
+            InvalidData);
+    }
+
+    // two bytes per sequentially executed cycle
+    TS_ASSERT_LESS_THAN(
+        FileSystem::sizeInBytes(FileSystem::absolutePathOf(fileName)),
+        2 * records.size() + 64);
+
+    InstructionTraceReader reader(fileName);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        TS_ASSERT_EQUALS(reader.cycle(), records[i].first);
+        TS_ASSERT_EQUALS(reader.address(), records[i].second);
+        if (i + 1 < records.size()) {
+            TS_ASSERT(reader.hasNext());
+            reader.next();
+        }
+    }
+    TS_ASSERT_EQUALS(reader.hasNext(), false);
+    TS_ASSERT_THROWS(reader.next(), NotAvailable);
+}
+
+/**
+ * Tests that files which are not instruction traces are rejected.
+ */
+void
+InstructionTraceTest::testInvalidInput() {
+    TS_ASSERT_THROWS(
+        InstructionTraceReader("data/nonexisting.itrace"), IOException);
+    TS_ASSERT_THROWS(InstructionTraceReader("Makefile"), IOException);
+}
+
+/**
+ * Tests that the instruction_execution table of the trace database is
+ * filled from the trace, also while the trace is still being written.
+ */
+void
+InstructionTraceTest::testImportToTraceDB() {
+    const std::string dbFileName = "data/import.tdb";
+    FileSystem::removeFileOrDirectory(dbFileName);
+
+    ExecutionTrace* traceDB = ExecutionTrace::open(dbFileName);
+    InstructionTraceWriter* writer =
+        new InstructionTraceWriter(traceDB->instructionTraceFileName());
+    TS_ASSERT_EQUALS(traceDB->instructionExecutions().hasNext(), false);
+
+    writer->addInstructionExecution(0, 5);
+    writer->addInstructionExecution(1, 6);
+    writer->flush();
+    InstructionExecution& first = traceDB->instructionExecutions();
+    TS_ASSERT_EQUALS(first.cycle(), 0);
+    TS_ASSERT_EQUALS(first.address(), 5u);
+    first.next();
+    TS_ASSERT_EQUALS(first.cycle(), 1);
+    TS_ASSERT_EQUALS(first.hasNext(), false);
+
+    // the imported records are not imported again
+    writer->addInstructionExecution(4, 2);
+    delete writer;
+    InstructionExecution& all = traceDB->instructionExecutions();
+    all.next();
+    all.next();
+    TS_ASSERT_EQUALS(all.cycle(), 4);
+    TS_ASSERT_EQUALS(all.address(), 2u);
+    TS_ASSERT_EQUALS(all.hasNext(), false);
+    delete traceDB;
+
+    // neither when the database is reopened
+    traceDB = ExecutionTrace::open(dbFileName);
+    InstructionExecution& reopened = traceDB->instructionExecutions();
+    reopened.next();
+    reopened.next();
+    TS_ASSERT_EQUALS(reopened.hasNext(), false);
+    delete traceDB;
+
+    FileSystem::removeFileOrDirectory(dbFileName + ".itrace");
+    FileSystem::removeFileOrDirectory(dbFileName + ".calls");
+    FileSystem::removeFileOrDirectory(dbFileName + ".profile");
+    FileSystem::removeFileOrDirectory(dbFileName);
+}
+
+#endif
@@ -74,6 +74,7 @@ const string HDB_TO_CREATE_6 = "data" + DS + "newHDB6.hdb";
 const string HDB_TO_CREATE_7 = "data" + DS + "newHDB7.hdb";
 const string HDB_TO_CREATE_8 = "data" + DS + "newHDB8.hdb";
 const string HDB_TO_CREATE_9 = "data" + DS + "newHDB9.hdb";
+const string HDB_TO_CREATE_10 = "data" + DS + "newHDB10.hdb";
 const string OLD_HDB_1 = "data" + DS + "oldHDB1.hdb";
 const string OLD_HDB_2 = "data" + DS + "oldHDB2.hdb";
 const string TMP_HDB_1 = "data" + DS + "tmp_1.hdb";
@@ -102,6 +103,7 @@ public:
     void testGettingCostData();
     void testFUArchitectureMatching();
     void testRFArchitectureMatching();
+    void testSnapshotQueries();
     void testFUArchitectureIDbyOperationSet();
     void testBackwardCompatibility();
     void testNoLeaks();
@@ -696,6 +698,58 @@ HDBManagerTest::testRFArchitectureMatching() {
     delete rfArch;
 }
 
+/**
+ * Tests that the snapshot answers the entry queries like the HDB does.
+ */
+void
+HDBManagerTest::testSnapshotQueries() {
+
+    FunctionUnit* fu1 = new FunctionUnit("fu1");
+    FUPort* o1Port = new FUPort("o1", 16, *fu1, false, false);
+    FUPort* t1Port = new FUPort("t1", 16, *fu1, true, true);
+    HWOperation* op1 = new HWOperation("op1", *fu1);
+    op1->bindPort(2, *o1Port);
+    op1->bindPort(1, *t1Port);
+    op1->pipeline()->addPortRead(1, 0, 1);
+    op1->pipeline()->addPortWrite(2, 2, 1);
+    FUArchitecture* fuArch = new FUArchitecture(fu1);
+    RFArchitecture* rfArch = new RFArchitecture(2, 2, 0, 2, 2, 1, true, 0);
+    rfArch->setWidth(32);
+
+    FileSystem::removeFileOrDirectory(HDB_TO_CREATE_10);
+    CachedHDBManager& manager = CachedHDBManager::createNew(
+        HDB_TO_CREATE_10);
+    RowID fuEntryID = manager.addFUEntry();
+    manager.setArchitectureForFU(
+        fuEntryID, manager.addFUArchitecture(*fuArch));
+    RowID rfEntryID = manager.addRFEntry();
+    manager.setArchitectureForRF(
+        rfEntryID, manager.addRFArchitecture(*rfArch));
+
+    std::set<RowID> fuEntries = manager.fuEntriesByArchitecture(*fu1);
+    std::set<RowID> rfEntries = manager.rfEntriesByArchitecture(
+        2, 2, 0, 1, 1, 1, true, 0, 32, 16);
+    TS_ASSERT(AssocTools::containsKey(fuEntries, fuEntryID));
+    TS_ASSERT(AssocTools::containsKey(rfEntries, rfEntryID));
+
+    manager.setSnapshotEnabled(true);
+    TS_ASSERT(manager.fuEntriesByArchitecture(*fu1) == fuEntries);
+    TS_ASSERT(
+        manager.rfEntriesByArchitecture(
+            2, 2, 0, 1, 1, 1, true, 0, 32, 16) == rfEntries);
+    TS_ASSERT(
+        manager.rfEntriesByArchitecture(2, 2, 0, 2, 2, 2, true, 1).empty());
+    TS_ASSERT(
+        manager.rfEntriesByArchitecture(2, 2, 0, 1, 1, 1, false, 0, 16)
+        .empty());
+    TS_ASSERT(
+        manager.rfEntriesByArchitecture(2, 1, 0, 1, 1, 1, false).empty());
+    manager.setSnapshotEnabled(false);
+
+    delete fuArch;
+    delete rfArch;
+}
+
 /**
  * Test getting fuArchitectures base of operation set.
  */
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityOracleTest.hh
+ *
+ * A test suite for MachineConnectivityOracle.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_MACHINE_CONNECTIVITY_ORACLE_TEST_HH
+#define TTA_MACHINE_CONNECTIVITY_ORACLE_TEST_HH
+
+#include <TestSuite.h>
+
+#include "MachineConnectivityOracle.hh"
+#include "MachineConnectivityCheck.hh"
+#include "Machine.hh"
+#include "Bus.hh"
+#include "Segment.hh"
+#include "Socket.hh"
+#include "RegisterFile.hh"
+#include "RFPort.hh"
+
+using namespace TTAMachine;
+
+/**
+ * Class that tests MachineConnectivityOracle.
+ */
+class MachineConnectivityOracleTest : public CxxTest::TestSuite {
+public:
+    void testConnections();
+    void testInvalidation();
+
+private:
+    /// Adds a register file with one read and one write port.
+    RegisterFile* addRF(Machine& mach, const std::string& name) {
+        RegisterFile* rf = new RegisterFile(
+            name, 4, 32, 1, 1, 0, RegisterFile::NORMAL);
+        new RFPort("r", *rf);
+        new RFPort("w", *rf);
+        mach.addRegisterFile(*rf);
+        return rf;
+    }
+
+    /// Connects a port to a bus through a new socket.
+    Socket* connect(
+        Machine& mach, Port& port, Bus& bus, Socket::Direction direction,
+        const std::string& name) {
+        Socket* socket = new Socket(name);
+        mach.addSocket(*socket);
+        socket->attachBus(*bus.segment(0));
+        socket->setDirection(direction);
+        port.attachSocket(*socket);
+        return socket;
+    }
+};
+
+/**
+ * Tests the bus sets of ports and units.
+ */
+void
+MachineConnectivityOracleTest::testConnections() {
+
+    Machine mach;
+    Bus* bus0 = new Bus("b0", 32, 32, Machine::ZERO);
+    new Segment("seg", *bus0);
+    mach.addBus(*bus0);
+    Bus* bus1 = new Bus("b1", 32, 32, Machine::ZERO);
+    new Segment("seg", *bus1);
+    mach.addBus(*bus1);
+
+    RegisterFile* rf0 = addRF(mach, "rf0");
+    RegisterFile* rf1 = addRF(mach, "rf1");
+    connect(mach, *rf0->port("r"), *bus0, Socket::OUTPUT, "rf0r");
+    connect(mach, *rf1->port("w"), *bus0, Socket::INPUT, "rf1w");
+    connect(mach, *rf1->port("r"), *bus1, Socket::OUTPUT, "rf1r");
+
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        MachineConnectivityOracle::oracle(mach);
+    TS_ASSERT_EQUALS(oracle->busCount(), 2);
+    TS_ASSERT_EQUALS(&oracle->bus(1), bus1);
+    TS_ASSERT(oracle->isUpToDate());
+
+    TS_ASSERT(oracle->shareBus(
+        oracle->destinationBuses(*rf0->port("r")),
+        oracle->sourceBuses(*rf1->port("w"))));
+    TS_ASSERT(!oracle->shareBus(
+        oracle->destinationBuses(*rf1), oracle->sourceBuses(*rf0)));
+
+    std::vector<const Bus*> shared = oracle->sharedBuses(
+        oracle->destinationBuses(*rf0), oracle->sourceBuses(*rf1));
+    TS_ASSERT_EQUALS(shared.size(), 1u);
+    TS_ASSERT_EQUALS(shared.at(0), bus0);
+    TS_ASSERT_EQUALS(oracle->buses(oracle->destinationBuses(*rf1)).size(), 1u);
+
+    // the same oracle serves repeated queries
+    TS_ASSERT_EQUALS(MachineConnectivityOracle::oracle(mach), oracle);
+
+    TS_ASSERT(MachineConnectivityCheck::isConnected(*rf0, *rf1));
+    TS_ASSERT(!MachineConnectivityCheck::isConnected(*rf1, *rf0));
+    TS_ASSERT(MachineConnectivityCheck::isConnected(
+                  *rf0->port("r"), *rf1->port("w")));
+}
+
+/**
+ * Tests that changes to the machine are seen by the oracle.
+ */
+void
+MachineConnectivityOracleTest::testInvalidation() {
+
+    Machine mach;
+    Bus* bus = new Bus("b0", 32, 32, Machine::ZERO);
+    new Segment("seg", *bus);
+    mach.addBus(*bus);
+    RegisterFile* rf0 = addRF(mach, "rf0");
+    RegisterFile* rf1 = addRF(mach, "rf1");
+    connect(mach, *rf0->port("r"), *bus, Socket::OUTPUT, "rf0r");
+    TS_ASSERT(!MachineConnectivityCheck::isConnected(*rf0, *rf1));
+
+    std::shared_ptr<const MachineConnectivityOracle> oracle =
+        MachineConnectivityOracle::oracle(mach);
+    Socket* socket = connect(mach, *rf1->port("w"), *bus, Socket::INPUT,
+                             "rf1w");
+    TS_ASSERT(!oracle->isUpToDate());
+    TS_ASSERT(MachineConnectivityCheck::isConnected(*rf0, *rf1));
+
+    rf1->port("w")->detachSocket(*socket);
+    TS_ASSERT(!MachineConnectivityCheck::isConnected(*rf0, *rf1));
+
+    rf1->port("w")->attachSocket(*socket);
+    TS_ASSERT(MachineConnectivityCheck::isConnected(*rf0, *rf1));
+    socket->detachBus(*bus);
+    TS_ASSERT(!MachineConnectivityCheck::isConnected(*rf0, *rf1));
+}
+
+#endif
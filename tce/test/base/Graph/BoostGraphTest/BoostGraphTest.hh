@@ -51,6 +51,7 @@ public:
     
     void testRootNodeFinding();
     void testEdgeMoving();
+    void testPathCache();
 
 private:
     typedef BoostGraph<GraphNode, GraphEdge> TestGraph;
@@ -167,4 +168,50 @@ BoostGraphTest::testEdgeMoving() {
     TS_ASSERT_EQUALS(testGraph_.outDegree(*node0_), 3);
 }
 
+/**
+ * Test that hasPath() answers stay correct while the reachability index
+ * built by findAllPaths() is updated and dropped.
+ */
+void
+BoostGraphTest::testPathCache() {
+
+    GraphNode nodeA(0);
+    GraphNode nodeB(1);
+    GraphNode nodeC(2);
+    GraphNode nodeD(3);
+    GraphNode nodeE(4);
+    TestGraph graph;
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+    graph.connectNodes(nodeA, nodeB, *new GraphEdge);
+    graph.connectNodes(nodeB, nodeC, *new GraphEdge);
+
+    graph.findAllPaths();
+    TS_ASSERT(graph.hasPath(nodeA, nodeC));
+    TS_ASSERT(!graph.hasPath(nodeC, nodeA));
+    TS_ASSERT(!graph.hasPath(nodeA, nodeD));
+
+    // the index is extended by added nodes and edges
+    GraphEdge* edgeCD = new GraphEdge;
+    graph.connectNodes(nodeC, nodeD, *edgeCD);
+    graph.addNode(nodeE);
+    graph.connectNodes(nodeD, nodeE, *new GraphEdge);
+    TS_ASSERT(graph.hasPath(nodeA, nodeE));
+    TS_ASSERT(graph.hasPath(nodeB, nodeD));
+    TS_ASSERT(!graph.hasPath(nodeE, nodeA));
+
+    // and dropped when an edge is removed
+    graph.removeEdge(*edgeCD);
+    TS_ASSERT(!graph.hasPath(nodeA, nodeE));
+    TS_ASSERT(graph.hasPath(nodeA, nodeC));
+    TS_ASSERT(graph.hasPath(nodeD, nodeE));
+
+    graph.findAllPaths();
+    TS_ASSERT(!graph.hasPath(nodeA, nodeE));
+    TS_ASSERT(graph.hasPath(nodeD, nodeE));
+}
+
 #endif
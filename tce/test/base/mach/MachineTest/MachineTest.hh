@@ -47,6 +47,9 @@
 #include "AddressSpace.hh"
 #include "Port.hh"
 #include "FUPort.hh"
+#include "HWOperation.hh"
+#include "ExecutionPipeline.hh"
+#include "PipelineElement.hh"
 #include "ControlUnit.hh"
 #include "InstructionTemplate.hh"
 #include "Exception.hh"
@@ -70,6 +73,7 @@ public:
     void testAddAndDeleteAddressSpace();
     void testAddingFUAndGCUOfSameName();
     void testSaveAndLoadState();
+    void testFingerprint();
 
 private:
     Machine* mach_;
@@ -501,4 +505,52 @@ MachineTest::testSaveAndLoadState() {
     delete loadedMach;
 }
 
+/**
+ * Tests that editing the units gives the machine a new fingerprint.
+ */
+void
+MachineTest::testFingerprint() {
+
+    Machine machine;
+    unsigned long fingerprint = machine.fingerprint();
+    TS_ASSERT(Machine().fingerprint() != fingerprint);
+
+    FunctionUnit* fu = new FunctionUnit("fu");
+    machine.addFunctionUnit(*fu);
+    TS_ASSERT(machine.fingerprint() != fingerprint);
+
+#define TS_ASSERT_CHANGES(EDIT__) \
+    fingerprint = machine.fingerprint(); \
+    EDIT__; \
+    TS_ASSERT(machine.fingerprint() != fingerprint);
+
+    FUPort* in = NULL;
+    FUPort* out = NULL;
+    HWOperation* add = NULL;
+    TS_ASSERT_CHANGES(in = new FUPort("in", 32, *fu, true, true));
+    TS_ASSERT_CHANGES(out = new FUPort("out", 32, *fu, false, false));
+    TS_ASSERT_CHANGES(add = new HWOperation("add", *fu));
+    TS_ASSERT_CHANGES(add->bindPort(1, *in));
+    TS_ASSERT_CHANGES(add->bindPort(2, *out));
+    TS_ASSERT_CHANGES(add->pipeline()->addPortRead(1, 0, 1));
+    TS_ASSERT_CHANGES(add->pipeline()->addPortWrite(2, 2, 1));
+    TS_ASSERT_CHANGES(add->pipeline()->addResourceUse("alu", 0, 2));
+    TS_ASSERT_CHANGES(fu->pipelineElement("alu")->setName("adder"));
+    TS_ASSERT_CHANGES(add->pipeline()->removeResourceUse("adder", 1));
+    TS_ASSERT_CHANGES(add->pipeline()->removeOperandUse(2, 2));
+    TS_ASSERT_CHANGES(add->unbindPort(*out));
+    TS_ASSERT_CHANGES(out->setNoRegister(true));
+    TS_ASSERT_CHANGES(add->setName("sub"));
+    TS_ASSERT_CHANGES(delete add);
+    TS_ASSERT_CHANGES(delete out);
+
+#undef TS_ASSERT_CHANGES
+
+    // reading does not change it
+    fingerprint = machine.fingerprint();
+    ObjectState* state = machine.saveState();
+    delete state;
+    TS_ASSERT_EQUALS(machine.fingerprint(), fingerprint);
+}
+
 #endif
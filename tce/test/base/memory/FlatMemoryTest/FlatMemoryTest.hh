@@ -0,0 +1,266 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/** 
+ * @file FlatMemoryTest.hh
+ * 
+ * A test suite for FlatMemory.
+ */
+
+#ifndef FLAT_MEMORY_TEST_HH
+#define FLAT_MEMORY_TEST_HH
+
+#include <TestSuite.h>
+
+#include "FlatMemory.hh"
+#include "Exception.hh"
+
+/**
+ * Class for testing FlatMemory.
+ */
+class FlatMemoryTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testBasicInterface();
+    void testEndianness();
+    void testRangeChecking();
+    void testFillWithZeros();
+    void testWriteOrder();
+    void testAddressSpaceSize();
+
+private:
+    /// Starting point of the memory.
+    static const Word START;
+    /// End point of the memory.
+    static const Word END;
+    /// Size of the minimum addressable unit (MAU).
+    static const Word MAUSIZE;
+};
+
+const Word FlatMemoryTest::START = 100;
+const Word FlatMemoryTest::END = 1000;
+const Word FlatMemoryTest::MAUSIZE = 8;
+
+
+/**
+ * Called before each test.
+ */
+void
+FlatMemoryTest::setUp() {
+}
+
+
+/**
+ * Called after each test.
+ */
+void
+FlatMemoryTest::tearDown() {
+}
+
+/**
+ * Tests that the basic interface works and that the writes are commited
+ * at the cycle advance.
+ */
+void
+FlatMemoryTest::testBasicInterface() {
+    
+    FlatMemory memory(START, END, MAUSIZE, false);
+
+    ULongWord result;
+
+    memory.read(200, 1, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        memory.write(100 + i, 1, 128);
+    }
+
+    // assert the data is not yet commited to the memory
+    for (std::size_t i = 0; i < 5; ++i) {
+        memory.read(100 + i, 1, result);
+        TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+    }
+
+    memory.advanceClock();
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        memory.read(100 + i, 1, result);
+        TS_ASSERT_EQUALS(result, static_cast<ULongWord>(128));
+    }
+
+    DoubleWord d = 123.123;
+    memory.write(100, d);
+    memory.advanceClock();
+
+    DoubleWord readDouble = 0.0;
+    memory.read(100, readDouble);
+    TS_ASSERT_EQUALS(readDouble, d);
+
+    FloatWord f = 1.5f;
+    memory.writeBE(200, f);
+    memory.advanceClock();
+
+    FloatWord readFloat = 0.0f;
+    memory.readBE(200, readFloat);
+    TS_ASSERT_EQUALS(readFloat, f);
+
+    // pending writes are dropped at reset
+    memory.write(300, 4, 0x11223344);
+    memory.reset();
+    memory.advanceClock();
+    memory.read(300, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+}
+
+/**
+ * Tests the byte order of the accesses of different widths.
+ */
+void
+FlatMemoryTest::testEndianness() {
+
+    FlatMemory memory(START, END, MAUSIZE, true);
+
+    ULongWord result;
+
+    memory.writeBE(100, 4, 0x11223344);
+    memory.writeLE(200, 2, 0xaabb);
+    memory.writeLE(300, 8, 0x0102030405060708ULL);
+    memory.writeBE(400, 3, 0xabcdef);
+    memory.advanceClock();
+
+    memory.readBE(100, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x11223344));
+    memory.readLE(100, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x44332211));
+    memory.readBE(100, 1, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x11));
+
+    memory.readBE(200, 2, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0xbbaa));
+
+    memory.read(300, 8, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x0102030405060708ULL));
+    memory.readLE(300, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x05060708));
+
+    memory.readLE(400, 3, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0xefcdab));
+
+    // direct writes are visible immediately
+    memory.writeDirectlyLE(500, 4, 0xdeadbeef);
+    memory.readLE(500, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0xdeadbeef));
+}
+
+/**
+ * Tests that accesses outside the address space are rejected.
+ */
+void
+FlatMemoryTest::testRangeChecking() {
+
+    FlatMemory memory(START, END, MAUSIZE, false);
+
+    ULongWord result;
+
+    TS_ASSERT_THROWS_NOTHING(memory.readBE(END - 3, 4, result));
+    TS_ASSERT_THROWS(memory.readBE(END - 2, 4, result), OutOfRange);
+    TS_ASSERT_THROWS(memory.readBE(START - 1, 1, result), OutOfRange);
+    TS_ASSERT_THROWS(memory.writeBE(END, 2, 0), OutOfRange);
+    TS_ASSERT_THROWS_NOTHING(memory.writeLE(END - 7, 8, 0));
+
+    TS_ASSERT_THROWS(FlatMemory(START, END, 16, false), OutOfRange);
+}
+
+/**
+ * Tests that the memory is cleared by fillWithZeros().
+ */
+void
+FlatMemoryTest::testFillWithZeros() {
+
+    FlatMemory memory(START, END, MAUSIZE, false);
+
+    ULongWord result;
+
+    memory.write(START, 4, 0xffffffff);
+    memory.write(END - 3, 4, 0xffffffff);
+    memory.advanceClock();
+    memory.fillWithZeros();
+
+    memory.read(START, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+    memory.read(END - 3, 4, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+}
+
+/**
+ * Tests that the writes of different widths issued on the same cycle are
+ * committed in the order they were issued.
+ */
+void
+FlatMemoryTest::testWriteOrder() {
+
+    FlatMemory memory(START, END, MAUSIZE, true);
+
+    ULongWord result;
+
+    // a write wider than 8 MAUs overwritten by a narrow one
+    memory.writeLE(300, 16, 0x0102030405060708ULL);
+    memory.writeLE(300, 1, 0xff);
+    // and the other way round
+    memory.writeLE(400, 1, 0xff);
+    memory.writeLE(400, 16, 0x0102030405060708ULL);
+    memory.advanceClock();
+
+    memory.readLE(300, 2, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x07ff));
+    memory.readLE(400, 2, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x0708));
+    memory.readLE(408, 8, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+
+    memory.writeBE(500, 16, 0x0102030405060708ULL);
+    memory.advanceClock();
+    memory.readBE(500, 8, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0));
+    memory.readBE(508, 8, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0x0102030405060708ULL));
+
+    TS_ASSERT_THROWS(memory.writeLE(END - 14, 16, 0), OutOfRange);
+}
+
+/**
+ * Tests that address ranges whose size cannot be represented are rejected.
+ */
+void
+FlatMemoryTest::testAddressSpaceSize() {
+
+    const ULongWord maxAddress = ~static_cast<ULongWord>(0);
+    TS_ASSERT_THROWS(
+        FlatMemory(0, maxAddress, MAUSIZE, false), OutOfRange);
+    TS_ASSERT_THROWS(
+        FlatMemory(END, START, MAUSIZE, false), OutOfRange);
+}
+
+#endif
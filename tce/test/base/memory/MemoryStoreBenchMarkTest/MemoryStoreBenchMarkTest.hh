@@ -0,0 +1,128 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MemoryStoreBenchMarkTest.hh
+ *
+ * A benchmark for the store throughput of the memory models.
+ *
+ * @note rating: red
+ */
+
+#ifndef MEMORY_STORE_BENCHMARK_TEST_HH
+#define MEMORY_STORE_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+#include <cfloat>
+#include <boost/timer.hpp>
+
+#include "Memory.hh"
+#include "IdealSRAM.hh"
+#include "FlatMemory.hh"
+#include "Application.hh"
+
+class MemoryStoreBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testRequestQueueGrowth();
+    void testStoreThroughput();
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define STORE_ROUNDS 3
+#define STORED_WORD_COUNT (50*1000000)
+/// Stores initiated per simulated cycle, i.e., the number of LSUs.
+#define STORES_PER_CYCLE 2
+#define MEMORY_SIZE (1024*1024)
+
+/**
+ * Tests that more stores than fit the preallocated request queue can be
+ * initiated in a cycle and that they are committed in order.
+ */
+void
+MemoryStoreBenchMarkTest::testRequestQueueGrowth() {
+
+    IdealSRAM memory(0, 1023, 8, false);
+    memory.setWriteRequestCapacity(2);
+
+    for (int round = 0; round < 3; ++round) {
+        for (ULongWord i = 0; i < 100; ++i) {
+            memory.write(i * 4, 4, i + round);
+        }
+        // overwrites the first store of the cycle
+        memory.write(0, 4, 0xcafe);
+        memory.advanceClock();
+
+        ULongWord result;
+        memory.read(0, 4, result);
+        TS_ASSERT_EQUALS(result, static_cast<ULongWord>(0xcafe));
+        for (ULongWord i = 1; i < 100; ++i) {
+            memory.read(i * 4, 4, result);
+            TS_ASSERT_EQUALS(result, i + round);
+        }
+    }
+}
+
+#define STORE_BENCHMARK(MEMORY__, WIDTH__) {                              \
+    double best = DBL_MAX;                                                \
+    for (int round = 0; round < STORE_ROUNDS; ++round) {                  \
+        MEMORY__ memory(0, MEMORY_SIZE - 1, 8, true);                     \
+        memory.setWriteRequestCapacity(STORES_PER_CYCLE);                 \
+        boost::timer t;                                                   \
+        for (ULongWord i = 0; i < STORED_WORD_COUNT; ++i) {               \
+            const ULongWord address =                                     \
+                (i * WIDTH__) & (MEMORY_SIZE - 1);                        \
+            memory.write(address, WIDTH__, i);                            \
+            if (i % STORES_PER_CYCLE == STORES_PER_CYCLE - 1) {           \
+                memory.advanceClock();                                    \
+            }                                                             \
+        }                                                                 \
+        double val = t.elapsed();                                         \
+        if (val < best)                                                   \
+            best = val;                                                   \
+    }                                                                     \
+    Application::logStream()                                              \
+        << #MEMORY__ << " " << WIDTH__ << " MAU stores: "                 \
+        << STORED_WORD_COUNT / (best * 1e6) << " Mstores/s" << std::endl; \
+}
+
+/**
+ * Measures the number of stores per second committed through the write
+ * request queue of the memory models.
+ */
+void
+MemoryStoreBenchMarkTest::testStoreThroughput() {
+#ifdef BENCHMARKING_ENABLED
+    Application::logStream()
+        << "STORE_ROUNDS " << STORE_ROUNDS << std::endl
+        << "STORED_WORD_COUNT " << STORED_WORD_COUNT << std::endl;
+
+    STORE_BENCHMARK(IdealSRAM, 1);
+    STORE_BENCHMARK(IdealSRAM, 4);
+    STORE_BENCHMARK(FlatMemory, 1);
+    STORE_BENCHMARK(FlatMemory, 4);
+    STORE_BENCHMARK(FlatMemory, 8);
+#endif
+}
+
+#endif
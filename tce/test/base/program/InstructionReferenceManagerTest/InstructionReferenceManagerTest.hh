@@ -0,0 +1,202 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file InstructionReferenceManagerTest.hh
+ *
+ * A test suite for InstructionReferenceManager.
+ *
+ * @note rating: red
+ */
+
+#ifndef INSTRUCTION_REFERENCE_MANAGER_TEST_HH
+#define INSTRUCTION_REFERENCE_MANAGER_TEST_HH
+
+#include <TestSuite.h>
+#include <thread>
+#include <vector>
+
+#include "Instruction.hh"
+#include "InstructionReference.hh"
+#include "InstructionReferenceManager.hh"
+
+using namespace TTAProgram;
+
+class InstructionReferenceManagerTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testReferenceCounting();
+    void testConcurrentReferences();
+
+private:
+    static void referenceTraffic(
+        InstructionReferenceManager& irm,
+        std::vector<Instruction*>& shared,
+        Instruction& own, Instruction& replacement);
+
+    /// Number of threads in the concurrent test, as with
+    /// --scheduler-jobs=4.
+    static const int THREADS = 4;
+    /// Iterations per thread in the concurrent test.
+    static const int ITERATIONS = 20000;
+};
+
+
+/**
+ * Called before each test.
+ */
+void
+InstructionReferenceManagerTest::setUp() {
+}
+
+
+/**
+ * Called after each test.
+ */
+void
+InstructionReferenceManagerTest::tearDown() {
+}
+
+/**
+ * Tests that the references are counted and replaced correctly.
+ */
+void
+InstructionReferenceManagerTest::testReferenceCounting() {
+
+    InstructionReferenceManager irm;
+    Instruction insA;
+    Instruction insB;
+
+    TS_ASSERT(!irm.hasReference(insA));
+    {
+        InstructionReference refA = irm.createReference(insA);
+        InstructionReference copyA(refA);
+        TS_ASSERT_EQUALS(irm.referenceCount(insA), 2u);
+        TS_ASSERT_EQUALS(&copyA.instruction(), &insA);
+
+        InstructionReference refB = irm.createReference(insB);
+        copyA = refB;
+        TS_ASSERT_EQUALS(irm.referenceCount(insA), 1u);
+        TS_ASSERT_EQUALS(irm.referenceCount(insB), 2u);
+
+        // merges the references of insA to the ones of insB
+        irm.replace(insA, insB);
+        TS_ASSERT(!irm.hasReference(insA));
+        TS_ASSERT_EQUALS(irm.referenceCount(insB), 3u);
+        TS_ASSERT_EQUALS(&refA.instruction(), &insB);
+    }
+    TS_ASSERT(!irm.hasReference(insA));
+    TS_ASSERT(!irm.hasReference(insB));
+}
+
+/**
+ * Copies, assigns, destroys and replaces references of a program from
+ * one thread, like the scheduler of one procedure does.
+ *
+ * @param irm The reference manager of the program.
+ * @param shared Instructions referred to by all the threads, e.g., the
+ *               entries of called procedures.
+ * @param own Instruction referred to only by this thread.
+ * @param replacement Instruction own is replaced with in the end.
+ */
+void
+InstructionReferenceManagerTest::referenceTraffic(
+    InstructionReferenceManager& irm,
+    std::vector<Instruction*>& shared,
+    Instruction& own, Instruction& replacement) {
+
+    std::vector<InstructionReference> refs;
+    for (int i = 0; i < ITERATIONS; ++i) {
+        InstructionReference ref =
+            irm.createReference(*shared[i % shared.size()]);
+        InstructionReference ownRef = irm.createReference(own);
+        refs.push_back(ref);
+        refs.push_back(ownRef);
+        ownRef = ref;
+        if (refs.size() > 16) {
+            // destroys the references in the middle of the vector, and
+            // assigns the following ones to their places
+            refs.erase(refs.begin() + 3, refs.begin() + 11);
+        }
+    }
+    InstructionReference ownRef = irm.createReference(own);
+    InstructionReference replacementRef = irm.createReference(replacement);
+    irm.replace(own, replacement);
+}
+
+/**
+ * Tests that a reference manager can be used by many threads at once.
+ *
+ * This is the reference traffic of the parallel procedure scheduling of
+ * llvm-tce --scheduler-jobs: the procedures share the reference manager of
+ * the program, and their references may point to the same instructions.
+ */
+void
+InstructionReferenceManagerTest::testConcurrentReferences() {
+
+    InstructionReferenceManager irm;
+    std::vector<Instruction*> shared;
+    for (int i = 0; i < 3; ++i) {
+        shared.push_back(new Instruction());
+    }
+    std::vector<Instruction*> own;
+    std::vector<Instruction*> replacements;
+    for (int t = 0; t < THREADS; ++t) {
+        own.push_back(new Instruction());
+        replacements.push_back(new Instruction());
+    }
+
+    InstructionReference kept = irm.createReference(*shared[0]);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.push_back(
+            std::thread(
+                referenceTraffic, std::ref(irm), std::ref(shared),
+                std::ref(*own[t]), std::ref(*replacements[t])));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    TS_ASSERT_EQUALS(irm.referenceCount(*shared[0]), 1u);
+    TS_ASSERT(!irm.hasReference(*shared[1]));
+    TS_ASSERT(!irm.hasReference(*shared[2]));
+    for (int t = 0; t < THREADS; ++t) {
+        TS_ASSERT(!irm.hasReference(*own[t]));
+        TS_ASSERT(!irm.hasReference(*replacements[t]));
+    }
+    TS_ASSERT_EQUALS(&kept.instruction(), shared[0]);
+
+    for (std::size_t i = 0; i < shared.size(); ++i) {
+        delete shared[i];
+    }
+    for (int t = 0; t < THREADS; ++t) {
+        delete own[t];
+        delete replacements[t];
+    }
+}
+
+#endif
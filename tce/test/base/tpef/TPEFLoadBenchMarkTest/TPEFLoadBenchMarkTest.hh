@@ -0,0 +1,222 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file TPEFLoadBenchMarkTest.hh
+ *
+ * A benchmark for loading large TPEF binaries.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_TPEF_LOAD_BENCHMARK_TEST_HH
+#define TTA_TPEF_LOAD_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+#include <cstdio>
+#include <cfloat>
+#include <boost/timer.hpp>
+
+#include "Binary.hh"
+#include "BinaryStream.hh"
+#include "BinaryReader.hh"
+#include "TPEFWriter.hh"
+#include "Section.hh"
+#include "NullSection.hh"
+#include "StringSection.hh"
+#include "ASpaceSection.hh"
+#include "ASpaceElement.hh"
+#include "ResourceSection.hh"
+#include "ResourceElement.hh"
+#include "CodeSection.hh"
+#include "MoveElement.hh"
+#include "ImmediateElement.hh"
+#include "Application.hh"
+
+using namespace TPEF;
+
+class TPEFLoadBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testWriteAndLoad();
+    void testLoadSpeed();
+
+private:
+    static void generateBinary(
+        const std::string& fileName, unsigned int instructions);
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define LOAD_ROUNDS 3
+#define LOADED_INSTRUCTION_COUNT (1000*1000)
+
+/**
+ * Writes a binary with a single code section to the given file.
+ *
+ * Every instruction has one register to register move and every fourth
+ * one also an immediate.
+ *
+ * @param fileName The file to write.
+ * @param instructions Number of instructions to generate.
+ */
+void
+TPEFLoadBenchMarkTest::generateBinary(
+    const std::string& fileName, unsigned int instructions) {
+
+    Binary* binary = new Binary();
+    binary->setArch(Binary::FA_TTA_TUT);
+    binary->setType(Binary::FT_PARALLEL);
+
+    NullSection* nullSection = dynamic_cast<NullSection*>(
+        Section::createSection(Section::ST_NULL));
+    StringSection* strings = dynamic_cast<StringSection*>(
+        Section::createSection(Section::ST_STRTAB));
+    strings->addByte(0);
+    binary->setStrings(strings);
+    Chunk* noName = strings->chunk(0);
+
+    ASpaceSection* aSpaces = dynamic_cast<ASpaceSection*>(
+        Section::createSection(Section::ST_ADDRSP));
+    ASpaceElement* undefASpace = new ASpaceElement();
+    undefASpace->setName(noName);
+    aSpaces->setUndefinedASpace(undefASpace);
+    aSpaces->addElement(undefASpace);
+    ASpaceElement* instructionASpace = new ASpaceElement();
+    instructionASpace->setName(noName);
+    instructionASpace->setMAU(8);
+    instructionASpace->setAlign(1);
+    instructionASpace->setWordSize(4);
+    aSpaces->addElement(instructionASpace);
+
+    ResourceSection* resources = dynamic_cast<ResourceSection*>(
+        Section::createSection(Section::ST_MR));
+    ResourceElement* registerFile = new ResourceElement();
+    registerFile->setId(1);
+    registerFile->setType(ResourceElement::MRT_RF);
+    registerFile->setName(noName);
+    registerFile->setInfo(32);
+    resources->addElement(registerFile);
+
+    CodeSection* code = dynamic_cast<CodeSection*>(
+        Section::createSection(Section::ST_CODE));
+    code->setStartingAddress(0);
+    for (unsigned int i = 0; i < instructions; ++i) {
+        MoveElement* move = new MoveElement();
+        move->setBegin(true);
+        move->setBus(1);
+        move->setSourceType(MoveElement::MF_RF);
+        move->setSourceUnit(1);
+        move->setSourceIndex(i % 32);
+        move->setDestinationType(MoveElement::MF_RF);
+        move->setDestinationUnit(1);
+        move->setDestinationIndex((i + 1) % 32);
+        code->addElement(move);
+
+        if (i % 4 == 0) {
+            ImmediateElement* immediate = new ImmediateElement();
+            immediate->setDestinationUnit(0);
+            immediate->setDestinationIndex(i % 256);
+            immediate->setWord(i);
+            code->addElement(immediate);
+        }
+    }
+
+    Section* sections[] = { nullSection, aSpaces, strings, resources, code };
+    for (unsigned int i = 0; i < sizeof(sections) / sizeof(Section*); ++i) {
+        sections[i]->setName(noName);
+        sections[i]->setASpace(
+            sections[i] == code ? instructionASpace : undefASpace);
+        binary->addSection(sections[i]);
+    }
+    aSpaces->setLink(strings);
+    strings->setLink(nullSection);
+    resources->setLink(strings);
+    code->setLink(resources);
+
+    BinaryStream stream(fileName);
+    TPEFWriter::instance().writeBinary(stream, binary);
+    delete binary;
+}
+
+/**
+ * Tests that a generated binary is read back with all its instructions.
+ */
+void
+TPEFLoadBenchMarkTest::testWriteAndLoad() {
+    const std::string fileName = "data/generated.tpef";
+    const unsigned int instructions = 1000;
+    generateBinary(fileName, instructions);
+
+    BinaryStream stream(fileName);
+    Binary* binary = BinaryReader::readBinary(stream);
+    TS_ASSERT_EQUALS(binary->sectionCount(Section::ST_CODE), 1u);
+
+    CodeSection* code = dynamic_cast<CodeSection*>(
+        binary->section(Section::ST_CODE, 0));
+    TS_ASSERT_EQUALS(code->instructionCount(), instructions);
+
+    const MoveElement* move = dynamic_cast<const MoveElement*>(
+        code->element(code->instructionToSectionIndex(5)));
+    TS_ASSERT(move != NULL);
+    TS_ASSERT_EQUALS(move->sourceIndex(), 5);
+    TS_ASSERT_EQUALS(move->destinationIndex(), 6);
+
+    const ImmediateElement* immediate =
+        dynamic_cast<const ImmediateElement*>(
+            code->element(code->instructionToSectionIndex(8) + 1));
+    TS_ASSERT(immediate != NULL);
+    TS_ASSERT_EQUALS(immediate->word(), 8u);
+
+    delete binary;
+    std::remove(fileName.c_str());
+}
+
+/**
+ * Measures the time it takes to load a binary of LOADED_INSTRUCTION_COUNT
+ * instructions.
+ */
+void
+TPEFLoadBenchMarkTest::testLoadSpeed() {
+#ifdef BENCHMARKING_ENABLED
+    const std::string fileName = "data/generated.tpef";
+    generateBinary(fileName, LOADED_INSTRUCTION_COUNT);
+
+    double best = DBL_MAX;
+    for (int round = 0; round < LOAD_ROUNDS; ++round) {
+        boost::timer t;
+        BinaryStream stream(fileName);
+        Binary* binary = BinaryReader::readBinary(stream);
+        delete binary;
+        double val = t.elapsed();
+        if (val < best) {
+            best = val;
+        }
+    }
+    Application::logStream()
+        << "LOADED_INSTRUCTION_COUNT " << LOADED_INSTRUCTION_COUNT
+        << std::endl << "best load time: " << best << " s" << std::endl;
+    std::remove(fileName.c_str());
+#endif
+}
+
+#endif
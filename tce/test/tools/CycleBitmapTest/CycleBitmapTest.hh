@@ -0,0 +1,126 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CycleBitmapTest.hh
+ *
+ * A test suite for CycleBitmap.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_CYCLE_BITMAP_TEST_HH
+#define TTA_CYCLE_BITMAP_TEST_HH
+
+#include <TestSuite.h>
+#include <climits>
+#include "CycleBitmap.hh"
+
+/**
+ * Implements the tests needed to verify correct operation of CycleBitmap.
+ */
+class CycleBitmapTest : public CxxTest::TestSuite {
+public:
+    void testBasic();
+    void testNegativeIndices();
+    void testFarIndices();
+};
+
+/**
+ * Tests setting, resetting and clearing bits across word boundaries.
+ */
+void
+CycleBitmapTest::testBasic() {
+
+    CycleBitmap bitmap;
+    TS_ASSERT_EQUALS(bitmap.bitAt(0), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(1000), false);
+
+    bitmap.setBit(63, true);
+    bitmap.setBit(64, true);
+    bitmap.setBit(1000, true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(62), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(63), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(64), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(65), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(1000), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(100000), false);
+
+    bitmap.setBit(64, false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(63), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(64), false);
+
+    // resetting outside of the stored range is a no-op
+    bitmap.setBit(100000, false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(100000), false);
+
+    bitmap.clear();
+    TS_ASSERT_EQUALS(bitmap.bitAt(63), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(1000), false);
+}
+
+/**
+ * Tests that negative indices are independent of the positive ones.
+ */
+void
+CycleBitmapTest::testNegativeIndices() {
+
+    CycleBitmap bitmap;
+    bitmap.setBit(-1, true);
+    bitmap.setBit(-65, true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(-1), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(-65), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(-2), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(0), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(64), false);
+
+    bitmap.setBit(0, true);
+    bitmap.setBit(-1, false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(0), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(-1), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(-65), true);
+}
+
+/**
+ * Tests the indices near the start cycle of the bottom-up schedulers.
+ */
+void
+CycleBitmapTest::testFarIndices() {
+
+    const int start = INT_MAX / 1024;
+    CycleBitmap bitmap;
+    bitmap.setBit(start, true);
+    bitmap.setBit(start - 100, true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(start), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(start - 100), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(start - 1), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(0), false);
+    TS_ASSERT_EQUALS(bitmap.bitAt(-1), false);
+
+    bitmap.clear();
+    bitmap.setBit(5, true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(5), true);
+    TS_ASSERT_EQUALS(bitmap.bitAt(start), false);
+}
+
+#endif
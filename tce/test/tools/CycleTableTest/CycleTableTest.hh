@@ -0,0 +1,117 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CycleTableTest.hh
+ *
+ * A test suite for CycleTable.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_CYCLE_TABLE_TEST_HH
+#define TTA_CYCLE_TABLE_TEST_HH
+
+#include <TestSuite.h>
+#include <climits>
+#include "CycleTable.hh"
+
+/**
+ * Implements the tests needed to verify correct operation of CycleTable.
+ */
+class CycleTableTest : public CxxTest::TestSuite {
+public:
+    void testWindow();
+    void testGrowingBackwards();
+    void testClear();
+};
+
+/// The start cycle of the bottom-up schedulers.
+const int FAR_CYCLE = INT_MAX / 1024;
+
+/**
+ * Tests that the stored window starts from the first written index.
+ */
+void
+CycleTableTest::testWindow() {
+
+    CycleTable<int> table;
+    TS_ASSERT(table.empty());
+    TS_ASSERT_EQUALS(table[FAR_CYCLE], 0);
+
+    table.entry(FAR_CYCLE) = 1;
+    table.entry(FAR_CYCLE + 3) = 2;
+    TS_ASSERT(!table.empty());
+    TS_ASSERT_EQUALS(table.firstIndex(), FAR_CYCLE);
+    TS_ASSERT_EQUALS(table.endIndex(), FAR_CYCLE + 4);
+    TS_ASSERT_EQUALS(table[FAR_CYCLE], 1);
+    TS_ASSERT_EQUALS(table[FAR_CYCLE + 1], 0);
+    TS_ASSERT_EQUALS(table[FAR_CYCLE + 3], 2);
+    TS_ASSERT_EQUALS(table[FAR_CYCLE + 4], 0);
+    TS_ASSERT_EQUALS(table[0], 0);
+    TS_ASSERT(table.contains(FAR_CYCLE + 3));
+    TS_ASSERT(!table.contains(FAR_CYCLE - 1));
+    TS_ASSERT(!table.contains(0));
+}
+
+/**
+ * Tests filling the table from the large indices to the small ones.
+ */
+void
+CycleTableTest::testGrowingBackwards() {
+
+    CycleTable<int> table;
+    for (int i = 0; i < 1000; ++i) {
+        table.entry(FAR_CYCLE - i) = i;
+    }
+    TS_ASSERT(table.firstIndex() <= FAR_CYCLE - 999);
+    TS_ASSERT(table.firstIndex() > FAR_CYCLE - 2000);
+    TS_ASSERT_EQUALS(table.endIndex(), FAR_CYCLE + 1);
+    for (int i = 0; i < 1000; ++i) {
+        TS_ASSERT_EQUALS(table[FAR_CYCLE - i], i);
+    }
+
+    table.entry(-5) = 7;
+    TS_ASSERT_EQUALS(table[-5], 7);
+    TS_ASSERT_EQUALS(table[FAR_CYCLE - 999], 999);
+}
+
+/**
+ * Tests that the window starts again after clearing.
+ */
+void
+CycleTableTest::testClear() {
+
+    CycleTable<int> table;
+    table.entry(FAR_CYCLE) = 1;
+    table.clear();
+    TS_ASSERT(table.empty());
+    TS_ASSERT_EQUALS(table[FAR_CYCLE], 0);
+
+    table.entry(10) = 3;
+    TS_ASSERT_EQUALS(table.firstIndex(), 10);
+    TS_ASSERT_EQUALS(table.endIndex(), 11);
+    TS_ASSERT_EQUALS(table[10], 3);
+}
+
+#endif
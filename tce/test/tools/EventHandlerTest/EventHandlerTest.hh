@@ -96,10 +96,14 @@ EventHandlerTest::testRegisterListener() {
     bool checkRetval = false;
 
     // simple add and remove
+    TS_ASSERT(!informer_->hasListeners(defaultEvent_));
     checkRetval = informer_->registerListener(defaultEvent_, listener_);
     TS_ASSERT(checkRetval);
+    TS_ASSERT(informer_->hasListeners(defaultEvent_));
+    TS_ASSERT(!informer_->hasListeners(defaultEvent_ + 1));
     checkRetval = informer_->unregisterListener(defaultEvent_, listener_);
     TS_ASSERT(checkRetval);
+    TS_ASSERT(!informer_->hasListeners(defaultEvent_));
 
     // same listener added several times
     checkRetval = informer_->registerListener(defaultEvent_, listener_);
@@ -114,6 +118,7 @@ EventHandlerTest::testRegisterListener() {
     TS_ASSERT(checkRetval);
     checkRetval = informer_->unregisterListener(defaultEvent_, listener_);
     TS_ASSERT(checkRetval);
+    TS_ASSERT(!informer_->hasListeners(defaultEvent_));
 }
 
 #endif
@@ -65,6 +65,7 @@ public:
     void testFindFileInSearchPaths();
     void testDirectoryContents();
     void testRelativeDir();
+    void testCreateTempDirectory();
 
 private:
     /// Existing, writable file name.
@@ -360,5 +361,30 @@ FileSystemTest::testRelativeDir() {
     TS_ASSERT_EQUALS(filePath, relPartOfPath);
 }
 
+/**
+ * Tests that the temporary directories are unique and that the missing
+ * directories of their path are created.
+ */
+void
+FileSystemTest::testCreateTempDirectory() {
+    const string DS = FileSystem::DIRECTORY_SEPARATOR;
+    const string parent =
+        FileSystem::currentWorkingDir() + DS + "tmp_parent";
+    const string path = parent + DS + "missing";
+    TS_ASSERT(!FileSystem::fileExists(parent));
+
+    const string first = FileSystem::createTempDirectory(path);
+    const string second = FileSystem::createTempDirectory(path);
+    TS_ASSERT(first != "");
+    TS_ASSERT(second != "");
+    TS_ASSERT(first != second);
+    TS_ASSERT(FileSystem::fileIsDirectory(first));
+    TS_ASSERT(FileSystem::fileIsDirectory(second));
+    TS_ASSERT_EQUALS(FileSystem::directoryOfPath(first), path);
+
+    FileSystem::removeFileOrDirectory(parent);
+    TS_ASSERT(!FileSystem::fileExists(parent));
+}
+
 
 #endif
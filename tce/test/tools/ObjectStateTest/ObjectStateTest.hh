@@ -55,6 +55,7 @@ public:
     void testChildren();
     void testCopying();
     void testInequalityOperator();
+    void testHash();
 };
 
 
@@ -329,4 +330,42 @@ ObjectStateTest::testInequalityOperator() {
     delete copied;
 }
 
+/**
+ * Tests that equal trees hash equally and modified ones differently.
+ */
+void
+ObjectStateTest::testHash() {
+
+    ObjectState* root = new ObjectState("root");
+    root->setAttribute("a", 1);
+    root->setAttribute("b", 2);
+    ObjectState* child = new ObjectState("child");
+    child->setValue(5);
+    root->addChild(child);
+
+    ObjectState* copied = new ObjectState(*root);
+    TS_ASSERT_EQUALS(copied->hash(), root->hash());
+
+    // attribute order does not matter, like in operator!=
+    ObjectState* reordered = new ObjectState("root");
+    reordered->setAttribute("b", 2);
+    reordered->setAttribute("a", 1);
+    ObjectState* child2 = new ObjectState("child");
+    child2->setValue(5);
+    reordered->addChild(child2);
+    TS_ASSERT(!(*reordered != *root));
+    TS_ASSERT_EQUALS(reordered->hash(), root->hash());
+
+    copied->child(0)->setValue(6);
+    TS_ASSERT_DIFFERS(copied->hash(), root->hash());
+
+    copied->child(0)->setValue(5);
+    copied->setAttribute("a", 3);
+    TS_ASSERT_DIFFERS(copied->hash(), root->hash());
+
+    delete root;
+    delete copied;
+    delete reordered;
+}
+
 #endif
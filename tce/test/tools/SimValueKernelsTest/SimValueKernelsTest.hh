@@ -0,0 +1,226 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/** 
+ * @file SimValueKernelsTest.hh
+ * 
+ * A test suite for SimValueKernels.
+ */
+
+#ifndef SIM_VALUE_KERNELS_TEST_HH
+#define SIM_VALUE_KERNELS_TEST_HH
+
+#include <TestSuite.h>
+#include <cstdlib>
+#include "SimValue.hh"
+#include "SimValueKernels.hh"
+#include "TCEString.hh"
+
+class SimValueKernelsTest : public CxxTest::TestSuite {
+public:
+    void testArithmetic();
+    void testShifts();
+    void testComparisons();
+    void testShuffle();
+    void testNarrowValues();
+
+private:
+    static ULongWord lane(const SimValue& value, int index, int laneWidth);
+    static SLongWord signedLane(
+        const SimValue& value, int index, int laneWidth);
+    static void randomize(SimValue& value, unsigned seed);
+};
+
+/**
+ * Returns the zero extended lane of the given index.
+ */
+ULongWord
+SimValueKernelsTest::lane(const SimValue& value, int index, int laneWidth) {
+    ULongWord result = 0;
+    const int laneSize = laneWidth / 8;
+    for (int i = laneSize - 1; i >= 0; --i) {
+        result = (result << 8) | value.rawData_[index * laneSize + i];
+    }
+    return result;
+}
+
+/**
+ * Returns the sign extended lane of the given index.
+ */
+SLongWord
+SimValueKernelsTest::signedLane(
+    const SimValue& value, int index, int laneWidth) {
+
+    ULongWord bits = lane(value, index, laneWidth);
+    if (laneWidth < 64 && (bits >> (laneWidth - 1)) & 1) {
+        bits |= ~ULongWord(0) << laneWidth;
+    }
+    return static_cast<SLongWord>(bits);
+}
+
+/**
+ * Fills the value with pseudo random bytes.
+ */
+void
+SimValueKernelsTest::randomize(SimValue& value, unsigned seed) {
+    srand(seed);
+    for (int i = 0; i < value.width() / 8; ++i) {
+        value.rawData_[i] = rand() & 0xff;
+    }
+}
+
+/**
+ * Tests addition, subtraction and multiplication on all lane widths.
+ */
+void
+SimValueKernelsTest::testArithmetic() {
+    for (int laneWidth = 8; laneWidth <= 64; laneWidth *= 2) {
+        const ULongWord mask =
+            laneWidth == 64 ? ~ULongWord(0) : (ULongWord(1) << laneWidth) - 1;
+        SimValue a(1024), b(1024), sum(1024), difference(1024);
+        SimValue product(1024);
+        randomize(a, laneWidth);
+        randomize(b, laneWidth + 1);
+
+        SimValueKernels::add(a, b, sum, laneWidth);
+        SimValueKernels::sub(a, b, difference, laneWidth);
+        SimValueKernels::mul(a, b, product, laneWidth);
+        for (int i = 0; i < 1024 / laneWidth; ++i) {
+            const ULongWord x = lane(a, i, laneWidth);
+            const ULongWord y = lane(b, i, laneWidth);
+            TS_ASSERT_EQUALS(lane(sum, i, laneWidth), (x + y) & mask);
+            TS_ASSERT_EQUALS(
+                lane(difference, i, laneWidth), (x - y) & mask);
+            TS_ASSERT_EQUALS(lane(product, i, laneWidth), (x * y) & mask);
+        }
+    }
+}
+
+/**
+ * Tests the shifts, including the wrapping of the shift amount.
+ */
+void
+SimValueKernelsTest::testShifts() {
+    for (int laneWidth = 8; laneWidth <= 64; laneWidth *= 2) {
+        const ULongWord mask =
+            laneWidth == 64 ? ~ULongWord(0) : (ULongWord(1) << laneWidth) - 1;
+        SimValue a(512), b(512), left(512), right(512), rightu(512);
+        randomize(a, 3 * laneWidth);
+        randomize(b, 3 * laneWidth + 1);
+
+        SimValueKernels::shl(a, b, left, laneWidth);
+        SimValueKernels::shr(a, b, right, laneWidth);
+        SimValueKernels::shru(a, b, rightu, laneWidth);
+        for (int i = 0; i < 512 / laneWidth; ++i) {
+            const int amount = lane(b, i, laneWidth) % laneWidth;
+            const ULongWord x = lane(a, i, laneWidth);
+            TS_ASSERT_EQUALS(
+                lane(left, i, laneWidth), (x << amount) & mask);
+            TS_ASSERT_EQUALS(lane(rightu, i, laneWidth), x >> amount);
+            TS_ASSERT_EQUALS(
+                signedLane(right, i, laneWidth),
+                signedLane(a, i, laneWidth) >> amount);
+        }
+    }
+}
+
+/**
+ * Tests the comparisons, minimums and maximums.
+ */
+void
+SimValueKernelsTest::testComparisons() {
+    for (int laneWidth = 8; laneWidth <= 64; laneWidth *= 2) {
+        SimValue a(512), b(512);
+        randomize(a, 5 * laneWidth);
+        randomize(b, 5 * laneWidth + 1);
+        // make some of the lanes equal
+        for (int i = 0; i < 512 / 8; i += 3 * laneWidth / 8) {
+            for (int j = 0; j < laneWidth / 8; ++j) {
+                b.rawData_[i + j] = a.rawData_[i + j];
+            }
+        }
+        SimValue eq(512), gt(512), gtu(512);
+        SimValue min(512), minu(512), max(512), maxu(512);
+        SimValueKernels::eq(a, b, eq, laneWidth);
+        SimValueKernels::gt(a, b, gt, laneWidth);
+        SimValueKernels::gtu(a, b, gtu, laneWidth);
+        SimValueKernels::min(a, b, min, laneWidth);
+        SimValueKernels::minu(a, b, minu, laneWidth);
+        SimValueKernels::max(a, b, max, laneWidth);
+        SimValueKernels::maxu(a, b, maxu, laneWidth);
+        for (int i = 0; i < 512 / laneWidth; ++i) {
+            const ULongWord x = lane(a, i, laneWidth);
+            const ULongWord y = lane(b, i, laneWidth);
+            const SLongWord sx = signedLane(a, i, laneWidth);
+            const SLongWord sy = signedLane(b, i, laneWidth);
+            TS_ASSERT_EQUALS(lane(eq, i, laneWidth), ULongWord(x == y));
+            TS_ASSERT_EQUALS(lane(gt, i, laneWidth), ULongWord(sx > sy));
+            TS_ASSERT_EQUALS(lane(gtu, i, laneWidth), ULongWord(x > y));
+            TS_ASSERT_EQUALS(
+                signedLane(min, i, laneWidth), sx < sy ? sx : sy);
+            TS_ASSERT_EQUALS(
+                signedLane(max, i, laneWidth), sx > sy ? sx : sy);
+            TS_ASSERT_EQUALS(lane(minu, i, laneWidth), x < y ? x : y);
+            TS_ASSERT_EQUALS(lane(maxu, i, laneWidth), x > y ? x : y);
+        }
+    }
+}
+
+/**
+ * Tests lane permutation, also in place.
+ */
+void
+SimValueKernelsTest::testShuffle() {
+    SimValue a(256), indices(256), result(256);
+    for (int i = 0; i < 8; ++i) {
+        a.rawData_[4 * i] = 10 + i;
+        // reverse, with out-of-range indices wrapping around
+        indices.rawData_[4 * i] = (7 - i) + (i % 2) * 8;
+    }
+    SimValueKernels::shuffle(a, indices, result, 32);
+    for (int i = 0; i < 8; ++i) {
+        TS_ASSERT_EQUALS(lane(result, i, 32), ULongWord(17 - i));
+    }
+    SimValueKernels::shuffle(a, indices, a, 32);
+    for (int i = 0; i < 8; ++i) {
+        TS_ASSERT_EQUALS(lane(a, i, 32), ULongWord(17 - i));
+    }
+}
+
+/**
+ * Tests values that are narrower than a host vector register.
+ */
+void
+SimValueKernelsTest::testNarrowValues() {
+    SimValue a(64), b(64), sum(48);
+    a.setValue("0x0001000200030004");
+    b.setValue("0x000100010001ffff");
+    SimValueKernels::add(a, b, sum, 16);
+    TS_ASSERT_EQUALS(sum.hexValue(), "0x000300040003");
+
+    // in-place update
+    SimValueKernels::add(a, b, a, 16);
+    TS_ASSERT_EQUALS(a.hexValue(), "0x0002000300040003");
+}
+
+#endif
@@ -51,6 +51,7 @@ public:
     void testEqualities();
 
     void testMisc();
+    void testWideValues();
     
     
 private:
@@ -412,4 +413,50 @@ SimValueTest::testMisc() {
     TS_ASSERT_EQUALS(simValue.hexValue(), "0x0000");
 }
 
+/**
+ * Tests values wider than the inline storage.
+ */
+void
+SimValueTest::testWideValues() {
+    const TCEString hex =
+        "0x0123456789abcdeffedcba98765432100011223344556677"
+        "8899aabbccddeeff";
+    SimValue wide(256);
+    wide.setValue(hex);
+    TS_ASSERT_EQUALS(wide.width(), 256);
+    TS_ASSERT_EQUALS(wide.hexValue(), hex);
+    TS_ASSERT_EQUALS(wide.rawData_[0], 0xff);
+    TS_ASSERT_EQUALS(wide.rawData_[31], 0x01);
+
+    // copies keep their own storage
+    SimValue copy(wide);
+    TS_ASSERT_EQUALS(copy.hexValue(), hex);
+    copy.clearToZero();
+    TS_ASSERT_EQUALS(wide.hexValue(), hex);
+
+    // assignment keeps the destination width
+    SimValue narrow(32);
+    narrow = wide;
+    TS_ASSERT_EQUALS(narrow.width(), 32);
+    TS_ASSERT_EQUALS(narrow.hexValue(), "0xccddeeff");
+
+    SimValue wider(512);
+    wider = wide;
+    TS_ASSERT_EQUALS(wider.width(), 512);
+    TS_ASSERT_EQUALS(
+        wider.hexValue(),
+        "0x" + TCEString(std::string(64, '0')) + hex.substr(2));
+
+    // growing and shrinking the width clears the value
+    narrow.setBitWidth(4096);
+    TS_ASSERT_EQUALS(
+        narrow.hexValue(), "0x" + TCEString(std::string(1024, '0')));
+    narrow.setBitWidth(16);
+    TS_ASSERT_EQUALS(narrow.hexValue(), "0x0000");
+
+    narrow.deepCopy(wide);
+    TS_ASSERT_EQUALS(narrow.width(), 256);
+    TS_ASSERT(narrow == wide);
+}
+
 #endif